@@ -0,0 +1,173 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "batch.h"
+#include "minesweeper_engine/selfplay.h"
+#include "minesweeper_engine/thread_pool.h"
+
+static void print_usage(const char* p_program);
+static const char* get_first_click_name(const engine_first_click_t first_click);
+
+int run_batch(int argc, char* argv[])
+{
+    if (argc < 4 || argv[1][0] == '-')
+    {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    selfplay_config_t config;
+    memset(&config, 0, sizeof(selfplay_config_t));
+    config.rows = (size_t)strtoull(argv[1], NULL, 10);
+    config.cols = (size_t)strtoull(argv[2], NULL, 10);
+    config.num_mines = (size_t)strtoull(argv[3], NULL, 10);
+    config.first_click = ENGINE_FIRST_CLICK_SAFE_AREA;
+    config.first_seed = 1;
+    config.num_games = 1000;
+    config.p_policy = selfplay_find_policy("solver");
+
+    size_t num_threads = 0;
+
+    for (int i = 4; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--games") == 0 && i + 1 < argc)
+        {
+            config.num_games = (size_t)strtoull(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            config.first_seed = strtoull(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--seeds") == 0 && i + 2 < argc)
+        {
+            const uint64_t first_seed = strtoull(argv[++i], NULL, 10);
+            const uint64_t last_seed = strtoull(argv[++i], NULL, 10);
+            config.first_seed = first_seed;
+            config.num_games = (last_seed > first_seed) ? (size_t)(last_seed - first_seed) : 0;
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            num_threads = (size_t)strtoull(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--policy") == 0 && i + 1 < argc)
+        {
+            config.p_policy = selfplay_find_policy(argv[++i]);
+            if (config.p_policy == NULL)
+            {
+                printf("unknown policy: %s\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--first-click") == 0 && i + 1 < argc)
+        {
+            ++i;
+            if (strcmp(argv[i], "any") == 0)
+            {
+                config.first_click = ENGINE_FIRST_CLICK_ANY;
+            }
+            else if (strcmp(argv[i], "safe") == 0)
+            {
+                config.first_click = ENGINE_FIRST_CLICK_SAFE;
+            }
+            else if (strcmp(argv[i], "safe-area") == 0)
+            {
+                config.first_click = ENGINE_FIRST_CLICK_SAFE_AREA;
+            }
+            else
+            {
+                printf("unknown first click: %s\n", argv[i]);
+                return 1;
+            }
+        }
+        else
+        {
+            printf("unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (config.rows < 1 || config.cols < 1 || config.num_mines < 1 || config.num_mines >= config.rows * config.cols)
+    {
+        printf("rows >= 1, cols >= 1, 1 <= num_mines < rows * cols\n");
+        return 1;
+    }
+
+    // 일감 번호가 32비트
+    if (config.num_games < 1 || config.num_games > UINT32_MAX)
+    {
+        printf("1 <= games <= %u\n", UINT32_MAX);
+        return 1;
+    }
+
+    thread_pool_t pool;
+    thread_pool_t* p_pool = NULL;
+    if (num_threads != 1)
+    {
+        if (!thread_pool_init(&pool, num_threads))
+        {
+            printf("Failed to init thread pool\n");
+            return 1;
+        }
+        p_pool = &pool;
+    }
+
+    int exit_code = 0;
+
+    selfplay_t selfplay;
+    if (!selfplay_init(&selfplay, p_pool, &config))
+    {
+        printf("Failed to init selfplay\n");
+        exit_code = 1;
+        goto failed_init_selfplay;
+    }
+
+    selfplay_result_t result;
+    selfplay_run(&selfplay, &result);
+
+    const double elapsed = (result.elapsed > 0.0) ? result.elapsed : 1e-9;
+
+    printf("policy: %s\n", config.p_policy->p_name);
+    printf("threads: %zu\n", (p_pool == NULL) ? (size_t)1 : thread_pool_get_num_threads(p_pool));
+    printf("board: %zu x %zu, %zu mines, first click %s\n", config.rows, config.cols, config.num_mines, get_first_click_name(config.first_click));
+    printf("seeds: [%llu, %llu)\n", (unsigned long long)config.first_seed, (unsigned long long)(config.first_seed + config.num_games));
+    printf("games: %zu (won %zu, lost %zu, stuck %zu)\n", result.num_games, result.num_won, result.num_lost, result.num_stuck);
+    printf("win rate: %.2f%%\n", 100.0 * (double)result.num_won / (double)result.num_games);
+    printf("elapsed: %.3f s\n", result.elapsed);
+    printf("games/s: %.1f\n", (double)result.num_games / elapsed);
+    printf("moves/game: %.1f\n", (double)result.num_moves / (double)result.num_games);
+    printf("latency ms: mean %.3f, p50 %.3f, p90 %.3f, p99 %.3f, max %.3f\n",
+           result.mean_latency * 1000.0, result.p50_latency * 1000.0, result.p90_latency * 1000.0,
+           result.p99_latency * 1000.0, result.max_latency * 1000.0);
+
+    selfplay_release(&selfplay);
+
+failed_init_selfplay:
+    if (p_pool != NULL)
+    {
+        thread_pool_release(p_pool);
+    }
+
+    return exit_code;
+}
+
+static void print_usage(const char* p_program)
+{
+    printf("usage: %s rows cols num_mines [--games n] [--seed n] [--seeds first last] [--threads n] [--policy solver|probability|random] [--first-click any|safe|safe-area]\n", p_program);
+}
+
+static const char* get_first_click_name(const engine_first_click_t first_click)
+{
+    switch (first_click)
+    {
+    case ENGINE_FIRST_CLICK_ANY:
+        return "any";
+    case ENGINE_FIRST_CLICK_SAFE:
+        return "safe";
+    default:
+        return "safe-area";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "safe99_common/defines.h"
+
+// 창 없이 정책으로 여러 판을 자동으로 두고 결과를 콘솔에 출력 (야간 회귀 측정용)
+//
+// rows cols num_mines [options]
+//   --games n          둘 판 수 (기본 1000)
+//   --seed n           첫 판 시드, 판 i는 seed + i (기본 1)
+//   --seeds a b        시드 범위 [a, b), --seed/--games 대신
+//   --threads n        스레드 수, 0이면 논리 프로세서 수, 1이면 풀 없이 (기본 0)
+//   --policy name      solver, probability, random (기본 solver)
+//   --first-click m    any, safe, safe-area (기본 safe-area)
+
+START_EXTERN_C
+
+// argv[0]은 프로그램 이름, 성공하면 0
+int run_batch(int argc, char* argv[]);
+
+END_EXTERN_C
+
+#endif // BATCH_H
\ No newline at end of file
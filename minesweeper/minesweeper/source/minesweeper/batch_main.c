@@ -0,0 +1,7 @@
+#include "batch.h"
+
+// 창 없는 자동 대국 (batch.h 참고)
+int main(int argc, char* argv[])
+{
+    return run_batch(argc, argv);
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include <string.h>
+
+#include "blitter.h"
+#include "safe99_common/assert.h"
+
+#if defined(ENABLE_SSE_INTRINSICS)
+    #include <emmintrin.h>
+    #if defined(__AVX2__)
+        #include <immintrin.h>
+    #endif // __AVX2__
+#endif // ENABLE_SSE_INTRINSICS
+
+void blit_16x16(char* p_dst, const size_t dst_pitch, const char* p_src, const size_t src_pitch)
+{
+    ASSERT(p_dst != NULL, "p_dst == NULL");
+    ASSERT(p_src != NULL, "p_src == NULL");
+
+    for (size_t y = 0; y < BLITTER_TILE_HEIGHT; ++y)
+    {
+#if defined(ENABLE_SSE_INTRINSICS) && defined(__AVX2__)
+        const __m256i row0 = _mm256_loadu_si256((const __m256i*)(p_src + 0));
+        const __m256i row1 = _mm256_loadu_si256((const __m256i*)(p_src + 32));
+        _mm256_storeu_si256((__m256i*)(p_dst + 0), row0);
+        _mm256_storeu_si256((__m256i*)(p_dst + 32), row1);
+#elif defined(ENABLE_SSE_INTRINSICS)
+        const __m128i row0 = _mm_loadu_si128((const __m128i*)(p_src + 0));
+        const __m128i row1 = _mm_loadu_si128((const __m128i*)(p_src + 16));
+        const __m128i row2 = _mm_loadu_si128((const __m128i*)(p_src + 32));
+        const __m128i row3 = _mm_loadu_si128((const __m128i*)(p_src + 48));
+        _mm_storeu_si128((__m128i*)(p_dst + 0), row0);
+        _mm_storeu_si128((__m128i*)(p_dst + 16), row1);
+        _mm_storeu_si128((__m128i*)(p_dst + 32), row2);
+        _mm_storeu_si128((__m128i*)(p_dst + 48), row3);
+#else
+        memcpy(p_dst, p_src, BLITTER_TILE_WIDTH * 4);
+#endif // ENABLE_SSE_INTRINSICS
+
+        p_dst += dst_pitch;
+        p_src += src_pitch;
+    }
+}
+
+void blit_13x23(char* p_dst, const size_t dst_pitch, const char* p_src, const size_t src_pitch)
+{
+    ASSERT(p_dst != NULL, "p_dst == NULL");
+    ASSERT(p_src != NULL, "p_src == NULL");
+
+    for (size_t y = 0; y < BLITTER_NUMBER_HEIGHT; ++y)
+    {
+#if defined(ENABLE_SSE_INTRINSICS)
+        // 36 ~ 51 바이트를 마지막으로 저장해 32 ~ 35 바이트는 두 번 씀
+        const __m128i row0 = _mm_loadu_si128((const __m128i*)(p_src + 0));
+        const __m128i row1 = _mm_loadu_si128((const __m128i*)(p_src + 16));
+        const __m128i row2 = _mm_loadu_si128((const __m128i*)(p_src + 32));
+        const __m128i row3 = _mm_loadu_si128((const __m128i*)(p_src + 36));
+        _mm_storeu_si128((__m128i*)(p_dst + 0), row0);
+        _mm_storeu_si128((__m128i*)(p_dst + 16), row1);
+        _mm_storeu_si128((__m128i*)(p_dst + 32), row2);
+        _mm_storeu_si128((__m128i*)(p_dst + 36), row3);
+#else
+        memcpy(p_dst, p_src, BLITTER_NUMBER_WIDTH * 4);
+#endif // ENABLE_SSE_INTRINSICS
+
+        p_dst += dst_pitch;
+        p_src += src_pitch;
+    }
+}
+
+void blit_scaled_clipped(char* p_dst, const size_t dst_pitch, const int32_t clip_left, const int32_t clip_top, const int32_t clip_right, const int32_t clip_bottom,
+                         const int64_t dx, const int64_t dy, const char* p_src, const size_t src_pitch, const size_t src_width, const size_t src_height, const uint32_t scale)
+{
+    ASSERT(p_dst != NULL, "p_dst == NULL");
+    ASSERT(p_src != NULL, "p_src == NULL");
+    ASSERT(scale > 0, "scale == 0");
+
+    const int64_t left = (dx > clip_left) ? dx : clip_left;
+    const int64_t top = (dy > clip_top) ? dy : clip_top;
+    const int64_t right = (dx + (int64_t)(src_width * scale) < clip_right) ? dx + (int64_t)(src_width * scale) : clip_right;
+    const int64_t bottom = (dy + (int64_t)(src_height * scale) < clip_bottom) ? dy + (int64_t)(src_height * scale) : clip_bottom;
+
+    if (left >= right || top >= bottom)
+    {
+        return;
+    }
+
+    const size_t row_size = (size_t)(right - left) * sizeof(uint32_t);
+    const int64_t begin_sx = (left - dx) / scale;
+    const int64_t end_sx = (right - 1 - dx) / scale + 1;
+
+    for (int64_t y = top; y < bottom; ++y)
+    {
+        uint32_t* p_dst_row = (uint32_t*)(p_dst + (size_t)y * dst_pitch);
+
+        // 같은 원본 줄을 늘린 줄은 바로 위 줄을 복사
+        const int64_t sy = (y - dy) / scale;
+        if (y > top && (y - 1 - dy) / scale == sy)
+        {
+            memcpy(p_dst_row + left, (const char*)p_dst_row - dst_pitch + (size_t)left * sizeof(uint32_t), row_size);
+            continue;
+        }
+
+        // 원본 픽셀 하나를 scale개로 늘려 채움
+        const uint32_t* p_src_row = (const uint32_t*)(p_src + (size_t)sy * src_pitch);
+        for (int64_t sx = begin_sx; sx < end_sx; ++sx)
+        {
+            const uint32_t pixel = p_src_row[sx];
+            int64_t x = dx + sx * scale;
+            int64_t x_end = x + scale;
+            x = (x < left) ? left : x;
+            x_end = (x_end > right) ? right : x_end;
+            for (; x < x_end; ++x)
+            {
+                p_dst_row[x] = pixel;
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef BLITTER_H
+#define BLITTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "safe99_common/defines.h"
+
+// 크기가 고정된 A8R8G8B8 스프라이트 복사
+// 자르기 없이 대상 영역이 버퍼 안에 완전히 들어와야 함
+// pitch는 바이트 단위, 정렬은 필요 없음
+
+#define BLITTER_TILE_WIDTH 16
+#define BLITTER_TILE_HEIGHT 16
+#define BLITTER_NUMBER_WIDTH 13
+#define BLITTER_NUMBER_HEIGHT 23
+
+START_EXTERN_C
+
+// 한 줄 64바이트를 SSE2 저장 4번 (AVX2면 2번)으로 복사
+void blit_16x16(char* p_dst, const size_t dst_pitch, const char* p_src, const size_t src_pitch);
+
+// 한 줄 52바이트를 16바이트 저장 4번으로 복사 (마지막은 앞 저장과 겹침)
+void blit_13x23(char* p_dst, const size_t dst_pitch, const char* p_src, const size_t src_pitch);
+
+// src_width * src_height 스프라이트를 scale배 확대해 (dx, dy)에 그림
+// 대상 중 [clip_left, clip_right) x [clip_top, clip_bottom) 밖은 버림 (버퍼 안이어야 함)
+void blit_scaled_clipped(char* p_dst, const size_t dst_pitch, const int32_t clip_left, const int32_t clip_top, const int32_t clip_right, const int32_t clip_bottom,
+                         const int64_t dx, const int64_t dy, const char* p_src, const size_t src_pitch, const size_t src_width, const size_t src_height, const uint32_t scale);
+
+END_EXTERN_C
+
+#endif // BLITTER_H
\ No newline at end of file
@@ -1,79 +1,97 @@
 #include <stddef.h>
-#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
+#include "blitter.h"
 #include "game.h"
-#include "image_loader.h"
-#include "mouse_event.h"
+#include "minesweeper_engine/profiler.h"
 #include "safe99_common/assert.h"
 #include "safe99_common/safe_delete.h"
+#include "sprite_atlas.h"
 
-static size_t depth = 0;
+#if SPRITE_TILE_WIDTH != BLITTER_TILE_WIDTH || SPRITE_TILE_HEIGHT != BLITTER_TILE_HEIGHT
+    #error "Tile sprite size does not match blit_16x16"
+#endif
 
-static image_t s_sprite_tiles;
-static image_t s_sprite_numbers;
-static image_t s_sprite_faces;
+#if SPRITE_NUMBER_WIDTH != BLITTER_NUMBER_WIDTH || SPRITE_NUMBER_HEIGHT != BLITTER_NUMBER_HEIGHT
+    #error "Number sprite size does not match blit_13x23"
+#endif
 
-static bool load_sprites();
-static void unload_sprites();
+static sprite_atlas_t s_sprite_atlas;
+
+static void apply_input(game_t* p_game, const mouse_event_t* p_event);
+static void update_pressed_tile(game_t* p_game);
+static void restart_game(game_t* p_game, const uint64_t now);
+static void record_action(game_t* p_game, const action_type_t type, const size_t x, const size_t y, const uint64_t seed, const uint64_t now);
+static uint64_t get_elapsed_ms(const game_t* p_game, const uint64_t now);
 
-static void make_mine(bool* p_mines, const size_t rows, const size_t cols, const size_t num_mines);
+static int64_t get_tile_size(const game_t* p_game);
+static bool clamp_camera(game_t* p_game);
+static bool is_mouse_on_face(const game_t* p_game);
+static bool screen_to_tile(const game_t* p_game, const int32_t screen_x, const int32_t screen_y, size_t* p_out_x, size_t* p_out_y);
+static void get_visible_tiles(const game_t* p_game, size_t* p_out_begin_x, size_t* p_out_begin_y, size_t* p_out_end_x, size_t* p_out_end_y);
 
-static bool is_valid_position(const game_t* p_game, const size_t x, const size_t y);
-static void open_tile_recursion(game_t* p_game, const size_t x, const size_t y);
-static void open_tile(game_t* p_game, const size_t x, const size_t y);
+static void draw_tile(const game_t* p_game, const engine_status_t status, const size_t x, const size_t y);
+static void draw_tile_sprite(const game_t* p_game, const int32_t dx, const int32_t dy, const int32_t sx, const int32_t sy);
+static void draw_number_sprite(const game_t* p_game, const int32_t dx, const int32_t dy, const int32_t digit);
+
+static bool load_sprites();
+static void unload_sprites();
 
-bool init_game(HWND hwnd, game_t* p_game, const int rows, const int cols, const int num_mines)
+bool init_game(renderer_t* p_renderer, game_t* p_game, const int rows, const int cols, const int num_mines)
 {
+    ASSERT(p_renderer != NULL, "p_renderer == NULL");
     ASSERT(p_game != NULL, "p_game == NULL");
     ASSERT(rows >= 9, "width < 9");
     ASSERT(cols >= 9, "height < 9");
     ASSERT(num_mines > 0, "num_mines == 0");
 
-    p_game->rows = rows;
-    p_game->cols = cols;
-    p_game->num_mines = num_mines;
-    p_game->num_max_mines = num_mines;
     p_game->count = 0;
-    p_game->b_gameover = false;
+    p_game->start_time = 0;
+    p_game->b_timer_started = false;
+    p_game->mouse_x = 0;
+    p_game->mouse_y = 0;
     p_game->b_left_mouse_pressed = false;
-    p_game->num_tiles = rows * cols;
-
-    srand((unsigned int)time(NULL));
-
-    // 지뢰 초기화
-    p_game->pa_mines = (bool*)malloc(sizeof(bool) * rows * cols);
-    if (p_game->pa_mines == NULL)
+    p_game->b_right_mouse_pressed = false;
+    p_game->pressed_tile_x = 0;
+    p_game->pressed_tile_y = 0;
+    p_game->b_tile_pressed = false;
+    p_game->camera_x = 0;
+    p_game->camera_y = 0;
+    p_game->zoom = GAME_MIN_ZOOM;
+    p_game->b_no_guess = false;
+    p_game->b_recording = false;
+    p_game->p_autosave_path = NULL;
+    p_game->autosave_interval = 0;
+    p_game->next_autosave_time = 0;
+    p_game->b_unsaved = false;
+
+    mouse_event_queue_init(&p_game->input_queue);
+
+    random_init(&p_game->seed_random, (uint64_t)time(NULL));
+
+    // 엔진 초기화
+    if (!engine_init(&p_game->engine, (size_t)rows, (size_t)cols, (size_t)num_mines, random_next(&p_game->seed_random)))
     {
-        ASSERT(false, "Failed to malloc mines");
-        goto failed_malloc_mines;
+        ASSERT(false, "Failed to init engine");
+        goto failed_init_engine;
     }
-    memset(p_game->pa_mines, false, sizeof(bool) * rows * cols);
 
-    // 타일 초기화
-    p_game->pa_tiles = (tile_t*)malloc(sizeof(tile_t) * rows * cols);
-    if (p_game->pa_tiles == NULL)
-    {
-        ASSERT(false, "Failed to malloc tiles");
-        goto failed_malloc_tiles;
-    }
-    memset(p_game->pa_tiles, TILE_BLIND, sizeof(tile_t) * rows * cols);
+    // 첫 번째로 연 타일은 지뢰가 아님
+    engine_set_first_click(&p_game->engine, ENGINE_FIRST_CLICK_SAFE);
 
-    // 렌더러 생성
-    p_game->pa_renderer = (renderer_ddraw_t*)malloc(sizeof(renderer_ddraw_t));
-    if (p_game->pa_renderer == NULL)
+    if (!snapshot_writer_init(&p_game->snapshot_writer))
     {
-        ASSERT(false, "Failed to malloc renderer");
-        goto failed_malloc_renderer;
+        ASSERT(false, "Failed to init snapshot writer");
+        goto failed_init_snapshot_writer;
     }
 
-    // 렌더러 초기화
-    if (!renderer_ddraw_init(p_game->pa_renderer, hwnd))
-    {
-        ASSERT(false, "Failed to init renderer");
-        goto failed_init_renderer;
-    }
+    p_game->p_renderer = p_renderer;
+    p_game->p_locked_buffer = NULL;
+    p_game->locked_buffer_pitch = 0;
+    p_game->locked_buffer_width = 0;
+    p_game->locked_buffer_height = 0;
 
     // 스프라이트 로드
     if (!load_sprites())
@@ -82,39 +100,20 @@ bool init_game(HWND hwnd, game_t* p_game, const int rows, const int cols, const
         goto failed_load_sprites;
     }
 
-    // 타이머 초기화
-    if (!timer_init(&p_game->timer, 1000.0f))
-    {
-        ASSERT(false, "Failed to init timer");
-        goto failed_init_timer;
-    }
-
-    const size_t window_width = renderer_ddraw_get_width(p_game->pa_renderer);
-    const size_t window_height = renderer_ddraw_get_height(p_game->pa_renderer);
+    const size_t window_width = renderer_get_width(p_game->p_renderer);
 
     p_game->face_x = window_width / 2 - SPRITE_FACE_WIDTH / 2;
     p_game->face_y = INFO_HEIGHT / 2 - SPRITE_FACE_HEIGHT / 2;
 
-    make_mine(p_game->pa_mines, rows, cols, num_mines);
-
     return true;
 
-failed_init_timer:
-    unload_sprites();
-
 failed_load_sprites:
-    renderer_ddraw_release(p_game->pa_renderer);
-
-failed_init_renderer:
-    SAFE_FREE(p_game->pa_renderer);
+    snapshot_writer_release(&p_game->snapshot_writer);
 
-failed_malloc_renderer:
-    SAFE_FREE(p_game->pa_tiles);
+failed_init_snapshot_writer:
+    engine_release(&p_game->engine);
 
-failed_malloc_tiles:
-    SAFE_FREE(p_game->pa_mines);
-
-failed_malloc_mines:
+failed_init_engine:
     memset(p_game, 0, sizeof(game_t));
     return false;
 }
@@ -125,167 +124,263 @@ void shutdown_game(game_t* p_game)
 
     unload_sprites();
 
-    SAFE_FREE(p_game->pa_renderer);
-    SAFE_FREE(p_game->pa_tiles);
-    SAFE_FREE(p_game->pa_mines);
+    // 종료 시각을 모르므로 마지막 행동 시각으로 끝냄
+    if (p_game->b_recording)
+    {
+        stop_game_recording(p_game, p_game->action_log.last_time);
+    }
+
+    // 진행 중인 저장은 끝까지 씀
+    snapshot_writer_release(&p_game->snapshot_writer);
+
+    set_game_no_guess(p_game, false);
+    engine_release(&p_game->engine);
 
     memset(p_game, 0, sizeof(game_t));
 }
 
-void update_game(game_t* p_game)
+bool set_game_no_guess(game_t* p_game, const bool b_no_guess)
 {
     ASSERT(p_game != NULL, "p_game == NULL");
 
-    const size_t WINDOW_WIDTH = renderer_ddraw_get_width(p_game->pa_renderer);
-    const size_t WINDOW_HEIGHT = renderer_ddraw_get_height(p_game->pa_renderer);
+    if (p_game->b_no_guess == b_no_guess)
+    {
+        return true;
+    }
+
+    // 첫 클릭 방식은 기록 헤더에만 남으므로 기록 중에 바꾸면 재생한 판이 달라짐
+    if (p_game->b_recording)
+    {
+        return false;
+    }
 
-    const size_t ROWS = (size_t)p_game->rows;
-    const size_t COLS = (size_t)p_game->cols;
+    engine_t* p_engine = &p_game->engine;
 
-    if (!p_game->b_left_mouse_pressed && get_left_mouse_state() == MOUSE_STATE_DOWN)
+    if (!b_no_guess)
     {
-        p_game->b_left_mouse_pressed = true;
+        generator_release(&p_game->generator);
+        thread_pool_release(&p_game->thread_pool);
+        p_game->b_no_guess = false;
+
+        engine_set_first_click(p_engine, ENGINE_FIRST_CLICK_SAFE);
+        return true;
     }
 
-    if (p_game->b_right_mouse_pressed && get_right_mouse_state() == MOUSE_STATE_UP)
+    // 논리 프로세서 수만큼
+    if (!thread_pool_init(&p_game->thread_pool, 0))
     {
-        p_game->b_right_mouse_pressed = false;
+        ASSERT(false, "Failed to init thread pool");
+        goto failed_init_thread_pool;
     }
 
-    if (p_game->b_left_mouse_pressed && get_left_mouse_state() == MOUSE_STATE_UP)
+    // 첫 타일 주변이 비어 있어야 추론을 시작할 수 있음
+    if (!generator_init(&p_game->generator, &p_game->thread_pool, p_engine->rows, p_engine->cols, p_engine->num_max_mines, ENGINE_FIRST_CLICK_SAFE_AREA))
     {
-        const size_t mouse_x = (size_t)get_mouse_x();
-        const size_t mouse_y = (size_t)get_mouse_y();
+        ASSERT(false, "Failed to init generator");
+        goto failed_init_generator;
+    }
 
-        // 얼굴 클릭 시 게임 재시작
-        if (mouse_x >= p_game->face_x && mouse_x <= p_game->face_x + SPRITE_FACE_WIDTH
-            && mouse_y >= p_game->face_y && mouse_y <= p_game->face_y + SPRITE_FACE_HEIGHT)
-        {
-            p_game->num_mines = p_game->num_max_mines;
-            p_game->num_tiles = (int)p_game->rows * (int)p_game->cols;
-            p_game->count = 0;
-            p_game->b_gameover = false;
+    p_game->b_no_guess = true;
+    engine_set_first_click(p_engine, ENGINE_FIRST_CLICK_SAFE_AREA);
 
-            timer_reset(&p_game->timer);
+    return true;
 
-            memset(p_game->pa_mines, false, sizeof(bool) * p_game->rows * p_game->cols);
-            memset(p_game->pa_tiles, TILE_BLIND, sizeof(tile_t) * p_game->rows * p_game->cols);
-            make_mine(p_game->pa_mines, p_game->rows, p_game->cols, p_game->num_max_mines);
+failed_init_generator:
+    thread_pool_release(&p_game->thread_pool);
 
-            p_game->b_left_mouse_pressed = false;
-            p_game->b_right_mouse_pressed = false;
-        }
+failed_init_thread_pool:
+    return false;
+}
 
-        if (p_game->b_gameover)
-        {
-            p_game->b_left_mouse_pressed = false;
-        }
-    }
+bool start_game_recording(game_t* p_game, const char* p_path, const uint64_t now)
+{
+    ASSERT(p_game != NULL, "p_game == NULL");
+    ASSERT(p_path != NULL, "p_path == NULL");
+    ASSERT(!p_game->b_recording, "Already recording");
 
-    if (p_game->b_gameover)
+    // 헤더의 시드로 판을 다시 만들 수 있어야 함
+    if (p_game->engine.b_mines_placed)
     {
-        return;
+        restart_game(p_game, now);
     }
 
-    timer_update(&p_game->timer);
-    if (timer_is_on_tick(&p_game->timer))
+    if (!action_log_writer_open(&p_game->action_log, p_path, &p_game->engine, now))
     {
-        ++p_game->count;
+        return false;
     }
 
-    if (p_game->b_left_mouse_pressed && get_left_mouse_state() == MOUSE_STATE_UP)
+    p_game->b_recording = true;
+    return true;
+}
+
+bool stop_game_recording(game_t* p_game, const uint64_t now)
+{
+    ASSERT(p_game != NULL, "p_game == NULL");
+    ASSERT(p_game->b_recording, "Not recording");
+
+    p_game->b_recording = false;
+    return action_log_writer_close(&p_game->action_log, &p_game->engine, now);
+}
+
+bool save_game_snapshot(game_t* p_game, const char* p_path, const uint64_t now)
+{
+    ASSERT(p_game != NULL, "p_game == NULL");
+    ASSERT(p_path != NULL, "p_path == NULL");
+
+    snapshot_session_t session;
+    session.elapsed_ms = get_elapsed_ms(p_game, now);
+    session.b_timer_started = p_game->b_timer_started;
+    session.seed_random = p_game->seed_random;
+
+    if (!snapshot_writer_request(&p_game->snapshot_writer, p_path, &p_game->engine, &session))
     {
-        const size_t mouse_x = (size_t)get_mouse_x();
-        const size_t mouse_y = (size_t)get_mouse_y();
+        return false;
+    }
 
-        // 스크린 좌표 -> 타일 좌표 변환
-        const size_t tile_x = mouse_x / SPRITE_TILE_WIDTH;
-        const size_t tile_y = (mouse_y - INFO_HEIGHT) / SPRITE_TILE_HEIGHT;
+    p_game->b_unsaved = false;
+    return true;
+}
 
-        // 타일 클릭 시
-        if (mouse_x >= 0 && mouse_x < WINDOW_WIDTH
-            && mouse_y >= INFO_HEIGHT && mouse_y < WINDOW_HEIGHT)
-        {
-            // 지뢰일 경우
-            const bool b_gameover_mine = p_game->pa_mines[tile_y * p_game->cols + tile_x];
-            if (b_gameover_mine)
-            {
-                // 지뢰가 있는 타일 열기
-                for (size_t i = 0; i < p_game->rows; ++i)
-                {
-                    for (size_t j = 0; j < p_game->cols; ++j)
-                    {
-                        const bool b_mine = p_game->pa_mines[i * p_game->cols + j];
-                        if (b_mine)
-                        {
-                            p_game->pa_tiles[i * p_game->cols + j] = TILE_MINE;
-                        }
-                    }
-                }
+bool flush_game_snapshot(game_t* p_game)
+{
+    ASSERT(p_game != NULL, "p_game == NULL");
 
-                p_game->pa_tiles[tile_y * p_game->cols + tile_x] = TILE_GAMEOVER_MINE;
-                p_game->b_gameover = true;
-            }
-            else if (p_game->pa_tiles[tile_y * p_game->cols + tile_x] != TILE_FLAG)
-            {
-                //open_tile_recursion(p_game, tile_x, tile_y);
-                //printf("depth: %llu", depth);
-                //depth = 0;
-                open_tile(p_game, tile_x, tile_y);
+    return snapshot_writer_wait(&p_game->snapshot_writer);
+}
 
-                // 남은 타일의 수와 지뢰 개수가 같으면 승리
-                if (p_game->num_tiles == p_game->num_max_mines)
-                {
-                    p_game->num_mines = 0;
-                    p_game->b_gameover = true;
-                }
-            }
-        }
+bool resume_game(game_t* p_game, const char* p_path, const uint64_t now)
+{
+    ASSERT(p_game != NULL, "p_game == NULL");
+    ASSERT(p_path != NULL, "p_path == NULL");
+    ASSERT(!p_game->b_recording, "Recording");
 
-        p_game->b_left_mouse_pressed = false;
+    snapshot_t snapshot;
+    if (!snapshot_open(&snapshot, p_path))
+    {
+        return false;
     }
 
-    if (!p_game->b_right_mouse_pressed && get_right_mouse_state() == MOUSE_STATE_DOWN)
+    engine_t engine;
+    snapshot_session_t session;
+    const bool b_restored = snapshot_restore(&snapshot, &engine, &session);
+    snapshot_close(&snapshot);
+
+    if (!b_restored)
     {
-        const size_t mouse_x = (size_t)get_mouse_x();
-        const size_t mouse_y = (size_t)get_mouse_y();
+        return false;
+    }
 
-        if (mouse_x >= 0 && mouse_x < WINDOW_WIDTH
-            && mouse_y >= INFO_HEIGHT && mouse_y < WINDOW_HEIGHT)
-        {
-            // 스크린 좌표 -> 타일 좌표 변환
-            const size_t tile_x = mouse_x / SPRITE_TILE_WIDTH;
-            const size_t tile_y = (mouse_y - INFO_HEIGHT) / SPRITE_TILE_HEIGHT;
+    engine_release(&p_game->engine);
+    p_game->engine = engine;
+    p_game->seed_random = session.seed_random;
 
-            const tile_t tile = p_game->pa_tiles[tile_y * p_game->cols + tile_x];
-            switch (tile)
-            {
-            case TILE_BLIND:
-                --p_game->num_mines;
-                p_game->pa_tiles[tile_y * p_game->cols + tile_x] = TILE_FLAG;
-                break;
-            case TILE_FLAG:
-                p_game->num_mines++;
-                p_game->pa_tiles[tile_y * p_game->cols + tile_x] = TILE_UNKNOWN;
-                break;
-            case TILE_UNKNOWN:
-                p_game->pa_tiles[tile_y * p_game->cols + tile_x] = TILE_BLIND;
-                break;
-            default:
-                break;
-            }
+    // 생성기는 판 크기에 묶여 있으므로 새 크기로 다시 만듦
+    const bool b_no_guess = p_game->b_no_guess;
+    set_game_no_guess(p_game, false);
+    if (!b_no_guess || !set_game_no_guess(p_game, true))
+    {
+        engine_set_first_click(&p_game->engine, ENGINE_FIRST_CLICK_SAFE);
+    }
+
+    // 멈춘 타이머는 멈춘 값 그대로, 도는 타이머는 이어서 셈
+    p_game->b_timer_started = session.b_timer_started;
+    p_game->start_time = (now > session.elapsed_ms) ? now - session.elapsed_ms : 0;
+    p_game->count = (size_t)(session.elapsed_ms / 1000);
+
+    p_game->b_left_mouse_pressed = false;
+    p_game->b_right_mouse_pressed = false;
+    p_game->b_tile_pressed = false;
+    p_game->b_unsaved = false;
+
+    clamp_camera(p_game);
+    invalidate_game(p_game);
+
+    return true;
+}
+
+void set_game_autosave(game_t* p_game, const char* p_path, const uint64_t interval_ms, const uint64_t now)
+{
+    ASSERT(p_game != NULL, "p_game == NULL");
+
+    p_game->p_autosave_path = p_path;
+    p_game->autosave_interval = interval_ms;
+    p_game->next_autosave_time = now + interval_ms;
+}
+
+bool push_game_input(game_t* p_game, const mouse_event_type_t type, const int32_t x, const int32_t y, const uint64_t time)
+{
+    ASSERT(p_game != NULL, "p_game == NULL");
+
+    return mouse_event_queue_push(&p_game->input_queue, type, x, y, time);
+}
+
+void update_game(game_t* p_game, const uint64_t now)
+{
+    ASSERT(p_game != NULL, "p_game == NULL");
+
+    PROFILE_BEGIN(update_game);
+
+    const size_t WINDOW_WIDTH = renderer_get_width(p_game->p_renderer);
+
+    engine_t* p_engine = &p_game->engine;
+
+    // 창 크기가 바뀌었을 수 있음
+    p_game->face_x = WINDOW_WIDTH / 2 - SPRITE_FACE_WIDTH / 2;
+    if (clamp_camera(p_game))
+    {
+        invalidate_game(p_game);
+    }
+
+    // 프레임 사이에 쌓인 입력을 합치지 않고 들어온 순서대로 모두 적용
+    // 한 묶음을 다 채웠을 때만 더 꺼내므로 넣는 쪽이 계속 넣어도 끝남
+    PROFILE_BEGIN(apply_input);
+    mouse_event_t events[GAME_INPUT_BATCH_SIZE];
+    size_t num_events;
+    do
+    {
+        num_events = mouse_event_queue_pop(&p_game->input_queue, events, GAME_INPUT_BATCH_SIZE);
+        for (size_t i = 0; i < num_events; ++i)
+        {
+            apply_input(p_game, &events[i]);
         }
+    } while (num_events == GAME_INPUT_BATCH_SIZE);
+    PROFILE_END(apply_input);
 
-        p_game->b_right_mouse_pressed = true;
+    update_pressed_tile(p_game);
+
+    // 이전 저장을 아직 쓰는 중이면 다음 프레임에 다시 시도
+    if (p_game->p_autosave_path != NULL && p_game->b_unsaved && now >= p_game->next_autosave_time
+        && save_game_snapshot(p_game, p_game->p_autosave_path, now))
+    {
+        p_game->next_autosave_time = now + p_game->autosave_interval;
     }
+
+    if (engine_is_gameover(p_engine))
+    {
+        PROFILE_END(update_game);
+        return;
+    }
+
+    // 첫 프레임부터 초 단위로 셈
+    if (!p_game->b_timer_started)
+    {
+        p_game->start_time = now;
+        p_game->b_timer_started = true;
+    }
+    p_game->count = (size_t)((now - p_game->start_time) / 1000);
+
+    PROFILE_END(update_game);
 }
 
-void draw_game(const game_t* p_game)
+void draw_game(game_t* p_game)
 {
     ASSERT(p_game != NULL, "p_game == NULL");
 
-    const size_t WINDOW_WIDTH = renderer_ddraw_get_width(p_game->pa_renderer);
-    const size_t WINDOW_HEIGHT = renderer_ddraw_get_height(p_game->pa_renderer);
+    PROFILE_BEGIN(draw_game);
+
+    engine_t* p_engine = &p_game->engine;
+
+    const size_t WINDOW_WIDTH = renderer_get_width(p_game->p_renderer);
 
     const int32_t NUM_MINES_DIGIT0_X = SPRITE_NUMBER_WIDTH * 2;
     const int32_t NUM_MINES_DIGIT0_Y = INFO_HEIGHT / 2 - SPRITE_NUMBER_HEIGHT / 2;
@@ -301,26 +396,63 @@ void draw_game(const game_t* p_game)
     const int32_t TIMER_DIGIT2_X = (int32_t)WINDOW_WIDTH - SPRITE_NUMBER_WIDTH * 3;
     const int32_t TIMER_DIGIT2_Y = INFO_HEIGHT / 2 - SPRITE_NUMBER_HEIGHT / 2;
 
-    const int32_t START_TILE_X = 0;
-    const int32_t START_TILE_Y = INFO_HEIGHT;
-
-    const uint32_t mouse_x = get_mouse_x();
-    const uint32_t mouse_y = get_mouse_y();
+    const engine_status_t status = engine_get_status(p_engine);
 
     uint32_t face_index = 0;
 
-    renderer_ddraw_begin_draw(p_game->pa_renderer);
+    // 백 버퍼는 프레임 사이에 유지되므로 바뀐 부분만 덮어씀
+    renderer_begin_draw(p_game->p_renderer);
+    p_game->p_locked_buffer = renderer_get_locked_buffer(p_game->p_renderer, &p_game->locked_buffer_pitch);
+    p_game->locked_buffer_width = WINDOW_WIDTH;
+    p_game->locked_buffer_height = renderer_get_height(p_game->p_renderer);
     {
-        renderer_ddraw_clear(p_game->pa_renderer, 0xffc6c6c6);
+        // 화면과 겹치는 타일만 그림
+        size_t begin_x;
+        size_t begin_y;
+        size_t end_x;
+        size_t end_y;
+        get_visible_tiles(p_game, &begin_x, &begin_y, &end_x, &end_y);
+
+        PROFILE_BEGIN(draw_tiles);
+        if (engine_is_full_redraw(p_engine))
+        {
+            renderer_clear(p_game->p_renderer, 0xffc6c6c6);
+
+            for (size_t y = begin_y; y < end_y; ++y)
+            {
+                for (size_t x = begin_x; x < end_x; ++x)
+                {
+                    draw_tile(p_game, status, x, y);
+                }
+            }
+        }
+        else
+        {
+            size_t num_dirty;
+            const size_t* p_dirty_tiles = engine_get_dirty_tiles(p_engine, &num_dirty);
+            for (size_t i = 0; i < num_dirty; ++i)
+            {
+                const size_t x = p_dirty_tiles[i] % p_engine->cols;
+                const size_t y = p_dirty_tiles[i] / p_engine->cols;
+                if (x >= begin_x && x < end_x && y >= begin_y && y < end_y)
+                {
+                    draw_tile(p_game, status, x, y);
+                }
+            }
+        }
+        PROFILE_END(draw_tiles);
+
+        // 정보 표시줄 지우기, 걸쳐 그린 타일도 덮음
+        renderer_draw_rectangle(p_game->p_renderer, 0, 0, WINDOW_WIDTH, INFO_HEIGHT, 0xffc6c6c6);
 
         // 지뢰 개수 그리기
         {
-            const int32_t digit0_index = (p_game->num_mines <= 0) ? 0 : p_game->num_mines % 10;
-            const int32_t digit1_index = (p_game->num_mines <= 0) ? 0 : p_game->num_mines / 10 % 10;
-            const int32_t digit2_index = (p_game->num_mines <= 0) ? 0 : p_game->num_mines / 100 % 10;
-            renderer_ddraw_draw_bitmap(p_game->pa_renderer, NUM_MINES_DIGIT0_X, NUM_MINES_DIGIT0_Y, digit0_index * SPRITE_NUMBER_WIDTH, 0, SPRITE_NUMBER_WIDTH, SPRITE_NUMBER_HEIGHT, s_sprite_numbers.width, s_sprite_numbers.height, s_sprite_numbers.pa_bitmap);
-            renderer_ddraw_draw_bitmap(p_game->pa_renderer, NUM_MINES_DIGIT1_X, NUM_MINES_DIGIT1_Y, digit1_index * SPRITE_NUMBER_WIDTH, 0, SPRITE_NUMBER_WIDTH, SPRITE_NUMBER_HEIGHT, s_sprite_numbers.width, s_sprite_numbers.height, s_sprite_numbers.pa_bitmap);
-            renderer_ddraw_draw_bitmap(p_game->pa_renderer, NUM_MINES_DIGIT2_X, NUM_MINES_DIGIT2_Y, digit2_index * SPRITE_NUMBER_WIDTH, 0, SPRITE_NUMBER_WIDTH, SPRITE_NUMBER_HEIGHT, s_sprite_numbers.width, s_sprite_numbers.height, s_sprite_numbers.pa_bitmap);
+            const int32_t digit0_index = (p_engine->num_mines <= 0) ? 0 : (int32_t)(p_engine->num_mines % 10);
+            const int32_t digit1_index = (p_engine->num_mines <= 0) ? 0 : (int32_t)(p_engine->num_mines / 10 % 10);
+            const int32_t digit2_index = (p_engine->num_mines <= 0) ? 0 : (int32_t)(p_engine->num_mines / 100 % 10);
+            draw_number_sprite(p_game, NUM_MINES_DIGIT0_X, NUM_MINES_DIGIT0_Y, digit0_index);
+            draw_number_sprite(p_game, NUM_MINES_DIGIT1_X, NUM_MINES_DIGIT1_Y, digit1_index);
+            draw_number_sprite(p_game, NUM_MINES_DIGIT2_X, NUM_MINES_DIGIT2_Y, digit2_index);
         }
 
         // 타이머 그리기
@@ -328,313 +460,480 @@ void draw_game(const game_t* p_game)
             const int32_t digit0_index = p_game->count % 10;
             const int32_t digit1_index = p_game->count / 10 % 10;
             const int32_t digit2_index = p_game->count / 100 % 10;
-            renderer_ddraw_draw_bitmap(p_game->pa_renderer, TIMER_DIGIT0_X, TIMER_DIGIT0_Y, digit0_index * SPRITE_NUMBER_WIDTH, 0, SPRITE_NUMBER_WIDTH, SPRITE_NUMBER_HEIGHT, s_sprite_numbers.width, s_sprite_numbers.height, s_sprite_numbers.pa_bitmap);
-            renderer_ddraw_draw_bitmap(p_game->pa_renderer, TIMER_DIGIT1_X, TIMER_DIGIT1_Y, digit1_index * SPRITE_NUMBER_WIDTH, 0, SPRITE_NUMBER_WIDTH, SPRITE_NUMBER_HEIGHT, s_sprite_numbers.width, s_sprite_numbers.height, s_sprite_numbers.pa_bitmap);
-            renderer_ddraw_draw_bitmap(p_game->pa_renderer, TIMER_DIGIT2_X, TIMER_DIGIT2_Y, digit2_index * SPRITE_NUMBER_WIDTH, 0, SPRITE_NUMBER_WIDTH, SPRITE_NUMBER_HEIGHT, s_sprite_numbers.width, s_sprite_numbers.height, s_sprite_numbers.pa_bitmap);
+            draw_number_sprite(p_game, TIMER_DIGIT0_X, TIMER_DIGIT0_Y, digit0_index);
+            draw_number_sprite(p_game, TIMER_DIGIT1_X, TIMER_DIGIT1_Y, digit1_index);
+            draw_number_sprite(p_game, TIMER_DIGIT2_X, TIMER_DIGIT2_Y, digit2_index);
         }
 
-        // 타일 그리기
-        // 윈도우 좌표 -> 타일 좌표 변환
-        uint32_t tile_x = mouse_x / SPRITE_TILE_WIDTH;
-        uint32_t tile_y = (mouse_y - INFO_HEIGHT) / SPRITE_TILE_HEIGHT;
-
-        for (size_t y = 0; y < p_game->rows; ++y)
+        // 얼굴 그리기
+        if (p_game->b_tile_pressed)
         {
-            for (size_t x = 0; x < p_game->cols; ++x)
-            {
-                tile_t tile = p_game->pa_tiles[y * p_game->cols + x];
-                if (get_left_mouse_state() == MOUSE_STATE_DOWN && tile_x == x && tile_y == y)
-                {
-                    face_index = 2;
-
-                    if (!p_game->b_gameover && tile == TILE_BLIND)
-                    {
-                        tile = TILE_OPEN;
-                    }
-                }
-
-                switch (tile)
-                {
-                case TILE_BLIND:
-                case TILE_OPEN:
-                case TILE_FLAG:
-                case TILE_UNKNOWN:
-                case TILE_OPEN_UNKNOWN:
-                case TILE_MINE:
-                case TILE_GAMEOVER_MINE:
-                case TILE_FLAG_MINE:
-                    if (p_game->b_gameover && p_game->num_tiles == p_game->num_max_mines
-                        && tile == TILE_BLIND)
-                    {
-                        tile = TILE_FLAG;
-                    }
-
-                    renderer_ddraw_draw_bitmap(p_game->pa_renderer, START_TILE_X + (int32_t)x * SPRITE_TILE_WIDTH, START_TILE_Y + (int32_t)y * SPRITE_TILE_HEIGHT, tile * SPRITE_TILE_WIDTH, 0, SPRITE_TILE_WIDTH, SPRITE_TILE_HEIGHT, s_sprite_tiles.width, s_sprite_tiles.height, s_sprite_tiles.pa_bitmap);
-                    break;
-                case TILE_1:
-                case TILE_2:
-                case TILE_3:
-                case TILE_4:
-                case TILE_5:
-                case TILE_6:
-                case TILE_7:
-                case TILE_8:
-                    renderer_ddraw_draw_bitmap(p_game->pa_renderer, START_TILE_X + (int32_t)x * SPRITE_TILE_WIDTH, START_TILE_Y + (int32_t)y * SPRITE_TILE_HEIGHT, (tile - 8) * SPRITE_TILE_WIDTH, SPRITE_TILE_HEIGHT, SPRITE_TILE_WIDTH, SPRITE_TILE_HEIGHT, s_sprite_tiles.width, s_sprite_tiles.height, s_sprite_tiles.pa_bitmap);
-                    break;
-                default:
-                    ASSERT(false, "Invalid tile");
-                    break;
-                }
-            }
+            face_index = 2;
         }
 
-        // 얼굴 그리기
-        if (get_left_mouse_state() == MOUSE_STATE_DOWN
-            && mouse_x >= p_game->face_x && mouse_x <= p_game->face_x + SPRITE_FACE_WIDTH
-            && mouse_y >= p_game->face_y && mouse_y <= p_game->face_y + SPRITE_FACE_HEIGHT)
+        if (p_game->b_left_mouse_pressed && is_mouse_on_face(p_game))
         {
             face_index = 1;
         }
 
-        if (p_game->b_gameover)
+        if (status != ENGINE_STATUS_PLAYING)
         {
-            face_index = (p_game->num_tiles == p_game->num_max_mines) ? 3 : 4;
+            face_index = (status == ENGINE_STATUS_WON) ? 3 : 4;
         }
 
-        renderer_ddraw_draw_bitmap(p_game->pa_renderer, (int32_t)p_game->face_x, (int32_t)p_game->face_y, face_index * SPRITE_FACE_WIDTH, 0, SPRITE_FACE_WIDTH, SPRITE_FACE_HEIGHT, s_sprite_faces.width, s_sprite_faces.height, s_sprite_faces.pa_bitmap);
+        const sprite_atlas_rect_t* p_faces = &s_sprite_atlas.regions[SPRITE_ATLAS_REGION_FACES];
+        renderer_draw_bitmap(p_game->p_renderer, (int32_t)p_game->face_x, (int32_t)p_game->face_y, (int32_t)(p_faces->x + face_index * SPRITE_FACE_WIDTH), (int32_t)p_faces->y,
+                             SPRITE_FACE_WIDTH, SPRITE_FACE_HEIGHT, s_sprite_atlas.width, s_sprite_atlas.height, s_sprite_atlas.p_pixels);
     }
-    renderer_ddraw_end_draw(p_game->pa_renderer);
+    p_game->p_locked_buffer = NULL;
+    renderer_end_draw(p_game->p_renderer);
 
-    renderer_ddraw_on_draw(p_game->pa_renderer);
+    // DirectDraw는 여기서 백 버퍼를 화면으로 보냄
+    PROFILE_BEGIN(present);
+    renderer_on_draw(p_game->p_renderer);
+    PROFILE_END(present);
+
+    engine_clear_dirty(p_engine);
+
+    PROFILE_END(draw_game);
 }
 
-static bool load_sprites()
+void pan_game(game_t* p_game, const int32_t dx, const int32_t dy)
 {
-    unload_sprites();
+    ASSERT(p_game != NULL, "p_game == NULL");
 
-    if (!load_a8r8g8b8_dds("sprite/tiles.dds", &s_sprite_tiles))
-    {
-        ASSERT(false, "Failed to load tile sprites");
-        goto failed_load_sprites;
-    }
+    const int64_t prev_camera_x = p_game->camera_x;
+    const int64_t prev_camera_y = p_game->camera_y;
 
-    if (!load_a8r8g8b8_dds("sprite/numbers.dds", &s_sprite_numbers))
+    p_game->camera_x += dx;
+    p_game->camera_y += dy;
+    clamp_camera(p_game);
+
+    if (p_game->camera_x != prev_camera_x || p_game->camera_y != prev_camera_y)
     {
-        ASSERT(false, "Failed to load number sprites");
-        goto failed_load_sprites;
+        invalidate_game(p_game);
     }
+}
+
+void zoom_game(game_t* p_game, const int32_t steps, const int32_t anchor_x, const int32_t anchor_y)
+{
+    ASSERT(p_game != NULL, "p_game == NULL");
 
-    if (!load_a8r8g8b8_dds("sprite/faces.dds", &s_sprite_faces))
+    int64_t zoom = (int64_t)p_game->zoom + steps;
+    zoom = (zoom < GAME_MIN_ZOOM) ? GAME_MIN_ZOOM : zoom;
+    zoom = (zoom > GAME_MAX_ZOOM) ? GAME_MAX_ZOOM : zoom;
+    if ((uint32_t)zoom == p_game->zoom)
     {
-        ASSERT(false, "Failed to load face sprites");
-        goto failed_load_sprites;
+        return;
     }
 
-    return true;
+    // 기준점 아래의 보드 좌표를 새 배율로 옮긴 뒤 같은 화면 좌표에 오도록 카메라 이동
+    const int64_t view_x = anchor_x;
+    const int64_t view_y = (int64_t)anchor_y - INFO_HEIGHT;
+    const int64_t board_x = p_game->camera_x + view_x;
+    const int64_t board_y = p_game->camera_y + view_y;
 
-failed_load_sprites:
-    unload_sprites();
-    return false;
+    p_game->camera_x = board_x * zoom / p_game->zoom - view_x;
+    p_game->camera_y = board_y * zoom / p_game->zoom - view_y;
+    p_game->zoom = (uint32_t)zoom;
+    clamp_camera(p_game);
+
+    invalidate_game(p_game);
 }
 
-static void unload_sprites()
+uint64_t get_game_next_tick(const game_t* p_game)
 {
-    if (s_sprite_tiles.pa_bitmap != NULL)
-    {
-        SAFE_FREE(s_sprite_tiles.pa_bitmap);
-    }
+    ASSERT(p_game != NULL, "p_game == NULL");
 
-    if (s_sprite_numbers.pa_bitmap != NULL)
+    // 게임이 끝나면 타이머가 멈추므로 깨어날 필요 없음
+    uint64_t next_tick = UINT64_MAX;
+    if (!engine_is_gameover(&p_game->engine) && p_game->b_timer_started)
     {
-        SAFE_FREE(s_sprite_numbers.pa_bitmap);
+        next_tick = p_game->start_time + (p_game->count + 1) * 1000;
     }
 
-    if (s_sprite_faces.pa_bitmap != NULL)
+    // 입력 없이도 바뀐 판은 제때 저장
+    if (p_game->p_autosave_path != NULL && p_game->b_unsaved && p_game->next_autosave_time < next_tick)
     {
-        SAFE_FREE(s_sprite_faces.pa_bitmap);
+        next_tick = p_game->next_autosave_time;
     }
+
+    return next_tick;
 }
 
-static void make_mine(bool* p_mines, const size_t rows, const size_t cols, const size_t num_mines)
+void invalidate_game(game_t* p_game)
 {
-    ASSERT(p_mines != NULL, "p_mines == NULL");
+    ASSERT(p_game != NULL, "p_game == NULL");
+    engine_request_full_redraw(&p_game->engine);
+}
 
-    size_t count = 0;
-    while (count != num_mines)
-    {
-        const size_t index = rand() % (rows * cols);
-        //const size_t x = rand() % cols;
-        //const size_t y = rand() % rows;
-        
-        if (p_mines[index])
-        {
-            continue;
-        }
+static int64_t get_tile_size(const game_t* p_game)
+{
+    return (int64_t)SPRITE_TILE_WIDTH * p_game->zoom;
+}
 
-        p_mines[index] = true;
+// 보드 밖을 보지 않도록 카메라를 자름, 바뀌었으면 true
+static bool clamp_camera(game_t* p_game)
+{
+    const int64_t tile_size = get_tile_size(p_game);
+    const int64_t view_width = (int64_t)renderer_get_width(p_game->p_renderer);
+    const int64_t view_height = (int64_t)renderer_get_height(p_game->p_renderer) - INFO_HEIGHT;
+
+    const int64_t max_camera_x = (int64_t)p_game->engine.cols * tile_size - view_width;
+    const int64_t max_camera_y = (int64_t)p_game->engine.rows * tile_size - view_height;
+
+    int64_t camera_x = (p_game->camera_x > max_camera_x) ? max_camera_x : p_game->camera_x;
+    int64_t camera_y = (p_game->camera_y > max_camera_y) ? max_camera_y : p_game->camera_y;
+    camera_x = (camera_x < 0) ? 0 : camera_x;
+    camera_y = (camera_y < 0) ? 0 : camera_y;
+
+    const bool b_changed = (camera_x != p_game->camera_x || camera_y != p_game->camera_y);
+    p_game->camera_x = camera_x;
+    p_game->camera_y = camera_y;
+
+    return b_changed;
+}
+
+// 창 밖 (음수) 좌표는 크게 바뀌어 얼굴 밖으로 판정됨
+static bool is_mouse_on_face(const game_t* p_game)
+{
+    const size_t mouse_x = (size_t)p_game->mouse_x;
+    const size_t mouse_y = (size_t)p_game->mouse_y;
+
+    return mouse_x >= p_game->face_x && mouse_x <= p_game->face_x + SPRITE_FACE_WIDTH
+        && mouse_y >= p_game->face_y && mouse_y <= p_game->face_y + SPRITE_FACE_HEIGHT;
+}
 
-        ++count;
+// 스크린 좌표 -> 타일 좌표 변환, 타일 영역 밖이면 false
+static bool screen_to_tile(const game_t* p_game, const int32_t screen_x, const int32_t screen_y, size_t* p_out_x, size_t* p_out_y)
+{
+    if (screen_x < 0 || screen_y < INFO_HEIGHT
+        || (size_t)screen_x >= renderer_get_width(p_game->p_renderer) || (size_t)screen_y >= renderer_get_height(p_game->p_renderer))
+    {
+        return false;
     }
 
-    for (size_t y = 0; y < rows; ++y)
+    const int64_t tile_size = get_tile_size(p_game);
+    const int64_t tile_x = (p_game->camera_x + screen_x) / tile_size;
+    const int64_t tile_y = (p_game->camera_y + screen_y - INFO_HEIGHT) / tile_size;
+    if (tile_x >= (int64_t)p_game->engine.cols || tile_y >= (int64_t)p_game->engine.rows)
     {
-        for (size_t x = 0; x < cols; ++x)
-        {
-            printf("%c ", p_mines[y * cols + x] == true ? 'o' : '.');
-        }
-        printf("\n");
+        return false;
     }
-    printf("\n");
+
+    *p_out_x = (size_t)tile_x;
+    *p_out_y = (size_t)tile_y;
+    return true;
 }
 
-static bool is_valid_position(const game_t* p_game, const size_t x, const size_t y)
+// 화면과 겹치는 타일 범위 [begin, end)
+static void get_visible_tiles(const game_t* p_game, size_t* p_out_begin_x, size_t* p_out_begin_y, size_t* p_out_end_x, size_t* p_out_end_y)
 {
-    ASSERT(p_game != NULL, "p_game == NULL");
-    return (x < p_game->cols && y < p_game->rows);
+    const int64_t tile_size = get_tile_size(p_game);
+    const int64_t view_width = (int64_t)renderer_get_width(p_game->p_renderer);
+    const int64_t view_height = (int64_t)renderer_get_height(p_game->p_renderer) - INFO_HEIGHT;
+
+    const size_t end_x = (size_t)((p_game->camera_x + view_width + tile_size - 1) / tile_size);
+    const size_t end_y = (size_t)((p_game->camera_y + view_height + tile_size - 1) / tile_size);
+
+    *p_out_begin_x = (size_t)(p_game->camera_x / tile_size);
+    *p_out_begin_y = (size_t)(p_game->camera_y / tile_size);
+    *p_out_end_x = (end_x < p_game->engine.cols) ? end_x : p_game->engine.cols;
+    *p_out_end_y = (end_y < p_game->engine.rows) ? end_y : p_game->engine.rows;
 }
 
-static void open_tile_recursion(game_t* p_game, const size_t x, const size_t y)
+static void restart_game(game_t* p_game, const uint64_t now)
 {
-    ASSERT(p_game != NULL, "p_game == NULL");
-    ++depth;
+    p_game->count = 0;
+    p_game->b_timer_started = false;
 
-    if (!is_valid_position(p_game, x, y))
-    {
-        return;
-    }
+    const uint64_t seed = random_next(&p_game->seed_random);
+    record_action(p_game, ACTION_TYPE_RESTART, 0, 0, seed, now);
+    engine_restart(&p_game->engine, seed);
+}
+
+// 엔진에 실제로 적용된 행동만 기록해야 재생할 때 결과가 같음
+// 재시작은 버리는 판의 해시를 남기므로 적용하기 전에 기록
+// 기록 여부와 무관하게 판이 바뀌었으므로 자동 저장 대상
+static void record_action(game_t* p_game, const action_type_t type, const size_t x, const size_t y, const uint64_t seed, const uint64_t now)
+{
+    p_game->b_unsaved = true;
 
-    const tile_t tile = p_game->pa_tiles[y * p_game->cols + x];
-    if (tile != TILE_BLIND && tile != TILE_FLAG && tile != TILE_UNKNOWN)
+    if (!p_game->b_recording)
     {
         return;
     }
 
-    size_t count = 0;
-    count += (is_valid_position(p_game, x, y - 1) && p_game->pa_mines[(y - 1) * p_game->cols + x]);
-    count += (is_valid_position(p_game, x, y + 1) && p_game->pa_mines[(y + 1) * p_game->cols + x]);
-    count += (is_valid_position(p_game, x - 1, y) && p_game->pa_mines[y * p_game->cols + (x - 1)]);
-    count += (is_valid_position(p_game, x + 1, y) && p_game->pa_mines[y * p_game->cols + (x + 1)]);
-    count += (is_valid_position(p_game, x - 1, y - 1) && p_game->pa_mines[(y - 1) * p_game->cols + (x - 1)]);
-    count += (is_valid_position(p_game, x + 1, y - 1) && p_game->pa_mines[(y - 1) * p_game->cols + (x + 1)]);
-    count += (is_valid_position(p_game, x - 1, y + 1) && p_game->pa_mines[(y + 1) * p_game->cols + (x - 1)]);
-    count += (is_valid_position(p_game, x + 1, y + 1) && p_game->pa_mines[(y + 1) * p_game->cols + (x + 1)]);
+    action_t action;
+    action.type = type;
+    action.time = now;
+    action.x = x;
+    action.y = y;
+    action.seed = seed;
+    action.hash = (type == ACTION_TYPE_RESTART) ? engine_get_hash(&p_game->engine) : 0;
+    action.num_actions = 0;
 
-    if (p_game->pa_tiles[y * p_game->cols + x] == TILE_FLAG)
-    {
-        ++p_game->num_mines;
-    }
+    action_log_writer_write(&p_game->action_log, &action);
+}
 
-    if (count == 0)
+// 타이머가 멈춘 판은 멈출 때까지 센 시간
+static uint64_t get_elapsed_ms(const game_t* p_game, const uint64_t now)
+{
+    if (!p_game->b_timer_started)
     {
-        p_game->pa_tiles[y * p_game->cols + x] = TILE_OPEN;
-
-        open_tile_recursion(p_game, x, y - 1);
-        open_tile_recursion(p_game, x, y + 1);
-        open_tile_recursion(p_game, x - 1, y);
-        open_tile_recursion(p_game, x + 1, y);
-        open_tile_recursion(p_game, x - 1, y - 1);
-        open_tile_recursion(p_game, x + 1, y - 1);
-        open_tile_recursion(p_game, x - 1, y + 1);
-        open_tile_recursion(p_game, x + 1, y + 1);
+        return 0;
     }
-    else
+
+    if (engine_is_gameover(&p_game->engine))
     {
-        p_game->pa_tiles[y * p_game->cols + x] = TILE_1 + count - 1;
+        return (uint64_t)p_game->count * 1000;
     }
 
-    --p_game->num_tiles;
+    return (now > p_game->start_time) ? now - p_game->start_time : 0;
 }
 
-static void open_tile(game_t* p_game, const size_t x, const size_t y)
+// 행동은 입력이 들어온 시각으로 기록
+static void apply_input(game_t* p_game, const mouse_event_t* p_event)
 {
     ASSERT(p_game != NULL, "p_game == NULL");
+    ASSERT(p_event != NULL, "p_event == NULL");
 
-    // 재귀 횟수 근사값
-    // (rows * cols - num_max_mines) * 8
+    engine_t* p_engine = &p_game->engine;
 
-    size_t stack_index = 0;
-    size_t* stack_x = (size_t*)malloc(sizeof(size_t) * (p_game->rows * p_game->cols - p_game->num_max_mines) * 8);
-    size_t* stack_y = (size_t*)malloc(sizeof(size_t) * (p_game->rows * p_game->cols - p_game->num_max_mines) * 8);
-    ASSERT(stack_x != NULL, "Failed to malloc stack_x");
-    ASSERT(stack_y != NULL, "Failed to malloc stack_y");
+    p_game->mouse_x = p_event->x;
+    p_game->mouse_y = p_event->y;
 
-    stack_x[stack_index] = x;
-    stack_y[stack_index] = y;
-    ++stack_index;
+    size_t tile_x;
+    size_t tile_y;
+    uint64_t seed;
 
-    while (stack_index > 0)
+    switch (p_event->type)
     {
-        --stack_index;
-        const size_t tile_x = stack_x[stack_index];
-        const size_t tile_y = stack_y[stack_index];
+    case MOUSE_EVENT_TYPE_MOVE:
+        break;
 
-        if (!is_valid_position(p_game, tile_x, tile_y))
+    case MOUSE_EVENT_TYPE_LEFT_DOWN:
+        p_game->b_left_mouse_pressed = true;
+        break;
+
+    case MOUSE_EVENT_TYPE_LEFT_UP:
+        if (!p_game->b_left_mouse_pressed)
         {
-            continue;
+            break;
         }
+        p_game->b_left_mouse_pressed = false;
 
-        const tile_t tile = p_game->pa_tiles[tile_y * p_game->cols + tile_x];
-        if (tile != TILE_BLIND && tile != TILE_FLAG && tile != TILE_UNKNOWN)
+        // 얼굴 클릭 시 게임 재시작
+        if (is_mouse_on_face(p_game))
         {
-            continue;
+            restart_game(p_game, p_event->time);
+            p_game->b_right_mouse_pressed = false;
+            break;
         }
 
-        size_t count = 0;
-        count += (is_valid_position(p_game, tile_x, tile_y - 1) && p_game->pa_mines[(tile_y - 1) * p_game->cols + tile_x]);
-        count += (is_valid_position(p_game, tile_x, tile_y + 1) && p_game->pa_mines[(tile_y + 1) * p_game->cols + tile_x]);
-        count += (is_valid_position(p_game, tile_x - 1, tile_y) && p_game->pa_mines[tile_y * p_game->cols + (tile_x - 1)]);
-        count += (is_valid_position(p_game, tile_x + 1, tile_y) && p_game->pa_mines[tile_y * p_game->cols + (tile_x + 1)]);
-        count += (is_valid_position(p_game, tile_x - 1, tile_y - 1) && p_game->pa_mines[(tile_y - 1) * p_game->cols + (tile_x - 1)]);
-        count += (is_valid_position(p_game, tile_x + 1, tile_y - 1) && p_game->pa_mines[(tile_y - 1) * p_game->cols + (tile_x + 1)]);
-        count += (is_valid_position(p_game, tile_x - 1, tile_y + 1) && p_game->pa_mines[(tile_y + 1) * p_game->cols + (tile_x - 1)]);
-        count += (is_valid_position(p_game, tile_x + 1, tile_y + 1) && p_game->pa_mines[(tile_y + 1) * p_game->cols + (tile_x + 1)]);
-
-        if (p_game->pa_tiles[tile_y * p_game->cols + tile_x] == TILE_FLAG)
+        // 타일 클릭 시
+        if (engine_is_gameover(p_engine) || !screen_to_tile(p_game, p_game->mouse_x, p_game->mouse_y, &tile_x, &tile_y))
         {
-            ++p_game->num_mines;
+            break;
         }
 
-        if (count == 0)
+        // 첫 클릭이면 현재 시드에서 시작해 추측 없이 풀리는 판을 찾음
+        if (p_game->b_no_guess && !p_engine->b_mines_placed
+            && generator_find_seed(&p_game->generator, tile_x, tile_y, p_engine->seed, GAME_NO_GUESS_MAX_CANDIDATES, &seed))
         {
-            p_game->pa_tiles[tile_y * p_game->cols + tile_x] = TILE_OPEN;
+            engine_set_seed(p_engine, seed);
+            record_action(p_game, ACTION_TYPE_SET_SEED, 0, 0, seed, p_event->time);
+        }
 
-            stack_x[stack_index] = tile_x;
-            stack_y[stack_index] = tile_y - 1;
-            ++stack_index;
+        // 연쇄로 열린 칸 수를 트레이스에 남김, 첫 클릭이면 지뢰 배치도 포함
+        // 엔진 안이 아니라 여기서 재므로 생성기/풀이기/자가 대국이 여는 칸은 잡히지 않음
+        PROFILE_BEGIN(open_tile);
+        const size_t num_tiles = p_engine->num_tiles;
+        const bool b_opened = engine_open(p_engine, tile_x, tile_y);
+        PROFILE_END_ARG(open_tile, "cascade", num_tiles - p_engine->num_tiles);
 
-            stack_x[stack_index] = tile_x;
-            stack_y[stack_index] = tile_y + 1;
-            ++stack_index;
+        if (b_opened)
+        {
+            record_action(p_game, ACTION_TYPE_OPEN, tile_x, tile_y, 0, p_event->time);
+        }
+        break;
 
-            stack_x[stack_index] = tile_x - 1;
-            stack_y[stack_index] = tile_y;
-            ++stack_index;
+    case MOUSE_EVENT_TYPE_RIGHT_DOWN:
+        if (p_game->b_right_mouse_pressed)
+        {
+            break;
+        }
+        p_game->b_right_mouse_pressed = true;
 
-            stack_x[stack_index] = tile_x + 1;
-            stack_y[stack_index] = tile_y;
-            ++stack_index;
+        if (!engine_is_gameover(p_engine) && screen_to_tile(p_game, p_game->mouse_x, p_game->mouse_y, &tile_x, &tile_y)
+            && engine_cycle_flag(p_engine, tile_x, tile_y))
+        {
+            record_action(p_game, ACTION_TYPE_CYCLE_FLAG, tile_x, tile_y, 0, p_event->time);
+        }
+        break;
 
-            stack_x[stack_index] = tile_x - 1;
-            stack_y[stack_index] = tile_y - 1;
-            ++stack_index;
+    case MOUSE_EVENT_TYPE_RIGHT_UP:
+        p_game->b_right_mouse_pressed = false;
+        break;
 
-            stack_x[stack_index] = tile_x + 1;
-            stack_y[stack_index] = tile_y - 1;
-            ++stack_index;
+    default:
+        ASSERT(false, "Invalid mouse event type");
+        break;
+    }
+}
 
-            stack_x[stack_index] = tile_x - 1;
-            stack_y[stack_index] = tile_y + 1;
-            ++stack_index;
+// 눌린 타일이 바뀌면 이전/현재 타일을 다시 그리도록 기록
+static void update_pressed_tile(game_t* p_game)
+{
+    ASSERT(p_game != NULL, "p_game == NULL");
 
-            stack_x[stack_index] = tile_x + 1;
-            stack_y[stack_index] = tile_y + 1;
-            ++stack_index;
-        }
-        else
+    engine_t* p_engine = &p_game->engine;
+
+    size_t tile_x = 0;
+    size_t tile_y = 0;
+    const bool b_tile_pressed = p_game->b_left_mouse_pressed
+        && screen_to_tile(p_game, p_game->mouse_x, p_game->mouse_y, &tile_x, &tile_y);
+
+    if (b_tile_pressed == p_game->b_tile_pressed
+        && (!b_tile_pressed || (tile_x == p_game->pressed_tile_x && tile_y == p_game->pressed_tile_y)))
+    {
+        return;
+    }
+
+    if (p_game->b_tile_pressed)
+    {
+        engine_mark_dirty(p_engine, p_game->pressed_tile_x, p_game->pressed_tile_y);
+    }
+
+    if (b_tile_pressed)
+    {
+        engine_mark_dirty(p_engine, tile_x, tile_y);
+    }
+
+    p_game->pressed_tile_x = tile_x;
+    p_game->pressed_tile_y = tile_y;
+    p_game->b_tile_pressed = b_tile_pressed;
+}
+
+static void draw_tile(const game_t* p_game, const engine_status_t status, const size_t x, const size_t y)
+{
+    ASSERT(p_game != NULL, "p_game == NULL");
+
+    const int64_t tile_size = get_tile_size(p_game);
+    const int32_t dx = (int32_t)((int64_t)x * tile_size - p_game->camera_x);
+    const int32_t dy = (int32_t)(INFO_HEIGHT + (int64_t)y * tile_size - p_game->camera_y);
+
+    tile_t tile = engine_get_tile(&p_game->engine, x, y);
+
+    // 누르고 있는 타일은 열린 것처럼 그림
+    if (p_game->b_tile_pressed && p_game->pressed_tile_x == x && p_game->pressed_tile_y == y
+        && status == ENGINE_STATUS_PLAYING && tile == TILE_BLIND)
+    {
+        tile = TILE_OPEN;
+    }
+
+    switch (tile)
+    {
+    case TILE_BLIND:
+    case TILE_OPEN:
+    case TILE_FLAG:
+    case TILE_UNKNOWN:
+    case TILE_OPEN_UNKNOWN:
+    case TILE_MINE:
+    case TILE_GAMEOVER_MINE:
+    case TILE_FLAG_MINE:
+        draw_tile_sprite(p_game, dx, dy, tile * SPRITE_TILE_WIDTH, 0);
+        break;
+    case TILE_1:
+    case TILE_2:
+    case TILE_3:
+    case TILE_4:
+    case TILE_5:
+    case TILE_6:
+    case TILE_7:
+    case TILE_8:
+        draw_tile_sprite(p_game, dx, dy, (tile - 8) * SPRITE_TILE_WIDTH, SPRITE_TILE_HEIGHT);
+        break;
+    default:
+        ASSERT(false, "Invalid tile");
+        break;
+    }
+}
+
+// 배율 1이고 타일 영역 안에 완전히 들어오면 고정 크기 복사
+// 아니면 타일 영역으로 자르면서 확대 복사
+// 잠근 버퍼가 없으면 자르기가 있는 일반 경로 (배율 1만 지원, 정보 표시줄에 걸친 부분은 나중에 덮음)
+static void draw_tile_sprite(const game_t* p_game, const int32_t dx, const int32_t dy, const int32_t sx, const int32_t sy)
+{
+    if (p_game->p_locked_buffer != NULL)
+    {
+        const size_t src_pitch = s_sprite_atlas.pitch;
+        const char* p_src = sprite_atlas_get_region_pixels(&s_sprite_atlas, SPRITE_ATLAS_REGION_TILES) + (size_t)sy * src_pitch + (size_t)sx * sizeof(uint32_t);
+
+        if (p_game->zoom == 1
+            && dx >= 0 && (size_t)dx + SPRITE_TILE_WIDTH <= p_game->locked_buffer_width
+            && dy >= INFO_HEIGHT && (size_t)dy + SPRITE_TILE_HEIGHT <= p_game->locked_buffer_height)
         {
-            p_game->pa_tiles[tile_y * p_game->cols + tile_x] = TILE_1 + count - 1;
+            blit_16x16(p_game->p_locked_buffer + (size_t)dy * p_game->locked_buffer_pitch + (size_t)dx * sizeof(uint32_t), p_game->locked_buffer_pitch, p_src, src_pitch);
+            return;
         }
 
-        --p_game->num_tiles;
+        blit_scaled_clipped(p_game->p_locked_buffer, p_game->locked_buffer_pitch, 0, INFO_HEIGHT, (int32_t)p_game->locked_buffer_width, (int32_t)p_game->locked_buffer_height,
+                            dx, dy, p_src, src_pitch, SPRITE_TILE_WIDTH, SPRITE_TILE_HEIGHT, p_game->zoom);
+        return;
     }
+
+    const sprite_atlas_rect_t* p_tiles = &s_sprite_atlas.regions[SPRITE_ATLAS_REGION_TILES];
+    renderer_draw_bitmap(p_game->p_renderer, dx, dy, (int32_t)p_tiles->x + sx, (int32_t)p_tiles->y + sy, SPRITE_TILE_WIDTH, SPRITE_TILE_HEIGHT, s_sprite_atlas.width, s_sprite_atlas.height, s_sprite_atlas.p_pixels);
+}
+
+static void draw_number_sprite(const game_t* p_game, const int32_t dx, const int32_t dy, const int32_t digit)
+{
+    const int32_t sx = digit * SPRITE_NUMBER_WIDTH;
+
+    if (p_game->p_locked_buffer != NULL
+        && dx >= 0 && (size_t)dx + SPRITE_NUMBER_WIDTH <= p_game->locked_buffer_width
+        && dy >= 0 && (size_t)dy + SPRITE_NUMBER_HEIGHT <= p_game->locked_buffer_height)
+    {
+        blit_13x23(p_game->p_locked_buffer + (size_t)dy * p_game->locked_buffer_pitch + (size_t)dx * sizeof(uint32_t), p_game->locked_buffer_pitch,
+                   sprite_atlas_get_region_pixels(&s_sprite_atlas, SPRITE_ATLAS_REGION_NUMBERS) + (size_t)sx * sizeof(uint32_t), s_sprite_atlas.pitch);
+        return;
+    }
+
+    const sprite_atlas_rect_t* p_numbers = &s_sprite_atlas.regions[SPRITE_ATLAS_REGION_NUMBERS];
+    renderer_draw_bitmap(p_game->p_renderer, dx, dy, (int32_t)p_numbers->x + sx, (int32_t)p_numbers->y, SPRITE_NUMBER_WIDTH, SPRITE_NUMBER_HEIGHT, s_sprite_atlas.width, s_sprite_atlas.height, s_sprite_atlas.p_pixels);
+}
+
+// 타일 8 * 2 (빈 칸/깃발/... + 숫자 1 ~ 8), 숫자 0 ~ 9, 얼굴 5개가 들어가는지 한 번만 확인
+static bool load_sprites()
+{
+    unload_sprites();
+
+    PROFILE_BEGIN(load_sprites);
+
+    if (!sprite_atlas_open(&s_sprite_atlas, "sprite/sprites.msat"))
+    {
+        ASSERT(false, "Failed to load sprite atlas");
+        PROFILE_END(load_sprites);
+        return false;
+    }
+
+    const sprite_atlas_rect_t* p_regions = s_sprite_atlas.regions;
+    if (p_regions[SPRITE_ATLAS_REGION_TILES].width < 8 * SPRITE_TILE_WIDTH || p_regions[SPRITE_ATLAS_REGION_TILES].height < 2 * SPRITE_TILE_HEIGHT
+        || p_regions[SPRITE_ATLAS_REGION_NUMBERS].width < 10 * SPRITE_NUMBER_WIDTH || p_regions[SPRITE_ATLAS_REGION_NUMBERS].height < SPRITE_NUMBER_HEIGHT
+        || p_regions[SPRITE_ATLAS_REGION_FACES].width < 5 * SPRITE_FACE_WIDTH || p_regions[SPRITE_ATLAS_REGION_FACES].height < SPRITE_FACE_HEIGHT)
+    {
+        ASSERT(false, "Sprite atlas regions too small");
+        unload_sprites();
+        PROFILE_END(load_sprites);
+        return false;
+    }
+
+    PROFILE_END(load_sprites);
+    return true;
+}
+
+static void unload_sprites()
+{
+    sprite_atlas_close(&s_sprite_atlas);
 }
\ No newline at end of file
@@ -3,9 +3,16 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
-#include "safe99_core/util/timer.h"
-#include "safe99_renderer_ddraw/renderer_ddraw.h"
+#include "minesweeper_engine/action_log.h"
+#include "minesweeper_engine/engine.h"
+#include "minesweeper_engine/generator.h"
+#include "minesweeper_engine/random.h"
+#include "minesweeper_engine/snapshot.h"
+#include "minesweeper_engine/thread_pool.h"
+#include "mouse_event.h"
+#include "renderer.h"
 
 #define SPRITE_TILE_WIDTH 16
 #define SPRITE_TILE_HEIGHT 16
@@ -16,54 +23,128 @@
 
 #define INFO_HEIGHT 48
 
-typedef enum tile
-{
-    TILE_BLIND,
-    TILE_OPEN,
-    TILE_FLAG,
-    TILE_UNKNOWN,
-    TILE_OPEN_UNKNOWN,
-    TILE_MINE,
-    TILE_GAMEOVER_MINE,
-    TILE_FLAG_MINE,
-    TILE_1,
-    TILE_2,
-    TILE_3,
-    TILE_4,
-    TILE_5,
-    TILE_6,
-    TILE_7,
-    TILE_8,
-} tile_t;
+// 타일 확대 배율 범위 (정수배)
+#define GAME_MIN_ZOOM 1
+#define GAME_MAX_ZOOM 4
+
+// update_game이 큐에서 한 번에 꺼내는 입력 수
+#define GAME_INPUT_BATCH_SIZE 64
+
+// 추측 없는 판: 첫 클릭마다 풀어 볼 최대 후보 수, 못 찾으면 일반 판
+#define GAME_NO_GUESS_MAX_CANDIDATES 100000
 
 typedef struct game
 {
-    size_t rows;
-    size_t cols;
-    int num_mines;
-    int num_max_mines;
-    int num_tiles;
-    bool* pa_mines;
-    tile_t* pa_tiles;
+    engine_t engine;
+
+    // 재시작할 때마다 새 판의 시드를 뽑음
+    random_t seed_random;
+
+    // 추측 없는 판, 켜져 있을 때만 스레드 풀/생성기가 유효
+    // 첫 클릭 때 모든 코어로 후보 판을 풀어 보고 그 시드로 판을 만듦
+    thread_pool_t thread_pool;
+    generator_t generator;
+    bool b_no_guess;
+
+    // 켜져 있으면 엔진에 적용한 행동 (열기/깃발/재시작/시드 변경)을 모두 기록
+    action_log_writer_t action_log;
+    bool b_recording;
 
-    renderer_ddraw_t* pa_renderer;
+    // 스냅숏은 쓰기 스레드가 파일로 씀
+    // 자동 저장은 p_autosave_path가 있을 때만, 마지막 저장 이후 엔진에 적용한 행동이 있으면 주기마다 저장
+    snapshot_writer_t snapshot_writer;
+    const char* p_autosave_path;
+    uint64_t autosave_interval;
+    uint64_t next_autosave_time;
+    bool b_unsaved;
+
+    // 만든 쪽에서 해제
+    renderer_t* p_renderer;
+
+    // draw_game 중에만 유효, 고정 크기 스프라이트를 직접 복사할 때 사용
+    char* p_locked_buffer;
+    size_t locked_buffer_pitch;
+    size_t locked_buffer_width;
+    size_t locked_buffer_height;
 
     size_t face_x;
     size_t face_y;
 
-    timer_t timer;
+    // 카메라: 타일 영역 왼쪽 위에 보이는 보드 픽셀 좌표 (현재 배율 기준)
+    // 화면과 겹치는 타일만 그리고 클릭을 판정함
+    int64_t camera_x;
+    int64_t camera_y;
+    uint32_t zoom;
+
+    // 경과 시간 (초), start_time은 밀리초
+    uint64_t start_time;
     size_t count;
+    bool b_timer_started;
 
-    bool b_gameover;
+    // 창 프로시저가 넣고 update_game이 꺼내 순서대로 적용
+    mouse_event_queue_t input_queue;
 
+    // 마지막으로 적용한 입력의 마우스 위치와 버튼 상태
+    int32_t mouse_x;
+    int32_t mouse_y;
     bool b_left_mouse_pressed;
     bool b_right_mouse_pressed;
+
+    // 왼쪽 버튼으로 누르고 있는 타일, 바뀌면 이전/현재 타일만 다시 그림
+    size_t pressed_tile_x;
+    size_t pressed_tile_y;
+    bool b_tile_pressed;
 } game_t;
 
-bool init_game(HWND hwnd, game_t* p_game, const int rows, const int cols, const int num_mines);
+bool init_game(renderer_t* p_renderer, game_t* p_game, const int rows, const int cols, const int num_mines);
 void shutdown_game(game_t* p_game);
 
-void update_game(game_t* p_game);
-void draw_game(const game_t* p_game);
+// 추측 없는 판 켜기/끄기, 다음 첫 클릭부터 적용
+// 켤 때 스레드 풀/생성기를 만들지 못하거나 기록 중이면 false
+bool set_game_no_guess(game_t* p_game, const bool b_no_guess);
+
+// 행동 기록 시작/끝, now는 밀리초 단위 현재 시각
+// 이미 지뢰를 배치한 판이면 새 판으로 재시작한 뒤 기록을 시작함
+// 끝낼 때 마지막 판 상태 해시를 같이 기록하고, 쓰기에 실패했으면 false
+bool start_game_recording(game_t* p_game, const char* p_path, const uint64_t now);
+bool stop_game_recording(game_t* p_game, const uint64_t now);
+
+// 스냅숏 저장 요청, now는 밀리초 단위 현재 시각
+// 지난 저장 이후 바뀐 부분만 복사한 뒤 바로 반환하고 파일은 쓰기 스레드가 씀, 이전 저장이 아직 끝나지 않았으면 건너뛰고 false
+bool save_game_snapshot(game_t* p_game, const char* p_path, const uint64_t now);
+
+// 진행 중인 저장이 끝날 때까지 기다림, 마지막 저장이 실패했으면 false
+bool flush_game_snapshot(game_t* p_game);
+
+// 스냅숏의 판/경과 시간/다음 판 시드로 이어 함, 추측 없는 판 설정은 지금 설정을 따름
+// 기록 중에는 호출하지 말 것, 파일이 틀렸거나 메모리가 모자라면 지금 판을 그대로 두고 false
+bool resume_game(game_t* p_game, const char* p_path, const uint64_t now);
+
+// interval_ms마다 판이 바뀌었으면 p_path에 저장, NULL이면 끔
+// p_path는 끌 때까지 살아 있어야 함
+void set_game_autosave(game_t* p_game, const char* p_path, const uint64_t interval_ms, const uint64_t now);
+
+// 입력 큐에 넣기, 창 프로시저 쪽 스레드에서 호출
+// time은 update_game의 now와 같은 시계, 큐가 가득 차면 버리고 false
+bool push_game_input(game_t* p_game, const mouse_event_type_t type, const int32_t x, const int32_t y, const uint64_t time);
+
+// 쌓인 입력을 모두 순서대로 적용한 뒤 타이머 갱신
+// now는 밀리초 단위 현재 시각
+void update_game(game_t* p_game, const uint64_t now);
+
+// 정보 표시줄과 바뀐 타일만 백 버퍼에 다시 그림
+void draw_game(game_t* p_game);
+
+// 타일 영역을 (dx, dy) 픽셀만큼 이동
+void pan_game(game_t* p_game, const int32_t dx, const int32_t dy);
+
+// steps만큼 배율 변경 (양수면 확대), 화면 좌표 (anchor_x, anchor_y) 아래의 보드 지점은 그대로 둠
+void zoom_game(game_t* p_game, const int32_t steps, const int32_t anchor_x, const int32_t anchor_y);
+
+// 타이머 표시가 다음에 바뀌거나 자동 저장할 시각 (밀리초), 둘 다 없으면 UINT64_MAX
+uint64_t get_game_next_tick(const game_t* p_game);
+
+// 백 버퍼를 다시 만들었을 때처럼 전체를 다시 그려야 하면 호출
+void invalidate_game(game_t* p_game);
 
 #endif // GAME_H
\ No newline at end of file
@@ -0,0 +1,370 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "game.h"
+#include "minesweeper_engine/clock.h"
+#include "minesweeper_engine/profiler.h"
+#include "minesweeper_engine/random.h"
+#include "renderer_software.h"
+
+// 창 없이 소프트웨어 렌더러로 게임을 돌려 draw_game 처리량을 잼
+// 실행 위치에 sprite 폴더가 있어야 함
+//
+// minesweeper_headless rows cols num_mines [options]
+//   --frames n      돌릴 프레임 수 (기본 1000)
+//   --seed n        판/입력 시드 (기본 1)
+//   --pitch n       프레임 버퍼 한 줄 바이트 수 (기본 cols * 16 * 4)
+//   --full          매 프레임 전체 다시 그리기
+//   --view w h      화면 크기 (기본은 판 전체가 보이는 크기), 판보다 작으면 보이는 타일만 그림
+//   --zoom n        타일 확대 배율 (1 ~ 4)
+//   --pan n         매 프레임 카메라를 (n, n) 픽셀 이동, 끝에 닿으면 방향을 바꿈
+//   --dump prefix   프레임마다 prefix000000.ppm 저장
+//   --no-guess      추측 없는 판 (첫 클릭마다 생성기로 판을 찾음)
+//   --record path   행동 기록 (minesweeper_replay로 재생)
+//   --resume path   스냅숏에서 이어 함 (판 크기는 스냅숏을 따름)
+//   --snapshot path 마지막 프레임 뒤 스냅숏 저장
+//   --profile       구간별/프레임별 시간 분포 출력 (MINESWEEPER_ENABLE_PROFILER로 빌드했을 때만)
+//   --trace path    크롬 트레이스 이벤트 JSON 저장 (chrome://tracing, Perfetto), 스프라이트 로딩부터 기록 (MINESWEEPER_ENABLE_PROFILER로 빌드했을 때만)
+
+#define FRAME_TIME_MS 16
+
+int main(int argc, char* argv[])
+{
+    if (argc < 4)
+    {
+        printf("usage: %s rows cols num_mines [--frames n] [--seed n] [--pitch n] [--full] [--view w h] [--zoom n] [--pan n] [--dump prefix] [--no-guess] [--record path] [--resume path] [--snapshot path] [--profile] [--trace path]\n", argv[0]);
+        return 1;
+    }
+
+    const int rows = atoi(argv[1]);
+    const int cols = atoi(argv[2]);
+    const int num_mines = atoi(argv[3]);
+
+    size_t num_frames = 1000;
+    uint64_t seed = 1;
+    size_t pitch = 0;
+    bool b_full_redraw = false;
+    size_t view_width = 0;
+    size_t view_height = 0;
+    int32_t zoom = GAME_MIN_ZOOM;
+    int32_t pan = 0;
+    const char* p_dump_prefix = NULL;
+    bool b_no_guess = false;
+    const char* p_record_path = NULL;
+    const char* p_resume_path = NULL;
+    const char* p_snapshot_path = NULL;
+    bool b_profile = false;
+    const char* p_trace_path = NULL;
+
+    for (int i = 4; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+        {
+            num_frames = (size_t)strtoull(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            seed = strtoull(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--pitch") == 0 && i + 1 < argc)
+        {
+            pitch = (size_t)strtoull(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--full") == 0)
+        {
+            b_full_redraw = true;
+        }
+        else if (strcmp(argv[i], "--view") == 0 && i + 2 < argc)
+        {
+            view_width = (size_t)strtoull(argv[++i], NULL, 10);
+            view_height = (size_t)strtoull(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--zoom") == 0 && i + 1 < argc)
+        {
+            zoom = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--pan") == 0 && i + 1 < argc)
+        {
+            pan = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--dump") == 0 && i + 1 < argc)
+        {
+            p_dump_prefix = argv[++i];
+        }
+        else if (strcmp(argv[i], "--no-guess") == 0)
+        {
+            b_no_guess = true;
+        }
+        else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+        {
+            p_record_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--resume") == 0 && i + 1 < argc)
+        {
+            p_resume_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--snapshot") == 0 && i + 1 < argc)
+        {
+            p_snapshot_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--profile") == 0)
+        {
+#if defined(MINESWEEPER_PROFILER)
+            b_profile = true;
+#else
+            printf("--profile needs MINESWEEPER_ENABLE_PROFILER\n");
+            return 1;
+#endif // MINESWEEPER_PROFILER
+        }
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+        {
+#if defined(MINESWEEPER_PROFILER)
+            p_trace_path = argv[++i];
+#else
+            printf("--trace needs MINESWEEPER_ENABLE_PROFILER\n");
+            return 1;
+#endif // MINESWEEPER_PROFILER
+        }
+        else
+        {
+            printf("unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (rows < 9 || cols < 9 || num_mines < 1 || num_mines >= rows * cols)
+    {
+        printf("rows >= 9, cols >= 9, 1 <= num_mines < rows * cols\n");
+        return 1;
+    }
+
+    // 기록은 새 판의 시드부터 시작하므로 이어 할 판을 버리게 됨
+    if (p_record_path != NULL && p_resume_path != NULL)
+    {
+        printf("--record cannot be used with --resume\n");
+        return 1;
+    }
+
+    if (zoom < GAME_MIN_ZOOM || zoom > GAME_MAX_ZOOM)
+    {
+        printf("%d <= zoom <= %d\n", GAME_MIN_ZOOM, GAME_MAX_ZOOM);
+        return 1;
+    }
+
+    const size_t width = (view_width != 0) ? view_width : (size_t)cols * SPRITE_TILE_WIDTH;
+    const size_t height = (view_height != 0) ? view_height : (size_t)rows * SPRITE_TILE_HEIGHT + INFO_HEIGHT;
+    if (width < SPRITE_NUMBER_WIDTH * 6 + SPRITE_FACE_WIDTH || height <= INFO_HEIGHT)
+    {
+        printf("view must be at least %d x %d\n", SPRITE_NUMBER_WIDTH * 6 + SPRITE_FACE_WIDTH, INFO_HEIGHT + 1);
+        return 1;
+    }
+    if (pitch != 0 && (pitch < width * sizeof(uint32_t) || pitch % sizeof(uint32_t) != 0))
+    {
+        printf("pitch must be a multiple of 4 and >= %zu\n", width * sizeof(uint32_t));
+        return 1;
+    }
+
+    // 스프라이트 로딩과 첫 판 배치까지 트레이스에 들어가도록 게임보다 먼저 시작
+    if ((b_profile || p_trace_path != NULL) && !profiler_init())
+    {
+        printf("Failed to init profiler\n");
+        return 1;
+    }
+    PROFILE_THREAD_NAME("main");
+
+    if (p_trace_path != NULL && !profiler_start_trace(p_trace_path))
+    {
+        printf("Failed to open %s\n", p_trace_path);
+        profiler_shutdown();
+        return 1;
+    }
+
+    renderer_software_t software;
+    if (!renderer_software_init(&software, width, height, pitch))
+    {
+        printf("Failed to init software renderer\n");
+        profiler_shutdown();
+        return 1;
+    }
+    renderer_software_set_dump(&software, p_dump_prefix);
+
+    renderer_t renderer;
+    renderer_software_bind(&renderer, &software);
+
+    game_t* pa_game = (game_t*)malloc(sizeof(game_t));
+    if (pa_game == NULL || !init_game(&renderer, pa_game, rows, cols, num_mines))
+    {
+        printf("Failed to init game (sprite folder?)\n");
+        free(pa_game);
+        renderer_software_release(&software);
+        profiler_shutdown();
+        return 1;
+    }
+
+    if (!set_game_no_guess(pa_game, b_no_guess))
+    {
+        printf("Failed to enable no guess\n");
+        shutdown_game(pa_game);
+        free(pa_game);
+        renderer_software_release(&software);
+        profiler_shutdown();
+        return 1;
+    }
+
+    // 같은 시드면 같은 판, 같은 입력, 같은 프레임
+    random_t input_random;
+    random_init(&input_random, seed);
+    random_init(&pa_game->seed_random, random_next(&input_random));
+    engine_restart(&pa_game->engine, random_next(&pa_game->seed_random));
+    zoom_game(pa_game, zoom - GAME_MIN_ZOOM, 0, INFO_HEIGHT);
+
+    if (p_resume_path != NULL)
+    {
+        const double resume_start_time = clock_get_seconds();
+        if (!resume_game(pa_game, p_resume_path, 0))
+        {
+            printf("Failed to resume %s\n", p_resume_path);
+            shutdown_game(pa_game);
+            free(pa_game);
+            renderer_software_release(&software);
+            profiler_shutdown();
+            return 1;
+        }
+
+        printf("resumed: %s (%zu x %zu, hash %016llx) in %.3f ms\n", p_resume_path, pa_game->engine.rows, pa_game->engine.cols,
+            (unsigned long long)engine_get_hash(&pa_game->engine), (clock_get_seconds() - resume_start_time) * 1000.0);
+    }
+
+    if (p_record_path != NULL && !start_game_recording(pa_game, p_record_path, 0))
+    {
+        printf("Failed to open %s\n", p_record_path);
+        shutdown_game(pa_game);
+        free(pa_game);
+        renderer_software_release(&software);
+        profiler_shutdown();
+        return 1;
+    }
+
+    const double start_time = clock_get_seconds();
+
+    // 짝수 프레임은 임의 타일 (가끔 얼굴) 누르기, 홀수 프레임은 떼기
+    for (size_t frame = 0; frame < num_frames; ++frame)
+    {
+        const uint64_t now = (uint64_t)frame * FRAME_TIME_MS;
+
+        if (frame % 2 == 0)
+        {
+            int32_t x;
+            int32_t y;
+            if (engine_is_gameover(&pa_game->engine))
+            {
+                x = (int32_t)(pa_game->face_x + SPRITE_FACE_WIDTH / 2);
+                y = (int32_t)(pa_game->face_y + SPRITE_FACE_HEIGHT / 2);
+            }
+            else
+            {
+                x = (int32_t)random_next_bounded(&input_random, width);
+                y = INFO_HEIGHT + (int32_t)random_next_bounded(&input_random, height - INFO_HEIGHT);
+            }
+
+            push_game_input(pa_game, MOUSE_EVENT_TYPE_LEFT_DOWN, x, y, now);
+        }
+        else
+        {
+            push_game_input(pa_game, MOUSE_EVENT_TYPE_LEFT_UP, pa_game->mouse_x, pa_game->mouse_y, now);
+        }
+
+        if (pan != 0)
+        {
+            const int64_t prev_camera_x = pa_game->camera_x;
+            const int64_t prev_camera_y = pa_game->camera_y;
+            pan_game(pa_game, pan, pan);
+            if (pa_game->camera_x == prev_camera_x && pa_game->camera_y == prev_camera_y)
+            {
+                pan = -pan;
+            }
+        }
+
+        if (b_full_redraw)
+        {
+            invalidate_game(pa_game);
+        }
+
+        PROFILE_BEGIN_FRAME();
+        update_game(pa_game, now);
+        draw_game(pa_game);
+        PROFILE_END_FRAME();
+    }
+
+    const double elapsed = clock_get_seconds() - start_time;
+
+    printf("frames: %zu\n", num_frames);
+    printf("board: %d x %d, %d mines%s, view %zu x %zu px, zoom %d, pitch %zu\n", rows, cols, num_mines, b_no_guess ? " (no guess)" : "", width, height, zoom, software.pitch);
+    printf("elapsed: %.3f s\n", elapsed);
+    printf("frames/s: %.1f\n", (elapsed > 0.0) ? (double)num_frames / elapsed : 0.0);
+    printf("us/frame: %.2f\n", (num_frames > 0) ? elapsed * 1000000.0 / (double)num_frames : 0.0);
+
+    int exit_code = 0;
+    if (p_trace_path != NULL)
+    {
+        // 빠진 구간이 있으면 그만큼 트레이스가 비어 있음
+        uint64_t num_dropped_events;
+        if (profiler_stop_trace(&num_dropped_events))
+        {
+            printf("trace: %s, %llu dropped events\n", p_trace_path, (unsigned long long)num_dropped_events);
+        }
+        else
+        {
+            printf("Failed to write %s\n", p_trace_path);
+            exit_code = 1;
+        }
+    }
+
+    if (b_profile)
+    {
+        profiler_report(stdout);
+    }
+    profiler_shutdown();
+
+    if (p_record_path != NULL)
+    {
+        if (stop_game_recording(pa_game, (uint64_t)num_frames * FRAME_TIME_MS))
+        {
+            printf("recorded: %s (hash %016llx)\n", p_record_path, (unsigned long long)engine_get_hash(&pa_game->engine));
+        }
+        else
+        {
+            printf("Failed to write %s\n", p_record_path);
+            exit_code = 1;
+        }
+    }
+
+    // 프레임을 막는 건 판 복사뿐이고 파일 쓰기는 기다릴 때만 드러남
+    if (p_snapshot_path != NULL)
+    {
+        const double capture_start_time = clock_get_seconds();
+        const bool b_requested = save_game_snapshot(pa_game, p_snapshot_path, (uint64_t)num_frames * FRAME_TIME_MS);
+        const double capture_time = clock_get_seconds() - capture_start_time;
+
+        if (b_requested && flush_game_snapshot(pa_game))
+        {
+            printf("snapshot: %s (hash %016llx), capture %.3f ms, write %.3f ms\n", p_snapshot_path, (unsigned long long)engine_get_hash(&pa_game->engine),
+                capture_time * 1000.0, (clock_get_seconds() - capture_start_time - capture_time) * 1000.0);
+        }
+        else
+        {
+            printf("Failed to write %s\n", p_snapshot_path);
+            exit_code = 1;
+        }
+    }
+
+    shutdown_game(pa_game);
+    free(pa_game);
+
+    renderer_software_release(&software);
+
+    return exit_code;
+}
\ No newline at end of file
@@ -4,10 +4,19 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "image_loader.h"
 
 #define DDS_HEADER_SIZE 124
+#define DDS_MAX_SIZE 16384
+
+// DDS_PIXELFORMAT
+#define DDS_PIXEL_FORMAT_OFFSET 72
+#define DDPF_ALPHAPIXELS 0x1
+#define DDPF_RGB 0x40
+
+static uint32_t read_u32(const char* p_bytes);
 
 bool load_a8r8g8b8_dds(const char* filename, image_t* out_image)
 {
@@ -20,31 +29,44 @@ bool load_a8r8g8b8_dds(const char* filename, image_t* out_image)
         return false;
     }
 
-    uint32_t magic;
-    fread(&magic, sizeof(uint32_t), 1, p_file);
-
-    const char* p_magic = (const char*)&magic;
-    if (p_magic[0] != 'D'
-        || p_magic[1] != 'D'
-        || p_magic[2] != 'S'
-        || p_magic[3] != ' ') {
+    char magic[4];
+    char dds_header[DDS_HEADER_SIZE];
+    if (fread(magic, 1, sizeof(magic), p_file) != sizeof(magic)
+        || memcmp(magic, "DDS ", 4) != 0
+        || fread(dds_header, 1, DDS_HEADER_SIZE, p_file) != DDS_HEADER_SIZE) {
         fclose(p_file);
         return false;
     }
 
-    char dds_header[DDS_HEADER_SIZE];
-    fread(dds_header, sizeof(char), DDS_HEADER_SIZE, p_file);
+    const uint32_t height = read_u32(&dds_header[8]);
+    const uint32_t width = read_u32(&dds_header[12]);
 
-    const uint32_t height = *(uint32_t*)&dds_header[8];
-    const uint32_t width = *(uint32_t*)&dds_header[12];
+    // 압축하지 않은 32비트 A8R8G8B8만
+    const char* p_format = &dds_header[DDS_PIXEL_FORMAT_OFFSET];
+    if (read_u32(&dds_header[0]) != DDS_HEADER_SIZE
+        || width == 0 || height == 0 || width > DDS_MAX_SIZE || height > DDS_MAX_SIZE
+        || (read_u32(&p_format[4]) & (DDPF_RGB | DDPF_ALPHAPIXELS)) != (DDPF_RGB | DDPF_ALPHAPIXELS)
+        || read_u32(&p_format[12]) != 32
+        || read_u32(&p_format[16]) != 0x00ff0000
+        || read_u32(&p_format[20]) != 0x0000ff00
+        || read_u32(&p_format[24]) != 0x000000ff
+        || read_u32(&p_format[28]) != 0xff000000) {
+        fclose(p_file);
+        return false;
+    }
 
-    char* pa_bitmap = (char*)malloc(width * height * sizeof(uint32_t));
+    const size_t size = (size_t)width * height * sizeof(uint32_t);
+    char* pa_bitmap = (char*)malloc(size);
     if (pa_bitmap == NULL) {
         fclose(p_file);
         return false;
     }
 
-    fread(pa_bitmap, 1, width * height * sizeof(uint32_t), p_file);
+    if (fread(pa_bitmap, 1, size, p_file) != size) {
+        free(pa_bitmap);
+        fclose(p_file);
+        return false;
+    }
 
     out_image->width = width;
     out_image->height = height;
@@ -52,4 +74,11 @@ bool load_a8r8g8b8_dds(const char* filename, image_t* out_image)
 
     fclose(p_file);
     return true;
+}
+
+static uint32_t read_u32(const char* p_bytes)
+{
+    uint32_t value;
+    memcpy(&value, p_bytes, sizeof(uint32_t));
+    return value;
 }
\ No newline at end of file
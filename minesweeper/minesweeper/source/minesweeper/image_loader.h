@@ -8,6 +8,8 @@
 
 START_EXTERN_C
 
+// 압축하지 않은 A8R8G8B8 DDS만, 헤더/픽셀 형식이 다르거나 파일이 짧으면 false
+// 게임은 아틀라스만 읽고, 이 함수는 아틀라스를 만들 때 사용
 bool load_a8r8g8b8_dds(const char* filename, image_t* out_image);
 
 END_EXTERN_C
@@ -2,25 +2,71 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <Windows.h>
 #include <windowsx.h>
 
+#include "batch.h"
 #include "game.h"
-#include "mouse_event.h"
+#include "minesweeper_engine/profiler.h"
+#include "minesweeper_engine/scheduler.h"
+#include "renderer_ddraw_backend.h"
+
+// 입력이 몰려도 이보다 자주 그리지 않음
+#define MAX_FPS 60
+
+// 판 크기 상한, 화면보다 큰 판은 카메라로 이동하며 봄
+#define MAX_ROWS 10000
+#define MAX_COLS 10000
+
+// 방향키 한 번에 이동하는 픽셀 수
+#define KEY_PAN_PIXELS 64
+
+// 판이 바뀌었으면 이 주기로 실행 위치에 저장하고, 다음 실행 때 이어 할지 물음
+#define SNAPSHOT_PATH "minesweeper.snapshot"
+#define AUTOSAVE_INTERVAL_MS 10000
+
+// MINESWEEPER_ENABLE_PROFILER로 빌드하면 실행 위치에 크롬 트레이스 이벤트 JSON을 남김
+#define TRACE_PATH "minesweeper_trace.json"
 
 HINSTANCE g_hinstance;
 HWND g_hwnd;
 
+renderer_ddraw_t g_ddraw;
+renderer_t g_renderer;
 game_t* gp_game;
+scheduler_t g_scheduler;
+
+// 가운데 버튼 드래그 중 이전 마우스 위치
+bool gb_panning;
+int32_t g_pan_x;
+int32_t g_pan_y;
 
 HRESULT init_window(const size_t width, const size_t height);
 LRESULT CALLBACK wnd_proc(HWND, UINT, WPARAM, LPARAM);
 
-int main(void)
+static uint64_t get_clock_ms(void* p_context);
+static bool wait_message(void* p_context, const uint32_t timeout_ms);
+static void push_input(const mouse_event_type_t type, const LPARAM lParam);
+
+int main(int argc, char* argv[])
 {
+    // --record path: 평소처럼 두면서 행동을 기록 (minesweeper_replay로 재생)
+    // 그 밖의 인자가 있으면 창 없이 자동 대국만 (batch.h 참고)
+    const char* p_record_path = NULL;
+    if (argc == 3 && strcmp(argv[1], "--record") == 0)
+    {
+        p_record_path = argv[2];
+    }
+    else if (argc > 1)
+    {
+        return run_batch(argc, argv);
+    }
+
     int rows;
     int cols;
     int num_mines;
+    int no_guess;
 
     // 모니터 해상도 구하기
     HMONITOR monitor = MonitorFromWindow(GetConsoleWindow(), MONITOR_DEFAULTTONEAREST);
@@ -30,54 +76,121 @@ int main(void)
     const int monitor_width = info.rcMonitor.right - info.rcMonitor.left;
     const int monitor_height = info.rcMonitor.bottom - info.rcMonitor.top;
 
-    const int num_max_rows = (monitor_height - INFO_HEIGHT * 3) / SPRITE_TILE_HEIGHT;
-    const int num_max_cols = monitor_width / SPRITE_TILE_WIDTH;
+    // 지난 실행의 판이 남아 있으면 이어 할지 물음
+    int resume = 0;
+    snapshot_t snapshot;
+    if (snapshot_open(&snapshot, SNAPSHOT_PATH))
+    {
+        const snapshot_header_t* p_header = snapshot.p_header;
+        if (p_header->rows >= 9 && p_header->rows <= MAX_ROWS && p_header->cols >= 9 && p_header->cols <= MAX_COLS)
+        {
+            rows = (int)p_header->rows;
+            cols = (int)p_header->cols;
+            num_mines = (int)p_header->num_max_mines;
 
-    printf("rows(9 ~ %d)\n> ", num_max_rows);
-    scanf("%d", &rows);
-    printf("\n");
+            printf("resume saved game %d x %d, %d mines(0 / 1)\n> ", rows, cols, num_mines);
+            scanf("%d", &resume);
+            printf("\n");
+        }
+        snapshot_close(&snapshot);
+    }
 
-    if (rows < 9 || rows > num_max_rows)
+    if (resume == 0)
     {
-        MessageBox(NULL, L"Out of rows", L"rows", MB_OK | MB_ICONERROR);
-        return 0;
+        printf("rows(9 ~ %d)\n> ", MAX_ROWS);
+        scanf("%d", &rows);
+        printf("\n");
+
+        if (rows < 9 || rows > MAX_ROWS)
+        {
+            MessageBox(NULL, L"Out of rows", L"rows", MB_OK | MB_ICONERROR);
+            return 0;
+        }
+
+        printf("cols(9 ~ %d)\n> ", MAX_COLS);
+        scanf("%d", &cols);
+        printf("\n");
+
+        if (cols < 9 || cols > MAX_COLS)
+        {
+            MessageBox(NULL, L"Out of cols", L"cols", MB_OK | MB_ICONERROR);
+            return 0;
+        }
+
+        printf("num of mines(1 ~ %d)\n> ", rows * cols);
+        scanf("%d", &num_mines);
+        printf("\n");
+
+        if (num_mines < 1 || num_mines >= rows * cols)
+        {
+            MessageBox(NULL, L"Out of mines", L"num of mines", MB_OK | MB_ICONERROR);
+            return 0;
+        }
     }
 
-    printf("cols(9 ~ %d)\n> ", num_max_cols);
-    scanf("%d", &cols);
+    printf("no guess(0 / 1)\n> ");
+    scanf("%d", &no_guess);
     printf("\n");
 
-    if (cols < 9 || cols > num_max_cols)
+    // 판이 모니터보다 크면 모니터에 맞는 창을 만들고 나머지는 스크롤
+    const size_t max_window_width = monitor_width;
+    const size_t max_window_height = monitor_height - INFO_HEIGHT * 2;
+    const size_t board_width = (size_t)cols * SPRITE_TILE_WIDTH;
+    const size_t board_height = (size_t)rows * SPRITE_TILE_HEIGHT + INFO_HEIGHT;
+    const size_t window_width = (board_width < max_window_width) ? board_width : max_window_width;
+    const size_t window_height = (board_height < max_window_height) ? board_height : max_window_height;
+
+    if (FAILED(init_window(window_width, window_height)))
     {
-        MessageBox(NULL, L"Out of cols", L"cols", MB_OK | MB_ICONERROR);
         return 0;
     }
 
-    printf("num of mines(1 ~ %d)\n> ", rows * cols);
-    scanf("%d", &num_mines);
-    printf("\n");
-
-    if (num_mines < 1 || num_mines >= rows * cols)
+    if (!renderer_ddraw_init(&g_ddraw, g_hwnd))
     {
-        MessageBox(NULL, L"Out of mines", L"num of mines", MB_OK | MB_ICONERROR);
         return 0;
     }
+    renderer_ddraw_backend_bind(&g_renderer, &g_ddraw);
 
-    const size_t window_width = cols * SPRITE_TILE_WIDTH;
-    const size_t window_height = rows * SPRITE_TILE_HEIGHT + INFO_HEIGHT;
+#if defined(MINESWEEPER_PROFILER)
+    // 끝낼 때 콘솔에 구간별 시간 분포 출력, 트레이스는 스프라이트 로딩부터
+    profiler_init();
+    PROFILE_THREAD_NAME("main");
+    profiler_start_trace(TRACE_PATH);
+#endif // MINESWEEPER_PROFILER
 
-    if (FAILED(init_window(window_width, window_height)))
+    gp_game = (game_t*)malloc(sizeof(game_t));
+    if (!init_game(&g_renderer, gp_game, rows, cols, num_mines))
     {
+#if defined(MINESWEEPER_PROFILER)
+        profiler_shutdown();
+#endif // MINESWEEPER_PROFILER
+        renderer_ddraw_release(&g_ddraw);
         return 0;
     }
 
-    gp_game = (game_t*)malloc(sizeof(game_t));
-    if (!init_game(g_hwnd, gp_game, rows, cols, num_mines))
+    // 실패하면 일반 판으로 진행
+    set_game_no_guess(gp_game, no_guess != 0);
+
+    scheduler_init(&g_scheduler, get_clock_ms, NULL, wait_message, NULL, MAX_FPS);
+
+    if (resume != 0 && !resume_game(gp_game, SNAPSHOT_PATH, scheduler_get_time(&g_scheduler)))
     {
-        return 0;
+        MessageBox(NULL, L"Failed to resume saved game", L"resume", MB_OK | MB_ICONERROR);
+    }
+    set_game_autosave(gp_game, SNAPSHOT_PATH, AUTOSAVE_INTERVAL_MS, scheduler_get_time(&g_scheduler));
+
+    // 기록은 새 판의 시드부터 시작하므로 이어 한 판에서 시작하면 판을 버리고 저장본도 덮어씀
+    if (p_record_path != NULL && resume != 0)
+    {
+        MessageBox(NULL, L"Cannot record a resumed game", L"record", MB_OK | MB_ICONERROR);
+    }
+    else if (p_record_path != NULL && !start_game_recording(gp_game, p_record_path, scheduler_get_time(&g_scheduler)))
+    {
+        MessageBox(NULL, L"Failed to open record file", L"record", MB_OK | MB_ICONERROR);
     }
 
     // Main message loop
+    // 메시지가 없으면 입력/타이머 표시 갱신이 있을 때까지 잠듦
     MSG msg = { 0 };
     while (WM_QUIT != msg.message)
     {
@@ -86,16 +199,47 @@ int main(void)
             TranslateMessage(&msg);
             DispatchMessage(&msg);
         }
-        else
+        else if (scheduler_wait(&g_scheduler))
         {
-            update_game(gp_game);
+            PROFILE_BEGIN_FRAME();
+            update_game(gp_game, scheduler_get_time(&g_scheduler));
+
+            // 최소화 중에는 그리지도, 타이머로 깨어나지도 않음
+            if (IsIconic(g_hwnd))
+            {
+                PROFILE_END_FRAME();
+                continue;
+            }
+
             draw_game(gp_game);
+            PROFILE_END_FRAME();
+            scheduler_set_deadline(&g_scheduler, get_game_next_tick(gp_game));
         }
     }
 
+#if defined(MINESWEEPER_PROFILER)
+    profiler_stop_trace(NULL);
+    profiler_report(stdout);
+    profiler_shutdown();
+#endif // MINESWEEPER_PROFILER
+
+    if (gp_game->b_recording)
+    {
+        stop_game_recording(gp_game, scheduler_get_time(&g_scheduler));
+    }
+
+    // 마지막 자동 저장 이후 바뀐 판도 남김, 쓰기는 shutdown_game이 끝까지 기다림
+    flush_game_snapshot(gp_game);
+    if (gp_game->b_unsaved)
+    {
+        save_game_snapshot(gp_game, SNAPSHOT_PATH, scheduler_get_time(&g_scheduler));
+    }
+
     shutdown_game(gp_game);
     free(gp_game);
 
+    renderer_ddraw_release(&g_ddraw);
+
     return (int)msg.wParam;
 }
 
@@ -152,6 +296,7 @@ LRESULT CALLBACK wnd_proc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
     case WM_PAINT:
         hdc = BeginPaint(hWnd, &ps);
         EndPaint(hWnd, &ps);
+        scheduler_request_redraw(&g_scheduler);
         break;
 
     case WM_DESTROY:
@@ -159,51 +304,89 @@ LRESULT CALLBACK wnd_proc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
         break;
 
     case WM_LBUTTONDOWN:
-    {
-        uint32_t x = GET_X_LPARAM(lParam);
-        uint32_t y = GET_Y_LPARAM(lParam);
-        on_down_left_mouse();
+        push_input(MOUSE_EVENT_TYPE_LEFT_DOWN, lParam);
         break;
-    }
     case WM_LBUTTONUP:
-    {
-        uint32_t x = GET_X_LPARAM(lParam);
-        uint32_t y = GET_Y_LPARAM(lParam);
-        on_up_left_mouse();
+        push_input(MOUSE_EVENT_TYPE_LEFT_UP, lParam);
         break;
-    }
     case WM_RBUTTONDOWN:
-    {
-        uint32_t x = GET_X_LPARAM(lParam);
-        uint32_t y = GET_Y_LPARAM(lParam);
-        on_down_right_mouse();
+        push_input(MOUSE_EVENT_TYPE_RIGHT_DOWN, lParam);
         break;
-    }
     case WM_RBUTTONUP:
-    {
-        uint32_t x = GET_X_LPARAM(lParam);
-        uint32_t y = GET_Y_LPARAM(lParam);
-        on_up_right_mouse();
+        push_input(MOUSE_EVENT_TYPE_RIGHT_UP, lParam);
         break;
-    }
     case WM_MOUSEMOVE:
     {
-        uint32_t x = GET_X_LPARAM(lParam);
-        uint32_t y = GET_Y_LPARAM(lParam);
-        on_move_mouse(x, y);
+        const int32_t x = GET_X_LPARAM(lParam);
+        const int32_t y = GET_Y_LPARAM(lParam);
+        push_input(MOUSE_EVENT_TYPE_MOVE, lParam);
+
+        // 가운데 버튼 드래그: 마우스를 끈 방향으로 판이 따라오도록 카메라는 반대로 이동
+        if (gb_panning && gp_game != NULL)
+        {
+            pan_game(gp_game, g_pan_x - x, g_pan_y - y);
+            g_pan_x = x;
+            g_pan_y = y;
+        }
+        scheduler_request_redraw(&g_scheduler);
         break;
     }
+    case WM_MBUTTONDOWN:
+        gb_panning = true;
+        g_pan_x = GET_X_LPARAM(lParam);
+        g_pan_y = GET_Y_LPARAM(lParam);
+        SetCapture(hWnd);
+        break;
+    case WM_MBUTTONUP:
+        gb_panning = false;
+        ReleaseCapture();
+        break;
+    case WM_MOUSEWHEEL:
+        if (gp_game != NULL)
+        {
+            // 휠 메시지의 좌표는 스크린 좌표
+            POINT point = { GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam) };
+            ScreenToClient(hWnd, &point);
+            zoom_game(gp_game, GET_WHEEL_DELTA_WPARAM(wParam) / WHEEL_DELTA, point.x, point.y);
+            scheduler_request_redraw(&g_scheduler);
+        }
+        break;
+    case WM_KEYDOWN:
+        if (gp_game != NULL)
+        {
+            switch (wParam)
+            {
+            case VK_LEFT:
+                pan_game(gp_game, -KEY_PAN_PIXELS, 0);
+                break;
+            case VK_RIGHT:
+                pan_game(gp_game, KEY_PAN_PIXELS, 0);
+                break;
+            case VK_UP:
+                pan_game(gp_game, 0, -KEY_PAN_PIXELS);
+                break;
+            case VK_DOWN:
+                pan_game(gp_game, 0, KEY_PAN_PIXELS);
+                break;
+            default:
+                break;
+            }
+            scheduler_request_redraw(&g_scheduler);
+        }
+        break;
 
     case WM_MOVE:
-        if (gp_game != NULL && gp_game->pa_renderer != NULL)
+        if (gp_game != NULL && gp_game->p_renderer != NULL)
         {
-            renderer_ddraw_update_window_pos(gp_game->pa_renderer);
+            renderer_ddraw_update_window_pos(&g_ddraw);
         }
         break;
     case WM_SIZE:
-        if (gp_game != NULL && gp_game->pa_renderer != NULL)
+        if (gp_game != NULL && gp_game->p_renderer != NULL)
         {
-            renderer_ddraw_update_window_size(gp_game->pa_renderer);
+            renderer_ddraw_update_window_size(&g_ddraw);
+            invalidate_game(gp_game);
+            scheduler_request_redraw(&g_scheduler);
         }
         break;
 
@@ -212,4 +395,27 @@ LRESULT CALLBACK wnd_proc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
     }
 
     return 0;
+}
+
+static uint64_t get_clock_ms(void* p_context)
+{
+    return GetTickCount64();
+}
+
+static bool wait_message(void* p_context, const uint32_t timeout_ms)
+{
+    const DWORD timeout = (timeout_ms == SCHEDULER_INFINITE) ? INFINITE : (DWORD)timeout_ms;
+    return MsgWaitForMultipleObjects(0, NULL, FALSE, timeout, QS_ALLINPUT) == WAIT_OBJECT_0;
+}
+
+// 입력은 받은 시각과 위치 그대로 큐에 넣고 다음 update_game에서 적용
+static void push_input(const mouse_event_type_t type, const LPARAM lParam)
+{
+    if (gp_game == NULL)
+    {
+        return;
+    }
+
+    push_game_input(gp_game, type, GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam), get_clock_ms(NULL));
+    scheduler_request_redraw(&g_scheduler);
 }
\ No newline at end of file
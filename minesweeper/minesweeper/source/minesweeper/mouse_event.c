@@ -1,59 +1,80 @@
+#include <string.h>
+
 #include "mouse_event.h"
+#include "safe99_common/assert.h"
 
-static mouse_state_t s_left_state;
-static mouse_state_t s_right_state;
+#define INDEX_MASK (MOUSE_EVENT_QUEUE_CAPACITY - 1)
 
-static int32_t s_x;
-static int32_t s_y;
+#if (MOUSE_EVENT_QUEUE_CAPACITY & INDEX_MASK) != 0
+    #error "MOUSE_EVENT_QUEUE_CAPACITY must be a power of 2"
+#endif
 
-void on_move_mouse(const int32_t x, const int32_t y)
+void mouse_event_queue_init(mouse_event_queue_t* p_queue)
 {
-    s_x = x;
-    s_y = y;
-}
+    ASSERT(p_queue != NULL, "p_queue == NULL");
 
-void on_down_left_mouse(void)
-{
-    s_left_state = MOUSE_STATE_DOWN;
+    memset(p_queue, 0, sizeof(mouse_event_queue_t));
 }
 
-void on_up_left_mouse(void)
+bool mouse_event_queue_push(mouse_event_queue_t* p_queue, const mouse_event_type_t type, const int32_t x, const int32_t y, const uint64_t time)
 {
-    s_left_state = MOUSE_STATE_UP;
-}
+    ASSERT(p_queue != NULL, "p_queue == NULL");
 
-void on_down_right_mouse(void)
-{
-    s_right_state = MOUSE_STATE_DOWN;
-}
+    // tail은 넣는 쪽만 쓰므로 그냥 읽어도 됨
+    // 색인은 계속 증가시키고 배열 색인만 감싸므로 가득 참과 빔을 구분할 수 있음
+    const uint32_t tail = p_queue->tail;
+    if (tail - p_queue->cached_head == MOUSE_EVENT_QUEUE_CAPACITY)
+    {
+        p_queue->cached_head = atomic_load_u32(&p_queue->head);
+        if (tail - p_queue->cached_head == MOUSE_EVENT_QUEUE_CAPACITY)
+        {
+            ++p_queue->num_dropped;
+            return false;
+        }
+    }
 
-void on_up_right_mouse(void)
-{
-    s_right_state = MOUSE_STATE_UP;
-}
+    mouse_event_t* p_event = &p_queue->events[tail & INDEX_MASK];
+    p_event->time = time;
+    p_event->x = x;
+    p_event->y = y;
+    p_event->type = type;
 
-void release_mouse(void)
-{
-    s_left_state = MOUSE_STATE_UP;
-    s_right_state = MOUSE_STATE_UP;
-}
+    // 내용을 다 쓴 뒤에 공개
+    atomic_store_u32(&p_queue->tail, tail + 1);
 
-int32_t get_mouse_x(void)
-{
-    return s_x;
+    return true;
 }
 
-int32_t get_mouse_y(void)
+size_t mouse_event_queue_pop(mouse_event_queue_t* p_queue, mouse_event_t* p_out_events, const size_t max_events)
 {
-    return s_y;
-}
+    ASSERT(p_queue != NULL, "p_queue == NULL");
+    ASSERT(p_out_events != NULL || max_events == 0, "p_out_events == NULL");
 
-mouse_state_t get_left_mouse_state(void)
-{
-    return s_left_state;
+    // 꺼낼 때마다 tail을 읽어 그때까지 들어온 입력을 모두 꺼냄
+    const uint32_t head = p_queue->head;
+    size_t num_events = (size_t)(atomic_load_u32(&p_queue->tail) - head);
+    if (num_events > max_events)
+    {
+        num_events = max_events;
+    }
+
+    for (size_t i = 0; i < num_events; ++i)
+    {
+        p_out_events[i] = p_queue->events[(head + (uint32_t)i) & INDEX_MASK];
+    }
+
+    // 다 읽은 뒤에 칸을 돌려줌
+    if (num_events > 0)
+    {
+        atomic_store_u32(&p_queue->head, head + (uint32_t)num_events);
+    }
+
+    return num_events;
 }
 
-mouse_state_t get_right_mouse_state(void)
+uint32_t mouse_event_queue_get_num_dropped(const mouse_event_queue_t* p_queue)
 {
-    return s_right_state;
+    ASSERT(p_queue != NULL, "p_queue == NULL");
+
+    return p_queue->num_dropped;
 }
\ No newline at end of file
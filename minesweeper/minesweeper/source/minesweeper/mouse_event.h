@@ -2,26 +2,72 @@
 #define MOUSE_EVENT_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
-typedef enum mouse_state
+#include "minesweeper_engine/thread.h"
+#include "safe99_common/defines.h"
+
+// 창 프로시저가 넣고 update_game이 프레임마다 한꺼번에 꺼내는 마우스 입력 큐
+// 넣는 스레드 하나, 꺼내는 스레드 하나 (SPSC), 잠금 없이 head/tail만 원자적으로 읽고 씀
+// 한 프레임 안에 누르고 뗀 입력도 합치지 않고 들어온 순서대로 모두 적용함
+// 넣는 쪽과 꺼내는 쪽은 같은 스레드여도 되고 다른 스레드여도 됨
+
+// 2의 거듭제곱
+#define MOUSE_EVENT_QUEUE_CAPACITY 1024
+#define MOUSE_EVENT_QUEUE_CACHE_LINE_SIZE 64
+
+typedef enum mouse_event_type
 {
-    MOUSE_STATE_UP,
-    MOUSE_STATE_DOWN
-} mouse_state_t;
+    MOUSE_EVENT_TYPE_MOVE,
+    MOUSE_EVENT_TYPE_LEFT_DOWN,
+    MOUSE_EVENT_TYPE_LEFT_UP,
+    MOUSE_EVENT_TYPE_RIGHT_DOWN,
+    MOUSE_EVENT_TYPE_RIGHT_UP
+} mouse_event_type_t;
+
+typedef struct mouse_event
+{
+    // 밀리초, 게임 시각과 같은 시계
+    uint64_t time;
+
+    // 창 클라이언트 좌표, 버튼 입력도 눌린 위치를 가짐
+    int32_t x;
+    int32_t y;
+
+    mouse_event_type_t type;
+} mouse_event_t;
+
+typedef struct mouse_event_queue
+{
+    // 넣는 쪽만 씀
+    volatile uint32_t tail;
+    // 넣는 쪽이 마지막으로 본 head, 가득 찼을 때만 다시 읽음
+    uint32_t cached_head;
+    // 가득 차서 버린 입력 수
+    uint32_t num_dropped;
+    uint8_t producer_padding[MOUSE_EVENT_QUEUE_CACHE_LINE_SIZE - sizeof(uint32_t) * 3];
+
+    // 꺼내는 쪽만 씀
+    volatile uint32_t head;
+    uint8_t consumer_padding[MOUSE_EVENT_QUEUE_CACHE_LINE_SIZE - sizeof(uint32_t)];
+
+    mouse_event_t events[MOUSE_EVENT_QUEUE_CAPACITY];
+} mouse_event_queue_t;
+
+START_EXTERN_C
+
+void mouse_event_queue_init(mouse_event_queue_t* p_queue);
 
-void on_move_mouse(const int32_t x, const int32_t y);
-void on_down_left_mouse(void);
-void on_up_left_mouse(void);
-void on_down_right_mouse(void);
-void on_up_right_mouse(void);
+// 넣는 쪽, 가득 찼으면 버리고 false
+bool mouse_event_queue_push(mouse_event_queue_t* p_queue, const mouse_event_type_t type, const int32_t x, const int32_t y, const uint64_t time);
 
-void release_mouse(void);
+// 꺼내는 쪽, 최대 max_events개를 넣은 순서대로 꺼내고 꺼낸 개수 반환
+size_t mouse_event_queue_pop(mouse_event_queue_t* p_queue, mouse_event_t* p_out_events, const size_t max_events);
 
-int32_t get_mouse_x(void);
-int32_t get_mouse_y(void);
+// 지금까지 버린 입력 수, 넣는 쪽 스레드에서만 정확함
+uint32_t mouse_event_queue_get_num_dropped(const mouse_event_queue_t* p_queue);
 
-mouse_state_t get_left_mouse_state(void);
-mouse_state_t get_right_mouse_state(void);
+END_EXTERN_C
 
 #endif // MOUSE_EVENT_H
\ No newline at end of file
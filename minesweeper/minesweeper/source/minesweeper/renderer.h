@@ -0,0 +1,98 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "safe99_common/assert.h"
+#include "safe99_common/defines.h"
+
+// 게임이 사용하는 렌더러 연산
+// 백엔드 (DirectDraw, 소프트웨어)는 함수 테이블과 인스턴스를 채워서 넘김
+// 인스턴스의 생성/해제는 백엔드를 만든 쪽에서 담당
+
+typedef struct renderer_vtable
+{
+    size_t (*pf_get_width)(void* p_instance);
+    size_t (*pf_get_height)(void* p_instance);
+
+    bool (*pf_begin_draw)(void* p_instance);
+    void (*pf_end_draw)(void* p_instance);
+    void (*pf_on_draw)(void* p_instance);
+
+    // begin_draw ~ end_draw 사이의 A8R8G8B8 백 버퍼, 직접 쓸 수 없으면 NULL
+    char* (*pf_get_locked_buffer)(void* p_instance, size_t* p_out_pitch);
+
+    void (*pf_clear)(void* p_instance, const uint32_t argb);
+    void (*pf_draw_rectangle)(void* p_instance, const int32_t dx, const int32_t dy, const size_t width, const size_t height, const uint32_t argb);
+    void (*pf_draw_bitmap)(void* p_instance, const int32_t dx, const int32_t dy, const int32_t sx, const int32_t sy, const size_t sw, const size_t sh, const size_t width, const size_t height, const char* p_bitmap);
+} renderer_vtable_t;
+
+typedef struct renderer
+{
+    const renderer_vtable_t* p_vtable;
+    void* p_instance;
+} renderer_t;
+
+START_EXTERN_C
+
+FORCEINLINE size_t renderer_get_width(const renderer_t* p_renderer)
+{
+    ASSERT(p_renderer != NULL, "p_renderer == NULL");
+    return p_renderer->p_vtable->pf_get_width(p_renderer->p_instance);
+}
+
+FORCEINLINE size_t renderer_get_height(const renderer_t* p_renderer)
+{
+    ASSERT(p_renderer != NULL, "p_renderer == NULL");
+    return p_renderer->p_vtable->pf_get_height(p_renderer->p_instance);
+}
+
+FORCEINLINE bool renderer_begin_draw(renderer_t* p_renderer)
+{
+    ASSERT(p_renderer != NULL, "p_renderer == NULL");
+    return p_renderer->p_vtable->pf_begin_draw(p_renderer->p_instance);
+}
+
+FORCEINLINE void renderer_end_draw(renderer_t* p_renderer)
+{
+    ASSERT(p_renderer != NULL, "p_renderer == NULL");
+    p_renderer->p_vtable->pf_end_draw(p_renderer->p_instance);
+}
+
+FORCEINLINE void renderer_on_draw(renderer_t* p_renderer)
+{
+    ASSERT(p_renderer != NULL, "p_renderer == NULL");
+    p_renderer->p_vtable->pf_on_draw(p_renderer->p_instance);
+}
+
+FORCEINLINE char* renderer_get_locked_buffer(renderer_t* p_renderer, size_t* p_out_pitch)
+{
+    ASSERT(p_renderer != NULL, "p_renderer == NULL");
+    ASSERT(p_out_pitch != NULL, "p_out_pitch == NULL");
+    return p_renderer->p_vtable->pf_get_locked_buffer(p_renderer->p_instance, p_out_pitch);
+}
+
+FORCEINLINE void renderer_clear(renderer_t* p_renderer, const uint32_t argb)
+{
+    ASSERT(p_renderer != NULL, "p_renderer == NULL");
+    p_renderer->p_vtable->pf_clear(p_renderer->p_instance, argb);
+}
+
+FORCEINLINE void renderer_draw_rectangle(renderer_t* p_renderer, const int32_t dx, const int32_t dy, const size_t width, const size_t height, const uint32_t argb)
+{
+    ASSERT(p_renderer != NULL, "p_renderer == NULL");
+    p_renderer->p_vtable->pf_draw_rectangle(p_renderer->p_instance, dx, dy, width, height, argb);
+}
+
+// p_bitmap (width * height, A8R8G8B8)의 (sx, sy, sw, sh) 영역을 (dx, dy)에 그림
+FORCEINLINE void renderer_draw_bitmap(renderer_t* p_renderer, const int32_t dx, const int32_t dy, const int32_t sx, const int32_t sy, const size_t sw, const size_t sh, const size_t width, const size_t height, const char* p_bitmap)
+{
+    ASSERT(p_renderer != NULL, "p_renderer == NULL");
+    p_renderer->p_vtable->pf_draw_bitmap(p_renderer->p_instance, dx, dy, sx, sy, sw, sh, width, height, p_bitmap);
+}
+
+END_EXTERN_C
+
+#endif // RENDERER_H
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "renderer_ddraw_backend.h"
+
+static size_t get_width(void* p_instance);
+static size_t get_height(void* p_instance);
+static bool begin_draw(void* p_instance);
+static void end_draw(void* p_instance);
+static void on_draw(void* p_instance);
+static char* get_locked_buffer(void* p_instance, size_t* p_out_pitch);
+static void clear(void* p_instance, const uint32_t argb);
+static void draw_rectangle(void* p_instance, const int32_t dx, const int32_t dy, const size_t width, const size_t height, const uint32_t argb);
+static void draw_bitmap(void* p_instance, const int32_t dx, const int32_t dy, const int32_t sx, const int32_t sy, const size_t sw, const size_t sh, const size_t width, const size_t height, const char* p_bitmap);
+
+static const renderer_vtable_t s_vtable =
+{
+    get_width,
+    get_height,
+    begin_draw,
+    end_draw,
+    on_draw,
+    get_locked_buffer,
+    clear,
+    draw_rectangle,
+    draw_bitmap,
+};
+
+void renderer_ddraw_backend_bind(renderer_t* p_out_renderer, renderer_ddraw_t* p_ddraw)
+{
+    ASSERT(p_out_renderer != NULL, "p_out_renderer == NULL");
+    ASSERT(p_ddraw != NULL, "p_ddraw == NULL");
+
+    p_out_renderer->p_vtable = &s_vtable;
+    p_out_renderer->p_instance = p_ddraw;
+}
+
+static size_t get_width(void* p_instance)
+{
+    return renderer_ddraw_get_width((renderer_ddraw_t*)p_instance);
+}
+
+static size_t get_height(void* p_instance)
+{
+    return renderer_ddraw_get_height((renderer_ddraw_t*)p_instance);
+}
+
+static bool begin_draw(void* p_instance)
+{
+    return renderer_ddraw_begin_draw((renderer_ddraw_t*)p_instance);
+}
+
+static void end_draw(void* p_instance)
+{
+    renderer_ddraw_end_draw((renderer_ddraw_t*)p_instance);
+}
+
+static void on_draw(void* p_instance)
+{
+    renderer_ddraw_on_draw((renderer_ddraw_t*)p_instance);
+}
+
+static char* get_locked_buffer(void* p_instance, size_t* p_out_pitch)
+{
+    renderer_ddraw_t* p_ddraw = (renderer_ddraw_t*)p_instance;
+    *p_out_pitch = p_ddraw->locked_back_buffer_pitch;
+    return p_ddraw->p_locked_back_buffer;
+}
+
+static void clear(void* p_instance, const uint32_t argb)
+{
+    renderer_ddraw_clear((renderer_ddraw_t*)p_instance, argb);
+}
+
+static void draw_rectangle(void* p_instance, const int32_t dx, const int32_t dy, const size_t width, const size_t height, const uint32_t argb)
+{
+    renderer_ddraw_draw_rectangle((renderer_ddraw_t*)p_instance, dx, dy, width, height, argb);
+}
+
+static void draw_bitmap(void* p_instance, const int32_t dx, const int32_t dy, const int32_t sx, const int32_t sy, const size_t sw, const size_t sh, const size_t width, const size_t height, const char* p_bitmap)
+{
+    renderer_ddraw_draw_bitmap((renderer_ddraw_t*)p_instance, dx, dy, sx, sy, sw, sh, width, height, p_bitmap);
+}
\ No newline at end of file
@@ -0,0 +1,14 @@
+#ifndef RENDERER_DDRAW_BACKEND_H
+#define RENDERER_DDRAW_BACKEND_H
+
+#include "renderer.h"
+#include "safe99_renderer_ddraw/renderer_ddraw.h"
+
+START_EXTERN_C
+
+// 초기화된 p_ddraw를 renderer_t로 감쌈, p_ddraw는 p_out_renderer보다 오래 살아야 함
+void renderer_ddraw_backend_bind(renderer_t* p_out_renderer, renderer_ddraw_t* p_ddraw);
+
+END_EXTERN_C
+
+#endif // RENDERER_DDRAW_BACKEND_H
\ No newline at end of file
@@ -0,0 +1,320 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "renderer_software.h"
+#include "safe99_common/assert.h"
+#include "safe99_common/safe_delete.h"
+
+static size_t get_width(void* p_instance);
+static size_t get_height(void* p_instance);
+static bool begin_draw(void* p_instance);
+static void end_draw(void* p_instance);
+static void on_draw(void* p_instance);
+static char* get_locked_buffer(void* p_instance, size_t* p_out_pitch);
+static void clear(void* p_instance, const uint32_t argb);
+static void draw_rectangle(void* p_instance, const int32_t dx, const int32_t dy, const size_t width, const size_t height, const uint32_t argb);
+static void draw_bitmap(void* p_instance, const int32_t dx, const int32_t dy, const int32_t sx, const int32_t sy, const size_t sw, const size_t sh, const size_t width, const size_t height, const char* p_bitmap);
+
+static bool clip_rectangle(const renderer_software_t* p_software, int32_t* p_dx, int32_t* p_dy, int32_t* p_sx, int32_t* p_sy, int32_t* p_width, int32_t* p_height);
+
+static const renderer_vtable_t s_vtable =
+{
+    get_width,
+    get_height,
+    begin_draw,
+    end_draw,
+    on_draw,
+    get_locked_buffer,
+    clear,
+    draw_rectangle,
+    draw_bitmap,
+};
+
+bool renderer_software_init(renderer_software_t* p_software, const size_t width, const size_t height, const size_t pitch)
+{
+    ASSERT(p_software != NULL, "p_software == NULL");
+    ASSERT(width > 0, "width == 0");
+    ASSERT(height > 0, "height == 0");
+    ASSERT(pitch == 0 || pitch >= width * sizeof(uint32_t), "pitch < width * 4");
+    ASSERT(pitch % sizeof(uint32_t) == 0, "pitch % 4 != 0");
+
+    p_software->width = width;
+    p_software->height = height;
+    p_software->pitch = (pitch == 0) ? width * sizeof(uint32_t) : pitch;
+    p_software->p_locked_buffer = NULL;
+    p_software->dump_prefix[0] = '\0';
+    p_software->num_frames = 0;
+
+    p_software->pa_frame_buffer = (char*)calloc(p_software->pitch * height, 1);
+    if (p_software->pa_frame_buffer == NULL)
+    {
+        ASSERT(false, "Failed to calloc frame buffer");
+        goto failed_malloc_frame_buffer;
+    }
+
+    return true;
+
+failed_malloc_frame_buffer:
+    memset(p_software, 0, sizeof(renderer_software_t));
+    return false;
+}
+
+void renderer_software_release(renderer_software_t* p_software)
+{
+    ASSERT(p_software != NULL, "p_software == NULL");
+
+    SAFE_FREE(p_software->pa_frame_buffer);
+
+    memset(p_software, 0, sizeof(renderer_software_t));
+}
+
+void renderer_software_bind(renderer_t* p_out_renderer, renderer_software_t* p_software)
+{
+    ASSERT(p_out_renderer != NULL, "p_out_renderer == NULL");
+    ASSERT(p_software != NULL, "p_software == NULL");
+
+    p_out_renderer->p_vtable = &s_vtable;
+    p_out_renderer->p_instance = p_software;
+}
+
+bool renderer_software_set_dump(renderer_software_t* p_software, const char* p_prefix)
+{
+    ASSERT(p_software != NULL, "p_software == NULL");
+
+    if (p_prefix == NULL)
+    {
+        p_software->dump_prefix[0] = '\0';
+        return true;
+    }
+
+    const size_t length = strlen(p_prefix);
+    if (length >= RENDERER_SOFTWARE_MAX_DUMP_PREFIX)
+    {
+        return false;
+    }
+
+    memcpy(p_software->dump_prefix, p_prefix, length + 1);
+    return true;
+}
+
+bool renderer_software_save_ppm(const renderer_software_t* p_software, const char* p_filename)
+{
+    ASSERT(p_software != NULL, "p_software == NULL");
+    ASSERT(p_filename != NULL, "p_filename == NULL");
+
+    FILE* p_file = fopen(p_filename, "wb");
+    if (p_file == NULL)
+    {
+        return false;
+    }
+
+    fprintf(p_file, "P6\n%zu %zu\n255\n", p_software->width, p_software->height);
+
+    // 한 줄씩 A8R8G8B8 -> R8G8B8 변환
+    uint8_t row[4096 * 3];
+    bool b_result = true;
+    for (size_t y = 0; y < p_software->height && b_result; ++y)
+    {
+        const uint32_t* p_src = (const uint32_t*)(p_software->pa_frame_buffer + y * p_software->pitch);
+        for (size_t x = 0; x < p_software->width && b_result; x += 4096)
+        {
+            const size_t count = (p_software->width - x < 4096) ? p_software->width - x : 4096;
+            for (size_t i = 0; i < count; ++i)
+            {
+                const uint32_t argb = p_src[x + i];
+                row[i * 3 + 0] = (uint8_t)(argb >> 16);
+                row[i * 3 + 1] = (uint8_t)(argb >> 8);
+                row[i * 3 + 2] = (uint8_t)argb;
+            }
+
+            b_result = (fwrite(row, 3, count, p_file) == count);
+        }
+    }
+
+    fclose(p_file);
+    return b_result;
+}
+
+size_t renderer_software_get_width(renderer_software_t* p_software)
+{
+    ASSERT(p_software != NULL, "p_software == NULL");
+    return p_software->width;
+}
+
+size_t renderer_software_get_height(renderer_software_t* p_software)
+{
+    ASSERT(p_software != NULL, "p_software == NULL");
+    return p_software->height;
+}
+
+bool renderer_software_begin_draw(renderer_software_t* p_software)
+{
+    ASSERT(p_software != NULL, "p_software == NULL");
+    ASSERT(p_software->p_locked_buffer == NULL, "Already locked");
+
+    p_software->p_locked_buffer = p_software->pa_frame_buffer;
+    return true;
+}
+
+void renderer_software_end_draw(renderer_software_t* p_software)
+{
+    ASSERT(p_software != NULL, "p_software == NULL");
+    ASSERT(p_software->p_locked_buffer != NULL, "Not locked");
+
+    p_software->p_locked_buffer = NULL;
+}
+
+void renderer_software_on_draw(renderer_software_t* p_software)
+{
+    ASSERT(p_software != NULL, "p_software == NULL");
+
+    if (p_software->dump_prefix[0] != '\0')
+    {
+        char filename[RENDERER_SOFTWARE_MAX_DUMP_PREFIX + 32];
+        sprintf(filename, "%s%06zu.ppm", p_software->dump_prefix, p_software->num_frames);
+        renderer_software_save_ppm(p_software, filename);
+    }
+
+    ++p_software->num_frames;
+}
+
+void renderer_software_clear(renderer_software_t* p_software, const uint32_t argb)
+{
+    ASSERT(p_software != NULL, "p_software == NULL");
+    renderer_software_draw_rectangle(p_software, 0, 0, p_software->width, p_software->height, argb);
+}
+
+void renderer_software_draw_rectangle(renderer_software_t* p_software, const int32_t dx, const int32_t dy, const size_t width, const size_t height, const uint32_t argb)
+{
+    ASSERT(p_software != NULL, "p_software == NULL");
+    ASSERT(p_software->p_locked_buffer != NULL, "Not locked");
+
+    int32_t x = dx;
+    int32_t y = dy;
+    int32_t sx = 0;
+    int32_t sy = 0;
+    int32_t w = (int32_t)width;
+    int32_t h = (int32_t)height;
+    if (!clip_rectangle(p_software, &x, &y, &sx, &sy, &w, &h))
+    {
+        return;
+    }
+
+    for (int32_t i = 0; i < h; ++i)
+    {
+        uint32_t* p_dst = (uint32_t*)(p_software->p_locked_buffer + (size_t)(y + i) * p_software->pitch) + x;
+        for (int32_t j = 0; j < w; ++j)
+        {
+            p_dst[j] = argb;
+        }
+    }
+}
+
+// 알파 없이 그대로 복사
+void renderer_software_draw_bitmap(renderer_software_t* p_software, const int32_t dx, const int32_t dy, const int32_t sx, const int32_t sy, const size_t sw, const size_t sh, const size_t width, const size_t height, const char* p_bitmap)
+{
+    ASSERT(p_software != NULL, "p_software == NULL");
+    ASSERT(p_software->p_locked_buffer != NULL, "Not locked");
+    ASSERT(p_bitmap != NULL, "p_bitmap == NULL");
+    ASSERT(sx >= 0 && sy >= 0 && (size_t)sx + sw <= width && (size_t)sy + sh <= height, "Invalid source rectangle");
+
+    int32_t x = dx;
+    int32_t y = dy;
+    int32_t src_x = sx;
+    int32_t src_y = sy;
+    int32_t w = (int32_t)sw;
+    int32_t h = (int32_t)sh;
+    if (!clip_rectangle(p_software, &x, &y, &src_x, &src_y, &w, &h))
+    {
+        return;
+    }
+
+    const size_t src_pitch = width * sizeof(uint32_t);
+    for (int32_t i = 0; i < h; ++i)
+    {
+        char* p_dst = p_software->p_locked_buffer + (size_t)(y + i) * p_software->pitch + (size_t)x * sizeof(uint32_t);
+        const char* p_src = p_bitmap + (size_t)(src_y + i) * src_pitch + (size_t)src_x * sizeof(uint32_t);
+        memcpy(p_dst, p_src, (size_t)w * sizeof(uint32_t));
+    }
+}
+
+static size_t get_width(void* p_instance)
+{
+    return renderer_software_get_width((renderer_software_t*)p_instance);
+}
+
+static size_t get_height(void* p_instance)
+{
+    return renderer_software_get_height((renderer_software_t*)p_instance);
+}
+
+static bool begin_draw(void* p_instance)
+{
+    return renderer_software_begin_draw((renderer_software_t*)p_instance);
+}
+
+static void end_draw(void* p_instance)
+{
+    renderer_software_end_draw((renderer_software_t*)p_instance);
+}
+
+static void on_draw(void* p_instance)
+{
+    renderer_software_on_draw((renderer_software_t*)p_instance);
+}
+
+static char* get_locked_buffer(void* p_instance, size_t* p_out_pitch)
+{
+    renderer_software_t* p_software = (renderer_software_t*)p_instance;
+    *p_out_pitch = p_software->pitch;
+    return p_software->p_locked_buffer;
+}
+
+static void clear(void* p_instance, const uint32_t argb)
+{
+    renderer_software_clear((renderer_software_t*)p_instance, argb);
+}
+
+static void draw_rectangle(void* p_instance, const int32_t dx, const int32_t dy, const size_t width, const size_t height, const uint32_t argb)
+{
+    renderer_software_draw_rectangle((renderer_software_t*)p_instance, dx, dy, width, height, argb);
+}
+
+static void draw_bitmap(void* p_instance, const int32_t dx, const int32_t dy, const int32_t sx, const int32_t sy, const size_t sw, const size_t sh, const size_t width, const size_t height, const char* p_bitmap)
+{
+    renderer_software_draw_bitmap((renderer_software_t*)p_instance, dx, dy, sx, sy, sw, sh, width, height, p_bitmap);
+}
+
+// 대상 사각형을 프레임 버퍼 안으로 자르고 원본 시작점도 같이 옮김
+// 남는 영역이 없으면 false
+static bool clip_rectangle(const renderer_software_t* p_software, int32_t* p_dx, int32_t* p_dy, int32_t* p_sx, int32_t* p_sy, int32_t* p_width, int32_t* p_height)
+{
+    if (*p_dx < 0)
+    {
+        *p_sx -= *p_dx;
+        *p_width += *p_dx;
+        *p_dx = 0;
+    }
+
+    if (*p_dy < 0)
+    {
+        *p_sy -= *p_dy;
+        *p_height += *p_dy;
+        *p_dy = 0;
+    }
+
+    if ((int64_t)*p_dx + *p_width > (int64_t)p_software->width)
+    {
+        *p_width = (int32_t)p_software->width - *p_dx;
+    }
+
+    if ((int64_t)*p_dy + *p_height > (int64_t)p_software->height)
+    {
+        *p_height = (int32_t)p_software->height - *p_dy;
+    }
+
+    return *p_width > 0 && *p_height > 0;
+}
\ No newline at end of file
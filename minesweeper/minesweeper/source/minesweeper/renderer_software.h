@@ -0,0 +1,60 @@
+#ifndef RENDERER_SOFTWARE_H
+#define RENDERER_SOFTWARE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "renderer.h"
+#include "safe99_common/defines.h"
+
+// 메모리 ARGB 프레임 버퍼에 그리는 렌더러, 창/디스플레이 없이 동작
+// 한 줄은 pitch 바이트 (width * 4 이상, 정렬/패딩을 흉내낼 때 크게 줌)
+
+#define RENDERER_SOFTWARE_MAX_DUMP_PREFIX 256
+
+typedef struct renderer_software
+{
+    size_t width;
+    size_t height;
+    size_t pitch;
+
+    char* pa_frame_buffer;
+
+    // begin_draw ~ end_draw 사이에만 유효
+    char* p_locked_buffer;
+
+    // on_draw마다 "<prefix>000000.ppm" 형식으로 저장, 빈 문자열이면 저장하지 않음
+    char dump_prefix[RENDERER_SOFTWARE_MAX_DUMP_PREFIX];
+    size_t num_frames;
+} renderer_software_t;
+
+START_EXTERN_C
+
+// pitch가 0이면 width * 4
+bool renderer_software_init(renderer_software_t* p_software, const size_t width, const size_t height, const size_t pitch);
+void renderer_software_release(renderer_software_t* p_software);
+
+// p_software는 p_out_renderer보다 오래 살아야 함
+void renderer_software_bind(renderer_t* p_out_renderer, renderer_software_t* p_software);
+
+// NULL이면 저장하지 않음
+bool renderer_software_set_dump(renderer_software_t* p_software, const char* p_prefix);
+
+// 현재 프레임 버퍼를 바이너리 PPM (P6)으로 저장, 알파는 버림
+bool renderer_software_save_ppm(const renderer_software_t* p_software, const char* p_filename);
+
+size_t renderer_software_get_width(renderer_software_t* p_software);
+size_t renderer_software_get_height(renderer_software_t* p_software);
+
+bool renderer_software_begin_draw(renderer_software_t* p_software);
+void renderer_software_end_draw(renderer_software_t* p_software);
+void renderer_software_on_draw(renderer_software_t* p_software);
+
+void renderer_software_clear(renderer_software_t* p_software, const uint32_t argb);
+void renderer_software_draw_rectangle(renderer_software_t* p_software, const int32_t dx, const int32_t dy, const size_t width, const size_t height, const uint32_t argb);
+void renderer_software_draw_bitmap(renderer_software_t* p_software, const int32_t dx, const int32_t dy, const int32_t sx, const int32_t sy, const size_t sw, const size_t sh, const size_t width, const size_t height, const char* p_bitmap);
+
+END_EXTERN_C
+
+#endif // RENDERER_SOFTWARE_H
\ No newline at end of file
@@ -0,0 +1,170 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "sprite_atlas.h"
+#include "safe99_common/assert.h"
+#include "safe99_common/safe_delete.h"
+
+#define NATIVE_A_MASK 0xff000000
+#define NATIVE_R_MASK 0x00ff0000
+#define NATIVE_G_MASK 0x0000ff00
+#define NATIVE_B_MASK 0x000000ff
+
+static bool convert_pixels(sprite_atlas_t* p_atlas, const sprite_atlas_header_t* p_header);
+static bool is_valid_channel_mask(const uint32_t mask);
+static uint32_t get_mask_shift(const uint32_t mask);
+
+bool sprite_atlas_open(sprite_atlas_t* p_atlas, const char* p_path)
+{
+    ASSERT(p_atlas != NULL, "p_atlas == NULL");
+    ASSERT(p_path != NULL, "p_path == NULL");
+
+    memset(p_atlas, 0, sizeof(sprite_atlas_t));
+
+    if (!mapped_file_open(&p_atlas->file, p_path))
+    {
+        return false;
+    }
+
+    const uint8_t* p_data = p_atlas->file.p_data;
+    const size_t file_size = p_atlas->file.size;
+    const sprite_atlas_header_t* p_header = (const sprite_atlas_header_t*)p_data;
+
+    if (file_size < sizeof(sprite_atlas_header_t)
+        || memcmp(p_header->magic, "MSAT", 4) != 0
+        || p_header->version != SPRITE_ATLAS_VERSION
+        || p_header->width == 0 || p_header->height == 0
+        || p_header->pitch % sizeof(uint32_t) != 0 || p_header->pitch / sizeof(uint32_t) < p_header->width
+        || p_header->data_offset < sizeof(sprite_atlas_header_t) || p_header->data_offset % sizeof(uint32_t) != 0
+        || p_header->data_offset > file_size
+        || (uint64_t)p_header->pitch * p_header->height > file_size - p_header->data_offset)
+    {
+        goto failed_validate;
+    }
+
+    // 채널마다 8비트, 서로 겹치지 않음
+    if ((p_header->a_mask != 0 && !is_valid_channel_mask(p_header->a_mask))
+        || !is_valid_channel_mask(p_header->r_mask)
+        || !is_valid_channel_mask(p_header->g_mask)
+        || !is_valid_channel_mask(p_header->b_mask)
+        || (p_header->a_mask & p_header->r_mask) != 0
+        || ((p_header->a_mask | p_header->r_mask) & p_header->g_mask) != 0
+        || ((p_header->a_mask | p_header->r_mask | p_header->g_mask) & p_header->b_mask) != 0)
+    {
+        goto failed_validate;
+    }
+
+    for (size_t i = 0; i < SPRITE_ATLAS_NUM_REGIONS; ++i)
+    {
+        const sprite_atlas_rect_t* p_rect = &p_header->regions[i];
+        if (p_rect->width == 0 || p_rect->height == 0
+            || (uint64_t)p_rect->x + p_rect->width > p_header->width
+            || (uint64_t)p_rect->y + p_rect->height > p_header->height)
+        {
+            goto failed_validate;
+        }
+    }
+
+    memcpy(p_atlas->regions, p_header->regions, sizeof(p_atlas->regions));
+    p_atlas->height = p_header->height;
+
+    if (p_header->a_mask == NATIVE_A_MASK && p_header->r_mask == NATIVE_R_MASK
+        && p_header->g_mask == NATIVE_G_MASK && p_header->b_mask == NATIVE_B_MASK
+        && p_header->data_offset % SPRITE_ATLAS_ALIGNMENT == 0 && p_header->pitch % SPRITE_ATLAS_ALIGNMENT == 0)
+    {
+        p_atlas->p_pixels = (const char*)(p_data + p_header->data_offset);
+        p_atlas->pitch = p_header->pitch;
+        p_atlas->width = p_header->pitch / sizeof(uint32_t);
+
+        return true;
+    }
+
+    if (!convert_pixels(p_atlas, p_header))
+    {
+        goto failed_validate;
+    }
+
+    // 변환한 픽셀만 쓰므로 매핑은 바로 닫음
+    mapped_file_close(&p_atlas->file);
+
+    return true;
+
+failed_validate:
+    mapped_file_close(&p_atlas->file);
+    memset(p_atlas, 0, sizeof(sprite_atlas_t));
+    return false;
+}
+
+void sprite_atlas_close(sprite_atlas_t* p_atlas)
+{
+    ASSERT(p_atlas != NULL, "p_atlas == NULL");
+
+    SAFE_FREE(p_atlas->pa_converted);
+    mapped_file_close(&p_atlas->file);
+
+    memset(p_atlas, 0, sizeof(sprite_atlas_t));
+}
+
+// 한 줄을 64바이트 배수로 맞춘 A8R8G8B8로 변환
+static bool convert_pixels(sprite_atlas_t* p_atlas, const sprite_atlas_header_t* p_header)
+{
+    const size_t pitch = ((size_t)p_header->width * sizeof(uint32_t) + SPRITE_ATLAS_ALIGNMENT - 1) & ~(size_t)(SPRITE_ATLAS_ALIGNMENT - 1);
+
+    p_atlas->pa_converted = (char*)malloc(pitch * p_header->height);
+    if (p_atlas->pa_converted == NULL)
+    {
+        ASSERT(false, "Failed to malloc converted atlas");
+        return false;
+    }
+    memset(p_atlas->pa_converted, 0, pitch * p_header->height);
+
+    const uint32_t a_shift = get_mask_shift(p_header->a_mask);
+    const uint32_t r_shift = get_mask_shift(p_header->r_mask);
+    const uint32_t g_shift = get_mask_shift(p_header->g_mask);
+    const uint32_t b_shift = get_mask_shift(p_header->b_mask);
+
+    const uint8_t* p_src_row = p_atlas->file.p_data + p_header->data_offset;
+    char* p_dst_row = p_atlas->pa_converted;
+    for (uint32_t y = 0; y < p_header->height; ++y)
+    {
+        for (uint32_t x = 0; x < p_header->width; ++x)
+        {
+            uint32_t src;
+            memcpy(&src, p_src_row + (size_t)x * sizeof(uint32_t), sizeof(uint32_t));
+
+            const uint32_t a = (p_header->a_mask != 0) ? (src & p_header->a_mask) >> a_shift : 0xff;
+            const uint32_t dst = a << 24
+                | ((src & p_header->r_mask) >> r_shift) << 16
+                | ((src & p_header->g_mask) >> g_shift) << 8
+                | (src & p_header->b_mask) >> b_shift;
+
+            memcpy(p_dst_row + (size_t)x * sizeof(uint32_t), &dst, sizeof(uint32_t));
+        }
+
+        p_src_row += p_header->pitch;
+        p_dst_row += pitch;
+    }
+
+    p_atlas->p_pixels = p_atlas->pa_converted;
+    p_atlas->pitch = pitch;
+    p_atlas->width = (uint32_t)(pitch / sizeof(uint32_t));
+
+    return true;
+}
+
+// 연속한 8비트
+static bool is_valid_channel_mask(const uint32_t mask)
+{
+    return mask != 0 && (mask >> get_mask_shift(mask)) == 0xff;
+}
+
+static uint32_t get_mask_shift(const uint32_t mask)
+{
+    uint32_t shift = 0;
+    while (shift < 32 && (mask & ((uint32_t)1 << shift)) == 0)
+    {
+        ++shift;
+    }
+
+    return shift;
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#ifndef SPRITE_ATLAS_H
+#define SPRITE_ATLAS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "minesweeper_engine/mapped_file.h"
+#include "safe99_common/defines.h"
+
+// 타일/숫자/얼굴 스프라이트를 한 이미지에 모은 아틀라스 (minesweeper_atlas_pack으로 만듦)
+// 파일을 메모리에 매핑하고 여는 시점에 한 번만 검사, 그리는 쪽은 A8R8G8B8 한 장만 읽음
+// 파일의 픽셀 형식이 A8R8G8B8이고 한 줄이 64바이트 배수면 매핑한 픽셀을 복사 없이 그대로 쓰고,
+// 아니면 열 때 한 번 A8R8G8B8로 바꿔 둠
+//
+// 형식 (정수는 모두 리틀 엔디언 u32)
+//   헤더: "MSAT" | 버전 | width | height | pitch (바이트) | 픽셀 시작 위치
+//         채널 마스크 a | r | g | b (a가 0이면 불투명)
+//         영역 (x | y | width | height) * SPRITE_ATLAS_NUM_REGIONS
+//   픽셀: 시작 위치부터 pitch * height 바이트
+
+#define SPRITE_ATLAS_VERSION 1
+// 매핑한 주소는 페이지 경계이므로 픽셀 시작 위치를 맞추면 줄마다 캐시 라인 경계에서 시작
+#define SPRITE_ATLAS_ALIGNMENT 64
+
+typedef enum sprite_atlas_region
+{
+    SPRITE_ATLAS_REGION_TILES,
+    SPRITE_ATLAS_REGION_NUMBERS,
+    SPRITE_ATLAS_REGION_FACES,
+    SPRITE_ATLAS_NUM_REGIONS,
+} sprite_atlas_region_t;
+
+typedef struct sprite_atlas_rect
+{
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+} sprite_atlas_rect_t;
+
+typedef struct sprite_atlas_header
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t pitch;
+    uint32_t data_offset;
+    uint32_t a_mask;
+    uint32_t r_mask;
+    uint32_t g_mask;
+    uint32_t b_mask;
+    sprite_atlas_rect_t regions[SPRITE_ATLAS_NUM_REGIONS];
+} sprite_atlas_header_t;
+
+typedef struct sprite_atlas
+{
+    mapped_file_t file;
+
+    // 변환했을 때만, 아니면 NULL
+    char* pa_converted;
+
+    // A8R8G8B8, width == pitch / 4 (줄 끝을 채운 부분 포함)
+    const char* p_pixels;
+    uint32_t width;
+    uint32_t height;
+    size_t pitch;
+
+    sprite_atlas_rect_t regions[SPRITE_ATLAS_NUM_REGIONS];
+} sprite_atlas_t;
+
+START_EXTERN_C
+
+// 헤더, 채널 마스크 (8비트씩 겹치지 않게), 영역이 아틀라스 안인지, 파일 크기를 확인
+bool sprite_atlas_open(sprite_atlas_t* p_atlas, const char* p_path);
+void sprite_atlas_close(sprite_atlas_t* p_atlas);
+
+// 영역 왼쪽 위 픽셀, 한 줄은 p_atlas->pitch 바이트
+FORCEINLINE const char* sprite_atlas_get_region_pixels(const sprite_atlas_t* p_atlas, const sprite_atlas_region_t region)
+{
+    const sprite_atlas_rect_t* p_rect = &p_atlas->regions[region];
+    return p_atlas->p_pixels + (size_t)p_rect->y * p_atlas->pitch + (size_t)p_rect->x * sizeof(uint32_t);
+}
+
+END_EXTERN_C
+
+#endif // SPRITE_ATLAS_H
\ No newline at end of file
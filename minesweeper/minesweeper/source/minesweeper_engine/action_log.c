@@ -0,0 +1,273 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <string.h>
+
+#include "action_log.h"
+#include "safe99_common/assert.h"
+#include "varint.h"
+
+// 종류 1 + 시각 varint 10 + 내용 최대 varint 10 * 2
+#define MAX_RECORD_SIZE 32
+
+bool action_log_writer_open(action_log_writer_t* p_writer, const char* p_path, const engine_t* p_engine, const uint64_t now)
+{
+    ASSERT(p_writer != NULL, "p_writer == NULL");
+    ASSERT(p_path != NULL, "p_path == NULL");
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+
+    memset(p_writer, 0, sizeof(action_log_writer_t));
+
+    p_writer->p_file = fopen(p_path, "wb");
+    if (p_writer->p_file == NULL)
+    {
+        return false;
+    }
+
+    uint8_t header[64];
+    size_t size = 0;
+    header[size++] = 'M';
+    header[size++] = 'S';
+    header[size++] = 'A';
+    header[size++] = 'L';
+    header[size++] = ACTION_LOG_VERSION;
+    header[size++] = (uint8_t)p_engine->first_click;
+    size += varint_put(header + size, p_engine->rows);
+    size += varint_put(header + size, p_engine->cols);
+    size += varint_put(header + size, p_engine->num_max_mines);
+    size += varint_put_u64(header + size, p_engine->seed);
+
+    if (fwrite(header, 1, size, p_writer->p_file) != size)
+    {
+        fclose(p_writer->p_file);
+        memset(p_writer, 0, sizeof(action_log_writer_t));
+        return false;
+    }
+
+    p_writer->last_time = now;
+    return true;
+}
+
+void action_log_writer_write(action_log_writer_t* p_writer, const action_t* p_action)
+{
+    ASSERT(p_writer != NULL, "p_writer == NULL");
+    ASSERT(p_action != NULL, "p_action == NULL");
+    ASSERT(p_writer->p_file != NULL, "Not opened");
+
+    if (p_writer->b_failed)
+    {
+        return;
+    }
+
+    // 시각이 거꾸로 가면 0으로 기록
+    const uint64_t delta = (p_action->time > p_writer->last_time) ? p_action->time - p_writer->last_time : 0;
+
+    uint8_t record[MAX_RECORD_SIZE];
+    size_t size = 0;
+    record[size++] = (uint8_t)p_action->type;
+    size += varint_put(record + size, delta);
+
+    switch (p_action->type)
+    {
+    case ACTION_TYPE_OPEN:
+    case ACTION_TYPE_CYCLE_FLAG:
+        size += varint_put(record + size, p_action->x);
+        size += varint_put(record + size, p_action->y);
+        break;
+    case ACTION_TYPE_RESTART:
+        size += varint_put_u64(record + size, p_action->seed);
+        size += varint_put_u64(record + size, p_action->hash);
+        break;
+    case ACTION_TYPE_SET_SEED:
+        size += varint_put_u64(record + size, p_action->seed);
+        break;
+    default:
+        ASSERT(false, "Invalid action type");
+        return;
+    }
+
+    if (fwrite(record, 1, size, p_writer->p_file) != size)
+    {
+        p_writer->b_failed = true;
+        return;
+    }
+
+    p_writer->last_time += delta;
+    ++p_writer->num_actions;
+}
+
+bool action_log_writer_close(action_log_writer_t* p_writer, const engine_t* p_engine, const uint64_t now)
+{
+    ASSERT(p_writer != NULL, "p_writer == NULL");
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+    ASSERT(p_writer->p_file != NULL, "Not opened");
+
+    const uint64_t delta = (now > p_writer->last_time) ? now - p_writer->last_time : 0;
+
+    uint8_t record[MAX_RECORD_SIZE];
+    size_t size = 0;
+    record[size++] = (uint8_t)ACTION_TYPE_END;
+    size += varint_put(record + size, delta);
+    size += varint_put(record + size, p_writer->num_actions);
+    size += varint_put_u64(record + size, engine_get_hash(p_engine));
+
+    bool b_succeeded = !p_writer->b_failed && fwrite(record, 1, size, p_writer->p_file) == size;
+    b_succeeded = (fclose(p_writer->p_file) == 0) && b_succeeded;
+
+    memset(p_writer, 0, sizeof(action_log_writer_t));
+    return b_succeeded;
+}
+
+bool action_log_reader_open(action_log_reader_t* p_reader, const char* p_path)
+{
+    ASSERT(p_reader != NULL, "p_reader == NULL");
+    ASSERT(p_path != NULL, "p_path == NULL");
+
+    memset(p_reader, 0, sizeof(action_log_reader_t));
+
+    p_reader->p_file = fopen(p_path, "rb");
+    if (p_reader->p_file == NULL)
+    {
+        return false;
+    }
+
+    uint8_t magic[6];
+    if (fread(magic, 1, sizeof(magic), p_reader->p_file) != sizeof(magic)
+        || memcmp(magic, "MSAL", 4) != 0 || magic[4] != ACTION_LOG_VERSION || magic[5] > ENGINE_FIRST_CLICK_SAFE_AREA)
+    {
+        goto failed_read_header;
+    }
+
+    uint64_t rows;
+    uint64_t cols;
+    uint64_t num_mines;
+    if (!varint_read(p_reader->p_file, &rows)
+        || !varint_read(p_reader->p_file, &cols)
+        || !varint_read(p_reader->p_file, &num_mines)
+        || !varint_read_u64(p_reader->p_file, &p_reader->header.seed))
+    {
+        goto failed_read_header;
+    }
+
+    // 엔진이 만들 수 있는 판인지만 확인
+    if (rows == 0 || cols == 0 || rows > SIZE_MAX / cols || num_mines == 0 || num_mines >= rows * cols)
+    {
+        goto failed_read_header;
+    }
+
+    p_reader->header.rows = (size_t)rows;
+    p_reader->header.cols = (size_t)cols;
+    p_reader->header.num_mines = (size_t)num_mines;
+    p_reader->header.first_click = (engine_first_click_t)magic[5];
+
+    return true;
+
+failed_read_header:
+    fclose(p_reader->p_file);
+    memset(p_reader, 0, sizeof(action_log_reader_t));
+    return false;
+}
+
+void action_log_reader_close(action_log_reader_t* p_reader)
+{
+    ASSERT(p_reader != NULL, "p_reader == NULL");
+
+    if (p_reader->p_file != NULL)
+    {
+        fclose(p_reader->p_file);
+    }
+
+    memset(p_reader, 0, sizeof(action_log_reader_t));
+}
+
+bool action_log_reader_read(action_log_reader_t* p_reader, action_t* p_out_action)
+{
+    ASSERT(p_reader != NULL, "p_reader == NULL");
+    ASSERT(p_out_action != NULL, "p_out_action == NULL");
+    ASSERT(p_reader->p_file != NULL, "Not opened");
+
+    if (p_reader->b_ended)
+    {
+        return false;
+    }
+
+    const int type = fgetc(p_reader->p_file);
+
+    uint64_t delta;
+    if (type == EOF || !varint_read(p_reader->p_file, &delta))
+    {
+        return false;
+    }
+
+    memset(p_out_action, 0, sizeof(action_t));
+    p_out_action->type = (action_type_t)type;
+
+    uint64_t x;
+    uint64_t y;
+    switch (type)
+    {
+    case ACTION_TYPE_OPEN:
+    case ACTION_TYPE_CYCLE_FLAG:
+        if (!varint_read(p_reader->p_file, &x) || !varint_read(p_reader->p_file, &y)
+            || x >= p_reader->header.cols || y >= p_reader->header.rows)
+        {
+            return false;
+        }
+        p_out_action->x = (size_t)x;
+        p_out_action->y = (size_t)y;
+        break;
+    case ACTION_TYPE_RESTART:
+        if (!varint_read_u64(p_reader->p_file, &p_out_action->seed) || !varint_read_u64(p_reader->p_file, &p_out_action->hash))
+        {
+            return false;
+        }
+        break;
+    case ACTION_TYPE_SET_SEED:
+        if (!varint_read_u64(p_reader->p_file, &p_out_action->seed))
+        {
+            return false;
+        }
+        break;
+    case ACTION_TYPE_END:
+        if (!varint_read(p_reader->p_file, &p_out_action->num_actions) || !varint_read_u64(p_reader->p_file, &p_out_action->hash))
+        {
+            return false;
+        }
+        p_reader->b_ended = true;
+        break;
+    default:
+        return false;
+    }
+
+    p_reader->last_time += delta;
+    p_out_action->time = p_reader->last_time;
+
+    return true;
+}
+
+bool action_log_apply(engine_t* p_engine, const action_t* p_action)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+    ASSERT(p_action != NULL, "p_action == NULL");
+
+    switch (p_action->type)
+    {
+    case ACTION_TYPE_OPEN:
+        return engine_open(p_engine, p_action->x, p_action->y);
+    case ACTION_TYPE_CYCLE_FLAG:
+        return engine_cycle_flag(p_engine, p_action->x, p_action->y);
+    case ACTION_TYPE_RESTART:
+        if (engine_get_hash(p_engine) != p_action->hash)
+        {
+            return false;
+        }
+        engine_restart(p_engine, p_action->seed);
+        return true;
+    case ACTION_TYPE_SET_SEED:
+        return engine_set_seed(p_engine, p_action->seed);
+    case ACTION_TYPE_END:
+        return engine_get_hash(p_engine) == p_action->hash;
+    default:
+        ASSERT(false, "Invalid action type");
+        return false;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#ifndef ACTION_LOG_H
+#define ACTION_LOG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "engine.h"
+#include "safe99_common/defines.h"
+
+// 엔진에 적용한 행동을 시각과 함께 기록하는 바이너리 로그
+// 엔진만으로 다시 적용할 수 있으므로 창/입력 없이 최대 속도로 재생 가능
+//
+// 형식 (정수는 모두 리틀 엔디언)
+//   헤더: "MSAL" | 버전 u8 | 첫 클릭 u8 | rows varint | cols varint | num_mines varint | seed u64
+//   행동: 종류 u8 | 이전 행동과의 시각 차 (밀리초) varint | 내용
+//     OPEN, CYCLE_FLAG: x varint | y varint
+//     RESTART: seed u64 | 버리는 판의 상태 해시 u64 (engine_get_hash)
+//     SET_SEED: seed u64
+//     END: 행동 수 varint | 마지막 판 상태 해시 u64
+// 재시작마다 이전 판 해시를 남기므로 중간 판이 어긋나도 찾을 수 있음
+// varint는 varint.h
+
+#define ACTION_LOG_VERSION 1
+
+typedef enum action_type
+{
+    ACTION_TYPE_OPEN = 1,
+    ACTION_TYPE_CYCLE_FLAG,
+    ACTION_TYPE_RESTART,
+    // 첫 클릭 전에 시드만 바꿈 (추측 없는 판)
+    ACTION_TYPE_SET_SEED,
+    ACTION_TYPE_END,
+} action_type_t;
+
+typedef struct action
+{
+    action_type_t type;
+    uint64_t time;
+
+    size_t x;
+    size_t y;
+
+    // RESTART, SET_SEED
+    uint64_t seed;
+    // RESTART는 재시작 직전, END는 마지막 판 상태 해시
+    uint64_t hash;
+    // END만, 기록한 행동 수
+    uint64_t num_actions;
+} action_t;
+
+typedef struct action_log_header
+{
+    size_t rows;
+    size_t cols;
+    size_t num_mines;
+    engine_first_click_t first_click;
+    uint64_t seed;
+} action_log_header_t;
+
+typedef struct action_log_writer
+{
+    FILE* p_file;
+    uint64_t last_time;
+    uint64_t num_actions;
+    bool b_failed;
+} action_log_writer_t;
+
+typedef struct action_log_reader
+{
+    FILE* p_file;
+    action_log_header_t header;
+    uint64_t last_time;
+    bool b_ended;
+} action_log_reader_t;
+
+START_EXTERN_C
+
+// 현재 엔진의 크기/지뢰 개수/첫 클릭 방식/시드로 헤더를 씀
+// now는 기록을 시작한 시각, 첫 행동의 시각 차는 이 시각부터 잼
+bool action_log_writer_open(action_log_writer_t* p_writer, const char* p_path, const engine_t* p_engine, const uint64_t now);
+
+// 행동 하나 기록, 쓰기에 실패하면 이후 기록은 무시하고 close에서 false
+void action_log_writer_write(action_log_writer_t* p_writer, const action_t* p_action);
+
+// END를 쓰고 파일을 닫음
+bool action_log_writer_close(action_log_writer_t* p_writer, const engine_t* p_engine, const uint64_t now);
+
+bool action_log_reader_open(action_log_reader_t* p_reader, const char* p_path);
+void action_log_reader_close(action_log_reader_t* p_reader);
+
+// 다음 행동, 파일 끝이거나 형식이 잘못됐으면 false
+// END를 읽은 뒤에는 항상 false
+bool action_log_reader_read(action_log_reader_t* p_reader, action_t* p_out_action);
+
+// 헤더대로 만든 엔진에 행동 하나 적용
+// 기록할 때와 결과가 다르면 (열기/깃발이 무시됨, 지뢰를 배치한 뒤 시드 변경, RESTART/END 해시 불일치) false
+bool action_log_apply(engine_t* p_engine, const action_t* p_action);
+
+END_EXTERN_C
+
+#endif // ACTION_LOG_H
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include <string.h>
+
+#include "bitboard.h"
+
+#if defined(ENABLE_SSE_INTRINSICS)
+    #include <emmintrin.h>
+    #if defined(__AVX2__)
+        #include <immintrin.h>
+    #endif // __AVX2__
+#endif // ENABLE_SSE_INTRINSICS
+
+static void expand_planes(const uint64_t plane0, const uint64_t plane1, const uint64_t plane2, const uint64_t plane3, uint8_t* p_out);
+
+void bitboard_count_neighbours(const uint64_t* p_bits, const size_t num_words, const size_t rows, const size_t cols, uint8_t* p_counts, const size_t count_stride)
+{
+    ASSERT(p_bits != NULL, "p_bits == NULL");
+    ASSERT(p_counts != NULL, "p_counts == NULL");
+    ASSERT(num_words == bitboard_get_num_words(cols), "Invalid num_words");
+
+    uint8_t expanded[64];
+
+    for (size_t y = 0; y < rows; ++y)
+    {
+        const uint64_t* p_above = p_bits + y * num_words;
+        const uint64_t* p_center = p_above + num_words;
+        const uint64_t* p_below = p_center + num_words;
+
+        uint8_t* p_out = p_counts + (y + 1) * count_stride + 1;
+
+        for (size_t w = 0; w < num_words; ++w)
+        {
+            const bool b_has_prev = (w > 0);
+            const bool b_has_next = (w + 1 < num_words);
+
+            // x번째 비트에 (x - 1)번째 칸이 오도록 왼쪽 시프트, (x + 1)번째 칸은 오른쪽 시프트
+            const uint64_t above = p_above[w];
+            const uint64_t above_left = (above << 1) | (b_has_prev ? p_above[w - 1] >> 63 : 0);
+            const uint64_t above_right = (above >> 1) | (b_has_next ? p_above[w + 1] << 63 : 0);
+
+            const uint64_t center = p_center[w];
+            const uint64_t center_left = (center << 1) | (b_has_prev ? p_center[w - 1] >> 63 : 0);
+            const uint64_t center_right = (center >> 1) | (b_has_next ? p_center[w + 1] << 63 : 0);
+
+            const uint64_t below = p_below[w];
+            const uint64_t below_left = (below << 1) | (b_has_prev ? p_below[w - 1] >> 63 : 0);
+            const uint64_t below_right = (below >> 1) | (b_has_next ? p_below[w + 1] << 63 : 0);
+
+            // 위 3칸, 아래 3칸, 좌우 2칸을 각각 2비트 수로 더함
+            const uint64_t a0 = above_left ^ above ^ above_right;
+            const uint64_t a1 = (above_left & above) | (above_right & (above_left ^ above));
+            const uint64_t b0 = below_left ^ below ^ below_right;
+            const uint64_t b1 = (below_left & below) | (below_right & (below_left ^ below));
+            const uint64_t c0 = center_left ^ center_right;
+            const uint64_t c1 = center_left & center_right;
+
+            // (a1 a0) + (b1 b0) -> (s2 s1 s0)
+            const uint64_t s0 = a0 ^ b0;
+            const uint64_t k0 = a0 & b0;
+            const uint64_t s1 = a1 ^ b1 ^ k0;
+            const uint64_t s2 = (a1 & b1) | (k0 & (a1 ^ b1));
+
+            // (s2 s1 s0) + (c1 c0) -> (t3 t2 t1 t0)
+            const uint64_t t0 = s0 ^ c0;
+            const uint64_t j0 = s0 & c0;
+            const uint64_t t1 = s1 ^ c1 ^ j0;
+            const uint64_t j1 = (s1 & c1) | (j0 & (s1 ^ c1));
+            const uint64_t t2 = s2 ^ j1;
+            const uint64_t t3 = s2 & j1;
+
+            const size_t x = w * 64;
+            if (x + 64 <= cols)
+            {
+                expand_planes(t0, t1, t2, t3, p_out + x);
+            }
+            else
+            {
+                expand_planes(t0, t1, t2, t3, expanded);
+                memcpy(p_out + x, expanded, cols - x);
+            }
+        }
+    }
+}
+
+// 4개 비트 평면의 64칸을 칸당 1바이트 (plane0 | plane1 << 1 | plane2 << 2 | plane3 << 3)로 펼침
+static void expand_planes(const uint64_t plane0, const uint64_t plane1, const uint64_t plane2, const uint64_t plane3, uint8_t* p_out)
+{
+#if defined(ENABLE_SSE_INTRINSICS) && defined(__AVX2__)
+    const __m256i shuffle = _mm256_setr_epi8(
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+        2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+    const __m256i bit_mask = _mm256_set1_epi64x((long long)0x8040201008040201);
+
+    for (size_t i = 0; i < 64; i += 32)
+    {
+        __m256i sum = _mm256_setzero_si256();
+        const uint64_t planes[4] = { plane0, plane1, plane2, plane3 };
+        for (int k = 0; k < 4; ++k)
+        {
+            const __m256i bits = _mm256_shuffle_epi8(_mm256_set1_epi32((int)(uint32_t)(planes[k] >> i)), shuffle);
+            const __m256i is_set = _mm256_cmpeq_epi8(_mm256_and_si256(bits, bit_mask), bit_mask);
+            sum = _mm256_or_si256(sum, _mm256_and_si256(is_set, _mm256_set1_epi8((char)(1 << k))));
+        }
+        _mm256_storeu_si256((__m256i*)(p_out + i), sum);
+    }
+#elif defined(ENABLE_SSE_INTRINSICS)
+    const __m128i bit_mask = _mm_set_epi32((int)0x80402010, 0x08040201, (int)0x80402010, 0x08040201);
+
+    for (size_t i = 0; i < 64; i += 16)
+    {
+        __m128i sum = _mm_setzero_si128();
+        const uint64_t planes[4] = { plane0, plane1, plane2, plane3 };
+        for (int k = 0; k < 4; ++k)
+        {
+            // 16비트를 바이트 0~7은 하위 바이트, 8~15는 상위 바이트로 복제
+            __m128i bits = _mm_cvtsi32_si128((int)((planes[k] >> i) & 0xffff));
+            bits = _mm_unpacklo_epi8(bits, bits);
+            bits = _mm_unpacklo_epi16(bits, bits);
+            bits = _mm_unpacklo_epi32(bits, bits);
+
+            const __m128i is_set = _mm_cmpeq_epi8(_mm_and_si128(bits, bit_mask), bit_mask);
+            sum = _mm_or_si128(sum, _mm_and_si128(is_set, _mm_set1_epi8((char)(1 << k))));
+        }
+        _mm_storeu_si128((__m128i*)(p_out + i), sum);
+    }
+#else
+    for (size_t i = 0; i < 64; ++i)
+    {
+        p_out[i] = (uint8_t)(((plane0 >> i) & 1)
+            | (((plane1 >> i) & 1) << 1)
+            | (((plane2 >> i) & 1) << 2)
+            | (((plane3 >> i) & 1) << 3));
+    }
+#endif // ENABLE_SSE_INTRINSICS
+}
\ No newline at end of file
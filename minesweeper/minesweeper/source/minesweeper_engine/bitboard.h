@@ -0,0 +1,44 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "safe99_common/assert.h"
+#include "safe99_common/defines.h"
+
+// 칸 하나당 1비트인 평면
+// 한 줄은 num_words개의 uint64_t, x번째 칸은 (x / 64)번째 워드의 (x % 64)번째 비트
+// 맨 위/아래에 0으로 채운 줄이 하나씩 있으므로 (rows + 2) * num_words개 워드가 필요함
+// cols 이후의 비트는 항상 0이어야 함
+
+START_EXTERN_C
+
+FORCEINLINE size_t bitboard_get_num_words(const size_t cols)
+{
+    return (cols + 63) / 64;
+}
+
+FORCEINLINE bool bitboard_test(const uint64_t* p_bits, const size_t num_words, const size_t x, const size_t y)
+{
+    ASSERT(p_bits != NULL, "p_bits == NULL");
+    return (p_bits[(y + 1) * num_words + x / 64] >> (x % 64)) & 1;
+}
+
+FORCEINLINE void bitboard_set(uint64_t* p_bits, const size_t num_words, const size_t x, const size_t y)
+{
+    ASSERT(p_bits != NULL, "p_bits == NULL");
+    p_bits[(y + 1) * num_words + x / 64] |= (uint64_t)1 << (x % 64);
+}
+
+// 모든 칸의 인접 지뢰 개수를 테두리 포함 격자 p_counts의 안쪽 칸에 기록
+// 테두리 칸은 건드리지 않음
+//
+// 한 번에 64칸씩 위/현재/아래 줄을 좌우로 시프트한 8개 평면을 비트 단위 가산기로 더하고
+// SSE2/AVX2로 4개 비트 평면을 바이트로 펼침
+void bitboard_count_neighbours(const uint64_t* p_bits, const size_t num_words, const size_t rows, const size_t cols, uint8_t* p_counts, const size_t count_stride);
+
+END_EXTERN_C
+
+#endif // BITBOARD_H
\ No newline at end of file
@@ -0,0 +1,643 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bitboard.h"
+#include "board_codec.h"
+#include "safe99_common/assert.h"
+#include "varint.h"
+
+// 청크 칸 수가 2^16이므로 길이는 17비트 안에 들어감
+#define MAX_RICE_K 17
+#define RICE_K_BITS 5
+#define TILE_BITS 4
+
+// 읽은 헤더의 청크 칸 수 상한
+#define MAX_CHUNK_CELLS (1 << 24)
+
+#define IO_BUFFER_SIZE 4096
+
+// 바이트의 하위 비트부터 채움
+typedef struct bit_writer
+{
+    FILE* p_file;
+    uint64_t bits;
+    uint32_t num_bits;
+    size_t size;
+    bool b_failed;
+    uint8_t buffer[IO_BUFFER_SIZE];
+} bit_writer_t;
+
+// 청크 내용만 읽고 그 뒤는 건드리지 않으므로 스트림에 판이 여러 개 이어져 있어도 됨
+typedef struct bit_reader
+{
+    FILE* p_file;
+    // 파일에서 아직 읽지 않은 청크 바이트 수
+    uint64_t num_bytes_left;
+    size_t size;
+    size_t pos;
+    uint64_t bits;
+    uint32_t num_bits;
+    // 청크 처음부터 읽은 비트 수
+    uint64_t num_consumed_bits;
+    bool b_failed;
+    uint8_t buffer[IO_BUFFER_SIZE];
+} bit_reader_t;
+
+static bool write_tile_chunk(bit_writer_t* p_writer, const engine_t* p_engine, const size_t begin, const size_t end);
+static bool write_mine_chunk(bit_writer_t* p_writer, const engine_t* p_engine, const size_t begin, const size_t end);
+static bool read_tile_chunk(FILE* p_file, engine_t* p_engine, const size_t begin, const size_t end, size_t* p_num_opened);
+static bool read_mine_chunk(FILE* p_file, engine_t* p_engine, const size_t begin, const size_t end, size_t* p_num_mines);
+
+static size_t find_next_mine(const engine_t* p_engine, size_t index, const size_t end);
+static uint32_t get_best_rice_k(const uint64_t* p_costs);
+static void add_rice_costs(uint64_t* p_costs, const uint64_t value);
+static uint32_t count_bits(const uint64_t bits);
+
+static void write_bits(bit_writer_t* p_writer, const uint64_t value, const uint32_t num_bits);
+static void write_rice(bit_writer_t* p_writer, const uint64_t value, const uint32_t k);
+static void write_bytes(bit_writer_t* p_writer, const uint8_t* p_bytes, const size_t size);
+static void align_writer(bit_writer_t* p_writer);
+static bool flush_writer(bit_writer_t* p_writer);
+
+static void init_reader(bit_reader_t* p_reader, FILE* p_file, const uint64_t num_bytes);
+static bool read_bits(bit_reader_t* p_reader, const uint32_t num_bits, uint64_t* p_out_value);
+static bool read_rice(bit_reader_t* p_reader, const uint32_t k, const uint64_t max_value, uint64_t* p_out_value);
+
+bool board_codec_write(FILE* p_file, const engine_t* p_engine)
+{
+    ASSERT(p_file != NULL, "p_file == NULL");
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+
+    // 버퍼가 커서 스택에 두지 않음
+    bit_writer_t* pa_writer = (bit_writer_t*)malloc(sizeof(bit_writer_t));
+    if (pa_writer == NULL)
+    {
+        return false;
+    }
+    memset(pa_writer, 0, offsetof(bit_writer_t, buffer));
+    pa_writer->p_file = p_file;
+
+    const int64_t num_mines = p_engine->num_mines;
+    const uint64_t zigzag_num_mines = ((uint64_t)num_mines << 1) ^ (uint64_t)(num_mines >> 63);
+
+    uint8_t header[80];
+    size_t size = 0;
+    header[size++] = 'M';
+    header[size++] = 'S';
+    header[size++] = 'B';
+    header[size++] = 'C';
+    header[size++] = BOARD_CODEC_VERSION;
+    header[size++] = p_engine->b_mines_placed ? 1 : 0;
+    header[size++] = (uint8_t)p_engine->first_click;
+    header[size++] = (uint8_t)p_engine->status;
+    size += varint_put(header + size, p_engine->rows);
+    size += varint_put(header + size, p_engine->cols);
+    size += varint_put(header + size, p_engine->num_max_mines);
+    size += varint_put(header + size, zigzag_num_mines);
+    size += varint_put(header + size, p_engine->num_tiles);
+    size += varint_put(header + size, BOARD_CODEC_CHUNK_CELLS);
+    size += varint_put_u64(header + size, p_engine->seed);
+    write_bytes(pa_writer, header, size);
+
+    const size_t num_cells = p_engine->rows * p_engine->cols;
+    for (size_t begin = 0; begin < num_cells && !pa_writer->b_failed; begin += BOARD_CODEC_CHUNK_CELLS)
+    {
+        const size_t end = (num_cells - begin > BOARD_CODEC_CHUNK_CELLS) ? begin + BOARD_CODEC_CHUNK_CELLS : num_cells;
+        write_tile_chunk(pa_writer, p_engine, begin, end);
+    }
+
+    if (p_engine->b_mines_placed)
+    {
+        for (size_t begin = 0; begin < num_cells && !pa_writer->b_failed; begin += BOARD_CODEC_CHUNK_CELLS)
+        {
+            const size_t end = (num_cells - begin > BOARD_CODEC_CHUNK_CELLS) ? begin + BOARD_CODEC_CHUNK_CELLS : num_cells;
+            write_mine_chunk(pa_writer, p_engine, begin, end);
+        }
+    }
+
+    const bool b_succeeded = flush_writer(pa_writer);
+    free(pa_writer);
+
+    return b_succeeded;
+}
+
+bool board_codec_read(FILE* p_file, engine_t* p_out_engine)
+{
+    ASSERT(p_file != NULL, "p_file == NULL");
+    ASSERT(p_out_engine != NULL, "p_out_engine == NULL");
+
+    uint8_t magic[8];
+    if (fread(magic, 1, sizeof(magic), p_file) != sizeof(magic)
+        || memcmp(magic, "MSBC", 4) != 0 || magic[4] != BOARD_CODEC_VERSION
+        || magic[5] > 1 || magic[6] > ENGINE_FIRST_CLICK_SAFE_AREA || magic[7] > ENGINE_STATUS_LOST)
+    {
+        return false;
+    }
+
+    uint64_t rows;
+    uint64_t cols;
+    uint64_t num_max_mines;
+    uint64_t zigzag_num_mines;
+    uint64_t num_tiles;
+    uint64_t chunk_cells;
+    uint64_t seed;
+    if (!varint_read(p_file, &rows)
+        || !varint_read(p_file, &cols)
+        || !varint_read(p_file, &num_max_mines)
+        || !varint_read(p_file, &zigzag_num_mines)
+        || !varint_read(p_file, &num_tiles)
+        || !varint_read(p_file, &chunk_cells)
+        || !varint_read_u64(p_file, &seed))
+    {
+        return false;
+    }
+
+    const bool b_mines_placed = magic[5] != 0;
+    const int64_t num_mines = (int64_t)(zigzag_num_mines >> 1) ^ -(int64_t)(zigzag_num_mines & 1);
+
+    // 엔진이 만들 수 있는 판인지, 지뢰를 배치하기 전에는 진행 중이어야 함
+    if (rows == 0 || cols == 0 || rows > UINT32_MAX || cols > UINT32_MAX || rows * cols > SIZE_MAX / 16
+        || num_max_mines == 0 || num_max_mines >= rows * cols
+        || num_mines > (int64_t)num_max_mines || num_mines < (int64_t)num_max_mines - (int64_t)(rows * cols)
+        || num_tiles > rows * cols
+        || chunk_cells == 0 || chunk_cells > MAX_CHUNK_CELLS
+        || (!b_mines_placed && magic[7] != ENGINE_STATUS_PLAYING))
+    {
+        return false;
+    }
+
+    if (!engine_init(p_out_engine, (size_t)rows, (size_t)cols, (size_t)num_max_mines, seed))
+    {
+        return false;
+    }
+
+    const size_t num_cells = (size_t)(rows * cols);
+
+    size_t num_opened = 0;
+    for (size_t begin = 0; begin < num_cells; begin += (size_t)chunk_cells)
+    {
+        const size_t end = (num_cells - begin > chunk_cells) ? begin + (size_t)chunk_cells : num_cells;
+        if (!read_tile_chunk(p_file, p_out_engine, begin, end, &num_opened))
+        {
+            goto failed_read;
+        }
+    }
+
+    if (num_cells - num_opened != num_tiles)
+    {
+        goto failed_read;
+    }
+
+    if (b_mines_placed)
+    {
+        memset(p_out_engine->pa_mine_bits, 0, sizeof(uint64_t) * (p_out_engine->rows + 2) * p_out_engine->num_mine_words);
+
+        size_t num_found_mines = 0;
+        for (size_t begin = 0; begin < num_cells; begin += (size_t)chunk_cells)
+        {
+            const size_t end = (num_cells - begin > chunk_cells) ? begin + (size_t)chunk_cells : num_cells;
+            if (!read_mine_chunk(p_file, p_out_engine, begin, end, &num_found_mines))
+            {
+                goto failed_read;
+            }
+        }
+
+        if (num_found_mines != num_max_mines)
+        {
+            goto failed_read;
+        }
+
+        engine_load_mines(p_out_engine);
+    }
+
+    p_out_engine->num_mines = num_mines;
+    p_out_engine->num_tiles = (size_t)num_tiles;
+    p_out_engine->first_click = (engine_first_click_t)magic[6];
+    p_out_engine->status = (engine_status_t)magic[7];
+
+    return true;
+
+failed_read:
+    engine_release(p_out_engine);
+    return false;
+}
+
+// 같은 타일이 이어지는 구간마다 (타일, 길이)
+static bool write_tile_chunk(bit_writer_t* p_writer, const engine_t* p_engine, const size_t begin, const size_t end)
+{
+    uint64_t costs[MAX_RICE_K + 1] = { 0 };
+    uint64_t num_runs = 0;
+    for (size_t i = begin; i < end;)
+    {
+        const tile_t tile = engine_get_tile_at(p_engine, i);
+        size_t run_end = i + 1;
+        while (run_end < end && engine_get_tile_at(p_engine, run_end) == tile)
+        {
+            ++run_end;
+        }
+
+        add_rice_costs(costs, run_end - i - 1);
+        ++num_runs;
+        i = run_end;
+    }
+
+    const uint32_t k = get_best_rice_k(costs);
+
+    uint8_t length[VARINT_MAX_SIZE];
+    write_bytes(p_writer, length, varint_put(length, RICE_K_BITS + num_runs * TILE_BITS + costs[k]));
+    write_bits(p_writer, k, RICE_K_BITS);
+
+    for (size_t i = begin; i < end;)
+    {
+        const tile_t tile = engine_get_tile_at(p_engine, i);
+        size_t run_end = i + 1;
+        while (run_end < end && engine_get_tile_at(p_engine, run_end) == tile)
+        {
+            ++run_end;
+        }
+
+        write_bits(p_writer, (uint64_t)tile, TILE_BITS);
+        write_rice(p_writer, run_end - i - 1, k);
+        i = run_end;
+    }
+
+    align_writer(p_writer);
+    return !p_writer->b_failed;
+}
+
+// 지뢰 사이의 빈칸 수, 마지막은 청크 끝까지
+static bool write_mine_chunk(bit_writer_t* p_writer, const engine_t* p_engine, const size_t begin, const size_t end)
+{
+    uint64_t costs[MAX_RICE_K + 1] = { 0 };
+    size_t pos = begin;
+    for (size_t mine = find_next_mine(p_engine, begin, end); mine < end; mine = find_next_mine(p_engine, pos, end))
+    {
+        add_rice_costs(costs, mine - pos);
+        pos = mine + 1;
+    }
+    add_rice_costs(costs, end - pos);
+
+    const uint32_t k = get_best_rice_k(costs);
+
+    uint8_t length[VARINT_MAX_SIZE];
+    write_bytes(p_writer, length, varint_put(length, RICE_K_BITS + costs[k]));
+    write_bits(p_writer, k, RICE_K_BITS);
+
+    pos = begin;
+    for (size_t mine = find_next_mine(p_engine, begin, end); mine < end; mine = find_next_mine(p_engine, pos, end))
+    {
+        write_rice(p_writer, mine - pos, k);
+        pos = mine + 1;
+    }
+    write_rice(p_writer, end - pos, k);
+
+    align_writer(p_writer);
+    return !p_writer->b_failed;
+}
+
+static bool read_tile_chunk(FILE* p_file, engine_t* p_engine, const size_t begin, const size_t end, size_t* p_num_opened)
+{
+    uint64_t num_bits;
+    if (!varint_read(p_file, &num_bits) || num_bits > UINT64_MAX - 7)
+    {
+        return false;
+    }
+
+    bit_reader_t* pa_reader = (bit_reader_t*)malloc(sizeof(bit_reader_t));
+    if (pa_reader == NULL)
+    {
+        return false;
+    }
+    init_reader(pa_reader, p_file, (num_bits + 7) / 8);
+
+    uint64_t k;
+    if (!read_bits(pa_reader, RICE_K_BITS, &k) || k > MAX_RICE_K)
+    {
+        goto failed_read;
+    }
+
+    // 0세대로 만든 엔진이므로 타일 값 그대로
+    uint32_t* p_tiles = p_engine->pa_tiles;
+    size_t num_opened = 0;
+    for (size_t i = begin; i < end;)
+    {
+        uint64_t tile;
+        uint64_t length;
+        if (!read_bits(pa_reader, TILE_BITS, &tile) || !read_rice(pa_reader, (uint32_t)k, end - i - 1, &length))
+        {
+            goto failed_read;
+        }
+
+        const size_t run_end = i + (size_t)length + 1;
+        if (tile == TILE_OPEN || tile >= TILE_1)
+        {
+            num_opened += run_end - i;
+        }
+
+        for (; i < run_end; ++i)
+        {
+            p_tiles[i] = (uint32_t)tile;
+        }
+    }
+
+    if (pa_reader->num_consumed_bits != num_bits)
+    {
+        goto failed_read;
+    }
+
+    // 청크 끝의 채운 비트
+    uint64_t padding;
+    if (num_bits % 8 != 0 && !read_bits(pa_reader, 8 - (uint32_t)(num_bits % 8), &padding))
+    {
+        goto failed_read;
+    }
+
+    free(pa_reader);
+    *p_num_opened += num_opened;
+    return true;
+
+failed_read:
+    free(pa_reader);
+    return false;
+}
+
+static bool read_mine_chunk(FILE* p_file, engine_t* p_engine, const size_t begin, const size_t end, size_t* p_num_mines)
+{
+    uint64_t num_bits;
+    if (!varint_read(p_file, &num_bits) || num_bits > UINT64_MAX - 7)
+    {
+        return false;
+    }
+
+    bit_reader_t* pa_reader = (bit_reader_t*)malloc(sizeof(bit_reader_t));
+    if (pa_reader == NULL)
+    {
+        return false;
+    }
+    init_reader(pa_reader, p_file, (num_bits + 7) / 8);
+
+    uint64_t k;
+    if (!read_bits(pa_reader, RICE_K_BITS, &k) || k > MAX_RICE_K)
+    {
+        goto failed_read;
+    }
+
+    const size_t cols = p_engine->cols;
+    size_t num_mines = *p_num_mines;
+    size_t pos = begin;
+    while (true)
+    {
+        uint64_t gap;
+        if (!read_rice(pa_reader, (uint32_t)k, end - pos, &gap))
+        {
+            goto failed_read;
+        }
+
+        pos += (size_t)gap;
+        if (pos == end)
+        {
+            break;
+        }
+
+        if (num_mines == p_engine->num_max_mines)
+        {
+            goto failed_read;
+        }
+
+        bitboard_set(p_engine->pa_mine_bits, p_engine->num_mine_words, pos % cols, pos / cols);
+        p_engine->pa_mine_indices[num_mines++] = pos;
+        ++pos;
+    }
+
+    if (pa_reader->num_consumed_bits != num_bits)
+    {
+        goto failed_read;
+    }
+
+    uint64_t padding;
+    if (num_bits % 8 != 0 && !read_bits(pa_reader, 8 - (uint32_t)(num_bits % 8), &padding))
+    {
+        goto failed_read;
+    }
+
+    free(pa_reader);
+    *p_num_mines = num_mines;
+    return true;
+
+failed_read:
+    free(pa_reader);
+    return false;
+}
+
+// [index, end)에서 첫 지뢰, 없으면 end
+// 한 줄의 cols 이후 비트는 항상 0이므로 워드 단위로 건너뜀
+static size_t find_next_mine(const engine_t* p_engine, size_t index, const size_t end)
+{
+    const size_t cols = p_engine->cols;
+    const size_t num_words = p_engine->num_mine_words;
+
+    while (index < end)
+    {
+        const size_t y = index / cols;
+        const size_t x = index % cols;
+
+        const uint64_t bits = p_engine->pa_mine_bits[(y + 1) * num_words + x / 64] & (~(uint64_t)0 << (x % 64));
+        if (bits != 0)
+        {
+            const size_t found = y * cols + (x & ~(size_t)63) + count_bits((bits & (~bits + 1)) - 1);
+            return (found < end) ? found : end;
+        }
+
+        const size_t next_x = (x | 63) + 1;
+        index = (next_x < cols) ? y * cols + next_x : (y + 1) * cols;
+    }
+
+    return end;
+}
+
+static uint32_t get_best_rice_k(const uint64_t* p_costs)
+{
+    uint32_t best_k = 0;
+    for (uint32_t k = 1; k <= MAX_RICE_K; ++k)
+    {
+        if (p_costs[k] < p_costs[best_k])
+        {
+            best_k = k;
+        }
+    }
+
+    return best_k;
+}
+
+// k마다 Rice 부호 길이를 더함
+static void add_rice_costs(uint64_t* p_costs, const uint64_t value)
+{
+    for (uint32_t k = 0; k <= MAX_RICE_K; ++k)
+    {
+        p_costs[k] += (value >> k) + 1 + k;
+    }
+}
+
+static uint32_t count_bits(const uint64_t bits)
+{
+#if defined(__GNUC__)
+    return (uint32_t)__builtin_popcountll(bits);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return (uint32_t)__popcnt64(bits);
+#else
+    uint64_t x = bits - ((bits >> 1) & 0x5555555555555555);
+    x = (x & 0x3333333333333333) + ((x >> 2) & 0x3333333333333333);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0f;
+    return (uint32_t)((x * 0x0101010101010101) >> 56);
+#endif // __GNUC__
+}
+
+// num_bits는 32 이하
+static void write_bits(bit_writer_t* p_writer, const uint64_t value, const uint32_t num_bits)
+{
+    ASSERT(num_bits <= 32, "num_bits > 32");
+
+    p_writer->bits |= (value & (((uint64_t)1 << num_bits) - 1)) << p_writer->num_bits;
+    p_writer->num_bits += num_bits;
+
+    while (p_writer->num_bits >= 8)
+    {
+        if (p_writer->size == IO_BUFFER_SIZE)
+        {
+            flush_writer(p_writer);
+        }
+
+        p_writer->buffer[p_writer->size++] = (uint8_t)p_writer->bits;
+        p_writer->bits >>= 8;
+        p_writer->num_bits -= 8;
+    }
+}
+
+static void write_rice(bit_writer_t* p_writer, const uint64_t value, const uint32_t k)
+{
+    uint64_t quotient = value >> k;
+    while (quotient >= 32)
+    {
+        write_bits(p_writer, 0xffffffff, 32);
+        quotient -= 32;
+    }
+
+    // 1비트 quotient개 뒤에 0
+    write_bits(p_writer, ((uint64_t)1 << quotient) - 1, (uint32_t)quotient + 1);
+    if (k > 0)
+    {
+        write_bits(p_writer, value, k);
+    }
+}
+
+// 바이트 경계에서만 호출
+static void write_bytes(bit_writer_t* p_writer, const uint8_t* p_bytes, const size_t size)
+{
+    ASSERT(p_writer->num_bits == 0, "Not aligned");
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        write_bits(p_writer, p_bytes[i], 8);
+    }
+}
+
+static void align_writer(bit_writer_t* p_writer)
+{
+    if (p_writer->num_bits > 0)
+    {
+        write_bits(p_writer, 0, 8 - p_writer->num_bits);
+    }
+}
+
+// 실패한 뒤로는 버퍼만 비움
+static bool flush_writer(bit_writer_t* p_writer)
+{
+    if (!p_writer->b_failed && fwrite(p_writer->buffer, 1, p_writer->size, p_writer->p_file) != p_writer->size)
+    {
+        p_writer->b_failed = true;
+    }
+
+    p_writer->size = 0;
+    return !p_writer->b_failed;
+}
+
+static void init_reader(bit_reader_t* p_reader, FILE* p_file, const uint64_t num_bytes)
+{
+    memset(p_reader, 0, offsetof(bit_reader_t, buffer));
+    p_reader->p_file = p_file;
+    p_reader->num_bytes_left = num_bytes;
+}
+
+// num_bits는 32 이하
+static bool read_bits(bit_reader_t* p_reader, const uint32_t num_bits, uint64_t* p_out_value)
+{
+    ASSERT(num_bits <= 32, "num_bits > 32");
+
+    while (p_reader->num_bits < num_bits)
+    {
+        if (p_reader->pos == p_reader->size)
+        {
+            const size_t size = (p_reader->num_bytes_left < IO_BUFFER_SIZE) ? (size_t)p_reader->num_bytes_left : IO_BUFFER_SIZE;
+            if (p_reader->b_failed || size == 0 || fread(p_reader->buffer, 1, size, p_reader->p_file) != size)
+            {
+                p_reader->b_failed = true;
+                return false;
+            }
+
+            p_reader->num_bytes_left -= size;
+            p_reader->size = size;
+            p_reader->pos = 0;
+        }
+
+        p_reader->bits |= (uint64_t)p_reader->buffer[p_reader->pos++] << p_reader->num_bits;
+        p_reader->num_bits += 8;
+    }
+
+    *p_out_value = p_reader->bits & (((uint64_t)1 << num_bits) - 1);
+    p_reader->bits >>= num_bits;
+    p_reader->num_bits -= num_bits;
+    p_reader->num_consumed_bits += num_bits;
+
+    return true;
+}
+
+// max_value보다 크면 false
+static bool read_rice(bit_reader_t* p_reader, const uint32_t k, const uint64_t max_value, uint64_t* p_out_value)
+{
+    uint64_t quotient = 0;
+    uint64_t bit;
+    while (true)
+    {
+        if (!read_bits(p_reader, 1, &bit))
+        {
+            return false;
+        }
+
+        if (bit == 0)
+        {
+            break;
+        }
+
+        if (++quotient > (max_value >> k))
+        {
+            return false;
+        }
+    }
+
+    uint64_t remainder = 0;
+    if (k > 0 && !read_bits(p_reader, k, &remainder))
+    {
+        return false;
+    }
+
+    const uint64_t value = (quotient << k) | remainder;
+    if (value > max_value)
+    {
+        return false;
+    }
+
+    *p_out_value = value;
+    return true;
+}
\ No newline at end of file
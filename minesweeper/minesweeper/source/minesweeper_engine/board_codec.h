@@ -0,0 +1,44 @@
+#ifndef BOARD_CODEC_H
+#define BOARD_CODEC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "engine.h"
+#include "safe99_common/defines.h"
+
+// 판 (타일 평면 + 지뢰 평면)을 압축해서 저장하거나 다른 프로세스로 넘기는 형식
+// 청크 (BOARD_CODEC_CHUNK_CELLS칸, 타일 인덱스 순서) 단위로 엔진 배열을 바로 읽고 쓰므로
+// 판 크기만 한 버퍼를 따로 잡지 않고, 파이프처럼 되감을 수 없는 스트림에도 쓸 수 있음
+//
+// 형식 (정수는 모두 리틀 엔디언, varint는 varint.h)
+//   헤더: "MSBC" | 버전 u8 | 지뢰 배치 여부 u8 | 첫 클릭 u8 | 상태 u8
+//         rows varint | cols varint | num_max_mines varint | 남은 지뢰 표시 (지그재그) varint | 열지 않은 타일 수 varint
+//         청크 칸 수 varint | seed u64
+//   타일 청크들, 지뢰를 배치했으면 이어서 지뢰 청크들
+//   청크: 내용 비트 수 varint | 내용 (바이트 단위로 채움)
+//     타일 청크 내용: k (5비트) | (타일 4비트 | Rice_k(같은 타일 길이 - 1))...
+//     지뢰 청크 내용: k (5비트) | Rice_k(다음 지뢰까지 지뢰가 아닌 칸 수)..., 마지막은 청크 끝까지의 칸 수
+//   Rice_k(v): v >> k를 1비트 개수로 쓰고 0으로 끝낸 뒤 하위 k비트, 비트는 바이트의 하위 비트부터 채움
+//   k는 청크마다 내용이 가장 짧아지는 값을 고름
+//
+// 세대가 지난 타일은 TILE_BLIND로 씀, 읽은 판은 0세대
+
+#define BOARD_CODEC_VERSION 1
+#define BOARD_CODEC_CHUNK_CELLS 65536
+
+START_EXTERN_C
+
+// 청크마다 두 번 훑음 (k 고르기, 쓰기)
+// 쓰기에 실패하면 false
+bool board_codec_write(FILE* p_file, const engine_t* p_engine);
+
+// p_out_engine은 초기화하지 않은 엔진이어야 하고, 실패하면 만들지 않음
+// 형식이 잘못됐거나 헤더의 지뢰/열지 않은 타일 수가 내용과 다르면 false
+bool board_codec_read(FILE* p_file, engine_t* p_out_engine);
+
+END_EXTERN_C
+
+#endif // BOARD_CODEC_H
\ No newline at end of file
@@ -0,0 +1,625 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "bitboard.h"
+#include "chunk_board.h"
+#include "random.h"
+#include "safe99_common/assert.h"
+#include "safe99_common/safe_delete.h"
+
+// 처음에 잡아 둘 청크 개수, map/풀은 필요하면 늘어남
+#define INITIAL_NUM_CHUNKS 1024
+#define NUM_CHUNKS_PER_POOL_BLOCK 64
+#define INITIAL_NUM_FRONTIER 4096
+
+// 이웃 청크 한 칸씩을 포함한 (64 + 2) x (64 + 2) 격자
+#define HALO_SIZE (CHUNK_BOARD_CHUNK_SIZE + 2)
+#define HALO_NUM_WORDS 2
+#define HALO_COUNT_STRIDE (HALO_SIZE + 2)
+
+static bool is_valid_position(const int64_t x, const int64_t y);
+
+// 음수 좌표도 산술 시프트로 내림
+static FORCEINLINE int64_t get_chunk_coord(const int64_t coord);
+static FORCEINLINE size_t get_local_index(const int64_t x, const int64_t y);
+
+static uint64_t get_chunk_hash(const void* p_key, const size_t key_size);
+static board_chunk_t* find_chunk_or_null(chunk_board_t* p_board, const int64_t chunk_x, const int64_t chunk_y);
+static board_chunk_t* get_chunk_or_null(chunk_board_t* p_board, const int64_t chunk_x, const int64_t chunk_y);
+static void release_chunk(chunk_board_t* p_board, board_chunk_t* p_chunk);
+
+static void make_chunk_mines(const chunk_board_t* p_board, const int64_t chunk_x, const int64_t chunk_y, uint64_t* p_out_mine_bits);
+static void make_chunk_counts(const chunk_board_t* p_board, board_chunk_t* p_chunk);
+
+static bool open_cell(chunk_board_t* p_board, board_chunk_t* p_chunk, const size_t index);
+static bool push_frontier(chunk_board_t* p_board, const int64_t x, const int64_t y);
+static void expand_frontier(chunk_board_t* p_board);
+static void reveal_mines(chunk_board_t* p_board);
+
+bool chunk_board_init(chunk_board_t* p_board, const uint64_t seed, const uint32_t num_mines_per_chunk, const size_t open_budget)
+{
+    ASSERT(p_board != NULL, "p_board == NULL");
+    ASSERT(num_mines_per_chunk > 0, "num_mines_per_chunk == 0");
+    ASSERT(num_mines_per_chunk < CHUNK_BOARD_NUM_CHUNK_TILES, "num_mines_per_chunk >= CHUNK_BOARD_NUM_CHUNK_TILES");
+
+    memset(p_board, 0, sizeof(chunk_board_t));
+
+    p_board->seed = seed;
+    p_board->num_mines_per_chunk = num_mines_per_chunk;
+    p_board->open_budget = open_budget;
+    p_board->status = ENGINE_STATUS_PLAYING;
+
+    if (!flat_map_init(&p_board->chunk_map, sizeof(chunk_key_t), sizeof(board_chunk_t*), INITIAL_NUM_CHUNKS, get_chunk_hash))
+    {
+        ASSERT(false, "Failed to init chunk map");
+        goto failed_init_chunk_map;
+    }
+
+    if (!memory_pool_init(&p_board->chunk_pool, sizeof(board_chunk_t), NUM_CHUNKS_PER_POOL_BLOCK))
+    {
+        ASSERT(false, "Failed to init chunk pool");
+        goto failed_init_chunk_pool;
+    }
+
+    p_board->num_max_frontier = INITIAL_NUM_FRONTIER;
+    p_board->pa_frontier = (chunk_board_position_t*)malloc(sizeof(chunk_board_position_t) * p_board->num_max_frontier);
+    if (p_board->pa_frontier == NULL)
+    {
+        ASSERT(false, "Failed to malloc frontier");
+        goto failed_malloc_frontier;
+    }
+
+    return true;
+
+failed_malloc_frontier:
+    memory_pool_release(&p_board->chunk_pool);
+
+failed_init_chunk_pool:
+    flat_map_release(&p_board->chunk_map);
+
+failed_init_chunk_map:
+    memset(p_board, 0, sizeof(chunk_board_t));
+    return false;
+}
+
+void chunk_board_release(chunk_board_t* p_board)
+{
+    ASSERT(p_board != NULL, "p_board == NULL");
+
+    SAFE_FREE(p_board->pa_frontier);
+    memory_pool_release(&p_board->chunk_pool);
+    flat_map_release(&p_board->chunk_map);
+
+    memset(p_board, 0, sizeof(chunk_board_t));
+}
+
+void chunk_board_restart(chunk_board_t* p_board, const uint64_t seed)
+{
+    ASSERT(p_board != NULL, "p_board == NULL");
+
+    flat_map_clear(&p_board->chunk_map);
+    memory_pool_reset(&p_board->chunk_pool);
+    p_board->p_last_chunk = NULL;
+
+    p_board->seed = seed;
+    p_board->b_safe_set = false;
+    p_board->num_frontier = 0;
+    p_board->num_opened = 0;
+    p_board->num_flags = 0;
+    p_board->status = ENGINE_STATUS_PLAYING;
+}
+
+bool chunk_board_open(chunk_board_t* p_board, const int64_t x, const int64_t y)
+{
+    ASSERT(p_board != NULL, "p_board == NULL");
+
+    if (p_board->status != ENGINE_STATUS_PLAYING || !is_valid_position(x, y))
+    {
+        return false;
+    }
+
+    // 첫 번째 열기: 안전 지점을 정하고 이미 할당한 주변 청크의 지뢰를 다시 만듦
+    if (!p_board->b_safe_set)
+    {
+        p_board->safe_x = x;
+        p_board->safe_y = y;
+        p_board->b_safe_set = true;
+
+        const int64_t safe_chunk_x = get_chunk_coord(x);
+        const int64_t safe_chunk_y = get_chunk_coord(y);
+
+        size_t slot = 0;
+        void* p_value;
+        while (flat_map_get_next(&p_board->chunk_map, &slot, NULL, &p_value))
+        {
+            board_chunk_t* p_chunk = *(board_chunk_t**)p_value;
+            if (p_chunk->key.chunk_x >= safe_chunk_x - 1 && p_chunk->key.chunk_x <= safe_chunk_x + 1
+                && p_chunk->key.chunk_y >= safe_chunk_y - 1 && p_chunk->key.chunk_y <= safe_chunk_y + 1)
+            {
+                make_chunk_counts(p_board, p_chunk);
+            }
+        }
+    }
+
+    board_chunk_t* p_chunk = get_chunk_or_null(p_board, get_chunk_coord(x), get_chunk_coord(y));
+    if (p_chunk == NULL)
+    {
+        return false;
+    }
+
+    const size_t index = get_local_index(x, y);
+
+    const tile_t tile = (tile_t)p_chunk->tiles[index];
+    if (tile != TILE_BLIND && tile != TILE_UNKNOWN)
+    {
+        return false;
+    }
+
+    // 지뢰일 경우
+    if ((p_chunk->mine_bits[index / CHUNK_BOARD_CHUNK_SIZE] >> (index % CHUNK_BOARD_CHUNK_SIZE)) & 1)
+    {
+        reveal_mines(p_board);
+
+        p_chunk->tiles[index] = TILE_GAMEOVER_MINE;
+        p_board->num_frontier = 0;
+        p_board->status = ENGINE_STATUS_LOST;
+
+        return true;
+    }
+
+    open_cell(p_board, p_chunk, index);
+    if (p_chunk->counts[index] == 0)
+    {
+        push_frontier(p_board, x, y);
+        expand_frontier(p_board);
+    }
+
+    return true;
+}
+
+bool chunk_board_continue(chunk_board_t* p_board)
+{
+    ASSERT(p_board != NULL, "p_board == NULL");
+
+    if (p_board->num_frontier == 0)
+    {
+        return false;
+    }
+
+    expand_frontier(p_board);
+    return true;
+}
+
+bool chunk_board_has_pending(const chunk_board_t* p_board)
+{
+    ASSERT(p_board != NULL, "p_board == NULL");
+    return p_board->num_frontier > 0;
+}
+
+bool chunk_board_cycle_flag(chunk_board_t* p_board, const int64_t x, const int64_t y)
+{
+    ASSERT(p_board != NULL, "p_board == NULL");
+
+    if (p_board->status != ENGINE_STATUS_PLAYING || !is_valid_position(x, y))
+    {
+        return false;
+    }
+
+    board_chunk_t* p_chunk = get_chunk_or_null(p_board, get_chunk_coord(x), get_chunk_coord(y));
+    if (p_chunk == NULL)
+    {
+        return false;
+    }
+
+    const size_t index = get_local_index(x, y);
+
+    switch ((tile_t)p_chunk->tiles[index])
+    {
+    case TILE_BLIND:
+        ++p_board->num_flags;
+        ++p_chunk->num_touched;
+        p_chunk->tiles[index] = TILE_FLAG;
+        return true;
+    case TILE_FLAG:
+        --p_board->num_flags;
+        p_chunk->tiles[index] = TILE_UNKNOWN;
+        return true;
+    case TILE_UNKNOWN:
+        p_chunk->tiles[index] = TILE_BLIND;
+        if (--p_chunk->num_touched == 0)
+        {
+            release_chunk(p_board, p_chunk);
+        }
+        return true;
+    default:
+        return false;
+    }
+}
+
+engine_status_t chunk_board_get_status(const chunk_board_t* p_board)
+{
+    ASSERT(p_board != NULL, "p_board == NULL");
+    return p_board->status;
+}
+
+tile_t chunk_board_get_tile(chunk_board_t* p_board, const int64_t x, const int64_t y)
+{
+    ASSERT(p_board != NULL, "p_board == NULL");
+    ASSERT(is_valid_position(x, y), "Invalid position");
+
+    const board_chunk_t* p_chunk = find_chunk_or_null(p_board, get_chunk_coord(x), get_chunk_coord(y));
+    return (p_chunk == NULL) ? TILE_BLIND : (tile_t)p_chunk->tiles[get_local_index(x, y)];
+}
+
+bool chunk_board_is_mine(chunk_board_t* p_board, const int64_t x, const int64_t y)
+{
+    ASSERT(p_board != NULL, "p_board == NULL");
+    ASSERT(is_valid_position(x, y), "Invalid position");
+
+    if (!p_board->b_safe_set)
+    {
+        return false;
+    }
+
+    const size_t index = get_local_index(x, y);
+
+    const board_chunk_t* p_chunk = find_chunk_or_null(p_board, get_chunk_coord(x), get_chunk_coord(y));
+    if (p_chunk != NULL)
+    {
+        return (p_chunk->mine_bits[index / CHUNK_BOARD_CHUNK_SIZE] >> (index % CHUNK_BOARD_CHUNK_SIZE)) & 1;
+    }
+
+    uint64_t mine_bits[CHUNK_BOARD_CHUNK_SIZE];
+    make_chunk_mines(p_board, get_chunk_coord(x), get_chunk_coord(y), mine_bits);
+    return (mine_bits[index / CHUNK_BOARD_CHUNK_SIZE] >> (index % CHUNK_BOARD_CHUNK_SIZE)) & 1;
+}
+
+uint64_t chunk_board_get_num_opened(const chunk_board_t* p_board)
+{
+    ASSERT(p_board != NULL, "p_board == NULL");
+    return p_board->num_opened;
+}
+
+int64_t chunk_board_get_num_flags(const chunk_board_t* p_board)
+{
+    ASSERT(p_board != NULL, "p_board == NULL");
+    return p_board->num_flags;
+}
+
+size_t chunk_board_get_num_chunks(chunk_board_t* p_board)
+{
+    ASSERT(p_board != NULL, "p_board == NULL");
+    return flat_map_get_num_elements(&p_board->chunk_map);
+}
+
+static bool is_valid_position(const int64_t x, const int64_t y)
+{
+    return (x >= CHUNK_BOARD_MIN_COORD && x <= CHUNK_BOARD_MAX_COORD
+            && y >= CHUNK_BOARD_MIN_COORD && y <= CHUNK_BOARD_MAX_COORD);
+}
+
+static FORCEINLINE int64_t get_chunk_coord(const int64_t coord)
+{
+    return coord >> CHUNK_BOARD_CHUNK_SHIFT;
+}
+
+static FORCEINLINE size_t get_local_index(const int64_t x, const int64_t y)
+{
+    return (size_t)(y & CHUNK_BOARD_CHUNK_MASK) * CHUNK_BOARD_CHUNK_SIZE + (size_t)(x & CHUNK_BOARD_CHUNK_MASK);
+}
+
+// 청크 맵의 해시, 키 16바이트를 FNV-1a로 한 바이트씩 섞는 대신 좌표 두 개를 splitmix64로 섞음
+static uint64_t get_chunk_hash(const void* p_key, const size_t key_size)
+{
+    ASSERT(key_size == sizeof(chunk_key_t), "Invalid key size");
+    (void)key_size;
+
+    const chunk_key_t* p_chunk_key = (const chunk_key_t*)p_key;
+    return random_mix_seed((uint64_t)p_chunk_key->chunk_x ^ random_mix_seed((uint64_t)p_chunk_key->chunk_y));
+}
+
+static board_chunk_t* find_chunk_or_null(chunk_board_t* p_board, const int64_t chunk_x, const int64_t chunk_y)
+{
+    ASSERT(p_board != NULL, "p_board == NULL");
+
+    board_chunk_t* p_last_chunk = p_board->p_last_chunk;
+    if (p_last_chunk != NULL && p_last_chunk->key.chunk_x == chunk_x && p_last_chunk->key.chunk_y == chunk_y)
+    {
+        return p_last_chunk;
+    }
+
+    const chunk_key_t key = { chunk_x, chunk_y };
+    const uint64_t hash = get_chunk_hash(&key, sizeof(chunk_key_t));
+
+    board_chunk_t** pp_chunk = (board_chunk_t**)flat_map_get_value_by_hash_or_null(&p_board->chunk_map, hash, &key, sizeof(chunk_key_t));
+    if (pp_chunk == NULL)
+    {
+        return NULL;
+    }
+
+    p_board->p_last_chunk = *pp_chunk;
+    return *pp_chunk;
+}
+
+// 없으면 할당, 할당에 실패하면 NULL
+static board_chunk_t* get_chunk_or_null(chunk_board_t* p_board, const int64_t chunk_x, const int64_t chunk_y)
+{
+    ASSERT(p_board != NULL, "p_board == NULL");
+
+    board_chunk_t* p_chunk = find_chunk_or_null(p_board, chunk_x, chunk_y);
+    if (p_chunk != NULL)
+    {
+        return p_chunk;
+    }
+
+    p_chunk = (board_chunk_t*)memory_pool_alloc_or_null(&p_board->chunk_pool);
+    if (p_chunk == NULL)
+    {
+        ASSERT(false, "Failed to alloc chunk");
+        return NULL;
+    }
+
+    p_chunk->key.chunk_x = chunk_x;
+    p_chunk->key.chunk_y = chunk_y;
+    p_chunk->num_touched = 0;
+    memset(p_chunk->tiles, TILE_BLIND, sizeof(p_chunk->tiles));
+    make_chunk_counts(p_board, p_chunk);
+
+    const uint64_t hash = get_chunk_hash(&p_chunk->key, sizeof(chunk_key_t));
+    if (!flat_map_insert_by_hash(&p_board->chunk_map, hash, &p_chunk->key, sizeof(chunk_key_t), &p_chunk, sizeof(board_chunk_t*)))
+    {
+        ASSERT(false, "Failed to insert chunk");
+        memory_pool_dealloc(&p_board->chunk_pool, p_chunk);
+        return NULL;
+    }
+
+    p_board->p_last_chunk = p_chunk;
+    return p_chunk;
+}
+
+static void release_chunk(chunk_board_t* p_board, board_chunk_t* p_chunk)
+{
+    ASSERT(p_board != NULL, "p_board == NULL");
+    ASSERT(p_chunk != NULL, "p_chunk == NULL");
+    ASSERT(p_chunk->num_touched == 0, "Chunk is touched");
+
+    const uint64_t hash = get_chunk_hash(&p_chunk->key, sizeof(chunk_key_t));
+    flat_map_remove_by_hash(&p_board->chunk_map, hash, &p_chunk->key, sizeof(chunk_key_t));
+
+    if (p_board->p_last_chunk == p_chunk)
+    {
+        p_board->p_last_chunk = NULL;
+    }
+
+    memory_pool_dealloc(&p_board->chunk_pool, p_chunk);
+}
+
+// Floyd 알고리즘으로 청크 안에 num_mines_per_chunk개 배치한 뒤 안전 지점 주변 3x3을 비움
+// 범위 밖 청크는 지뢰가 없음
+static void make_chunk_mines(const chunk_board_t* p_board, const int64_t chunk_x, const int64_t chunk_y, uint64_t* p_out_mine_bits)
+{
+    ASSERT(p_board != NULL, "p_board == NULL");
+    ASSERT(p_out_mine_bits != NULL, "p_out_mine_bits == NULL");
+
+    memset(p_out_mine_bits, 0, sizeof(uint64_t) * CHUNK_BOARD_CHUNK_SIZE);
+
+    if (!is_valid_position(chunk_x * CHUNK_BOARD_CHUNK_SIZE, chunk_y * CHUNK_BOARD_CHUNK_SIZE))
+    {
+        return;
+    }
+
+    // 청크 좌표마다 겹치지 않는 시드
+    random_t random;
+    random_init(&random, random_mix_seed(p_board->seed ^ random_mix_seed((uint64_t)chunk_x ^ random_mix_seed((uint64_t)chunk_y))));
+
+    for (size_t j = CHUNK_BOARD_NUM_CHUNK_TILES - p_board->num_mines_per_chunk; j < CHUNK_BOARD_NUM_CHUNK_TILES; ++j)
+    {
+        size_t index = (size_t)random_next_bounded(&random, (uint64_t)j + 1);
+        if ((p_out_mine_bits[index / CHUNK_BOARD_CHUNK_SIZE] >> (index % CHUNK_BOARD_CHUNK_SIZE)) & 1)
+        {
+            index = j;
+        }
+
+        p_out_mine_bits[index / CHUNK_BOARD_CHUNK_SIZE] |= (uint64_t)1 << (index % CHUNK_BOARD_CHUNK_SIZE);
+    }
+
+    if (!p_board->b_safe_set)
+    {
+        return;
+    }
+
+    for (int64_t y = p_board->safe_y - 1; y <= p_board->safe_y + 1; ++y)
+    {
+        for (int64_t x = p_board->safe_x - 1; x <= p_board->safe_x + 1; ++x)
+        {
+            if (get_chunk_coord(x) == chunk_x && get_chunk_coord(y) == chunk_y)
+            {
+                const size_t index = get_local_index(x, y);
+                p_out_mine_bits[index / CHUNK_BOARD_CHUNK_SIZE] &= ~((uint64_t)1 << (index % CHUNK_BOARD_CHUNK_SIZE));
+            }
+        }
+    }
+}
+
+// 청크의 지뢰와 인접 지뢰 개수 계산
+// 이웃 8개 청크의 지뢰도 시드로 다시 만들어 테두리 한 칸을 채운 격자에서 센다
+static void make_chunk_counts(const chunk_board_t* p_board, board_chunk_t* p_chunk)
+{
+    ASSERT(p_board != NULL, "p_board == NULL");
+    ASSERT(p_chunk != NULL, "p_chunk == NULL");
+
+    const int64_t chunk_x = p_chunk->key.chunk_x;
+    const int64_t chunk_y = p_chunk->key.chunk_y;
+
+    // neighbours[dy + 1][dx + 1]
+    uint64_t neighbours[3][3][CHUNK_BOARD_CHUNK_SIZE];
+    for (int64_t dy = -1; dy <= 1; ++dy)
+    {
+        for (int64_t dx = -1; dx <= 1; ++dx)
+        {
+            make_chunk_mines(p_board, chunk_x + dx, chunk_y + dy, neighbours[dy + 1][dx + 1]);
+        }
+    }
+
+    memcpy(p_chunk->mine_bits, neighbours[1][1], sizeof(p_chunk->mine_bits));
+
+    // 격자의 x번째 칸은 청크의 (x - 1)번째 칸, 격자 위아래에 bitboard 형식의 빈 줄이 하나씩 있음
+    uint64_t halo[(HALO_SIZE + 2) * HALO_NUM_WORDS];
+    memset(halo, 0, sizeof(halo));
+
+    for (size_t halo_y = 0; halo_y < HALO_SIZE; ++halo_y)
+    {
+        const size_t row = (halo_y == 0) ? 0 : (halo_y == HALO_SIZE - 1) ? 2 : 1;
+        const size_t y = (halo_y == 0) ? CHUNK_BOARD_CHUNK_SIZE - 1 : (halo_y == HALO_SIZE - 1) ? 0 : halo_y - 1;
+
+        const uint64_t left = neighbours[row][0][y];
+        const uint64_t center = neighbours[row][1][y];
+        const uint64_t right = neighbours[row][2][y];
+
+        uint64_t* p_halo_row = halo + (halo_y + 1) * HALO_NUM_WORDS;
+        p_halo_row[0] = (center << 1) | (left >> 63);
+        p_halo_row[1] = (center >> 63) | ((right & 1) << 1);
+    }
+
+    uint8_t counts[HALO_COUNT_STRIDE * HALO_COUNT_STRIDE];
+    bitboard_count_neighbours(halo, HALO_NUM_WORDS, HALO_SIZE, HALO_SIZE, counts, HALO_COUNT_STRIDE);
+
+    // 청크의 (x, y)는 격자의 (x + 1, y + 1), counts에서는 테두리 한 칸을 더해 (x + 2, y + 2)
+    for (size_t y = 0; y < CHUNK_BOARD_CHUNK_SIZE; ++y)
+    {
+        memcpy(p_chunk->counts + y * CHUNK_BOARD_CHUNK_SIZE, counts + (y + 2) * HALO_COUNT_STRIDE + 2, CHUNK_BOARD_CHUNK_SIZE);
+    }
+}
+
+static bool open_cell(chunk_board_t* p_board, board_chunk_t* p_chunk, const size_t index)
+{
+    ASSERT(p_board != NULL, "p_board == NULL");
+    ASSERT(p_chunk != NULL, "p_chunk == NULL");
+
+    const tile_t tile = (tile_t)p_chunk->tiles[index];
+    if (tile != TILE_BLIND && tile != TILE_FLAG && tile != TILE_UNKNOWN)
+    {
+        return false;
+    }
+
+    if (tile == TILE_FLAG)
+    {
+        --p_board->num_flags;
+    }
+    else if (tile == TILE_BLIND)
+    {
+        ++p_chunk->num_touched;
+    }
+
+    const uint8_t count = p_chunk->counts[index];
+    p_chunk->tiles[index] = (count == 0) ? TILE_OPEN : (uint8_t)(TILE_1 + count - 1);
+    ++p_board->num_opened;
+
+    return true;
+}
+
+static bool push_frontier(chunk_board_t* p_board, const int64_t x, const int64_t y)
+{
+    ASSERT(p_board != NULL, "p_board == NULL");
+
+    if (p_board->num_frontier == p_board->num_max_frontier)
+    {
+        const size_t num_max_frontier = p_board->num_max_frontier * 2;
+        chunk_board_position_t* pa_frontier = (chunk_board_position_t*)realloc(p_board->pa_frontier, sizeof(chunk_board_position_t) * num_max_frontier);
+        if (pa_frontier == NULL)
+        {
+            ASSERT(false, "Failed to realloc frontier");
+            return false;
+        }
+
+        p_board->pa_frontier = pa_frontier;
+        p_board->num_max_frontier = num_max_frontier;
+    }
+
+    p_board->pa_frontier[p_board->num_frontier].x = x;
+    p_board->pa_frontier[p_board->num_frontier].y = y;
+    ++p_board->num_frontier;
+
+    return true;
+}
+
+// 프런티어의 타일은 이미 열려 있으므로 한 칸은 최대 한 번만 쌓임
+// 메모리가 모자라면 해당 이웃은 닫힌 채로 둠
+static void expand_frontier(chunk_board_t* p_board)
+{
+    ASSERT(p_board != NULL, "p_board == NULL");
+
+    const size_t open_budget = p_board->open_budget;
+    size_t num_opened = 0;
+
+    while (p_board->num_frontier > 0 && (open_budget == 0 || num_opened < open_budget))
+    {
+        const chunk_board_position_t position = p_board->pa_frontier[--p_board->num_frontier];
+
+        for (int64_t y = position.y - 1; y <= position.y + 1; ++y)
+        {
+            for (int64_t x = position.x - 1; x <= position.x + 1; ++x)
+            {
+                if (!is_valid_position(x, y))
+                {
+                    continue;
+                }
+
+                board_chunk_t* p_chunk = get_chunk_or_null(p_board, get_chunk_coord(x), get_chunk_coord(y));
+                if (p_chunk == NULL)
+                {
+                    continue;
+                }
+
+                const size_t index = get_local_index(x, y);
+                if (!open_cell(p_board, p_chunk, index))
+                {
+                    continue;
+                }
+
+                ++num_opened;
+
+                if (p_chunk->counts[index] == 0)
+                {
+                    push_frontier(p_board, x, y);
+                }
+            }
+        }
+    }
+}
+
+// 할당한 청크의 지뢰만 보여줌, 나머지는 닫혀 있으므로 chunk_board_is_mine()으로 확인
+static void reveal_mines(chunk_board_t* p_board)
+{
+    ASSERT(p_board != NULL, "p_board == NULL");
+
+    size_t slot = 0;
+    void* p_value;
+    while (flat_map_get_next(&p_board->chunk_map, &slot, NULL, &p_value))
+    {
+        board_chunk_t* p_chunk = *(board_chunk_t**)p_value;
+        for (size_t y = 0; y < CHUNK_BOARD_CHUNK_SIZE; ++y)
+        {
+            const uint64_t bits = p_chunk->mine_bits[y];
+            if (bits == 0)
+            {
+                continue;
+            }
+
+            for (size_t x = 0; x < CHUNK_BOARD_CHUNK_SIZE; ++x)
+            {
+                if (((bits >> x) & 1) == 0)
+                {
+                    continue;
+                }
+
+                const size_t index = y * CHUNK_BOARD_CHUNK_SIZE + x;
+                if (p_chunk->tiles[index] == TILE_BLIND)
+                {
+                    ++p_chunk->num_touched;
+                }
+                p_chunk->tiles[index] = TILE_MINE;
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#ifndef CHUNK_BOARD_H
+#define CHUNK_BOARD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "engine.h"
+#include "flat_map.h"
+#include "memory_pool.h"
+#include "safe99_common/defines.h"
+
+// 64비트 좌표를 쓰는 사실상 무한한 판
+// 64 x 64 청크를 처음 건드릴 때 할당하므로 메모리는 탐색한 영역에 비례함
+// 지뢰는 (시드, 청크 좌표)로 청크마다 따로 만들므로 할당하지 않은 청크도 항상 같은 판을 유지함
+// 모두 닫혀 있고 깃발/물음표도 없는 청크는 회수함
+
+#define CHUNK_BOARD_CHUNK_SHIFT 6
+#define CHUNK_BOARD_CHUNK_SIZE 64
+#define CHUNK_BOARD_CHUNK_MASK 63
+#define CHUNK_BOARD_NUM_CHUNK_TILES (CHUNK_BOARD_CHUNK_SIZE * CHUNK_BOARD_CHUNK_SIZE)
+
+// 좌표 범위 [MIN, MAX], 이웃 좌표 계산이 넘치지 않도록 여유를 둠
+// 청크 경계에 맞춰져 있으므로 청크는 범위 안에 완전히 들어가거나 완전히 벗어남
+#define CHUNK_BOARD_MIN_COORD (-((int64_t)1 << 62))
+#define CHUNK_BOARD_MAX_COORD (((int64_t)1 << 62) - 1)
+
+typedef struct chunk_key
+{
+    int64_t chunk_x;
+    int64_t chunk_y;
+} chunk_key_t;
+
+typedef struct board_chunk
+{
+    chunk_key_t key;
+
+    // 줄마다 64비트, x번째 칸은 x번째 비트
+    uint64_t mine_bits[CHUNK_BOARD_CHUNK_SIZE];
+
+    // 청크 밖 이웃까지 포함한 인접 지뢰 개수
+    uint8_t counts[CHUNK_BOARD_NUM_CHUNK_TILES];
+
+    // tile_t
+    uint8_t tiles[CHUNK_BOARD_NUM_CHUNK_TILES];
+
+    // TILE_BLIND가 아닌 타일 개수, 0이 되면 회수
+    uint32_t num_touched;
+} board_chunk_t;
+
+typedef struct chunk_board_position
+{
+    int64_t x;
+    int64_t y;
+} chunk_board_position_t;
+
+typedef struct chunk_board
+{
+    uint64_t seed;
+    uint32_t num_mines_per_chunk;
+
+    flat_map_t chunk_map; // <chunk_key_t, board_chunk_t*>
+    memory_pool_t chunk_pool;
+
+    // 마지막으로 찾은 청크, flood fill은 대부분 같은 청크 안에서 움직임
+    board_chunk_t* p_last_chunk;
+
+    // 첫 번째로 연 타일, 주변 3x3에는 지뢰를 두지 않음
+    int64_t safe_x;
+    int64_t safe_y;
+    bool b_safe_set;
+
+    // flood fill 프런티어 (열었고 인접 지뢰가 0인 타일), 모자라면 두 배로 늘림
+    // open_budget이 0이 아니면 한 번에 최대 open_budget개만 열고 나머지는 chunk_board_continue()에서 이어감
+    chunk_board_position_t* pa_frontier;
+    size_t num_frontier;
+    size_t num_max_frontier;
+    size_t open_budget;
+
+    uint64_t num_opened;
+    int64_t num_flags;
+
+    engine_status_t status;
+} chunk_board_t;
+
+START_EXTERN_C
+
+// num_mines_per_chunk는 [0 < num_mines_per_chunk < CHUNK_BOARD_NUM_CHUNK_TILES]
+// 첫 타일 주변 3x3에서 뺀 지뢰만큼 그 청크의 지뢰는 적어짐
+// open_budget은 한 번의 열기/이어가기에서 열 최대 타일 수, 0이면 제한 없음
+// 지뢰 밀도가 낮으면 빈칸이 끝없이 이어질 수 있으므로 제한을 두는 것이 좋음
+//
+// 이미 초기화한 판을 다시 초기화하지 말 것
+// 해야 한다면 chunk_board_release() 호출 이후 재호출
+bool chunk_board_init(chunk_board_t* p_board, const uint64_t seed, const uint32_t num_mines_per_chunk, const size_t open_budget);
+void chunk_board_release(chunk_board_t* p_board);
+
+// 새 시드로 새 게임 시작, 할당한 청크는 모두 풀로 돌려보냄
+void chunk_board_restart(chunk_board_t* p_board, const uint64_t seed);
+
+// 타일 열기, 지뢰를 열면 패배하고 할당된 청크의 지뢰를 모두 보여줌
+// 게임 오버/범위 밖/깃발/이미 열린 타일이거나 청크를 할당하지 못하면 false 반환
+bool chunk_board_open(chunk_board_t* p_board, const int64_t x, const int64_t y);
+
+// 예산을 넘겨 남은 flood fill을 이어감, 남은 것이 없으면 false
+bool chunk_board_continue(chunk_board_t* p_board);
+bool chunk_board_has_pending(const chunk_board_t* p_board);
+
+// 깃발 -> 물음표 -> 없음 순환
+// 게임 오버/범위 밖/열린 타일이면 아무것도 하지 않고 false 반환
+bool chunk_board_cycle_flag(chunk_board_t* p_board, const int64_t x, const int64_t y);
+
+engine_status_t chunk_board_get_status(const chunk_board_t* p_board);
+
+// 할당하지 않은 청크의 타일은 TILE_BLIND
+tile_t chunk_board_get_tile(chunk_board_t* p_board, const int64_t x, const int64_t y);
+
+// 첫 번째 열기 전에는 false
+// 할당하지 않은 청크면 지뢰를 다시 만들어 봐야 하므로 느림
+bool chunk_board_is_mine(chunk_board_t* p_board, const int64_t x, const int64_t y);
+
+uint64_t chunk_board_get_num_opened(const chunk_board_t* p_board);
+int64_t chunk_board_get_num_flags(const chunk_board_t* p_board);
+size_t chunk_board_get_num_chunks(chunk_board_t* p_board);
+
+END_EXTERN_C
+
+#endif // CHUNK_BOARD_H
\ No newline at end of file
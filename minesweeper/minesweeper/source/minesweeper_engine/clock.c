@@ -0,0 +1,44 @@
+#include "clock.h"
+#include "thread.h"
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <Windows.h>
+#else
+    #include <time.h>
+#endif // _WIN32
+
+#if defined(_WIN32)
+// 부팅 후 바뀌지 않으므로 처음 한 번만 물어봄 (여러 스레드가 동시에 물어도 같은 값)
+static volatile uint64_t s_counter_frequency;
+#endif // _WIN32
+
+uint64_t clock_get_time_ns(void)
+{
+#if defined(_WIN32)
+    uint64_t frequency = atomic_load_u64(&s_counter_frequency);
+    if (frequency == 0)
+    {
+        LARGE_INTEGER counter_frequency;
+        QueryPerformanceFrequency(&counter_frequency);
+        frequency = (uint64_t)counter_frequency.QuadPart;
+        atomic_store_u64(&s_counter_frequency, frequency);
+    }
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+
+    // 곱하기가 넘치지 않도록 초와 나머지를 나눠서 계산
+    const uint64_t ticks = (uint64_t)counter.QuadPart;
+    return ticks / frequency * 1000000000 + ticks % frequency * 1000000000 / frequency;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+#endif // _WIN32
+}
+
+double clock_get_seconds(void)
+{
+    return (double)clock_get_time_ns() / 1000000000.0;
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+
+#include "safe99_common/defines.h"
+
+// 경과 시간 측정용 단조 증가 시각 (시스템 시각을 바꿔도 뒤로 가지 않음)
+// 기준점은 정해져 있지 않으므로 두 시각의 차이만 의미가 있음
+
+START_EXTERN_C
+
+uint64_t clock_get_time_ns(void);
+
+// clock_get_time_ns()를 초로 바꾼 값 (처리량, 걸린 시간 출력용)
+double clock_get_seconds(void);
+
+END_EXTERN_C
+
+#endif // CLOCK_H
\ No newline at end of file
@@ -0,0 +1,670 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "bitboard.h"
+#include "engine.h"
+#include "random.h"
+#include "safe99_common/assert.h"
+#include "safe99_common/safe_delete.h"
+
+static void make_mine(engine_t* p_engine, const size_t first_x, const size_t first_y);
+static void build_counts(engine_t* p_engine);
+static size_t skip_excluded(size_t index, const size_t* p_excluded, const size_t num_excluded);
+
+static FORCEINLINE tile_t load_tile(const engine_t* p_engine, const size_t index);
+static FORCEINLINE void store_tile(engine_t* p_engine, const size_t index, const tile_t tile);
+
+static void mark_dirty(engine_t* p_engine, const size_t index);
+
+static bool is_valid_position(const engine_t* p_engine, const size_t x, const size_t y);
+static void open_cell(engine_t* p_engine, const size_t index, const uint8_t count);
+static void open_tile(engine_t* p_engine, const size_t x, const size_t y);
+
+bool engine_init(engine_t* p_engine, const size_t rows, const size_t cols, const size_t num_mines, const uint64_t seed)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+    ASSERT(rows > 0, "rows == 0");
+    ASSERT(cols > 0, "cols == 0");
+    ASSERT(num_mines > 0, "num_mines == 0");
+    ASSERT(num_mines < rows * cols, "num_mines >= rows * cols");
+
+    p_engine->rows = rows;
+    p_engine->cols = cols;
+    p_engine->num_mines = (int64_t)num_mines;
+    p_engine->num_max_mines = num_mines;
+    p_engine->num_tiles = rows * cols;
+    p_engine->status = ENGINE_STATUS_PLAYING;
+    p_engine->seed = seed;
+    p_engine->first_click = ENGINE_FIRST_CLICK_ANY;
+    p_engine->b_mines_placed = false;
+    p_engine->generation = 0;
+    p_engine->num_dirty = 0;
+    p_engine->b_full_redraw = true;
+
+    // 지뢰 초기화
+    p_engine->num_mine_words = bitboard_get_num_words(cols);
+    p_engine->pa_mine_bits = (uint64_t*)malloc(sizeof(uint64_t) * (rows + 2) * p_engine->num_mine_words);
+    if (p_engine->pa_mine_bits == NULL)
+    {
+        ASSERT(false, "Failed to malloc mines");
+        goto failed_malloc_mines;
+    }
+
+    p_engine->pa_mine_indices = (size_t*)malloc(sizeof(size_t) * num_mines);
+    if (p_engine->pa_mine_indices == NULL)
+    {
+        ASSERT(false, "Failed to malloc mine indices");
+        goto failed_malloc_mine_indices;
+    }
+
+    // 타일 초기화 (0세대 TILE_BLIND)
+    p_engine->pa_tiles = (uint32_t*)calloc(rows * cols, sizeof(uint32_t));
+    if (p_engine->pa_tiles == NULL)
+    {
+        ASSERT(false, "Failed to calloc tiles");
+        goto failed_malloc_tiles;
+    }
+
+    // 변경 타일 기록 초기화
+    p_engine->pa_dirty_bits = (uint64_t*)calloc(bitboard_get_num_words(rows * cols), sizeof(uint64_t));
+    if (p_engine->pa_dirty_bits == NULL)
+    {
+        ASSERT(false, "Failed to calloc dirty bits");
+        goto failed_malloc_dirty_bits;
+    }
+
+    p_engine->pa_dirty_indices = (size_t*)malloc(sizeof(size_t) * ENGINE_MAX_DIRTY_TILES);
+    if (p_engine->pa_dirty_indices == NULL)
+    {
+        ASSERT(false, "Failed to malloc dirty indices");
+        goto failed_malloc_dirty_indices;
+    }
+
+    // 저장하지 않은 타일 블록 기록 초기화 (처음에는 전체)
+    p_engine->num_unsaved_words = bitboard_get_num_words((rows * cols + ENGINE_SAVE_BLOCK_TILES - 1) / ENGINE_SAVE_BLOCK_TILES);
+    p_engine->pa_unsaved_bits = (uint64_t*)calloc(p_engine->num_unsaved_words, sizeof(uint64_t));
+    if (p_engine->pa_unsaved_bits == NULL)
+    {
+        ASSERT(false, "Failed to calloc unsaved bits");
+        goto failed_malloc_unsaved_bits;
+    }
+    p_engine->b_all_unsaved = true;
+    p_engine->b_mines_unsaved = false;
+
+    // 인접 지뢰 개수 격자 초기화
+    p_engine->count_stride = cols + 2;
+    p_engine->pa_counts = (uint8_t*)malloc(sizeof(uint8_t) * (rows + 2) * p_engine->count_stride);
+    if (p_engine->pa_counts == NULL)
+    {
+        ASSERT(false, "Failed to malloc counts");
+        goto failed_malloc_counts;
+    }
+
+    // flood fill 프런티어 초기화
+    p_engine->num_max_frontier = rows * cols - num_mines;
+    p_engine->pa_frontier = (size_t*)malloc(sizeof(size_t) * p_engine->num_max_frontier);
+    if (p_engine->pa_frontier == NULL)
+    {
+        ASSERT(false, "Failed to malloc frontier");
+        goto failed_malloc_frontier;
+    }
+
+    return true;
+
+failed_malloc_frontier:
+    SAFE_FREE(p_engine->pa_counts);
+
+failed_malloc_counts:
+    SAFE_FREE(p_engine->pa_unsaved_bits);
+
+failed_malloc_unsaved_bits:
+    SAFE_FREE(p_engine->pa_dirty_indices);
+
+failed_malloc_dirty_indices:
+    SAFE_FREE(p_engine->pa_dirty_bits);
+
+failed_malloc_dirty_bits:
+    SAFE_FREE(p_engine->pa_tiles);
+
+failed_malloc_tiles:
+    SAFE_FREE(p_engine->pa_mine_indices);
+
+failed_malloc_mine_indices:
+    SAFE_FREE(p_engine->pa_mine_bits);
+
+failed_malloc_mines:
+    memset(p_engine, 0, sizeof(engine_t));
+    return false;
+}
+
+void engine_release(engine_t* p_engine)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+
+    SAFE_FREE(p_engine->pa_frontier);
+    SAFE_FREE(p_engine->pa_counts);
+    SAFE_FREE(p_engine->pa_unsaved_bits);
+    SAFE_FREE(p_engine->pa_dirty_indices);
+    SAFE_FREE(p_engine->pa_dirty_bits);
+    SAFE_FREE(p_engine->pa_tiles);
+    SAFE_FREE(p_engine->pa_mine_indices);
+    SAFE_FREE(p_engine->pa_mine_bits);
+
+    memset(p_engine, 0, sizeof(engine_t));
+}
+
+void engine_restart(engine_t* p_engine, const uint64_t seed)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+
+    p_engine->seed = seed;
+
+    p_engine->num_mines = (int64_t)p_engine->num_max_mines;
+    p_engine->num_tiles = p_engine->rows * p_engine->cols;
+    p_engine->status = ENGINE_STATUS_PLAYING;
+    p_engine->b_mines_placed = false;
+
+    // 세대가 바뀌면 모든 타일이 바뀜
+    p_engine->b_full_redraw = true;
+
+    // 세대가 한 바퀴 돌면 그때만 전체를 지움
+    if (p_engine->generation == ENGINE_MAX_GENERATION)
+    {
+        memset(p_engine->pa_tiles, 0, sizeof(uint32_t) * p_engine->rows * p_engine->cols);
+        p_engine->generation = 0;
+        p_engine->b_all_unsaved = true;
+    }
+    else
+    {
+        ++p_engine->generation;
+    }
+}
+
+void engine_load_mines(engine_t* p_engine)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+    ASSERT(!p_engine->b_mines_placed, "Mines already placed");
+
+    build_counts(p_engine);
+
+    // 이미 연 빈칸은 flood fill이 다시 확장하지 않도록 방문 표시
+    for (size_t y = 0; y < p_engine->rows; ++y)
+    {
+        for (size_t x = 0; x < p_engine->cols; ++x)
+        {
+            if (load_tile(p_engine, y * p_engine->cols + x) == TILE_OPEN)
+            {
+                p_engine->pa_counts[(y + 1) * p_engine->count_stride + x + 1] |= ENGINE_CELL_VISITED;
+            }
+        }
+    }
+
+    p_engine->b_mines_placed = true;
+    p_engine->b_mines_unsaved = true;
+}
+
+bool engine_set_seed(engine_t* p_engine, const uint64_t seed)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+
+    if (p_engine->b_mines_placed)
+    {
+        return false;
+    }
+
+    p_engine->seed = seed;
+    return true;
+}
+
+void engine_set_first_click(engine_t* p_engine, const engine_first_click_t first_click)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+    p_engine->first_click = first_click;
+}
+
+bool engine_open(engine_t* p_engine, const size_t x, const size_t y)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+
+    if (p_engine->status != ENGINE_STATUS_PLAYING || !is_valid_position(p_engine, x, y))
+    {
+        return false;
+    }
+
+    const size_t index = y * p_engine->cols + x;
+
+    const tile_t tile = load_tile(p_engine, index);
+    if (tile != TILE_BLIND && tile != TILE_UNKNOWN)
+    {
+        return false;
+    }
+
+    if (!p_engine->b_mines_placed)
+    {
+        make_mine(p_engine, x, y);
+    }
+
+    // 지뢰일 경우
+    if (bitboard_test(p_engine->pa_mine_bits, p_engine->num_mine_words, x, y))
+    {
+        // 지뢰가 있는 타일 열기
+        for (size_t i = 0; i < p_engine->num_max_mines; ++i)
+        {
+            store_tile(p_engine, p_engine->pa_mine_indices[i], TILE_MINE);
+        }
+
+        store_tile(p_engine, index, TILE_GAMEOVER_MINE);
+        p_engine->status = ENGINE_STATUS_LOST;
+
+        return true;
+    }
+
+    open_tile(p_engine, x, y);
+
+    // 남은 타일의 수와 지뢰 개수가 같으면 승리
+    if (p_engine->num_tiles == p_engine->num_max_mines)
+    {
+        // 남은 지뢰에 깃발 꽂기
+        for (size_t i = 0; i < p_engine->num_max_mines; ++i)
+        {
+            store_tile(p_engine, p_engine->pa_mine_indices[i], TILE_FLAG);
+        }
+
+        p_engine->num_mines = 0;
+        p_engine->status = ENGINE_STATUS_WON;
+    }
+
+    return true;
+}
+
+bool engine_cycle_flag(engine_t* p_engine, const size_t x, const size_t y)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+
+    if (p_engine->status != ENGINE_STATUS_PLAYING || !is_valid_position(p_engine, x, y))
+    {
+        return false;
+    }
+
+    const size_t index = y * p_engine->cols + x;
+
+    switch (load_tile(p_engine, index))
+    {
+    case TILE_BLIND:
+        --p_engine->num_mines;
+        store_tile(p_engine, index, TILE_FLAG);
+        return true;
+    case TILE_FLAG:
+        ++p_engine->num_mines;
+        store_tile(p_engine, index, TILE_UNKNOWN);
+        return true;
+    case TILE_UNKNOWN:
+        store_tile(p_engine, index, TILE_BLIND);
+        return true;
+    default:
+        return false;
+    }
+}
+
+engine_status_t engine_get_status(const engine_t* p_engine)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+    return p_engine->status;
+}
+
+bool engine_is_gameover(const engine_t* p_engine)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+    return p_engine->status != ENGINE_STATUS_PLAYING;
+}
+
+bool engine_is_win(const engine_t* p_engine)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+    return p_engine->status == ENGINE_STATUS_WON;
+}
+
+tile_t engine_get_tile(const engine_t* p_engine, const size_t x, const size_t y)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+    ASSERT(is_valid_position(p_engine, x, y), "Invalid position");
+
+    return load_tile(p_engine, y * p_engine->cols + x);
+}
+
+uint64_t engine_get_hash(const engine_t* p_engine)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+
+    // FNV-1a, 타일은 한 바이트씩
+    const uint64_t FNV_PRIME = 0x100000001b3;
+    uint64_t hash = 0xcbf29ce484222325;
+
+    const size_t num_tiles = p_engine->rows * p_engine->cols;
+    for (size_t i = 0; i < num_tiles; ++i)
+    {
+        hash = (hash ^ (uint64_t)load_tile(p_engine, i)) * FNV_PRIME;
+    }
+
+    hash = (hash ^ (uint64_t)p_engine->num_mines) * FNV_PRIME;
+    hash = (hash ^ (uint64_t)p_engine->num_tiles) * FNV_PRIME;
+    hash = (hash ^ (uint64_t)p_engine->status) * FNV_PRIME;
+
+    return hash;
+}
+
+bool engine_is_mine(const engine_t* p_engine, const size_t x, const size_t y)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+    ASSERT(is_valid_position(p_engine, x, y), "Invalid position");
+
+    return p_engine->b_mines_placed && bitboard_test(p_engine->pa_mine_bits, p_engine->num_mine_words, x, y);
+}
+
+void engine_mark_dirty(engine_t* p_engine, const size_t x, const size_t y)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+    ASSERT(is_valid_position(p_engine, x, y), "Invalid position");
+
+    mark_dirty(p_engine, y * p_engine->cols + x);
+}
+
+void engine_request_full_redraw(engine_t* p_engine)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+    p_engine->b_full_redraw = true;
+}
+
+bool engine_is_full_redraw(const engine_t* p_engine)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+    return p_engine->b_full_redraw;
+}
+
+const size_t* engine_get_dirty_tiles(const engine_t* p_engine, size_t* p_out_num_dirty)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+    ASSERT(p_out_num_dirty != NULL, "p_out_num_dirty == NULL");
+
+    *p_out_num_dirty = p_engine->num_dirty;
+    return p_engine->pa_dirty_indices;
+}
+
+void engine_clear_dirty(engine_t* p_engine)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+
+    // 목록에 있는 타일만 비트가 켜져 있으므로 목록만 지우면 됨
+    for (size_t i = 0; i < p_engine->num_dirty; ++i)
+    {
+        const size_t index = p_engine->pa_dirty_indices[i];
+        p_engine->pa_dirty_bits[index / 64] &= ~((uint64_t)1 << (index % 64));
+    }
+
+    p_engine->num_dirty = 0;
+    p_engine->b_full_redraw = false;
+}
+
+static void make_mine(engine_t* p_engine, const size_t first_x, const size_t first_y)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+    ASSERT(is_valid_position(p_engine, first_x, first_y), "Invalid position");
+
+    const size_t rows = p_engine->rows;
+    const size_t cols = p_engine->cols;
+    const size_t num_mines = p_engine->num_max_mines;
+    const size_t num_words = p_engine->num_mine_words;
+
+    uint64_t* p_mine_bits = p_engine->pa_mine_bits;
+    memset(p_mine_bits, 0, sizeof(uint64_t) * (rows + 2) * num_words);
+
+    // 첫 타일 (및 주변) 제외, 인덱스 오름차순
+    size_t excluded[9];
+    size_t num_excluded = 0;
+    if (p_engine->first_click == ENGINE_FIRST_CLICK_SAFE_AREA)
+    {
+        for (size_t y = first_y - 1; y != first_y + 2; ++y)
+        {
+            for (size_t x = first_x - 1; x != first_x + 2; ++x)
+            {
+                if (is_valid_position(p_engine, x, y))
+                {
+                    excluded[num_excluded++] = y * cols + x;
+                }
+            }
+        }
+
+        if (rows * cols - num_excluded < num_mines)
+        {
+            num_excluded = 0;
+        }
+    }
+
+    if (num_excluded == 0 && p_engine->first_click != ENGINE_FIRST_CLICK_ANY && rows * cols > num_mines)
+    {
+        excluded[num_excluded++] = first_y * cols + first_x;
+    }
+
+    // Floyd 알고리즘: 정확히 num_mines번만 난수를 뽑아 중복 없이 배치
+    // j번째 단계에서 [0, j]에서 하나를 뽑고, 이미 지뢰면 j에 배치
+    // 제외한 칸을 뺀 인덱스 공간에서 뽑은 뒤 실제 칸으로 옮김
+    random_t random;
+    random_init(&random, p_engine->seed);
+
+    size_t* p_mine_indices = p_engine->pa_mine_indices;
+
+    const size_t num_cells = rows * cols - num_excluded;
+    for (size_t j = num_cells - num_mines; j < num_cells; ++j)
+    {
+        size_t index = skip_excluded((size_t)random_next_bounded(&random, (uint64_t)j + 1), excluded, num_excluded);
+        if (bitboard_test(p_mine_bits, num_words, index % cols, index / cols))
+        {
+            index = skip_excluded(j, excluded, num_excluded);
+        }
+
+        bitboard_set(p_mine_bits, num_words, index % cols, index / cols);
+        *p_mine_indices++ = index;
+    }
+
+    build_counts(p_engine);
+
+    p_engine->b_mines_placed = true;
+    p_engine->b_mines_unsaved = true;
+}
+
+// 지뢰 비트 평면으로 테두리 포함 인접 지뢰 개수 격자를 다시 만듦
+static void build_counts(engine_t* p_engine)
+{
+    const size_t rows = p_engine->rows;
+    const size_t cols = p_engine->cols;
+    const size_t stride = p_engine->count_stride;
+    uint8_t* p_counts = p_engine->pa_counts;
+
+    memset(p_counts, ENGINE_CELL_SENTINEL, stride);
+    memset(p_counts + (rows + 1) * stride, ENGINE_CELL_SENTINEL, stride);
+    for (size_t y = 1; y <= rows; ++y)
+    {
+        p_counts[y * stride] = ENGINE_CELL_SENTINEL;
+        p_counts[y * stride + cols + 1] = ENGINE_CELL_SENTINEL;
+    }
+
+    bitboard_count_neighbours(p_engine->pa_mine_bits, p_engine->num_mine_words, rows, cols, p_counts, stride);
+}
+
+// 제외한 칸을 뺀 인덱스 -> 실제 칸 인덱스
+static size_t skip_excluded(size_t index, const size_t* p_excluded, const size_t num_excluded)
+{
+    for (size_t i = 0; i < num_excluded; ++i)
+    {
+        if (index < p_excluded[i])
+        {
+            break;
+        }
+
+        ++index;
+    }
+
+    return index;
+}
+
+static FORCEINLINE tile_t load_tile(const engine_t* p_engine, const size_t index)
+{
+    return engine_get_tile_at(p_engine, index);
+}
+
+static FORCEINLINE void store_tile(engine_t* p_engine, const size_t index, const tile_t tile)
+{
+    p_engine->pa_tiles[index] = (p_engine->generation << ENGINE_GENERATION_SHIFT) | (uint32_t)tile;
+    mark_dirty(p_engine, index);
+
+    const size_t block = index / ENGINE_SAVE_BLOCK_TILES;
+    p_engine->pa_unsaved_bits[block / 64] |= (uint64_t)1 << (block % 64);
+}
+
+static void mark_dirty(engine_t* p_engine, const size_t index)
+{
+    if (p_engine->b_full_redraw)
+    {
+        return;
+    }
+
+    uint64_t* p_word = &p_engine->pa_dirty_bits[index / 64];
+    const uint64_t bit = (uint64_t)1 << (index % 64);
+    if (*p_word & bit)
+    {
+        return;
+    }
+
+    // 목록이 넘치면 전체 다시 그리기로 전환
+    if (p_engine->num_dirty == ENGINE_MAX_DIRTY_TILES)
+    {
+        p_engine->b_full_redraw = true;
+        return;
+    }
+
+    *p_word |= bit;
+    p_engine->pa_dirty_indices[p_engine->num_dirty++] = index;
+}
+
+static bool is_valid_position(const engine_t* p_engine, const size_t x, const size_t y)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+    return (x < p_engine->cols && y < p_engine->rows);
+}
+
+static void open_cell(engine_t* p_engine, const size_t index, const uint8_t count)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+
+    const tile_t tile = load_tile(p_engine, index);
+    if (tile != TILE_BLIND && tile != TILE_FLAG && tile != TILE_UNKNOWN)
+    {
+        return;
+    }
+
+    if (tile == TILE_FLAG)
+    {
+        ++p_engine->num_mines;
+    }
+
+    store_tile(p_engine, index, (count == 0) ? TILE_OPEN : (tile_t)(TILE_1 + count - 1));
+    --p_engine->num_tiles;
+}
+
+// 스캔라인 flood fill
+// 프런티어에는 아직 확장하지 않은 빈칸(인접 지뢰 0)의 테두리 포함 인덱스만 쌓임
+// 쌓을 때 ENGINE_CELL_VISITED를 켜므로 한 칸은 최대 한 번만 쌓이고
+// pa_frontier는 (rows * cols - num_max_mines)개면 충분함
+static void open_tile(engine_t* p_engine, const size_t x, const size_t y)
+{
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+    ASSERT(is_valid_position(p_engine, x, y), "Invalid position");
+
+    const size_t rows = p_engine->rows;
+    const size_t cols = p_engine->cols;
+    const size_t stride = p_engine->count_stride;
+
+    uint8_t* p_counts = p_engine->pa_counts;
+    size_t* p_frontier = p_engine->pa_frontier;
+    size_t num_frontier = 0;
+
+    const size_t start = (y + 1) * stride + (x + 1);
+
+    // 숫자 타일이면 한 칸만 열기
+    if (p_counts[start] != 0)
+    {
+        open_cell(p_engine, y * cols + x, p_counts[start] & ENGINE_CELL_COUNT_MASK);
+        return;
+    }
+
+    p_counts[start] |= ENGINE_CELL_VISITED;
+    p_frontier[num_frontier++] = start;
+
+    while (num_frontier > 0)
+    {
+        const size_t seed = p_frontier[--num_frontier];
+        const size_t seed_y = seed / stride;
+
+        uint8_t* p_row = p_counts + seed_y * stride;
+
+        // 좌우로 방문하지 않은 빈칸 확장 (테두리/숫자/방문한 칸은 0이 아님)
+        size_t left = seed - seed_y * stride;
+        size_t right = left;
+        while (p_row[left - 1] == 0)
+        {
+            --left;
+            p_row[left] |= ENGINE_CELL_VISITED;
+        }
+        while (p_row[right + 1] == 0)
+        {
+            ++right;
+            p_row[right] |= ENGINE_CELL_VISITED;
+        }
+
+        // 구간을 둘러싼 3줄 열기, 위/아래 줄의 빈칸 구간마다 첫 칸을 프런티어에 추가
+        for (size_t row_y = seed_y - 1; row_y <= seed_y + 1; ++row_y)
+        {
+            if (row_y == 0 || row_y == rows + 1)
+            {
+                continue;
+            }
+
+            uint8_t* p_cells = p_counts + row_y * stride;
+
+            // 테두리 포함 열 -> 타일 인덱스 (부호 없는 정수 랩어라운드 이용)
+            const size_t tile_base = (row_y - 1) * cols - 1;
+
+            bool b_in_span = false;
+            for (size_t col_x = left - 1; col_x <= right + 1; ++col_x)
+            {
+                const uint8_t cell = p_cells[col_x];
+                if (cell & ENGINE_CELL_SENTINEL)
+                {
+                    continue;
+                }
+
+                open_cell(p_engine, tile_base + col_x, cell & ENGINE_CELL_COUNT_MASK);
+
+                if (row_y == seed_y)
+                {
+                    continue;
+                }
+
+                if (cell != 0)
+                {
+                    b_in_span = false;
+                    continue;
+                }
+
+                if (!b_in_span)
+                {
+                    ASSERT(num_frontier < p_engine->num_max_frontier, "Frontier overflow");
+
+                    p_cells[col_x] |= ENGINE_CELL_VISITED;
+                    p_frontier[num_frontier++] = row_y * stride + col_x;
+                    b_in_span = true;
+                }
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,192 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "safe99_common/defines.h"
+
+// 윈도우/렌더러/입력과 무관한 지뢰찾기 규칙 엔진
+// 좌표는 모두 타일 좌표 (x: 열, y: 행)
+
+typedef enum tile
+{
+    TILE_BLIND,
+    TILE_OPEN,
+    TILE_FLAG,
+    TILE_UNKNOWN,
+    TILE_OPEN_UNKNOWN,
+    TILE_MINE,
+    TILE_GAMEOVER_MINE,
+    TILE_FLAG_MINE,
+    TILE_1,
+    TILE_2,
+    TILE_3,
+    TILE_4,
+    TILE_5,
+    TILE_6,
+    TILE_7,
+    TILE_8,
+} tile_t;
+
+// 첫 번째로 여는 타일 처리 방식
+// 지뢰는 항상 첫 번째 열기 때 배치되므로 시작/재시작 비용은 판 크기와 무관함
+typedef enum engine_first_click
+{
+    ENGINE_FIRST_CLICK_ANY,         // 시드만으로 배치, 첫 타일도 지뢰일 수 있음
+    ENGINE_FIRST_CLICK_SAFE,        // 첫 타일은 지뢰가 아님
+    ENGINE_FIRST_CLICK_SAFE_AREA,   // 첫 타일과 주변 8칸은 지뢰가 아님 (칸이 모자라면 첫 타일만)
+} engine_first_click_t;
+
+typedef enum engine_status
+{
+    ENGINE_STATUS_PLAYING,
+    ENGINE_STATUS_WON,
+    ENGINE_STATUS_LOST,
+} engine_status_t;
+
+// 한 프레임에 개별로 기록하는 변경 타일 최대 개수, 넘으면 전체 다시 그리기
+#define ENGINE_MAX_DIRTY_TILES 4096
+
+// 스냅숏에 아직 복사하지 않은 타일을 기록하는 단위 (타일 수)
+#define ENGINE_SAVE_BLOCK_TILES 1024
+
+#define ENGINE_TILE_MASK 0xff
+#define ENGINE_GENERATION_SHIFT 8
+#define ENGINE_MAX_GENERATION 0xffffff
+
+#define ENGINE_CELL_SENTINEL 0x80
+#define ENGINE_CELL_VISITED 0x40
+#define ENGINE_CELL_COUNT_MASK 0x0f
+
+typedef struct engine
+{
+    size_t rows;
+    size_t cols;
+    // 남은 지뢰 표시 개수, 깃발을 지뢰보다 많이 꽂으면 음수
+    int64_t num_mines;
+    size_t num_max_mines;
+
+    // 열지 않은 타일 개수
+    size_t num_tiles;
+
+    // 하위 8비트는 tile_t, 상위 24비트는 세대
+    // 세대가 generation과 다른 칸은 TILE_BLIND로 취급하므로 재시작 때 지우지 않음
+    uint32_t* pa_tiles;
+    uint32_t generation;
+
+    // 마지막 engine_clear_dirty() 이후 바뀐 타일 인덱스
+    // pa_dirty_bits는 중복 방지용 타일당 1비트, 목록에 있는 타일만 비트가 켜져 있음
+    uint64_t* pa_dirty_bits;
+    size_t* pa_dirty_indices;
+    size_t num_dirty;
+    bool b_full_redraw;
+
+    // 스냅숏 (snapshot_writer_request)이 마지막으로 복사한 뒤 바뀐 타일 블록, ENGINE_SAVE_BLOCK_TILES개마다 1비트
+    // 재시작은 세대만 바꾸므로 기록하지 않고, 세대가 한 바퀴 돌아 전체를 지울 때만 b_all_unsaved
+    // 지뢰는 배치할 때 b_mines_unsaved, 복사한 쪽이 지움
+    uint64_t* pa_unsaved_bits;
+    size_t num_unsaved_words;
+    bool b_all_unsaved;
+    bool b_mines_unsaved;
+
+    // 지뢰 비트 평면 (bitboard.h 참고)
+    uint64_t* pa_mine_bits;
+    size_t num_mine_words;
+
+    // 지뢰가 있는 타일 인덱스 (y * cols + x), num_max_mines개
+    // 게임 오버 때 전체 칸 대신 지뢰만 순회
+    size_t* pa_mine_indices;
+
+    // 센티널 테두리 1칸을 포함한 (rows + 2) * (cols + 2) 격자
+    // 칸마다 인접 지뢰 개수, 테두리는 ENGINE_CELL_SENTINEL 비트가 켜져 있음
+    // flood fill로 확장한 빈칸은 ENGINE_CELL_VISITED 비트가 켜짐
+    uint8_t* pa_counts;
+    size_t count_stride;
+
+    // flood fill 프런티어, 초기화 때 한 번만 할당하고 재사용
+    size_t* pa_frontier;
+    size_t num_max_frontier;
+
+    // 현재 판의 시드, 같은 시드/크기/지뢰 개수/첫 타일이면 같은 판이 만들어짐
+    uint64_t seed;
+
+    engine_first_click_t first_click;
+    bool b_mines_placed;
+
+    engine_status_t status;
+} engine_t;
+
+START_EXTERN_C
+
+// rows, cols는 0보다 커야 함
+// num_mines는 [0 < num_mines < rows * cols]
+//
+// 이미 초기화한 엔진을 다시 초기화하지 말 것
+// 해야 한다면 engine_release() 호출 이후 재호출
+bool engine_init(engine_t* p_engine, const size_t rows, const size_t cols, const size_t num_mines, const uint64_t seed);
+void engine_release(engine_t* p_engine);
+
+// 같은 크기/지뢰 개수, 새 시드로 새 게임 시작
+// 세대만 바꾸므로 O(1)
+void engine_restart(engine_t* p_engine, const uint64_t seed);
+
+// 지뢰를 시드로 뽑지 않고 밖에서 채울 때 사용 (저장한 판 읽기 등)
+// 지뢰를 배치하기 전에 pa_mine_bits (테두리 줄 포함 0으로 지운 뒤)와 pa_mine_indices를 num_max_mines개 채우고 호출
+// 인접 지뢰 개수를 다시 계산하고 이미 열린 빈칸을 방문한 칸으로 표시, 판 크기에 비례
+void engine_load_mines(engine_t* p_engine);
+
+// 지뢰를 배치하기 전에만 시드를 바꿈, 이미 배치했으면 false
+// 첫 클릭 전에 꽂은 깃발은 그대로 둠
+bool engine_set_seed(engine_t* p_engine, const uint64_t seed);
+
+// 다음 판부터 적용 (이미 지뢰를 배치했다면)
+void engine_set_first_click(engine_t* p_engine, const engine_first_click_t first_click);
+
+// 타일 열기, 지뢰를 열면 패배
+// 지뢰가 아닌 타일을 모두 열면 승리, 남은 지뢰에는 깃발을 꽂음
+// 게임 오버/범위 밖/깃발/이미 열린 타일이면 아무것도 하지 않고 false 반환
+bool engine_open(engine_t* p_engine, const size_t x, const size_t y);
+
+// 깃발 -> 물음표 -> 없음 순환
+// 게임 오버/범위 밖/열린 타일이면 아무것도 하지 않고 false 반환
+bool engine_cycle_flag(engine_t* p_engine, const size_t x, const size_t y);
+
+engine_status_t engine_get_status(const engine_t* p_engine);
+bool engine_is_gameover(const engine_t* p_engine);
+bool engine_is_win(const engine_t* p_engine);
+
+tile_t engine_get_tile(const engine_t* p_engine, const size_t x, const size_t y);
+
+// 타일 인덱스 (y * cols + x)로 읽기, 범위를 검사하지 않음
+FORCEINLINE tile_t engine_get_tile_at(const engine_t* p_engine, const size_t index)
+{
+    const uint32_t state = p_engine->pa_tiles[index];
+    return ((state >> ENGINE_GENERATION_SHIFT) == p_engine->generation) ? (tile_t)(state & ENGINE_TILE_MASK) : TILE_BLIND;
+}
+
+// 보이는 판 상태 (모든 타일, 남은 지뢰 표시, 상태)의 64비트 해시
+// 같은 시드에 같은 행동을 하면 같은 값, 판 크기에 비례
+uint64_t engine_get_hash(const engine_t* p_engine);
+
+// 지뢰를 아직 배치하지 않았으면 false
+bool engine_is_mine(const engine_t* p_engine, const size_t x, const size_t y);
+
+// 타일 상태가 바뀌면 엔진이 직접 기록함
+// 눌림 표시처럼 화면에서만 바뀌는 타일은 engine_mark_dirty()로 기록
+void engine_mark_dirty(engine_t* p_engine, const size_t x, const size_t y);
+void engine_request_full_redraw(engine_t* p_engine);
+
+// 전체를 다시 그려야 하면 true, 이때 목록은 무시
+bool engine_is_full_redraw(const engine_t* p_engine);
+
+// 바뀐 타일 인덱스 (y * cols + x) 목록
+const size_t* engine_get_dirty_tiles(const engine_t* p_engine, size_t* p_out_num_dirty);
+
+// 그린 뒤 호출, 기록한 타일 개수에 비례
+void engine_clear_dirty(engine_t* p_engine);
+
+END_EXTERN_C
+
+#endif // ENGINE_H
\ No newline at end of file
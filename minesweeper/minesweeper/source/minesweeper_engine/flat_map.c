@@ -0,0 +1,429 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "flat_map.h"
+#include "safe99_common/assert.h"
+#include "safe99_common/safe_delete.h"
+
+#if defined(ENABLE_SSE_INTRINSICS)
+    #include <emmintrin.h>
+#endif // ENABLE_SSE_INTRINSICS
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif // _MSC_VER
+
+// 제어 바이트, 차 있는 슬롯은 섞은 해시의 상위 7비트 (0 ~ 127)
+// 비었음/지움은 최상위 비트가 켜져 있으므로 부호만 보면 넣을 자리인지 알 수 있음
+#define CONTROL_EMPTY ((int8_t)-128)
+#define CONTROL_DELETED ((int8_t)-2)
+
+#define NOT_FOUND ((size_t)-1)
+
+static size_t find_slot(const flat_map_t* p_map, const uint64_t hash, const void* p_key);
+static size_t find_insert_slot(const flat_map_t* p_map, const uint64_t hash);
+static bool rebuild(flat_map_t* p_map, const size_t num_slots);
+static size_t get_num_max_elements(const size_t num_slots);
+
+static FORCEINLINE uint64_t mix_hash(const uint64_t hash);
+static FORCEINLINE int8_t get_control(const uint64_t mixed_hash);
+static FORCEINLINE size_t get_first_group(const flat_map_t* p_map, const uint64_t mixed_hash);
+static FORCEINLINE char* get_slot(const flat_map_t* p_map, const size_t slot);
+
+static FORCEINLINE uint32_t match_control(const int8_t* p_group, const int8_t control);
+static FORCEINLINE uint32_t match_empty_or_deleted(const int8_t* p_group);
+static FORCEINLINE uint32_t get_lowest_bit(const uint32_t mask);
+
+bool flat_map_init(flat_map_t* p_map, const size_t key_size, const size_t value_size, const size_t num_max_elements, flat_map_hash_func pf_hash)
+{
+    ASSERT(p_map != NULL, "p_map == NULL");
+    ASSERT(key_size > 0, "key_size == 0");
+    ASSERT(value_size > 0, "value_size == 0");
+
+    memset(p_map, 0, sizeof(flat_map_t));
+
+    p_map->pf_hash = (pf_hash != NULL) ? pf_hash : flat_map_hash;
+    p_map->key_size = key_size;
+    p_map->value_size = value_size;
+    p_map->value_offset = (key_size + 7) & ~(size_t)7;
+    p_map->slot_size = (p_map->value_offset + value_size + 7) & ~(size_t)7;
+
+    size_t num_slots = FLAT_MAP_GROUP_SIZE;
+    while (get_num_max_elements(num_slots) < num_max_elements)
+    {
+        num_slots *= 2;
+    }
+
+    if (!rebuild(p_map, num_slots))
+    {
+        ASSERT(false, "Failed to malloc slots");
+        memset(p_map, 0, sizeof(flat_map_t));
+        return false;
+    }
+
+    return true;
+}
+
+void flat_map_release(flat_map_t* p_map)
+{
+    ASSERT(p_map != NULL, "p_map == NULL");
+
+    SAFE_FREE(p_map->pa_controls);
+    SAFE_FREE(p_map->pa_slots);
+
+    memset(p_map, 0, sizeof(flat_map_t));
+}
+
+void flat_map_clear(flat_map_t* p_map)
+{
+    ASSERT(p_map != NULL, "p_map == NULL");
+
+    memset(p_map->pa_controls, CONTROL_EMPTY, p_map->num_slots);
+    p_map->num_elements = 0;
+    p_map->num_growth_left = get_num_max_elements(p_map->num_slots);
+}
+
+uint64_t flat_map_hash(const void* p_key, const size_t key_size)
+{
+    ASSERT(p_key != NULL, "p_key == NULL");
+
+    const uint8_t* p_bytes = (const uint8_t*)p_key;
+
+    uint64_t hash = 0xcbf29ce484222325;
+    for (size_t i = 0; i < key_size; ++i)
+    {
+        hash ^= p_bytes[i];
+        hash *= 0x100000001b3;
+    }
+
+    return hash;
+}
+
+uint64_t flat_map_get_hash(const flat_map_t* p_map, const void* p_key)
+{
+    ASSERT(p_map != NULL, "p_map == NULL");
+    return p_map->pf_hash(p_key, p_map->key_size);
+}
+
+bool flat_map_insert(flat_map_t* p_map, const void* p_key, const size_t key_size, const void* p_value, const size_t value_size)
+{
+    return flat_map_insert_by_hash(p_map, flat_map_get_hash(p_map, p_key), p_key, key_size, p_value, value_size);
+}
+
+bool flat_map_insert_by_hash(flat_map_t* p_map, const uint64_t hash, const void* p_key, const size_t key_size, const void* p_value, const size_t value_size)
+{
+    ASSERT(p_map != NULL, "p_map == NULL");
+    ASSERT(p_key != NULL, "p_key == NULL");
+    ASSERT(p_value != NULL, "p_value == NULL");
+    ASSERT(key_size == p_map->key_size, "Invalid key size");
+    ASSERT(value_size == p_map->value_size, "Invalid value size");
+
+    if (find_slot(p_map, hash, p_key) != NOT_FOUND)
+    {
+        return false;
+    }
+
+    size_t slot = find_insert_slot(p_map, hash);
+
+    // 빈 슬롯을 써야 하는데 남은 게 없으면 다시 만듦, 지움 표시가 대부분이면 크기는 그대로
+    if (p_map->num_growth_left == 0 && p_map->pa_controls[slot] == CONTROL_EMPTY)
+    {
+        const size_t num_slots = (p_map->num_elements < get_num_max_elements(p_map->num_slots) / 2) ? p_map->num_slots : p_map->num_slots * 2;
+        if (!rebuild(p_map, num_slots))
+        {
+            ASSERT(false, "Failed to grow flat map");
+            return false;
+        }
+
+        slot = find_insert_slot(p_map, hash);
+    }
+
+    if (p_map->pa_controls[slot] == CONTROL_EMPTY)
+    {
+        --p_map->num_growth_left;
+    }
+
+    p_map->pa_controls[slot] = get_control(mix_hash(hash));
+
+    char* p_slot = get_slot(p_map, slot);
+    memcpy(p_slot, p_key, key_size);
+    memcpy(p_slot + p_map->value_offset, p_value, value_size);
+
+    ++p_map->num_elements;
+
+    return true;
+}
+
+bool flat_map_remove(flat_map_t* p_map, const void* p_key, const size_t key_size)
+{
+    return flat_map_remove_by_hash(p_map, flat_map_get_hash(p_map, p_key), p_key, key_size);
+}
+
+bool flat_map_remove_by_hash(flat_map_t* p_map, const uint64_t hash, const void* p_key, const size_t key_size)
+{
+    ASSERT(p_map != NULL, "p_map == NULL");
+    ASSERT(p_key != NULL, "p_key == NULL");
+    ASSERT(key_size == p_map->key_size, "Invalid key size");
+
+    const size_t slot = find_slot(p_map, hash, p_key);
+    if (slot == NOT_FOUND)
+    {
+        return false;
+    }
+
+    // 묶음에 빈 슬롯이 이미 있으면 찾기가 이 묶음을 넘어가지 않으므로 지움 표시 없이 비움
+    // 묶음이 한 번 가득 차면 다시 만들거나 비울 때까지 빈 슬롯이 생기지 않으므로 이 묶음을 지나간 키는 없음
+    const int8_t* p_group = p_map->pa_controls + (slot & ~(size_t)(FLAT_MAP_GROUP_SIZE - 1));
+    if (match_control(p_group, CONTROL_EMPTY) != 0)
+    {
+        p_map->pa_controls[slot] = CONTROL_EMPTY;
+        ++p_map->num_growth_left;
+    }
+    else
+    {
+        p_map->pa_controls[slot] = CONTROL_DELETED;
+    }
+
+    --p_map->num_elements;
+
+    return true;
+}
+
+size_t flat_map_get_num_elements(const flat_map_t* p_map)
+{
+    ASSERT(p_map != NULL, "p_map == NULL");
+    return p_map->num_elements;
+}
+
+size_t flat_map_get_num_max_elements(const flat_map_t* p_map)
+{
+    ASSERT(p_map != NULL, "p_map == NULL");
+    return get_num_max_elements(p_map->num_slots);
+}
+
+void* flat_map_get_value_or_null(flat_map_t* p_map, const void* p_key, const size_t key_size)
+{
+    return flat_map_get_value_by_hash_or_null(p_map, flat_map_get_hash(p_map, p_key), p_key, key_size);
+}
+
+void* flat_map_get_value_by_hash_or_null(flat_map_t* p_map, const uint64_t hash, const void* p_key, const size_t key_size)
+{
+    ASSERT(p_map != NULL, "p_map == NULL");
+    ASSERT(p_key != NULL, "p_key == NULL");
+    ASSERT(key_size == p_map->key_size, "Invalid key size");
+
+    const size_t slot = find_slot(p_map, hash, p_key);
+    if (slot == NOT_FOUND)
+    {
+        return NULL;
+    }
+
+    return get_slot(p_map, slot) + p_map->value_offset;
+}
+
+bool flat_map_get_next(flat_map_t* p_map, size_t* p_slot, void** pp_out_key, void** pp_out_value)
+{
+    ASSERT(p_map != NULL, "p_map == NULL");
+    ASSERT(p_slot != NULL, "p_slot == NULL");
+
+    for (size_t slot = *p_slot; slot < p_map->num_slots; ++slot)
+    {
+        if (p_map->pa_controls[slot] < 0)
+        {
+            continue;
+        }
+
+        char* p_entry = get_slot(p_map, slot);
+        if (pp_out_key != NULL)
+        {
+            *pp_out_key = p_entry;
+        }
+        if (pp_out_value != NULL)
+        {
+            *pp_out_value = p_entry + p_map->value_offset;
+        }
+
+        *p_slot = slot + 1;
+        return true;
+    }
+
+    *p_slot = p_map->num_slots;
+    return false;
+}
+
+static size_t find_slot(const flat_map_t* p_map, const uint64_t hash, const void* p_key)
+{
+    const uint64_t mixed_hash = mix_hash(hash);
+    const int8_t control = get_control(mixed_hash);
+    const size_t group_mask = p_map->num_slots / FLAT_MAP_GROUP_SIZE - 1;
+
+    // 묶음 수가 2의 거듭제곱이므로 1, 2, 3, ...씩 건너뛰면 모든 묶음을 한 번씩 지남
+    // 7/8 이상은 채우지 않으므로 빈 슬롯이 있는 묶음을 반드시 만남
+    size_t group = get_first_group(p_map, mixed_hash);
+    for (size_t step = 1; ; ++step)
+    {
+        const size_t first_slot = group * FLAT_MAP_GROUP_SIZE;
+        const int8_t* p_group = p_map->pa_controls + first_slot;
+
+        uint32_t mask = match_control(p_group, control);
+        while (mask != 0)
+        {
+            const size_t slot = first_slot + get_lowest_bit(mask);
+            if (memcmp(get_slot(p_map, slot), p_key, p_map->key_size) == 0)
+            {
+                return slot;
+            }
+
+            mask &= mask - 1;
+        }
+
+        if (match_control(p_group, CONTROL_EMPTY) != 0)
+        {
+            return NOT_FOUND;
+        }
+
+        group = (group + step) & group_mask;
+    }
+}
+
+// 찾기와 같은 순서로 지나가며 처음 만나는 빈 슬롯/지움 표시
+static size_t find_insert_slot(const flat_map_t* p_map, const uint64_t hash)
+{
+    const size_t group_mask = p_map->num_slots / FLAT_MAP_GROUP_SIZE - 1;
+
+    size_t group = get_first_group(p_map, mix_hash(hash));
+    for (size_t step = 1; ; ++step)
+    {
+        const size_t first_slot = group * FLAT_MAP_GROUP_SIZE;
+
+        const uint32_t mask = match_empty_or_deleted(p_map->pa_controls + first_slot);
+        if (mask != 0)
+        {
+            return first_slot + get_lowest_bit(mask);
+        }
+
+        group = (group + step) & group_mask;
+    }
+}
+
+// num_slots개 슬롯을 새로 잡고 차 있는 슬롯만 옮김 (지움 표시는 사라짐)
+// 실패하면 그대로 둠
+static bool rebuild(flat_map_t* p_map, const size_t num_slots)
+{
+    ASSERT(num_slots >= FLAT_MAP_GROUP_SIZE && (num_slots & (num_slots - 1)) == 0, "Invalid num_slots");
+    ASSERT(get_num_max_elements(num_slots) >= p_map->num_elements, "Too many elements");
+
+    int8_t* pa_controls = (int8_t*)malloc(num_slots);
+    char* pa_slots = (char*)malloc(num_slots * p_map->slot_size);
+    if (pa_controls == NULL || pa_slots == NULL)
+    {
+        free(pa_controls);
+        free(pa_slots);
+        return false;
+    }
+    memset(pa_controls, CONTROL_EMPTY, num_slots);
+
+    int8_t* pa_old_controls = p_map->pa_controls;
+    char* pa_old_slots = p_map->pa_slots;
+    const size_t num_old_slots = p_map->num_slots;
+
+    p_map->pa_controls = pa_controls;
+    p_map->pa_slots = pa_slots;
+    p_map->num_slots = num_slots;
+    p_map->num_growth_left = get_num_max_elements(num_slots) - p_map->num_elements;
+
+    // 이전 맵의 키는 모두 다르므로 비교 없이 빈 슬롯에 넣음
+    for (size_t i = 0; i < num_old_slots; ++i)
+    {
+        if (pa_old_controls[i] < 0)
+        {
+            continue;
+        }
+
+        const char* p_old_slot = pa_old_slots + i * p_map->slot_size;
+        const uint64_t hash = p_map->pf_hash(p_old_slot, p_map->key_size);
+
+        const size_t slot = find_insert_slot(p_map, hash);
+        p_map->pa_controls[slot] = get_control(mix_hash(hash));
+        memcpy(get_slot(p_map, slot), p_old_slot, p_map->slot_size);
+    }
+
+    free(pa_old_controls);
+    free(pa_old_slots);
+
+    return true;
+}
+
+static size_t get_num_max_elements(const size_t num_slots)
+{
+    return num_slots - num_slots / 8;
+}
+
+static FORCEINLINE uint64_t mix_hash(const uint64_t hash)
+{
+    return (hash ^ (hash >> 32)) * 0x9e3779b97f4a7c15;
+}
+
+static FORCEINLINE int8_t get_control(const uint64_t mixed_hash)
+{
+    return (int8_t)(mixed_hash >> 57);
+}
+
+static FORCEINLINE size_t get_first_group(const flat_map_t* p_map, const uint64_t mixed_hash)
+{
+    return (size_t)(mixed_hash >> 7) & (p_map->num_slots / FLAT_MAP_GROUP_SIZE - 1);
+}
+
+static FORCEINLINE char* get_slot(const flat_map_t* p_map, const size_t slot)
+{
+    return p_map->pa_slots + slot * p_map->slot_size;
+}
+
+// 묶음에서 control과 같은 슬롯마다 비트 하나
+static FORCEINLINE uint32_t match_control(const int8_t* p_group, const int8_t control)
+{
+#if defined(ENABLE_SSE_INTRINSICS)
+    const __m128i controls = _mm_loadu_si128((const __m128i*)p_group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(controls, _mm_set1_epi8(control)));
+#else
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < FLAT_MAP_GROUP_SIZE; ++i)
+    {
+        mask |= (uint32_t)(p_group[i] == control) << i;
+    }
+    return mask;
+#endif // ENABLE_SSE_INTRINSICS
+}
+
+static FORCEINLINE uint32_t match_empty_or_deleted(const int8_t* p_group)
+{
+#if defined(ENABLE_SSE_INTRINSICS)
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)p_group));
+#else
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < FLAT_MAP_GROUP_SIZE; ++i)
+    {
+        mask |= (uint32_t)(p_group[i] < 0) << i;
+    }
+    return mask;
+#endif // ENABLE_SSE_INTRINSICS
+}
+
+// mask != 0
+static FORCEINLINE uint32_t get_lowest_bit(const uint32_t mask)
+{
+#if defined(__GNUC__)
+    return (uint32_t)__builtin_ctz(mask);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (uint32_t)index;
+#else
+    uint32_t index = 0;
+    while (((mask >> index) & 1) == 0)
+    {
+        ++index;
+    }
+    return index;
+#endif // __GNUC__
+}
\ No newline at end of file
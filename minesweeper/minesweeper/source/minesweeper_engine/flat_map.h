@@ -0,0 +1,87 @@
+#ifndef FLAT_MAP_H
+#define FLAT_MAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "safe99_common/defines.h"
+
+// 키/값을 슬롯 배열에 그대로 넣는 개방 주소법 해시 맵 (Swiss table 방식)
+// safe99_core의 map_t와 같은 쓰임새로, 찾기가 제어 바이트 16개 한 묶음과 슬롯 하나만 읽음
+//
+// 슬롯마다 제어 바이트가 하나씩 있음: 비었음 / 지움 / 해시 7비트 (0 ~ 127)
+// 해시로 시작 묶음을 정하고 묶음 16개를 SSE2 비교 한 번으로 거른 뒤, 7비트가 같은 슬롯만 키를 비교함
+// 묶음에 빈 슬롯이 있으면 거기서 찾기를 멈추고, 없으면 다음 묶음 (1, 2, 3, ... 묶음씩 건너뜀)
+// 차 있는 슬롯과 지움 표시가 7/8을 넘으면 다시 만듦 (원소가 절반 이하면 크기는 그대로)
+//
+// 넣기/제거 후에는 이전에 받은 키/값 포인터가 무효일 수 있음
+
+#define FLAT_MAP_GROUP_SIZE 16
+
+typedef uint64_t (*flat_map_hash_func)(const void* p_key, const size_t key_size);
+
+typedef struct flat_map
+{
+    // 다시 만들 때 키에서 해시를 다시 구함
+    flat_map_hash_func pf_hash;
+
+    size_t key_size;
+    size_t value_size;
+    // 슬롯 안에서 값의 위치, 슬롯 크기 (8바이트 정렬)
+    size_t value_offset;
+    size_t slot_size;
+
+    // 2의 거듭제곱, FLAT_MAP_GROUP_SIZE 이상
+    size_t num_slots;
+    size_t num_elements;
+    // 다시 만들기 전까지 더 쓸 수 있는 빈 슬롯 수 (지움 표시는 빈 슬롯으로 치지 않음)
+    size_t num_growth_left;
+
+    int8_t* pa_controls;
+    char* pa_slots;
+} flat_map_t;
+
+START_EXTERN_C
+
+// key_size는 0보다 커야 함
+// value_size는 0보다 커야 함
+// num_max_elements개까지는 다시 만들지 않음, 넘으면 두 배씩 늘어남
+// pf_hash가 NULL이면 flat_map_hash
+//
+// 이미 초기화 된 맵을 다시 초기화하지 말 것
+// 해야 한다면 flat_map_release() 호출 이후에 초기화 진행
+bool flat_map_init(flat_map_t* p_map, const size_t key_size, const size_t value_size, const size_t num_max_elements, flat_map_hash_func pf_hash);
+void flat_map_release(flat_map_t* p_map);
+
+// 크기는 그대로 두고 모두 제거
+void flat_map_clear(flat_map_t* p_map);
+
+// 기본 해시 (FNV-1a, map_t의 기본 해시와 같음)
+uint64_t flat_map_hash(const void* p_key, const size_t key_size);
+
+// _by_hash 함수에는 이 값을 넘겨야 함, 여러 번 찾을 키면 한 번만 구해서 재사용
+uint64_t flat_map_get_hash(const flat_map_t* p_map, const void* p_key);
+
+// 이미 있는 키거나 늘리지 못하면 false
+bool flat_map_insert(flat_map_t* p_map, const void* p_key, const size_t key_size, const void* p_value, const size_t value_size);
+bool flat_map_insert_by_hash(flat_map_t* p_map, const uint64_t hash, const void* p_key, const size_t key_size, const void* p_value, const size_t value_size);
+
+bool flat_map_remove(flat_map_t* p_map, const void* p_key, const size_t key_size);
+bool flat_map_remove_by_hash(flat_map_t* p_map, const uint64_t hash, const void* p_key, const size_t key_size);
+
+size_t flat_map_get_num_elements(const flat_map_t* p_map);
+
+// 다시 만들지 않고 넣을 수 있는 최대 원소 수
+size_t flat_map_get_num_max_elements(const flat_map_t* p_map);
+
+void* flat_map_get_value_or_null(flat_map_t* p_map, const void* p_key, const size_t key_size);
+void* flat_map_get_value_by_hash_or_null(flat_map_t* p_map, const uint64_t hash, const void* p_key, const size_t key_size);
+
+// 모든 원소 순회, *p_slot은 0에서 시작
+// 다음 원소가 없으면 false, 순회 중에는 넣기/제거 금지
+bool flat_map_get_next(flat_map_t* p_map, size_t* p_slot, void** pp_out_key, void** pp_out_value);
+
+END_EXTERN_C
+
+#endif // FLAT_MAP_H
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "generator.h"
+#include "random.h"
+#include "safe99_common/assert.h"
+#include "safe99_common/safe_delete.h"
+
+static void run_worker(void* p_context, const size_t job_index, const size_t worker_index);
+static bool try_candidate(generator_t* p_generator, generator_worker_t* p_worker, const uint64_t candidate);
+
+bool generator_init(generator_t* p_generator, thread_pool_t* p_pool, const size_t rows, const size_t cols, const size_t num_mines, const engine_first_click_t first_click)
+{
+    ASSERT(p_generator != NULL, "p_generator == NULL");
+
+    memset(p_generator, 0, sizeof(generator_t));
+
+    p_generator->p_pool = p_pool;
+    p_generator->num_workers = (p_pool == NULL) ? 1 : thread_pool_get_num_threads(p_pool);
+
+    p_generator->pa_workers = (generator_worker_t*)malloc(sizeof(generator_worker_t) * p_generator->num_workers);
+    if (p_generator->pa_workers == NULL)
+    {
+        ASSERT(false, "Failed to malloc workers");
+        goto failed_malloc_workers;
+    }
+
+    size_t num_ready = 0;
+    for (; num_ready < p_generator->num_workers; ++num_ready)
+    {
+        generator_worker_t* p_worker = &p_generator->pa_workers[num_ready];
+        if (!engine_init(&p_worker->engine, rows, cols, num_mines, 0))
+        {
+            goto failed_init_workers;
+        }
+        engine_set_first_click(&p_worker->engine, first_click);
+
+        if (!solver_init(&p_worker->solver, &p_worker->engine))
+        {
+            engine_release(&p_worker->engine);
+            goto failed_init_workers;
+        }
+    }
+
+    return true;
+
+failed_init_workers:
+    for (size_t i = 0; i < num_ready; ++i)
+    {
+        solver_release(&p_generator->pa_workers[i].solver);
+        engine_release(&p_generator->pa_workers[i].engine);
+    }
+    SAFE_FREE(p_generator->pa_workers);
+
+failed_malloc_workers:
+    memset(p_generator, 0, sizeof(generator_t));
+    return false;
+}
+
+void generator_release(generator_t* p_generator)
+{
+    ASSERT(p_generator != NULL, "p_generator == NULL");
+
+    for (size_t i = 0; i < p_generator->num_workers; ++i)
+    {
+        solver_release(&p_generator->pa_workers[i].solver);
+        engine_release(&p_generator->pa_workers[i].engine);
+    }
+    SAFE_FREE(p_generator->pa_workers);
+
+    memset(p_generator, 0, sizeof(generator_t));
+}
+
+bool generator_find_seed(generator_t* p_generator, const size_t first_x, const size_t first_y, const uint64_t seed, const uint64_t num_max_candidates, uint64_t* p_out_seed)
+{
+    ASSERT(p_generator != NULL, "p_generator == NULL");
+    ASSERT(p_out_seed != NULL, "p_out_seed == NULL");
+    ASSERT(first_x < p_generator->pa_workers[0].engine.cols && first_y < p_generator->pa_workers[0].engine.rows, "Out of range");
+
+    p_generator->first_x = first_x;
+    p_generator->first_y = first_y;
+    p_generator->seed = seed;
+    p_generator->num_max_candidates = num_max_candidates;
+
+    atomic_store_u64(&p_generator->next_candidate, 0);
+    atomic_store_u64(&p_generator->best_candidate, UINT64_MAX);
+    atomic_store_u64(&p_generator->num_tried_candidates, 0);
+
+    // 작업자마다 일감 하나, 일감 안에서 후보를 계속 가져감
+    if (p_generator->p_pool != NULL)
+    {
+        thread_pool_run(p_generator->p_pool, run_worker, p_generator, p_generator->num_workers);
+    }
+    else
+    {
+        run_worker(p_generator, 0, 0);
+    }
+
+    const uint64_t best_candidate = atomic_load_u64(&p_generator->best_candidate);
+    if (best_candidate == UINT64_MAX)
+    {
+        return false;
+    }
+
+    *p_out_seed = random_mix_seed(seed + best_candidate);
+    return true;
+}
+
+uint64_t generator_get_num_tried_candidates(const generator_t* p_generator)
+{
+    ASSERT(p_generator != NULL, "p_generator == NULL");
+    return atomic_load_u64(&p_generator->num_tried_candidates);
+}
+
+// job_index마다 엔진이 따로 있으므로 같은 작업자 스레드가 일감 두 개를 이어서 맡아도 됨
+static void run_worker(void* p_context, const size_t job_index, const size_t worker_index)
+{
+    generator_t* p_generator = (generator_t*)p_context;
+    generator_worker_t* p_worker = &p_generator->pa_workers[job_index];
+
+    (void)worker_index;
+
+    while (true)
+    {
+        const uint64_t candidate = atomic_fetch_add_u64(&p_generator->next_candidate, 1);
+        if (candidate >= p_generator->num_max_candidates || candidate > atomic_load_u64(&p_generator->best_candidate))
+        {
+            break;
+        }
+
+        atomic_fetch_add_u64(&p_generator->num_tried_candidates, 1);
+
+        if (!try_candidate(p_generator, p_worker, candidate))
+        {
+            continue;
+        }
+
+        // 더 앞 후보가 이미 풀렸으면 그대로 둠
+        uint64_t best_candidate = atomic_load_u64(&p_generator->best_candidate);
+        while (candidate < best_candidate && !atomic_compare_exchange_u64(&p_generator->best_candidate, best_candidate, candidate))
+        {
+            best_candidate = atomic_load_u64(&p_generator->best_candidate);
+        }
+    }
+}
+
+// 추론기가 찾은 안전한 칸만 열어서 이기면 true
+// 더 앞 후보가 풀리면 풀던 중이라도 그만둠
+static bool try_candidate(generator_t* p_generator, generator_worker_t* p_worker, const uint64_t candidate)
+{
+    engine_t* p_engine = &p_worker->engine;
+    solver_t* p_solver = &p_worker->solver;
+
+    engine_restart(p_engine, random_mix_seed(p_generator->seed + candidate));
+    engine_open(p_engine, p_generator->first_x, p_generator->first_y);
+
+    solver_update(p_solver);
+    engine_clear_dirty(p_engine);
+
+    while (engine_get_status(p_engine) == ENGINE_STATUS_PLAYING)
+    {
+        if (atomic_load_u64(&p_generator->best_candidate) < candidate)
+        {
+            return false;
+        }
+
+        solver_deduce(p_solver);
+
+        size_t num_safe_tiles;
+        const size_t* p_safe_tiles = solver_get_safe_tiles(p_solver, &num_safe_tiles);
+        if (num_safe_tiles == 0)
+        {
+            break;
+        }
+
+        // 열 때마다 반영해야 변경 타일 목록이 넘치지 않음
+        for (size_t i = 0; i < num_safe_tiles; ++i)
+        {
+            engine_open(p_engine, p_safe_tiles[i] % p_engine->cols, p_safe_tiles[i] / p_engine->cols);
+            solver_update(p_solver);
+            engine_clear_dirty(p_engine);
+        }
+        solver_clear_results(p_solver);
+    }
+
+    solver_clear_results(p_solver);
+    return engine_get_status(p_engine) == ENGINE_STATUS_WON;
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "engine.h"
+#include "solver.h"
+#include "thread_pool.h"
+#include "safe99_common/defines.h"
+
+// 첫 타일에서 시작해 추론기(solver.h)만으로 끝까지 풀리는 판의 시드를 찾음
+// 후보 i의 시드는 random_mix_seed(seed + i)이고 작업자마다 엔진/추론기를 따로 두고 후보를 하나씩 가져가 풀어 봄
+// 조건을 만족하는 가장 앞 후보를 고르므로 스레드 수, 실행 순서와 무관하게 같은 시드가 나옴
+// 앞 후보가 풀리면 그보다 뒤 후보는 풀던 중이라도 그만둠
+
+typedef struct generator_worker
+{
+    engine_t engine;
+    solver_t solver;
+} generator_worker_t;
+
+typedef struct generator
+{
+    // NULL이면 호출 스레드에서만 찾음
+    thread_pool_t* p_pool;
+    size_t num_workers;
+    generator_worker_t* pa_workers;
+
+    // generator_find_seed() 중에만 유효
+    size_t first_x;
+    size_t first_y;
+    uint64_t seed;
+    uint64_t num_max_candidates;
+
+    volatile uint64_t next_candidate;
+    // 풀린 후보 중 가장 앞, 없으면 UINT64_MAX
+    volatile uint64_t best_candidate;
+    volatile uint64_t num_tried_candidates;
+} generator_t;
+
+START_EXTERN_C
+
+// first_click은 찾은 시드로 판을 만들 엔진과 같아야 함 (ENGINE_FIRST_CLICK_SAFE_AREA 권장)
+// 작업자마다 판 크기만큼 메모리를 씀
+//
+// 이미 초기화한 생성기를 다시 초기화하지 말 것
+// 해야 한다면 generator_release() 호출 이후 재호출
+bool generator_init(generator_t* p_generator, thread_pool_t* p_pool, const size_t rows, const size_t cols, const size_t num_mines, const engine_first_click_t first_click);
+void generator_release(generator_t* p_generator);
+
+// (first_x, first_y)를 먼저 열면 추측 없이 풀리는 판의 시드
+// num_max_candidates개 안에서 찾지 못하면 false
+bool generator_find_seed(generator_t* p_generator, const size_t first_x, const size_t first_y, const uint64_t seed, const uint64_t num_max_candidates, uint64_t* p_out_seed);
+
+// 마지막 generator_find_seed()에서 풀어 본 후보 수
+uint64_t generator_get_num_tried_candidates(const generator_t* p_generator);
+
+END_EXTERN_C
+
+#endif // GENERATOR_H
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include <string.h>
+
+#include "mapped_file.h"
+#include "safe99_common/assert.h"
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif // _WIN32
+
+#if defined(_WIN32)
+
+bool mapped_file_open(mapped_file_t* p_file, const char* p_path)
+{
+    ASSERT(p_file != NULL, "p_file == NULL");
+    ASSERT(p_path != NULL, "p_path == NULL");
+
+    memset(p_file, 0, sizeof(mapped_file_t));
+
+    HANDLE file_handle = CreateFileA(p_path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file_handle == INVALID_HANDLE_VALUE)
+    {
+        goto failed_open_file;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file_handle, &size) || size.QuadPart <= 0 || (uint64_t)size.QuadPart > SIZE_MAX)
+    {
+        goto failed_get_size;
+    }
+
+    HANDLE mapping_handle = CreateFileMappingA(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping_handle == NULL)
+    {
+        goto failed_create_mapping;
+    }
+
+    const void* p_data = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+    if (p_data == NULL)
+    {
+        goto failed_map_view;
+    }
+
+    p_file->p_data = (const uint8_t*)p_data;
+    p_file->size = (size_t)size.QuadPart;
+    p_file->file_handle = file_handle;
+    p_file->mapping_handle = mapping_handle;
+
+    return true;
+
+failed_map_view:
+    CloseHandle(mapping_handle);
+
+failed_create_mapping:
+failed_get_size:
+    CloseHandle(file_handle);
+
+failed_open_file:
+    return false;
+}
+
+void mapped_file_close(mapped_file_t* p_file)
+{
+    ASSERT(p_file != NULL, "p_file == NULL");
+
+    if (p_file->p_data != NULL)
+    {
+        UnmapViewOfFile(p_file->p_data);
+        CloseHandle((HANDLE)p_file->mapping_handle);
+        CloseHandle((HANDLE)p_file->file_handle);
+    }
+
+    memset(p_file, 0, sizeof(mapped_file_t));
+}
+
+#else
+
+bool mapped_file_open(mapped_file_t* p_file, const char* p_path)
+{
+    ASSERT(p_file != NULL, "p_file == NULL");
+    ASSERT(p_path != NULL, "p_path == NULL");
+
+    memset(p_file, 0, sizeof(mapped_file_t));
+
+    const int fd = open(p_path, O_RDONLY);
+    if (fd < 0)
+    {
+        goto failed_open_file;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0 || (uint64_t)info.st_size > SIZE_MAX)
+    {
+        goto failed_get_size;
+    }
+
+    void* p_data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p_data == MAP_FAILED)
+    {
+        goto failed_map;
+    }
+
+    // 매핑은 파일을 닫아도 유지됨
+    close(fd);
+
+    p_file->p_data = (const uint8_t*)p_data;
+    p_file->size = (size_t)info.st_size;
+
+    return true;
+
+failed_map:
+failed_get_size:
+    close(fd);
+
+failed_open_file:
+    return false;
+}
+
+void mapped_file_close(mapped_file_t* p_file)
+{
+    ASSERT(p_file != NULL, "p_file == NULL");
+
+    if (p_file->p_data != NULL)
+    {
+        munmap((void*)p_file->p_data, p_file->size);
+    }
+
+    memset(p_file, 0, sizeof(mapped_file_t));
+}
+
+#endif // _WIN32
\ No newline at end of file
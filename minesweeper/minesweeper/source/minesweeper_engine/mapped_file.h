@@ -0,0 +1,32 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "safe99_common/defines.h"
+
+// 파일 전체를 읽기 전용으로 메모리에 매핑 (윈도우는 파일 매핑 객체, 그 밖은 mmap)
+// 읽기가 아니라 페이지 폴트로 필요한 부분만 올라오므로 큰 파일도 여는 비용이 크기와 무관함
+
+typedef struct mapped_file
+{
+    const uint8_t* p_data;
+    size_t size;
+
+#if defined(_WIN32)
+    void* file_handle;
+    void* mapping_handle;
+#endif // _WIN32
+} mapped_file_t;
+
+START_EXTERN_C
+
+// 빈 파일은 매핑할 수 없으므로 false
+bool mapped_file_open(mapped_file_t* p_file, const char* p_path);
+void mapped_file_close(mapped_file_t* p_file);
+
+END_EXTERN_C
+
+#endif // MAPPED_FILE_H
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "memory_pool.h"
+#include "safe99_common/assert.h"
+
+// 원소가 16바이트 경계에서 시작하도록 머리를 16바이트로 맞춤
+struct memory_pool_block
+{
+    memory_pool_block_t* p_next;
+    uint64_t padding;
+};
+
+#define ELEMENT_ALIGNMENT 16
+
+static memory_pool_block_t* alloc_block_or_null(const memory_pool_t* p_pool);
+
+bool memory_pool_init(memory_pool_t* p_pool, const size_t element_size, const size_t num_elements_per_block)
+{
+    ASSERT(p_pool != NULL, "p_pool == NULL");
+    ASSERT(element_size > 0, "element_size == 0");
+    ASSERT(num_elements_per_block > 0, "num_elements_per_block == 0");
+
+    memset(p_pool, 0, sizeof(memory_pool_t));
+
+    p_pool->element_size = (element_size + ELEMENT_ALIGNMENT - 1) & ~(size_t)(ELEMENT_ALIGNMENT - 1);
+    p_pool->num_elements_per_block = num_elements_per_block;
+
+    // 첫 블록은 미리 잡아서 초기화할 때 실패를 알림
+    p_pool->p_blocks = alloc_block_or_null(p_pool);
+    if (p_pool->p_blocks == NULL)
+    {
+        ASSERT(false, "Failed to malloc block");
+        memset(p_pool, 0, sizeof(memory_pool_t));
+        return false;
+    }
+    p_pool->p_current_block = p_pool->p_blocks;
+
+    return true;
+}
+
+void memory_pool_release(memory_pool_t* p_pool)
+{
+    ASSERT(p_pool != NULL, "p_pool == NULL");
+
+    memory_pool_block_t* p_block = p_pool->p_blocks;
+    while (p_block != NULL)
+    {
+        memory_pool_block_t* p_next = p_block->p_next;
+        free(p_block);
+        p_block = p_next;
+    }
+
+    memset(p_pool, 0, sizeof(memory_pool_t));
+}
+
+void* memory_pool_alloc_or_null(memory_pool_t* p_pool)
+{
+    ASSERT(p_pool != NULL, "p_pool == NULL");
+
+    void* p_element = p_pool->p_free_elements;
+    if (p_element != NULL)
+    {
+        p_pool->p_free_elements = *(void**)p_element;
+        return p_element;
+    }
+
+    // 지금 블록을 다 썼으면 reset 전에 잡아 둔 다음 블록, 없으면 새로 잡음
+    if (p_pool->num_used_elements == p_pool->num_elements_per_block)
+    {
+        memory_pool_block_t* p_next = p_pool->p_current_block->p_next;
+        if (p_next == NULL)
+        {
+            p_next = alloc_block_or_null(p_pool);
+            if (p_next == NULL)
+            {
+                return NULL;
+            }
+            p_pool->p_current_block->p_next = p_next;
+        }
+
+        p_pool->p_current_block = p_next;
+        p_pool->num_used_elements = 0;
+    }
+
+    p_element = (char*)(p_pool->p_current_block + 1) + p_pool->element_size * p_pool->num_used_elements;
+    ++p_pool->num_used_elements;
+
+    return p_element;
+}
+
+void memory_pool_dealloc(memory_pool_t* p_pool, void* p_element_or_null)
+{
+    ASSERT(p_pool != NULL, "p_pool == NULL");
+
+    if (p_element_or_null == NULL)
+    {
+        return;
+    }
+
+    *(void**)p_element_or_null = p_pool->p_free_elements;
+    p_pool->p_free_elements = p_element_or_null;
+}
+
+void memory_pool_reset(memory_pool_t* p_pool)
+{
+    ASSERT(p_pool != NULL, "p_pool == NULL");
+
+    p_pool->p_current_block = p_pool->p_blocks;
+    p_pool->num_used_elements = 0;
+    p_pool->p_free_elements = NULL;
+}
+
+static memory_pool_block_t* alloc_block_or_null(const memory_pool_t* p_pool)
+{
+    memory_pool_block_t* p_block = (memory_pool_block_t*)malloc(sizeof(memory_pool_block_t) + p_pool->element_size * p_pool->num_elements_per_block);
+    if (p_block != NULL)
+    {
+        p_block->p_next = NULL;
+    }
+
+    return p_block;
+}
\ No newline at end of file
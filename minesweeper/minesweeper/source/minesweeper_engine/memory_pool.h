@@ -0,0 +1,50 @@
+#ifndef MEMORY_POOL_H
+#define MEMORY_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "safe99_common/defines.h"
+
+// 같은 크기 원소를 블록 단위로 잡아 두고 나눠 주는 풀 (플랫폼 독립)
+// safe99_core의 chunked_memory_pool_t와 같은 쓰임새, 원소 주소는 돌려줄 때까지 바뀌지 않음
+// 돌려받은 원소는 목록에 모아 다음 할당에 먼저 씀
+// 블록은 memory_pool_release()에서만 해제하고, memory_pool_reset()은 블록을 그대로 두고 처음부터 다시 나눠 줌
+
+typedef struct memory_pool_block memory_pool_block_t;
+
+typedef struct memory_pool
+{
+    // 16바이트 배수
+    size_t element_size;
+    size_t num_elements_per_block;
+
+    // 잡은 순서대로 이어진 블록 목록, 지금 나눠 주는 블록과 그 블록에서 나눠 준 원소 수
+    memory_pool_block_t* p_blocks;
+    memory_pool_block_t* p_current_block;
+    size_t num_used_elements;
+
+    // 돌려받은 원소 목록, 원소 맨 앞에 다음 원소 포인터를 씀
+    void* p_free_elements;
+} memory_pool_t;
+
+START_EXTERN_C
+
+// element_size는 0보다 커야 함
+// num_elements_per_block은 0보다 커야 함
+//
+// 이미 초기화한 풀을 다시 초기화하지 말 것
+// 해야 한다면 memory_pool_release() 호출 이후 재호출
+bool memory_pool_init(memory_pool_t* p_pool, const size_t element_size, const size_t num_elements_per_block);
+void memory_pool_release(memory_pool_t* p_pool);
+
+// 블록을 더 잡지 못하면 NULL
+void* memory_pool_alloc_or_null(memory_pool_t* p_pool);
+void memory_pool_dealloc(memory_pool_t* p_pool, void* p_element_or_null);
+
+// 나눠 준 원소를 모두 돌려받은 것으로 침
+void memory_pool_reset(memory_pool_t* p_pool);
+
+END_EXTERN_C
+
+#endif // MEMORY_POOL_H
\ No newline at end of file
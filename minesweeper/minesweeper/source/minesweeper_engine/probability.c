@@ -0,0 +1,1149 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "probability.h"
+#include "safe99_common/assert.h"
+#include "safe99_common/safe_delete.h"
+
+// 그룹 크기는 한 숫자의 이웃 수를 넘지 않음
+static const double s_binomials[PROBABILITY_MAX_NEIGHBOURS + 1][PROBABILITY_MAX_NEIGHBOURS + 1] =
+{
+    { 1 },
+    { 1, 1 },
+    { 1, 2, 1 },
+    { 1, 3, 3, 1 },
+    { 1, 4, 6, 4, 1 },
+    { 1, 5, 10, 10, 5, 1 },
+    { 1, 6, 15, 20, 15, 6, 1 },
+    { 1, 7, 21, 35, 35, 21, 7, 1 },
+    { 1, 8, 28, 56, 70, 56, 28, 8, 1 },
+};
+
+// ln(n!), 작은 n은 표에서 읽고 나머지는 스털링 급수
+// 여러 스레드가 각자 확률을 계산하므로 전역 signgam을 쓰는 lgamma 대신 사용
+#define NUM_LOG_FACTORIALS 16
+
+static const double s_log_factorials[NUM_LOG_FACTORIALS] =
+{
+    0,
+    0,
+    0.69314718055994495,
+    1.7917594692280554,
+    3.1780538303479449,
+    4.7874917427820467,
+    6.5792512120101021,
+    8.5251613610654147,
+    10.604602902745249,
+    12.801827480081467,
+    15.104412573075514,
+    17.502307845873887,
+    19.987214495661885,
+    22.552163853123421,
+    25.191221182738683,
+    27.89927138384089,
+};
+
+// 덩어리 하나의 열거 상태
+typedef struct enumeration
+{
+    const probability_group_t* p_groups;
+    size_t num_groups;
+
+    // 덩어리 안 숫자 번호별 남은 지뢰 수 / 지금까지 둔 지뢰 수 / 아직 정하지 않은 이웃 칸 수
+    const int32_t* p_remaining;
+    int32_t* p_sums;
+    int32_t* p_caps;
+
+    // 그룹별로 둔 지뢰 수
+    uint8_t* p_mines;
+
+    double* p_weights;
+    double* p_hits;
+    size_t stride;
+} enumeration_t;
+
+static bool reserve(void** pp_buffer, size_t* p_capacity, const size_t count, const size_t element_size);
+
+static bool read_board(probability_t* p_probability, size_t* p_out_num_flags);
+static bool build_components(probability_t* p_probability);
+static bool build_jobs(probability_t* p_probability);
+static bool combine(probability_t* p_probability, const size_t num_flags);
+
+static uint32_t find_root(probability_var_t* p_vars, uint32_t var);
+static int compare_keys(const void* p_a, const void* p_b);
+static bool is_same_group(const probability_tile_key_t* p_key_a, const probability_tile_key_t* p_key_b);
+
+static void run_job(void* p_context, const size_t job_index, const size_t worker_index);
+static FORCEINLINE bool get_bounds(const enumeration_t* p_enum, const probability_group_t* p_group, int32_t* p_out_low, int32_t* p_out_high);
+static void enumerate(enumeration_t* p_enum, const size_t group_index, const uint32_t num_mines, const double weight);
+
+static FORCEINLINE bool is_flag(const tile_t tile);
+static FORCEINLINE int get_number(const tile_t tile);
+static double get_log_factorial(const int64_t n);
+static double get_log_binomial(const int64_t n, const int64_t k);
+static FORCEINLINE double get_log(const double value);
+
+bool probability_init(probability_t* p_probability, const engine_t* p_engine, thread_pool_t* p_pool)
+{
+    ASSERT(p_probability != NULL, "p_probability == NULL");
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+
+    memset(p_probability, 0, sizeof(probability_t));
+
+    p_probability->p_engine = p_engine;
+    p_probability->p_pool = p_pool;
+    p_probability->num_workers = (p_pool == NULL) ? 1 : thread_pool_get_num_threads(p_pool);
+    p_probability->num_tiles = p_engine->rows * p_engine->cols;
+
+    if (!mutex_init(&p_probability->result_lock))
+    {
+        ASSERT(false, "Failed to init result lock");
+        goto failed_init_lock;
+    }
+
+    p_probability->pa_tile_vars = (uint32_t*)malloc(sizeof(uint32_t) * p_probability->num_tiles);
+    if (p_probability->pa_tile_vars == NULL)
+    {
+        ASSERT(false, "Failed to malloc tile vars");
+        goto failed_malloc_tile_vars;
+    }
+
+    p_probability->pa_workers = (probability_worker_t*)calloc(p_probability->num_workers, sizeof(probability_worker_t));
+    if (p_probability->pa_workers == NULL)
+    {
+        ASSERT(false, "Failed to calloc workers");
+        goto failed_malloc_workers;
+    }
+
+    return true;
+
+failed_malloc_workers:
+    SAFE_FREE(p_probability->pa_tile_vars);
+
+failed_malloc_tile_vars:
+    mutex_release(&p_probability->result_lock);
+
+failed_init_lock:
+    memset(p_probability, 0, sizeof(probability_t));
+    return false;
+}
+
+void probability_release(probability_t* p_probability)
+{
+    ASSERT(p_probability != NULL, "p_probability == NULL");
+
+    for (size_t i = 0; i < p_probability->num_workers; ++i)
+    {
+        probability_worker_t* p_worker = &p_probability->pa_workers[i];
+        SAFE_FREE(p_worker->pa_results);
+        SAFE_FREE(p_worker->pa_mines);
+        SAFE_FREE(p_worker->pa_caps);
+        SAFE_FREE(p_worker->pa_sums);
+    }
+    SAFE_FREE(p_probability->pa_workers);
+
+    SAFE_FREE(p_probability->pa_expectations);
+    SAFE_FREE(p_probability->pa_log_weights);
+    SAFE_FREE(p_probability->pa_log_binomials);
+    SAFE_FREE(p_probability->pa_forward_next);
+    SAFE_FREE(p_probability->pa_forward);
+    SAFE_FREE(p_probability->pa_messages);
+    SAFE_FREE(p_probability->pa_results);
+    SAFE_FREE(p_probability->pa_job_components);
+    SAFE_FREE(p_probability->pa_components);
+    SAFE_FREE(p_probability->pa_groups);
+    SAFE_FREE(p_probability->pa_local_caps);
+    SAFE_FREE(p_probability->pa_local_remaining);
+    SAFE_FREE(p_probability->pa_constraints);
+    SAFE_FREE(p_probability->pa_keys);
+    SAFE_FREE(p_probability->pa_vars);
+    SAFE_FREE(p_probability->pa_tile_vars);
+
+    mutex_release(&p_probability->result_lock);
+
+    memset(p_probability, 0, sizeof(probability_t));
+}
+
+bool probability_compute(probability_t* p_probability)
+{
+    ASSERT(p_probability != NULL, "p_probability == NULL");
+
+    p_probability->b_valid = false;
+    p_probability->num_vars = 0;
+    p_probability->num_constraints = 0;
+    p_probability->num_groups = 0;
+    p_probability->num_components = 0;
+    p_probability->num_jobs = 0;
+
+    size_t num_flags;
+    if (!read_board(p_probability, &num_flags)
+        || !build_components(p_probability)
+        || !build_jobs(p_probability))
+    {
+        return false;
+    }
+
+    if (p_probability->p_pool != NULL)
+    {
+        thread_pool_run(p_probability->p_pool, run_job, p_probability, p_probability->num_jobs);
+    }
+    else
+    {
+        for (size_t i = 0; i < p_probability->num_jobs; ++i)
+        {
+            run_job(p_probability, i, 0);
+        }
+    }
+
+    p_probability->b_valid = combine(p_probability, num_flags);
+    return p_probability->b_valid;
+}
+
+double probability_get(const probability_t* p_probability, const size_t x, const size_t y)
+{
+    ASSERT(p_probability != NULL, "p_probability == NULL");
+    ASSERT(p_probability->b_valid, "Invalid result");
+    ASSERT(x < p_probability->p_engine->cols && y < p_probability->p_engine->rows, "Out of range");
+
+    const size_t tile_index = y * p_probability->p_engine->cols + x;
+    const uint32_t var = p_probability->pa_tile_vars[tile_index];
+    switch (var)
+    {
+    case PROBABILITY_TILE_REVEALED:
+        return is_flag(engine_get_tile_at(p_probability->p_engine, tile_index)) ? 1.0 : 0.0;
+    case PROBABILITY_TILE_INTERIOR:
+        return p_probability->interior_probability;
+    default:
+        return p_probability->pa_groups[p_probability->pa_vars[var].group].probability;
+    }
+}
+
+bool probability_find_safest(const probability_t* p_probability, size_t* p_out_x, size_t* p_out_y)
+{
+    ASSERT(p_probability != NULL, "p_probability == NULL");
+    ASSERT(p_probability->b_valid, "Invalid result");
+    ASSERT(p_out_x != NULL, "p_out_x == NULL");
+    ASSERT(p_out_y != NULL, "p_out_y == NULL");
+
+    const size_t cols = p_probability->p_engine->cols;
+
+    double best_probability = 2.0;
+    size_t best_tile_index = 0;
+
+    for (size_t i = 0; i < p_probability->num_groups; ++i)
+    {
+        const probability_group_t* p_group = &p_probability->pa_groups[i];
+        if (p_group->probability < best_probability)
+        {
+            best_probability = p_group->probability;
+            best_tile_index = p_probability->pa_vars[p_probability->pa_keys[p_group->first_key].var].tile_index;
+        }
+    }
+
+    if (p_probability->num_interior_tiles > 0 && p_probability->interior_probability < best_probability)
+    {
+        for (size_t i = 0; i < p_probability->num_tiles; ++i)
+        {
+            if (p_probability->pa_tile_vars[i] == PROBABILITY_TILE_INTERIOR)
+            {
+                best_probability = p_probability->interior_probability;
+                best_tile_index = i;
+                break;
+            }
+        }
+    }
+
+    if (best_probability > 1.0)
+    {
+        return false;
+    }
+
+    *p_out_x = best_tile_index % cols;
+    *p_out_y = best_tile_index / cols;
+    return true;
+}
+
+size_t probability_get_num_frontier_tiles(const probability_t* p_probability)
+{
+    ASSERT(p_probability != NULL, "p_probability == NULL");
+    return p_probability->num_vars;
+}
+
+size_t probability_get_num_components(const probability_t* p_probability)
+{
+    ASSERT(p_probability != NULL, "p_probability == NULL");
+    return p_probability->num_components;
+}
+
+// 모자라면 두 배 이상으로 늘림, 실패하면 기존 버퍼는 그대로
+static bool reserve(void** pp_buffer, size_t* p_capacity, const size_t count, const size_t element_size)
+{
+    if (count <= *p_capacity)
+    {
+        return true;
+    }
+
+    size_t capacity = (*p_capacity < 64) ? 64 : *p_capacity * 2;
+    if (capacity < count)
+    {
+        capacity = count;
+    }
+
+    void* p_buffer = realloc(*pp_buffer, capacity * element_size);
+    if (p_buffer == NULL)
+    {
+        return false;
+    }
+
+    *pp_buffer = p_buffer;
+    *p_capacity = capacity;
+    return true;
+}
+
+// 타일을 분류하고 닫힌 이웃이 있는 숫자마다 제약을 만듦
+// 같은 숫자에 이웃한 프런티어 칸은 같은 덩어리로 합침
+static bool read_board(probability_t* p_probability, size_t* p_out_num_flags)
+{
+    const engine_t* p_engine = p_probability->p_engine;
+    const size_t rows = p_engine->rows;
+    const size_t cols = p_engine->cols;
+
+    uint32_t* p_tile_vars = p_probability->pa_tile_vars;
+
+    size_t num_flags = 0;
+    size_t num_interior_tiles = 0;
+    for (size_t i = 0; i < p_probability->num_tiles; ++i)
+    {
+        const tile_t tile = engine_get_tile_at(p_engine, i);
+        if (is_flag(tile))
+        {
+            ++num_flags;
+            p_tile_vars[i] = PROBABILITY_TILE_REVEALED;
+        }
+        else if (get_number(tile) >= 0)
+        {
+            p_tile_vars[i] = PROBABILITY_TILE_REVEALED;
+        }
+        else
+        {
+            ++num_interior_tiles;
+            p_tile_vars[i] = PROBABILITY_TILE_INTERIOR;
+        }
+    }
+
+    for (size_t y = 0; y < rows; ++y)
+    {
+        for (size_t x = 0; x < cols; ++x)
+        {
+            const int number = get_number(engine_get_tile_at(p_engine, y * cols + x));
+            if (number < 0)
+            {
+                continue;
+            }
+
+            size_t closed_tiles[PROBABILITY_MAX_NEIGHBOURS];
+            uint32_t num_closed = 0;
+            int num_neighbour_flags = 0;
+
+            for (size_t ny = (y > 0) ? y - 1 : 0; ny <= y + 1 && ny < rows; ++ny)
+            {
+                for (size_t nx = (x > 0) ? x - 1 : 0; nx <= x + 1 && nx < cols; ++nx)
+                {
+                    const size_t neighbour_index = ny * cols + nx;
+                    if (p_tile_vars[neighbour_index] != PROBABILITY_TILE_REVEALED)
+                    {
+                        closed_tiles[num_closed++] = neighbour_index;
+                    }
+                    else if (is_flag(engine_get_tile_at(p_engine, neighbour_index)))
+                    {
+                        ++num_neighbour_flags;
+                    }
+                }
+            }
+
+            if (num_closed == 0)
+            {
+                continue;
+            }
+
+            const int32_t remaining = number - num_neighbour_flags;
+            if (remaining < 0 || remaining > (int32_t)num_closed)
+            {
+                return false;
+            }
+
+            if (!reserve((void**)&p_probability->pa_constraints, &p_probability->constraints_capacity, p_probability->num_constraints + 1, sizeof(probability_constraint_t)))
+            {
+                return false;
+            }
+
+            const uint32_t constraint_index = (uint32_t)p_probability->num_constraints++;
+            probability_constraint_t* p_constraint = &p_probability->pa_constraints[constraint_index];
+            p_constraint->remaining = remaining;
+            p_constraint->num_vars = num_closed;
+
+            for (uint32_t i = 0; i < num_closed; ++i)
+            {
+                uint32_t var = p_tile_vars[closed_tiles[i]];
+                if (var == PROBABILITY_TILE_INTERIOR)
+                {
+                    if (p_probability->num_vars + 1 > p_probability->vars_capacity)
+                    {
+                        size_t capacity = p_probability->vars_capacity;
+                        if (!reserve((void**)&p_probability->pa_vars, &capacity, p_probability->num_vars + 1, sizeof(probability_var_t))
+                            || !reserve((void**)&p_probability->pa_keys, &p_probability->vars_capacity, p_probability->num_vars + 1, sizeof(probability_tile_key_t)))
+                        {
+                            return false;
+                        }
+                        ASSERT(capacity == p_probability->vars_capacity, "Capacity mismatch");
+                    }
+
+                    var = (uint32_t)p_probability->num_vars++;
+                    --num_interior_tiles;
+                    p_tile_vars[closed_tiles[i]] = var;
+
+                    probability_var_t* p_var = &p_probability->pa_vars[var];
+                    p_var->tile_index = closed_tiles[i];
+                    p_var->parent = var;
+                    p_var->component = UINT32_MAX;
+
+                    p_probability->pa_keys[var].num_constraints = 0;
+                    p_probability->pa_keys[var].var = var;
+                }
+
+                probability_tile_key_t* p_key = &p_probability->pa_keys[var];
+                p_key->constraints[p_key->num_constraints++] = constraint_index;
+                p_constraint->vars[i] = var;
+
+                const uint32_t root_a = find_root(p_probability->pa_vars, p_constraint->vars[0]);
+                const uint32_t root_b = find_root(p_probability->pa_vars, var);
+                if (root_a != root_b)
+                {
+                    p_probability->pa_vars[root_b].parent = root_a;
+                }
+            }
+        }
+    }
+
+    p_probability->num_interior_tiles = num_interior_tiles;
+    *p_out_num_flags = num_flags;
+    return true;
+}
+
+// 덩어리 번호를 매기고 같은 숫자 목록을 가진 칸을 그룹으로 묶음
+// 정렬하면 덩어리마다 그룹이 연속하고, 숫자 번호가 행 우선이므로 그룹도 대략 판을 훑는 순서가 됨
+static bool build_components(probability_t* p_probability)
+{
+    probability_var_t* p_vars = p_probability->pa_vars;
+    probability_tile_key_t* p_keys = p_probability->pa_keys;
+    const size_t num_vars = p_probability->num_vars;
+
+    for (size_t i = 0; i < num_vars; ++i)
+    {
+        const uint32_t root = find_root(p_vars, (uint32_t)i);
+        if (p_vars[root].component == UINT32_MAX)
+        {
+            if (!reserve((void**)&p_probability->pa_components, &p_probability->components_capacity, p_probability->num_components + 1, sizeof(probability_component_t)))
+            {
+                return false;
+            }
+
+            p_vars[root].component = (uint32_t)p_probability->num_components;
+            memset(&p_probability->pa_components[p_probability->num_components++], 0, sizeof(probability_component_t));
+        }
+
+        p_vars[i].component = p_vars[root].component;
+        p_keys[i].component = p_vars[root].component;
+    }
+
+    qsort(p_keys, num_vars, sizeof(probability_tile_key_t), compare_keys);
+
+    for (size_t i = 0; i < num_vars; ++i)
+    {
+        const probability_tile_key_t* p_key = &p_keys[i];
+        probability_component_t* p_component = &p_probability->pa_components[p_key->component];
+
+        if (i == 0 || !is_same_group(&p_keys[i - 1], p_key))
+        {
+            if (!reserve((void**)&p_probability->pa_groups, &p_probability->groups_capacity, p_probability->num_groups + 1, sizeof(probability_group_t)))
+            {
+                return false;
+            }
+
+            probability_group_t* p_group = &p_probability->pa_groups[p_probability->num_groups];
+            p_group->first_key = (uint32_t)i;
+            p_group->num_tiles = 0;
+            p_group->num_constraints = p_key->num_constraints;
+            memcpy(p_group->constraints, p_key->constraints, sizeof(uint32_t) * p_key->num_constraints);
+            p_group->probability = 0.0;
+
+            if (p_component->num_groups == 0)
+            {
+                p_component->first_group = (uint32_t)p_probability->num_groups;
+            }
+            ++p_component->num_groups;
+            ++p_probability->num_groups;
+        }
+
+        ++p_probability->pa_groups[p_probability->num_groups - 1].num_tiles;
+        ++p_component->num_tiles;
+        p_vars[p_key->var].group = (uint32_t)(p_probability->num_groups - 1);
+
+        ASSERT(p_probability->pa_groups[p_probability->num_groups - 1].num_tiles <= PROBABILITY_MAX_NEIGHBOURS, "Group too large");
+    }
+
+    // 숫자에 덩어리 안 번호를 매김
+    for (size_t i = 0; i < p_probability->num_constraints; ++i)
+    {
+        probability_constraint_t* p_constraint = &p_probability->pa_constraints[i];
+        probability_component_t* p_component = &p_probability->pa_components[p_vars[p_constraint->vars[0]].component];
+        p_constraint->local_index = p_component->num_constraints++;
+    }
+
+    uint32_t first_constraint = 0;
+    for (size_t i = 0; i < p_probability->num_components; ++i)
+    {
+        p_probability->pa_components[i].first_constraint = first_constraint;
+        first_constraint += p_probability->pa_components[i].num_constraints;
+    }
+
+    if (p_probability->num_constraints > p_probability->local_capacity)
+    {
+        size_t capacity = p_probability->local_capacity;
+        if (!reserve((void**)&p_probability->pa_local_remaining, &capacity, p_probability->num_constraints, sizeof(int32_t))
+            || !reserve((void**)&p_probability->pa_local_caps, &p_probability->local_capacity, p_probability->num_constraints, sizeof(int32_t)))
+        {
+            return false;
+        }
+        ASSERT(capacity == p_probability->local_capacity, "Capacity mismatch");
+    }
+
+    for (size_t i = 0; i < p_probability->num_constraints; ++i)
+    {
+        const probability_constraint_t* p_constraint = &p_probability->pa_constraints[i];
+        const probability_component_t* p_component = &p_probability->pa_components[p_vars[p_constraint->vars[0]].component];
+
+        const size_t local_index = p_component->first_constraint + p_constraint->local_index;
+        p_probability->pa_local_remaining[local_index] = p_constraint->remaining;
+        p_probability->pa_local_caps[local_index] = (int32_t)p_constraint->num_vars;
+    }
+
+    for (size_t i = 0; i < p_probability->num_groups; ++i)
+    {
+        probability_group_t* p_group = &p_probability->pa_groups[i];
+        for (uint32_t j = 0; j < p_group->num_constraints; ++j)
+        {
+            p_group->constraints[j] = p_probability->pa_constraints[p_group->constraints[j]].local_index;
+        }
+    }
+
+    return true;
+}
+
+// 큰 덩어리는 앞쪽 그룹의 지뢰 개수 조합으로 나눔
+// 일감마다 필요한 작업자 버퍼를 미리 늘려 둠
+static bool build_jobs(probability_t* p_probability)
+{
+    const size_t num_target_jobs = p_probability->num_workers * PROBABILITY_JOBS_PER_THREAD;
+
+    size_t num_results = 0;
+    size_t max_constraints = 0;
+    size_t max_groups = 0;
+    size_t max_split_results = 0;
+
+    for (size_t i = 0; i < p_probability->num_components; ++i)
+    {
+        probability_component_t* p_component = &p_probability->pa_components[i];
+        const size_t component_results = (size_t)(p_component->num_groups + 1) * (p_component->num_tiles + 1);
+
+        p_component->first_result = num_results;
+        num_results += component_results;
+
+        uint32_t num_split_groups = 0;
+        size_t num_jobs = 1;
+        if (p_probability->num_workers > 1)
+        {
+            while (num_split_groups + PROBABILITY_MIN_SPLIT_GROUPS < p_component->num_groups)
+            {
+                const size_t num_choices = p_probability->pa_groups[p_component->first_group + num_split_groups].num_tiles + 1;
+                if (num_jobs * num_choices > num_target_jobs)
+                {
+                    break;
+                }
+
+                num_jobs *= num_choices;
+                ++num_split_groups;
+            }
+        }
+
+        p_component->num_split_groups = num_split_groups;
+        p_component->first_job = (uint32_t)p_probability->num_jobs;
+        p_component->num_jobs = (uint32_t)num_jobs;
+
+        if (!reserve((void**)&p_probability->pa_job_components, &p_probability->jobs_capacity, p_probability->num_jobs + num_jobs, sizeof(uint32_t)))
+        {
+            return false;
+        }
+        for (size_t j = 0; j < num_jobs; ++j)
+        {
+            p_probability->pa_job_components[p_probability->num_jobs++] = (uint32_t)i;
+        }
+
+        if (p_component->num_constraints > max_constraints)
+        {
+            max_constraints = p_component->num_constraints;
+        }
+        if (p_component->num_groups > max_groups)
+        {
+            max_groups = p_component->num_groups;
+        }
+        if (num_jobs > 1 && component_results > max_split_results)
+        {
+            max_split_results = component_results;
+        }
+    }
+
+    if (!reserve((void**)&p_probability->pa_results, &p_probability->results_capacity, num_results, sizeof(double)))
+    {
+        return false;
+    }
+    memset(p_probability->pa_results, 0, sizeof(double) * num_results);
+
+    for (size_t i = 0; i < p_probability->num_workers; ++i)
+    {
+        probability_worker_t* p_worker = &p_probability->pa_workers[i];
+
+        if (max_constraints > p_worker->constraints_capacity)
+        {
+            size_t capacity = p_worker->constraints_capacity;
+            if (!reserve((void**)&p_worker->pa_sums, &capacity, max_constraints, sizeof(int32_t))
+                || !reserve((void**)&p_worker->pa_caps, &p_worker->constraints_capacity, max_constraints, sizeof(int32_t)))
+            {
+                return false;
+            }
+            ASSERT(capacity == p_worker->constraints_capacity, "Capacity mismatch");
+        }
+
+        if (!reserve((void**)&p_worker->pa_mines, &p_worker->mines_capacity, max_groups, sizeof(uint8_t))
+            || !reserve((void**)&p_worker->pa_results, &p_worker->results_capacity, max_split_results, sizeof(double)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// 덩어리 c의 지뢰 개수 분포를 W_c, 프런티어 밖 칸 I개에 지뢰 k개를 둘 배치 수를 C(I, k)라 하면
+// 프런티어 지뢰가 모두 x개인 배치의 가중치는 (W_0 * ... * W_{K-1})[x] * C(I, R - x) (R: 남은 지뢰 수, *: 합성곱)
+//
+// 뒤에서부터 B_c[x] = sum_m W_c[m] * B_{c+1}[x + m], B_K[x] = C(I, R - x)를 만들어 두고
+// 앞에서부터 P = W_0 * ... * W_{c-1}를 넓혀 가며 E_c[m] = sum_x P[x] * B_{c+1}[x + m]을 구하면
+// 덩어리 c에 지뢰가 m개인 배치의 나머지 가중치가 되므로 덩어리마다 한 번씩만 훑으면 됨
+static bool combine(probability_t* p_probability, const size_t num_flags)
+{
+    const int64_t num_remaining_mines = (int64_t)p_probability->p_engine->num_max_mines - (int64_t)num_flags;
+    const int64_t num_interior_tiles = (int64_t)p_probability->num_interior_tiles;
+
+    p_probability->num_remaining_mines = num_remaining_mines;
+    if (num_remaining_mines < 0)
+    {
+        return false;
+    }
+
+    const size_t num_components = p_probability->num_components;
+    probability_component_t* p_components = p_probability->pa_components;
+
+    size_t num_frontier_tiles = 0;
+    size_t num_messages = 0;
+    for (size_t i = 0; i < num_components; ++i)
+    {
+        p_components[i].num_previous_tiles = num_frontier_tiles;
+        p_components[i].first_message = num_messages;
+        num_frontier_tiles += p_components[i].num_tiles;
+
+        // B_0은 만들지 않음
+        if (i > 0)
+        {
+            num_messages += p_components[i].num_previous_tiles + 1;
+        }
+    }
+
+    const size_t num_combine = num_frontier_tiles + 1;
+    if (num_combine > p_probability->combine_capacity)
+    {
+        size_t capacity = p_probability->combine_capacity;
+        if (!reserve((void**)&p_probability->pa_forward, &capacity, num_combine, sizeof(double)))
+        {
+            return false;
+        }
+        capacity = p_probability->combine_capacity;
+        if (!reserve((void**)&p_probability->pa_forward_next, &capacity, num_combine, sizeof(double)))
+        {
+            return false;
+        }
+        capacity = p_probability->combine_capacity;
+        if (!reserve((void**)&p_probability->pa_log_binomials, &capacity, num_combine, sizeof(double)))
+        {
+            return false;
+        }
+        capacity = p_probability->combine_capacity;
+        if (!reserve((void**)&p_probability->pa_log_weights, &capacity, num_combine, sizeof(double)))
+        {
+            return false;
+        }
+        if (!reserve((void**)&p_probability->pa_expectations, &p_probability->combine_capacity, num_combine, sizeof(double)))
+        {
+            return false;
+        }
+    }
+
+    if (!reserve((void**)&p_probability->pa_messages, &p_probability->messages_capacity, num_messages, sizeof(double)))
+    {
+        return false;
+    }
+
+    double* p_log_binomials = p_probability->pa_log_binomials;
+    for (size_t x = 0; x < num_combine; ++x)
+    {
+        p_log_binomials[x] = get_log_binomial(num_interior_tiles, num_remaining_mines - (int64_t)x);
+    }
+
+    double* p_log_weights = p_probability->pa_log_weights;
+
+    // 뒤에서부터 B_c
+    for (size_t c = num_components; c-- > 1;)
+    {
+        const probability_component_t* p_component = &p_components[c];
+        const double* p_weights = p_probability->pa_results + p_component->first_result;
+        const double* p_next = (c + 1 == num_components) ? p_log_binomials : p_probability->pa_messages + p_components[c + 1].first_message;
+        double* p_message = p_probability->pa_messages + p_component->first_message;
+
+        for (size_t m = 0; m <= p_component->num_tiles; ++m)
+        {
+            p_log_weights[m] = get_log(p_weights[m]);
+        }
+
+        for (size_t x = 0; x <= p_component->num_previous_tiles; ++x)
+        {
+            double max_term = -INFINITY;
+            for (size_t m = 0; m <= p_component->num_tiles; ++m)
+            {
+                const double term = p_log_weights[m] + p_next[x + m];
+                max_term = (term > max_term) ? term : max_term;
+            }
+
+            double sum = 0.0;
+            if (max_term != -INFINITY)
+            {
+                for (size_t m = 0; m <= p_component->num_tiles; ++m)
+                {
+                    sum += exp(p_log_weights[m] + p_next[x + m] - max_term);
+                }
+            }
+            p_message[x] = (max_term == -INFINITY) ? -INFINITY : max_term + log(sum);
+        }
+    }
+
+    // 앞에서부터 P를 넓히며 그룹 확률 계산
+    double* p_forward = p_probability->pa_forward;
+    double* p_forward_next = p_probability->pa_forward_next;
+    double* p_expectations = p_probability->pa_expectations;
+    p_forward[0] = 0.0;
+
+    double log_total = -INFINITY;
+    if (num_components == 0)
+    {
+        log_total = p_log_binomials[0];
+    }
+
+    for (size_t c = 0; c < num_components; ++c)
+    {
+        const probability_component_t* p_component = &p_components[c];
+        const size_t num_tiles = p_component->num_tiles;
+        const size_t num_previous_tiles = p_component->num_previous_tiles;
+        const double* p_results = p_probability->pa_results + p_component->first_result;
+        const double* p_next = (c + 1 == num_components) ? p_log_binomials : p_probability->pa_messages + p_components[c + 1].first_message;
+
+        bool b_possible = false;
+        for (size_t m = 0; m <= num_tiles; ++m)
+        {
+            p_log_weights[m] = get_log(p_results[m]);
+            b_possible |= p_results[m] > 0.0;
+        }
+
+        // 이 덩어리만으로 모순
+        if (!b_possible)
+        {
+            return false;
+        }
+
+        for (size_t m = 0; m <= num_tiles; ++m)
+        {
+            double max_term = -INFINITY;
+            for (size_t x = 0; x <= num_previous_tiles; ++x)
+            {
+                const double term = p_forward[x] + p_next[x + m];
+                max_term = (term > max_term) ? term : max_term;
+            }
+
+            double sum = 0.0;
+            if (max_term != -INFINITY)
+            {
+                for (size_t x = 0; x <= num_previous_tiles; ++x)
+                {
+                    sum += exp(p_forward[x] + p_next[x + m] - max_term);
+                }
+            }
+            p_expectations[m] = (max_term == -INFINITY) ? -INFINITY : max_term + log(sum);
+        }
+
+        // 전체 가중치는 어느 덩어리에서 구해도 같음
+        if (c == 0)
+        {
+            double max_term = -INFINITY;
+            for (size_t m = 0; m <= num_tiles; ++m)
+            {
+                const double term = p_log_weights[m] + p_expectations[m];
+                max_term = (term > max_term) ? term : max_term;
+            }
+            if (max_term == -INFINITY)
+            {
+                return false;
+            }
+
+            double sum = 0.0;
+            for (size_t m = 0; m <= num_tiles; ++m)
+            {
+                sum += exp(p_log_weights[m] + p_expectations[m] - max_term);
+            }
+            log_total = max_term + log(sum);
+        }
+
+        for (uint32_t g = 0; g < p_component->num_groups; ++g)
+        {
+            probability_group_t* p_group = &p_probability->pa_groups[p_component->first_group + g];
+            const double* p_hits = p_results + (size_t)(g + 1) * (num_tiles + 1);
+
+            double probability = 0.0;
+            for (size_t m = 0; m <= num_tiles; ++m)
+            {
+                if (p_hits[m] > 0.0 && p_expectations[m] != -INFINITY)
+                {
+                    probability += exp(log(p_hits[m]) + p_expectations[m] - log_total);
+                }
+            }
+            probability /= (double)p_group->num_tiles;
+            p_group->probability = (probability > 1.0) ? 1.0 : probability;
+        }
+
+        // P = P * W_c
+        for (size_t y = 0; y <= num_previous_tiles + num_tiles; ++y)
+        {
+            const size_t m_begin = (y > num_previous_tiles) ? y - num_previous_tiles : 0;
+            const size_t m_end = (y < num_tiles) ? y : num_tiles;
+
+            double max_term = -INFINITY;
+            for (size_t m = m_begin; m <= m_end; ++m)
+            {
+                const double term = p_forward[y - m] + p_log_weights[m];
+                max_term = (term > max_term) ? term : max_term;
+            }
+
+            double sum = 0.0;
+            if (max_term != -INFINITY)
+            {
+                for (size_t m = m_begin; m <= m_end; ++m)
+                {
+                    sum += exp(p_forward[y - m] + p_log_weights[m] - max_term);
+                }
+            }
+            p_forward_next[y] = (max_term == -INFINITY) ? -INFINITY : max_term + log(sum);
+        }
+
+        double* p_temp = p_forward;
+        p_forward = p_forward_next;
+        p_forward_next = p_temp;
+    }
+
+    if (log_total == -INFINITY)
+    {
+        return false;
+    }
+
+    // 프런티어 밖 칸 하나가 지뢰인 배치는 C(I - 1, R - x - 1), 다 쓴 p_log_binomials에 담음
+    p_probability->interior_probability = 0.0;
+    if (num_interior_tiles > 0)
+    {
+        double max_term = -INFINITY;
+        for (size_t x = 0; x < num_combine; ++x)
+        {
+            p_log_binomials[x] = p_forward[x] + get_log_binomial(num_interior_tiles - 1, num_remaining_mines - (int64_t)x - 1);
+            max_term = (p_log_binomials[x] > max_term) ? p_log_binomials[x] : max_term;
+        }
+
+        if (max_term != -INFINITY)
+        {
+            double sum = 0.0;
+            for (size_t x = 0; x < num_combine; ++x)
+            {
+                sum += exp(p_log_binomials[x] - max_term);
+            }
+
+            const double probability = exp(max_term + log(sum) - log_total);
+            p_probability->interior_probability = (probability > 1.0) ? 1.0 : probability;
+        }
+    }
+
+    return true;
+}
+
+static uint32_t find_root(probability_var_t* p_vars, uint32_t var)
+{
+    while (p_vars[var].parent != var)
+    {
+        p_vars[var].parent = p_vars[p_vars[var].parent].parent;
+        var = p_vars[var].parent;
+    }
+    return var;
+}
+
+// 덩어리, 숫자 번호 사전 순, 칸 번호 순
+// 칸 번호까지 비교해야 qsort 구현과 무관하게 같은 결과가 나옴
+static int compare_keys(const void* p_a, const void* p_b)
+{
+    const probability_tile_key_t* p_key_a = (const probability_tile_key_t*)p_a;
+    const probability_tile_key_t* p_key_b = (const probability_tile_key_t*)p_b;
+
+    if (p_key_a->component != p_key_b->component)
+    {
+        return (p_key_a->component < p_key_b->component) ? -1 : 1;
+    }
+
+    const uint32_t num_constraints = (p_key_a->num_constraints < p_key_b->num_constraints) ? p_key_a->num_constraints : p_key_b->num_constraints;
+    for (uint32_t i = 0; i < num_constraints; ++i)
+    {
+        if (p_key_a->constraints[i] != p_key_b->constraints[i])
+        {
+            return (p_key_a->constraints[i] < p_key_b->constraints[i]) ? -1 : 1;
+        }
+    }
+
+    if (p_key_a->num_constraints != p_key_b->num_constraints)
+    {
+        return (p_key_a->num_constraints < p_key_b->num_constraints) ? -1 : 1;
+    }
+
+    if (p_key_a->var != p_key_b->var)
+    {
+        return (p_key_a->var < p_key_b->var) ? -1 : 1;
+    }
+
+    return 0;
+}
+
+static bool is_same_group(const probability_tile_key_t* p_key_a, const probability_tile_key_t* p_key_b)
+{
+    return p_key_a->component == p_key_b->component
+        && p_key_a->num_constraints == p_key_b->num_constraints
+        && memcmp(p_key_a->constraints, p_key_b->constraints, sizeof(uint32_t) * p_key_a->num_constraints) == 0;
+}
+
+static void run_job(void* p_context, const size_t job_index, const size_t worker_index)
+{
+    probability_t* p_probability = (probability_t*)p_context;
+    const probability_component_t* p_component = &p_probability->pa_components[p_probability->pa_job_components[job_index]];
+    probability_worker_t* p_worker = &p_probability->pa_workers[worker_index];
+
+    const size_t stride = p_component->num_tiles + 1;
+    const size_t num_results = (size_t)(p_component->num_groups + 1) * stride;
+
+    // 나누지 않은 덩어리는 자기 결과에 바로 씀
+    const bool b_direct = (p_component->num_jobs == 1);
+    double* p_results = b_direct ? p_probability->pa_results + p_component->first_result : p_worker->pa_results;
+    if (!b_direct)
+    {
+        memset(p_results, 0, sizeof(double) * num_results);
+    }
+
+    enumeration_t enumeration;
+    enumeration.p_groups = p_probability->pa_groups + p_component->first_group;
+    enumeration.num_groups = p_component->num_groups;
+    enumeration.p_remaining = p_probability->pa_local_remaining + p_component->first_constraint;
+    enumeration.p_sums = p_worker->pa_sums;
+    enumeration.p_caps = p_worker->pa_caps;
+    enumeration.p_mines = p_worker->pa_mines;
+    enumeration.p_weights = p_results;
+    enumeration.p_hits = p_results + stride;
+    enumeration.stride = stride;
+
+    memset(enumeration.p_sums, 0, sizeof(int32_t) * p_component->num_constraints);
+    memcpy(enumeration.p_caps, p_probability->pa_local_caps + p_component->first_constraint, sizeof(int32_t) * p_component->num_constraints);
+
+    // 앞쪽 그룹의 지뢰 개수는 일감 번호로 정함
+    size_t code = job_index - p_component->first_job;
+    uint32_t num_mines = 0;
+    double weight = 1.0;
+    for (uint32_t g = 0; g < p_component->num_split_groups; ++g)
+    {
+        const probability_group_t* p_group = &enumeration.p_groups[g];
+        const int32_t size = (int32_t)p_group->num_tiles;
+        const int32_t mines = (int32_t)(code % (size_t)(size + 1));
+        code /= (size_t)(size + 1);
+
+        int32_t low;
+        int32_t high;
+        if (!get_bounds(&enumeration, p_group, &low, &high) || mines < low || mines > high)
+        {
+            return;
+        }
+
+        for (uint32_t j = 0; j < p_group->num_constraints; ++j)
+        {
+            enumeration.p_sums[p_group->constraints[j]] += mines;
+            enumeration.p_caps[p_group->constraints[j]] -= size;
+        }
+
+        enumeration.p_mines[g] = (uint8_t)mines;
+        num_mines += (uint32_t)mines;
+        weight *= s_binomials[size][mines];
+    }
+
+    enumerate(&enumeration, p_component->num_split_groups, num_mines, weight);
+
+    if (!b_direct)
+    {
+        double* p_component_results = p_probability->pa_results + p_component->first_result;
+
+        mutex_lock(&p_probability->result_lock);
+        for (size_t i = 0; i < num_results; ++i)
+        {
+            p_component_results[i] += p_results[i];
+        }
+        mutex_unlock(&p_probability->result_lock);
+    }
+}
+
+// 그룹에 둘 수 있는 지뢰 수 범위
+// 숫자마다 남은 지뢰를 넘지 않고, 이 그룹 뒤에 남은 이웃 칸을 모두 지뢰로 해도 모자라지 않아야 함
+static FORCEINLINE bool get_bounds(const enumeration_t* p_enum, const probability_group_t* p_group, int32_t* p_out_low, int32_t* p_out_high)
+{
+    const int32_t size = (int32_t)p_group->num_tiles;
+
+    int32_t low = 0;
+    int32_t high = size;
+    for (uint32_t j = 0; j < p_group->num_constraints; ++j)
+    {
+        const uint32_t constraint = p_group->constraints[j];
+        const int32_t needed = p_enum->p_remaining[constraint] - p_enum->p_sums[constraint];
+        const int32_t rest = p_enum->p_caps[constraint] - size;
+
+        high = (needed < high) ? needed : high;
+        low = (needed - rest > low) ? needed - rest : low;
+    }
+
+    *p_out_low = low;
+    *p_out_high = high;
+    return low <= high;
+}
+
+static void enumerate(enumeration_t* p_enum, const size_t group_index, const uint32_t num_mines, const double weight)
+{
+    if (group_index == p_enum->num_groups)
+    {
+        p_enum->p_weights[num_mines] += weight;
+
+        double* p_hits = p_enum->p_hits + num_mines;
+        for (size_t g = 0; g < p_enum->num_groups; ++g)
+        {
+            if (p_enum->p_mines[g] != 0)
+            {
+                p_hits[g * p_enum->stride] += weight * p_enum->p_mines[g];
+            }
+        }
+        return;
+    }
+
+    const probability_group_t* p_group = &p_enum->p_groups[group_index];
+    const int32_t size = (int32_t)p_group->num_tiles;
+
+    int32_t low;
+    int32_t high;
+    if (!get_bounds(p_enum, p_group, &low, &high))
+    {
+        return;
+    }
+
+    for (uint32_t j = 0; j < p_group->num_constraints; ++j)
+    {
+        p_enum->p_sums[p_group->constraints[j]] += low;
+        p_enum->p_caps[p_group->constraints[j]] -= size;
+    }
+
+    for (int32_t mines = low; mines <= high; ++mines)
+    {
+        p_enum->p_mines[group_index] = (uint8_t)mines;
+        enumerate(p_enum, group_index + 1, num_mines + (uint32_t)mines, weight * s_binomials[size][mines]);
+
+        for (uint32_t j = 0; j < p_group->num_constraints; ++j)
+        {
+            ++p_enum->p_sums[p_group->constraints[j]];
+        }
+    }
+
+    for (uint32_t j = 0; j < p_group->num_constraints; ++j)
+    {
+        p_enum->p_sums[p_group->constraints[j]] -= high + 1;
+        p_enum->p_caps[p_group->constraints[j]] += size;
+    }
+}
+
+static FORCEINLINE bool is_flag(const tile_t tile)
+{
+    return tile == TILE_FLAG || tile == TILE_MINE || tile == TILE_GAMEOVER_MINE || tile == TILE_FLAG_MINE;
+}
+
+// 열린 칸이면 인접 지뢰 개수, 아니면 -1
+static FORCEINLINE int get_number(const tile_t tile)
+{
+    if (tile == TILE_OPEN)
+    {
+        return 0;
+    }
+    if (tile >= TILE_1 && tile <= TILE_8)
+    {
+        return (int)(tile - TILE_1) + 1;
+    }
+    return -1;
+}
+
+static double get_log_binomial(const int64_t n, const int64_t k)
+{
+    if (k < 0 || k > n)
+    {
+        return -INFINITY;
+    }
+    return get_log_factorial(n) - get_log_factorial(k) - get_log_factorial(n - k);
+}
+
+// n >= 16이면 급수를 1/n^7 항까지만 더해도 오차가 1e-14보다 작음
+static double get_log_factorial(const int64_t n)
+{
+    if (n < NUM_LOG_FACTORIALS)
+    {
+        return s_log_factorials[n];
+    }
+
+    const double x = (double)n;
+    const double inv_x = 1.0 / x;
+    const double inv_x2 = inv_x * inv_x;
+    const double series = inv_x * (1.0 / 12.0 - inv_x2 * (1.0 / 360.0 - inv_x2 * (1.0 / 1260.0 - inv_x2 / 1680.0)));
+
+    return x * log(x) - x + 0.5 * log(2.0 * 3.14159265358979323846 * x) + series;
+}
+
+static FORCEINLINE double get_log(const double value)
+{
+    return (value > 0.0) ? log(value) : -INFINITY;
+}
\ No newline at end of file
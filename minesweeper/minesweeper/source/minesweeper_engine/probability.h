@@ -0,0 +1,199 @@
+#ifndef PROBABILITY_H
+#define PROBABILITY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "engine.h"
+#include "thread.h"
+#include "thread_pool.h"
+#include "safe99_common/defines.h"
+
+// 보이는 정보(열린 숫자, 깃발)만으로 닫힌 칸마다 정확한 지뢰 확률을 계산
+// - 숫자와 이웃한 닫힌 칸(프런티어)을 숫자를 공유하는 칸끼리 이어 서로 독립인 덩어리로 나눔
+// - 같은 숫자들에만 이웃한 칸은 한 그룹으로 묶고 그룹마다 지뢰 개수만 열거 (그룹 안 배치 수는 이항계수)
+// - 덩어리마다, 큰 덩어리는 앞쪽 그룹의 지뢰 개수로 다시 나눠서 스레드 풀에서 병렬로 열거
+// - 덩어리별 지뢰 개수 분포를 남은 지뢰 수 (num_max_mines - 깃발)와 프런티어 밖 칸 수로 결합
+//   프런티어 밖 배치 수는 이항계수이고 아주 커지므로 결합은 로그 공간에서 함
+// 깃발은 지뢰로 믿음
+//
+// 열거는 덩어리 크기에 지수적이므로 추론기(solver.h)로 확실한 칸을 먼저 처리한 뒤 호출하는 것이 좋음
+
+// 한 칸이 이웃할 수 있는 숫자 수, 한 숫자가 이웃할 수 있는 칸 수
+#define PROBABILITY_MAX_NEIGHBOURS 8
+
+// pa_tile_vars 값 (나머지는 프런티어 칸 번호)
+#define PROBABILITY_TILE_REVEALED UINT32_MAX
+#define PROBABILITY_TILE_INTERIOR (UINT32_MAX - 1)
+
+// 스레드마다 이 정도 일감이 생기도록 큰 덩어리를 나눔
+#define PROBABILITY_JOBS_PER_THREAD 4
+
+// 그룹이 이보다 적은 덩어리는 나누지 않음, 나눈 뒤에도 이만큼은 열거하도록 남김
+#define PROBABILITY_MIN_SPLIT_GROUPS 16
+
+typedef struct probability_var
+{
+    size_t tile_index;
+    uint32_t parent;
+    uint32_t component;
+    uint32_t group;
+} probability_var_t;
+
+// 그룹으로 묶기 위한 정렬 키, 이웃한 숫자 목록이 같으면 같은 그룹
+typedef struct probability_tile_key
+{
+    uint32_t component;
+    uint32_t num_constraints;
+    uint32_t constraints[PROBABILITY_MAX_NEIGHBOURS];
+    uint32_t var;
+} probability_tile_key_t;
+
+// 열린 숫자 하나
+typedef struct probability_constraint
+{
+    // 숫자 - 이웃 깃발
+    int32_t remaining;
+    uint32_t num_vars;
+    uint32_t vars[PROBABILITY_MAX_NEIGHBOURS];
+    uint32_t local_index;
+} probability_constraint_t;
+
+typedef struct probability_group
+{
+    // pa_keys 안의 시작 위치
+    uint32_t first_key;
+    uint32_t num_tiles;
+
+    // 덩어리 안 숫자 번호
+    uint32_t num_constraints;
+    uint32_t constraints[PROBABILITY_MAX_NEIGHBOURS];
+
+    double probability;
+} probability_group_t;
+
+typedef struct probability_component
+{
+    uint32_t first_group;
+    uint32_t num_groups;
+    uint32_t first_constraint;
+    uint32_t num_constraints;
+    uint32_t num_tiles;
+
+    // 앞쪽 num_split_groups개 그룹의 지뢰 개수 조합마다 일감 하나
+    uint32_t num_split_groups;
+    uint32_t first_job;
+    uint32_t num_jobs;
+
+    // 앞쪽 덩어리들의 칸 수 합, 결합 메시지 pa_messages 안의 시작 위치
+    size_t num_previous_tiles;
+    size_t first_message;
+
+    // pa_results 안의 시작 위치
+    // 지뢰 개수 m별 배치 수 [num_tiles + 1], 그룹별로 m개일 때 그룹 안 지뢰 수의 합 [num_groups][num_tiles + 1]
+    size_t first_result;
+} probability_component_t;
+
+// 작업자별 열거 상태
+typedef struct probability_worker
+{
+    int32_t* pa_sums;
+    int32_t* pa_caps;
+    size_t constraints_capacity;
+
+    uint8_t* pa_mines;
+    size_t mines_capacity;
+
+    // 나눈 덩어리의 일감은 여기에 모은 뒤 잠그고 더함
+    double* pa_results;
+    size_t results_capacity;
+} probability_worker_t;
+
+typedef struct probability
+{
+    const engine_t* p_engine;
+
+    // NULL이면 호출 스레드에서만 열거
+    thread_pool_t* p_pool;
+    size_t num_workers;
+    probability_worker_t* pa_workers;
+    mutex_t result_lock;
+
+    // 타일마다 프런티어 칸 번호 또는 PROBABILITY_TILE_*
+    uint32_t* pa_tile_vars;
+    size_t num_tiles;
+
+    // 아래는 프런티어 크기에 비례하며 모자라면 늘림
+    probability_var_t* pa_vars;
+    probability_tile_key_t* pa_keys;
+    size_t vars_capacity;
+    size_t num_vars;
+
+    probability_constraint_t* pa_constraints;
+    size_t constraints_capacity;
+    size_t num_constraints;
+
+    // 덩어리 안 번호 순서의 남은 지뢰 수, 이웃 프런티어 칸 수
+    int32_t* pa_local_remaining;
+    int32_t* pa_local_caps;
+    size_t local_capacity;
+
+    probability_group_t* pa_groups;
+    size_t groups_capacity;
+    size_t num_groups;
+
+    probability_component_t* pa_components;
+    size_t components_capacity;
+    size_t num_components;
+
+    uint32_t* pa_job_components;
+    size_t jobs_capacity;
+    size_t num_jobs;
+
+    double* pa_results;
+    size_t results_capacity;
+
+    // 결합용 (로그 공간)
+    // 뒤쪽 덩어리들과 프런티어 밖을 합친 가중치, 덩어리마다 하나
+    double* pa_messages;
+    size_t messages_capacity;
+    double* pa_forward;
+    double* pa_forward_next;
+    double* pa_log_binomials;
+    double* pa_log_weights;
+    double* pa_expectations;
+    size_t combine_capacity;
+
+    size_t num_interior_tiles;
+    int64_t num_remaining_mines;
+    double interior_probability;
+    bool b_valid;
+} probability_t;
+
+START_EXTERN_C
+
+// p_engine은 probability보다 오래 살아야 하고 크기가 바뀌면 안 됨
+// p_pool이 NULL이 아니면 probability보다 오래 살아야 함
+//
+// 이미 초기화한 계산기를 다시 초기화하지 말 것
+// 해야 한다면 probability_release() 호출 이후 재호출
+bool probability_init(probability_t* p_probability, const engine_t* p_engine, thread_pool_t* p_pool);
+void probability_release(probability_t* p_probability);
+
+// 현재 판의 확률 계산
+// 보이는 정보가 모순이거나 (깃발이 틀림) 메모리가 모자라면 false, 이때 결과는 무효
+bool probability_compute(probability_t* p_probability);
+
+// 마지막 probability_compute() 결과, 열린 칸은 0, 깃발은 1
+double probability_get(const probability_t* p_probability, const size_t x, const size_t y);
+
+// 지뢰 확률이 가장 낮은 닫힌 칸 (같으면 프런티어, 앞쪽 칸), 없으면 false
+bool probability_find_safest(const probability_t* p_probability, size_t* p_out_x, size_t* p_out_y);
+
+size_t probability_get_num_frontier_tiles(const probability_t* p_probability);
+size_t probability_get_num_components(const probability_t* p_probability);
+
+END_EXTERN_C
+
+#endif // PROBABILITY_H
\ No newline at end of file
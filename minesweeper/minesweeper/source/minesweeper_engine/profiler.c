@@ -0,0 +1,847 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "clock.h"
+#include "profiler.h"
+#include "thread.h"
+#include "safe99_common/assert.h"
+#include "safe99_common/safe_delete.h"
+
+#if defined(_MSC_VER)
+    #define THREAD_LOCAL __declspec(thread)
+#else
+    #define THREAD_LOCAL _Thread_local
+#endif // _MSC_VER
+
+#define CACHE_LINE_SIZE 64
+
+// 16 미만은 값마다 한 칸, 그 위로는 2의 거듭제곱마다 8칸
+#define HISTOGRAM_SUB_BUCKET_BITS 3
+#define HISTOGRAM_NUM_BUCKETS (16 + (64 - 4) * (1 << HISTOGRAM_SUB_BUCKET_BITS))
+
+// 트레이스 이벤트 하나의 JSON 최대 길이 (이름 제외)
+#define TRACE_EVENT_SIZE 192
+
+typedef struct profiler_event
+{
+    uint32_t zone;
+    // 바깥 구간 수
+    uint32_t depth;
+    uint64_t start;
+    uint64_t duration;
+
+    // NULL이면 값 없음
+    const char* p_arg_name;
+    uint64_t arg;
+} profiler_event_t;
+
+// 소유 스레드가 넣고 profiler_end_frame()/profiler_report()가 잠금 안에서 비우는 SPSC 링
+typedef struct profiler_ring
+{
+    // 소유 스레드만 씀
+    volatile uint32_t tail;
+    volatile uint32_t num_dropped;
+    uint32_t depth;
+    const char* p_thread_name;
+    char padding0[CACHE_LINE_SIZE - sizeof(uint32_t) * 3 - sizeof(const char*)];
+
+    // 비우는 쪽만 씀
+    volatile uint32_t head;
+    char padding1[CACHE_LINE_SIZE - sizeof(uint32_t)];
+
+    profiler_event_t events[PROFILER_RING_CAPACITY];
+} profiler_ring_t;
+
+typedef struct profiler_histogram
+{
+    uint64_t count;
+    uint64_t total;
+    uint64_t max;
+    uint32_t buckets[HISTOGRAM_NUM_BUCKETS];
+} profiler_histogram_t;
+
+typedef struct profiler_zone
+{
+    const char* p_name;
+    profiler_histogram_t calls;
+    profiler_histogram_t frames;
+
+    // 이번 프레임에 비운 호출
+    uint64_t frame_total;
+    uint32_t num_frame_calls;
+} profiler_zone_t;
+
+// 링을 비우는 쪽이 pa_buffer에 이어 쓰고, 다 차면 쓰기 스레드가 쉬고 있을 때 pa_pending과 맞바꿈
+typedef struct profiler_trace
+{
+    FILE* p_file;
+    uint64_t start_time;
+    bool b_first_event;
+
+    char* pa_buffer;
+    size_t size;
+    size_t capacity;
+    uint64_t num_dropped;
+    // 시작할 때 링들이 버린 구간 수, 끝낼 때와의 차이가 트레이스에서 빠진 구간 수
+    uint64_t num_dropped_events_at_start;
+
+    thread_t thread;
+    // 아래는 잠금 안에서만
+    mutex_t lock;
+    cond_t cond;
+    char* pa_pending;
+    size_t pending_size;
+    size_t pending_capacity;
+    bool b_stop;
+    bool b_failed;
+} profiler_trace_t;
+
+typedef struct profiler
+{
+    // 구간 등록, 링 비우기, 분포
+    mutex_t lock;
+
+    // 0번은 비움 (등록 전)
+    volatile uint32_t num_zones;
+    profiler_zone_t zones[PROFILER_MAX_ZONES + 1];
+
+    volatile uint32_t num_rings;
+    profiler_ring_t rings[PROFILER_MAX_THREADS];
+
+    profiler_histogram_t frames;
+    uint64_t frame_start;
+
+    // 쓰는 중일 때만
+    profiler_trace_t* pa_trace;
+} profiler_t;
+
+static profiler_t* s_pa_profiler;
+static volatile uint32_t s_b_enabled;
+// 초기화할 때마다 바뀜, 스레드마다 잡은 링이 이전 초기화 것인지 확인
+static volatile uint32_t s_generation;
+
+static THREAD_LOCAL profiler_ring_t* s_p_ring;
+static THREAD_LOCAL uint32_t s_ring_generation;
+
+static uint32_t register_zone(const char* p_name);
+static profiler_ring_t* get_ring(void);
+static void drain_rings(profiler_t* p_profiler);
+static uint64_t count_dropped_events(const profiler_t* p_profiler);
+static void trace_event(profiler_trace_t* p_trace, const char* p_name, const uint32_t tid, const uint64_t start, const uint64_t duration, const char* p_arg_name, const uint64_t arg);
+static void trace_append(profiler_trace_t* p_trace, const char* p_text, const size_t size);
+static void trace_hand_off(profiler_trace_t* p_trace, const bool b_wait);
+static void trace_thread(void* p_arg);
+static void write_row(FILE* p_file, const char* p_name, const profiler_histogram_t* p_calls, const profiler_histogram_t* p_frames);
+
+static void add_sample(profiler_histogram_t* p_histogram, const uint64_t value);
+static uint64_t get_percentile(const profiler_histogram_t* p_histogram, const double percentile);
+static uint32_t get_bucket(const uint64_t value);
+static uint64_t get_bucket_value(const uint32_t bucket);
+static uint32_t get_highest_bit(const uint64_t value);
+
+bool profiler_init(void)
+{
+    if (s_pa_profiler != NULL)
+    {
+        return true;
+    }
+
+    profiler_t* pa_profiler = (profiler_t*)calloc(1, sizeof(profiler_t));
+    if (pa_profiler == NULL)
+    {
+        ASSERT(false, "Failed to calloc profiler");
+        return false;
+    }
+
+    if (!mutex_init(&pa_profiler->lock))
+    {
+        ASSERT(false, "Failed to init profiler lock");
+        free(pa_profiler);
+        return false;
+    }
+
+    s_pa_profiler = pa_profiler;
+    atomic_fetch_add_u32(&s_generation, 1);
+    atomic_store_u32(&s_b_enabled, 1);
+
+    return true;
+}
+
+void profiler_shutdown(void)
+{
+    if (s_pa_profiler == NULL)
+    {
+        return;
+    }
+
+    profiler_stop_trace(NULL);
+
+    atomic_store_u32(&s_b_enabled, 0);
+
+    mutex_release(&s_pa_profiler->lock);
+    SAFE_FREE(s_pa_profiler);
+}
+
+void profiler_reset(void)
+{
+    profiler_t* p_profiler = s_pa_profiler;
+    if (p_profiler == NULL)
+    {
+        return;
+    }
+
+    mutex_lock(&p_profiler->lock);
+    {
+        drain_rings(p_profiler);
+
+        const uint32_t num_zones = atomic_load_u32(&p_profiler->num_zones);
+        for (uint32_t i = 1; i <= num_zones; ++i)
+        {
+            profiler_zone_t* p_zone = &p_profiler->zones[i];
+            memset(&p_zone->calls, 0, sizeof(profiler_histogram_t));
+            memset(&p_zone->frames, 0, sizeof(profiler_histogram_t));
+            p_zone->frame_total = 0;
+            p_zone->num_frame_calls = 0;
+        }
+
+        memset(&p_profiler->frames, 0, sizeof(profiler_histogram_t));
+    }
+    mutex_unlock(&p_profiler->lock);
+}
+
+uint64_t profiler_begin_zone(volatile uint64_t* p_zone, const char* p_name)
+{
+    if (atomic_load_u32(&s_b_enabled) == 0)
+    {
+        return 0;
+    }
+
+    // 세대는 1부터이므로 0으로 시작한 정적 변수는 항상 등록함
+    const uint32_t generation = atomic_load_u32(&s_generation);
+    if ((uint32_t)(atomic_load_u64(p_zone) >> 32) != generation)
+    {
+        const uint32_t zone = register_zone(p_name);
+        if (zone == 0)
+        {
+            return 0;
+        }
+        atomic_store_u64(p_zone, (uint64_t)generation << 32 | zone);
+    }
+
+    profiler_ring_t* p_ring = get_ring();
+    if (p_ring == NULL)
+    {
+        return 0;
+    }
+
+    ++p_ring->depth;
+    return clock_get_time_ns();
+}
+
+void profiler_end_zone(const volatile uint64_t* p_zone, const uint64_t start, const char* p_arg_name, const uint64_t arg)
+{
+    if (start == 0)
+    {
+        return;
+    }
+
+    const uint64_t end = clock_get_time_ns();
+
+    // begin 뒤에 끝냈거나 다시 초기화했으면 버림
+    const uint32_t generation = atomic_load_u32(&s_generation);
+    const uint64_t zone = atomic_load_u64(p_zone);
+    profiler_ring_t* p_ring = s_p_ring;
+    if (atomic_load_u32(&s_b_enabled) == 0 || s_ring_generation != generation || (uint32_t)(zone >> 32) != generation || p_ring == NULL)
+    {
+        return;
+    }
+
+    --p_ring->depth;
+
+    const uint32_t tail = p_ring->tail;
+    if (tail - atomic_load_u32(&p_ring->head) >= PROFILER_RING_CAPACITY)
+    {
+        atomic_store_u32(&p_ring->num_dropped, p_ring->num_dropped + 1);
+        return;
+    }
+
+    profiler_event_t* p_event = &p_ring->events[tail & (PROFILER_RING_CAPACITY - 1)];
+    p_event->zone = (uint32_t)zone;
+    p_event->depth = p_ring->depth;
+    p_event->start = start;
+    p_event->duration = end - start;
+    p_event->p_arg_name = p_arg_name;
+    p_event->arg = arg;
+
+    atomic_store_u32(&p_ring->tail, tail + 1);
+}
+
+void profiler_set_thread_name(const char* p_name)
+{
+    if (atomic_load_u32(&s_b_enabled) == 0)
+    {
+        return;
+    }
+
+    profiler_ring_t* p_ring = get_ring();
+    if (p_ring != NULL)
+    {
+        // 트레이스를 끝낼 때 잠금 안에서 읽음
+        mutex_lock(&s_pa_profiler->lock);
+        p_ring->p_thread_name = p_name;
+        mutex_unlock(&s_pa_profiler->lock);
+    }
+}
+
+void profiler_begin_frame(void)
+{
+    profiler_t* p_profiler = s_pa_profiler;
+    if (p_profiler == NULL)
+    {
+        return;
+    }
+
+    p_profiler->frame_start = clock_get_time_ns();
+}
+
+void profiler_end_frame(void)
+{
+    profiler_t* p_profiler = s_pa_profiler;
+    if (p_profiler == NULL || p_profiler->frame_start == 0)
+    {
+        return;
+    }
+
+    const uint64_t frame_start = p_profiler->frame_start;
+    const uint64_t duration = clock_get_time_ns() - frame_start;
+    p_profiler->frame_start = 0;
+
+    mutex_lock(&p_profiler->lock);
+    {
+        drain_rings(p_profiler);
+
+        add_sample(&p_profiler->frames, duration);
+
+        profiler_ring_t* p_ring = get_ring();
+        if (p_profiler->pa_trace != NULL && p_ring != NULL)
+        {
+            trace_event(p_profiler->pa_trace, "frame", (uint32_t)(p_ring - p_profiler->rings) + 1, frame_start, duration, NULL, 0);
+            trace_hand_off(p_profiler->pa_trace, false);
+        }
+
+        // 이번 프레임에 지난 구간만 프레임당 분포에 넣음
+        const uint32_t num_zones = atomic_load_u32(&p_profiler->num_zones);
+        for (uint32_t i = 1; i <= num_zones; ++i)
+        {
+            profiler_zone_t* p_zone = &p_profiler->zones[i];
+            if (p_zone->num_frame_calls > 0)
+            {
+                add_sample(&p_zone->frames, p_zone->frame_total);
+                p_zone->frame_total = 0;
+                p_zone->num_frame_calls = 0;
+            }
+        }
+    }
+    mutex_unlock(&p_profiler->lock);
+}
+
+void profiler_report(FILE* p_file)
+{
+    ASSERT(p_file != NULL, "p_file == NULL");
+
+    profiler_t* p_profiler = s_pa_profiler;
+    if (p_profiler == NULL)
+    {
+        return;
+    }
+
+    mutex_lock(&p_profiler->lock);
+    {
+        drain_rings(p_profiler);
+
+        const uint32_t num_rings = atomic_load_u32(&p_profiler->num_rings);
+        const uint64_t num_dropped = count_dropped_events(p_profiler);
+
+        fprintf(p_file, "profiler: %llu frames, %u threads, %llu dropped events\n",
+                (unsigned long long)p_profiler->frames.count, (num_rings < PROFILER_MAX_THREADS) ? num_rings : PROFILER_MAX_THREADS, (unsigned long long)num_dropped);
+        fprintf(p_file, "%-20s %10s %10s %10s %10s %10s | %8s %10s %10s %10s\n",
+                "zone (us)", "calls", "avg", "p50", "p99", "max", "frames", "p50", "p99", "max");
+
+        write_row(p_file, "frame", &p_profiler->frames, &p_profiler->frames);
+
+        const uint32_t num_zones = atomic_load_u32(&p_profiler->num_zones);
+        for (uint32_t i = 1; i <= num_zones; ++i)
+        {
+            const profiler_zone_t* p_zone = &p_profiler->zones[i];
+            write_row(p_file, p_zone->p_name, &p_zone->calls, &p_zone->frames);
+        }
+    }
+    mutex_unlock(&p_profiler->lock);
+}
+
+bool profiler_start_trace(const char* p_path)
+{
+    ASSERT(p_path != NULL, "p_path == NULL");
+
+    profiler_t* p_profiler = s_pa_profiler;
+    if (p_profiler == NULL || p_profiler->pa_trace != NULL)
+    {
+        return false;
+    }
+
+    profiler_trace_t* pa_trace = (profiler_trace_t*)calloc(1, sizeof(profiler_trace_t));
+    if (pa_trace == NULL)
+    {
+        ASSERT(false, "Failed to calloc trace");
+        return false;
+    }
+
+    pa_trace->p_file = fopen(p_path, "wb");
+    if (pa_trace->p_file == NULL)
+    {
+        goto failed_open_file;
+    }
+
+    pa_trace->capacity = PROFILER_TRACE_FLUSH_SIZE * 2;
+    pa_trace->pa_buffer = (char*)malloc(pa_trace->capacity);
+    pa_trace->pending_capacity = PROFILER_TRACE_FLUSH_SIZE * 2;
+    pa_trace->pa_pending = (char*)malloc(pa_trace->pending_capacity);
+    if (pa_trace->pa_buffer == NULL || pa_trace->pa_pending == NULL)
+    {
+        ASSERT(false, "Failed to malloc trace buffers");
+        goto failed_malloc_buffers;
+    }
+
+    if (!mutex_init(&pa_trace->lock))
+    {
+        ASSERT(false, "Failed to init trace lock");
+        goto failed_malloc_buffers;
+    }
+
+    if (!cond_init(&pa_trace->cond))
+    {
+        ASSERT(false, "Failed to init trace cond");
+        goto failed_init_cond;
+    }
+
+    if (!thread_create(&pa_trace->thread, trace_thread, pa_trace))
+    {
+        ASSERT(false, "Failed to create trace thread");
+        goto failed_create_thread;
+    }
+
+    static const char HEADER[] = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    trace_append(pa_trace, HEADER, sizeof(HEADER) - 1);
+    pa_trace->b_first_event = true;
+
+    mutex_lock(&p_profiler->lock);
+    {
+        // 시작하기 전에 쌓인 구간은 트레이스에 넣지 않음
+        pa_trace->start_time = clock_get_time_ns();
+        drain_rings(p_profiler);
+        pa_trace->num_dropped_events_at_start = count_dropped_events(p_profiler);
+        p_profiler->pa_trace = pa_trace;
+    }
+    mutex_unlock(&p_profiler->lock);
+
+    return true;
+
+failed_create_thread:
+    cond_release(&pa_trace->cond);
+
+failed_init_cond:
+    mutex_release(&pa_trace->lock);
+
+failed_malloc_buffers:
+    free(pa_trace->pa_buffer);
+    free(pa_trace->pa_pending);
+    fclose(pa_trace->p_file);
+
+failed_open_file:
+    free(pa_trace);
+    return false;
+}
+
+bool profiler_stop_trace(uint64_t* p_out_num_dropped_events)
+{
+    profiler_t* p_profiler = s_pa_profiler;
+    if (p_profiler == NULL || p_profiler->pa_trace == NULL)
+    {
+        return false;
+    }
+
+    profiler_trace_t* p_trace = p_profiler->pa_trace;
+    uint64_t num_dropped_events;
+
+    mutex_lock(&p_profiler->lock);
+    {
+        drain_rings(p_profiler);
+        p_profiler->pa_trace = NULL;
+
+        num_dropped_events = count_dropped_events(p_profiler) - p_trace->num_dropped_events_at_start;
+
+        // 이름을 붙인 스레드만 트랙 이름을 씀, 나머지는 tid로 보임
+        char text[TRACE_EVENT_SIZE];
+        const uint32_t num_rings = atomic_load_u32(&p_profiler->num_rings);
+        for (uint32_t i = 0; i < num_rings && i < PROFILER_MAX_THREADS; ++i)
+        {
+            const char* p_name = p_profiler->rings[i].p_thread_name;
+            if (p_name == NULL)
+            {
+                continue;
+            }
+
+            const int size = snprintf(text, sizeof(text), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"",
+                                      p_trace->b_first_event ? "" : ",\n", i + 1);
+            trace_append(p_trace, text, (size_t)size);
+            trace_append(p_trace, p_name, strlen(p_name));
+            trace_append(p_trace, "\"}}", 3);
+            p_trace->b_first_event = false;
+        }
+    }
+    mutex_unlock(&p_profiler->lock);
+
+    // 빠진 구간 수는 chrome://tracing의 Metadata에 보임
+    char footer[TRACE_EVENT_SIZE];
+    const int footer_size = snprintf(footer, sizeof(footer), "\n],\"otherData\":{\"dropped_events\":\"%llu\"}}\n", (unsigned long long)num_dropped_events);
+    trace_append(p_trace, footer, (size_t)footer_size);
+
+    // 마지막 버퍼를 넘기고 쓰기 스레드가 끝날 때까지 기다림
+    trace_hand_off(p_trace, true);
+
+    mutex_lock(&p_trace->lock);
+    {
+        p_trace->b_stop = true;
+        cond_broadcast(&p_trace->cond);
+    }
+    mutex_unlock(&p_trace->lock);
+
+    thread_join(&p_trace->thread);
+
+    bool b_succeeded = !p_trace->b_failed && p_trace->num_dropped == 0;
+    b_succeeded = (fclose(p_trace->p_file) == 0) && b_succeeded;
+
+    cond_release(&p_trace->cond);
+    mutex_release(&p_trace->lock);
+    free(p_trace->pa_buffer);
+    free(p_trace->pa_pending);
+    free(p_trace);
+
+    if (p_out_num_dropped_events != NULL)
+    {
+        *p_out_num_dropped_events = num_dropped_events;
+    }
+
+    return b_succeeded;
+}
+
+// 같은 이름이 있으면 그 번호, 표가 가득 찼으면 0
+static uint32_t register_zone(const char* p_name)
+{
+    profiler_t* p_profiler = s_pa_profiler;
+    uint32_t zone = 0;
+
+    mutex_lock(&p_profiler->lock);
+    {
+        const uint32_t num_zones = p_profiler->num_zones;
+        for (uint32_t i = 1; i <= num_zones; ++i)
+        {
+            if (strcmp(p_profiler->zones[i].p_name, p_name) == 0)
+            {
+                zone = i;
+                break;
+            }
+        }
+
+        if (zone == 0 && num_zones < PROFILER_MAX_ZONES)
+        {
+            zone = num_zones + 1;
+            p_profiler->zones[zone].p_name = p_name;
+            atomic_store_u32(&p_profiler->num_zones, zone);
+        }
+    }
+    mutex_unlock(&p_profiler->lock);
+
+    return zone;
+}
+
+// 스레드마다 처음 구간을 지날 때 링 하나를 잡음, 다 썼으면 NULL (이 스레드는 재지 않음)
+static profiler_ring_t* get_ring(void)
+{
+    const uint32_t generation = atomic_load_u32(&s_generation);
+    if (s_ring_generation != generation)
+    {
+        const uint32_t index = atomic_fetch_add_u32(&s_pa_profiler->num_rings, 1);
+        s_p_ring = (index < PROFILER_MAX_THREADS) ? &s_pa_profiler->rings[index] : NULL;
+        s_ring_generation = generation;
+    }
+
+    return s_p_ring;
+}
+
+// 잠금 안에서 호출
+static void drain_rings(profiler_t* p_profiler)
+{
+    const uint32_t num_rings = atomic_load_u32(&p_profiler->num_rings);
+    for (uint32_t i = 0; i < num_rings && i < PROFILER_MAX_THREADS; ++i)
+    {
+        profiler_ring_t* p_ring = &p_profiler->rings[i];
+
+        const uint32_t tail = atomic_load_u32(&p_ring->tail);
+        for (uint32_t head = p_ring->head; head != tail; ++head)
+        {
+            const profiler_event_t* p_event = &p_ring->events[head & (PROFILER_RING_CAPACITY - 1)];
+            profiler_zone_t* p_zone = &p_profiler->zones[p_event->zone];
+
+            add_sample(&p_zone->calls, p_event->duration);
+            p_zone->frame_total += p_event->duration;
+            ++p_zone->num_frame_calls;
+
+            if (p_profiler->pa_trace != NULL)
+            {
+                trace_event(p_profiler->pa_trace, p_zone->p_name, i + 1, p_event->start, p_event->duration, p_event->p_arg_name, p_event->arg);
+            }
+        }
+
+        atomic_store_u32(&p_ring->head, tail);
+    }
+
+    if (p_profiler->pa_trace != NULL)
+    {
+        trace_hand_off(p_profiler->pa_trace, false);
+    }
+}
+
+// 스레드마다 링이 가득 차서 버린 구간 수의 합
+static uint64_t count_dropped_events(const profiler_t* p_profiler)
+{
+    const uint32_t num_rings = atomic_load_u32(&p_profiler->num_rings);
+    uint64_t num_dropped = 0;
+    for (uint32_t i = 0; i < num_rings && i < PROFILER_MAX_THREADS; ++i)
+    {
+        num_dropped += atomic_load_u32(&p_profiler->rings[i].num_dropped);
+    }
+
+    return num_dropped;
+}
+
+// 완료 이벤트 ("ph": "X") 하나, 시각은 트레이스 시작부터 마이크로초
+static void trace_event(profiler_trace_t* p_trace, const char* p_name, const uint32_t tid, const uint64_t start, const uint64_t duration, const char* p_arg_name, const uint64_t arg)
+{
+    if (start < p_trace->start_time)
+    {
+        return;
+    }
+
+    const uint64_t ts = start - p_trace->start_time;
+
+    char text[TRACE_EVENT_SIZE];
+    int size = snprintf(text, sizeof(text), "%s{\"name\":\"", p_trace->b_first_event ? "" : ",\n");
+    trace_append(p_trace, text, (size_t)size);
+    trace_append(p_trace, p_name, strlen(p_name));
+
+    size = snprintf(text, sizeof(text), "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%llu.%03u,\"dur\":%llu.%03u",
+                    tid, (unsigned long long)(ts / 1000), (uint32_t)(ts % 1000), (unsigned long long)(duration / 1000), (uint32_t)(duration % 1000));
+    if (p_arg_name != NULL)
+    {
+        size += snprintf(text + size, sizeof(text) - (size_t)size, ",\"args\":{\"%s\":%llu}", p_arg_name, (unsigned long long)arg);
+    }
+    text[size++] = '}';
+    trace_append(p_trace, text, (size_t)size);
+
+    p_trace->b_first_event = false;
+}
+
+// 버퍼가 모자라면 늘림, 늘리지 못하면 버리고 개수만 셈 (파일은 끝낼 때 실패로 알림)
+static void trace_append(profiler_trace_t* p_trace, const char* p_text, const size_t size)
+{
+    if (p_trace->size + size > p_trace->capacity)
+    {
+        const size_t capacity = (p_trace->capacity * 2 > p_trace->size + size) ? p_trace->capacity * 2 : p_trace->size + size;
+        char* pa_buffer = (char*)realloc(p_trace->pa_buffer, capacity);
+        if (pa_buffer == NULL)
+        {
+            ++p_trace->num_dropped;
+            return;
+        }
+
+        p_trace->pa_buffer = pa_buffer;
+        p_trace->capacity = capacity;
+    }
+
+    memcpy(p_trace->pa_buffer + p_trace->size, p_text, size);
+    p_trace->size += size;
+}
+
+// 모은 양이 PROFILER_TRACE_FLUSH_SIZE를 넘었고 쓰기 스레드가 쉬고 있으면 버퍼를 맞바꿈
+// b_wait이면 양과 상관없이, 이전 버퍼를 다 쓸 때까지 기다렸다가 넘기고 그것까지 다 쓸 때까지 기다림
+static void trace_hand_off(profiler_trace_t* p_trace, const bool b_wait)
+{
+    if (!b_wait && p_trace->size < PROFILER_TRACE_FLUSH_SIZE)
+    {
+        return;
+    }
+
+    mutex_lock(&p_trace->lock);
+    {
+        while (b_wait && p_trace->pending_size > 0)
+        {
+            cond_wait(&p_trace->cond, &p_trace->lock);
+        }
+
+        if (p_trace->pending_size == 0 && p_trace->size > 0)
+        {
+            char* p_buffer = p_trace->pa_pending;
+            const size_t capacity = p_trace->pending_capacity;
+
+            p_trace->pa_pending = p_trace->pa_buffer;
+            p_trace->pending_capacity = p_trace->capacity;
+            p_trace->pending_size = p_trace->size;
+
+            p_trace->pa_buffer = p_buffer;
+            p_trace->capacity = capacity;
+            p_trace->size = 0;
+
+            cond_broadcast(&p_trace->cond);
+        }
+
+        while (b_wait && p_trace->pending_size > 0)
+        {
+            cond_wait(&p_trace->cond, &p_trace->lock);
+        }
+    }
+    mutex_unlock(&p_trace->lock);
+}
+
+static void trace_thread(void* p_arg)
+{
+    profiler_trace_t* p_trace = (profiler_trace_t*)p_arg;
+
+    mutex_lock(&p_trace->lock);
+    while (true)
+    {
+        while (p_trace->pending_size == 0 && !p_trace->b_stop)
+        {
+            cond_wait(&p_trace->cond, &p_trace->lock);
+        }
+
+        if (p_trace->pending_size == 0)
+        {
+            break;
+        }
+
+        // 넘겨받은 버퍼는 다 쓸 때까지 맞바꾸지 않으므로 잠금 없이 씀
+        const char* p_buffer = p_trace->pa_pending;
+        const size_t size = p_trace->pending_size;
+        mutex_unlock(&p_trace->lock);
+
+        const bool b_written = fwrite(p_buffer, 1, size, p_trace->p_file) == size;
+
+        mutex_lock(&p_trace->lock);
+        if (!b_written)
+        {
+            p_trace->b_failed = true;
+        }
+        p_trace->pending_size = 0;
+        cond_broadcast(&p_trace->cond);
+    }
+    mutex_unlock(&p_trace->lock);
+}
+
+static void write_row(FILE* p_file, const char* p_name, const profiler_histogram_t* p_calls, const profiler_histogram_t* p_frames)
+{
+    const double avg = (p_calls->count > 0) ? (double)p_calls->total / (double)p_calls->count : 0.0;
+
+    fprintf(p_file, "%-20s %10llu %10.2f %10.2f %10.2f %10.2f | %8llu %10.2f %10.2f %10.2f\n",
+            p_name, (unsigned long long)p_calls->count, avg / 1000.0,
+            (double)get_percentile(p_calls, 0.5) / 1000.0, (double)get_percentile(p_calls, 0.99) / 1000.0, (double)p_calls->max / 1000.0,
+            (unsigned long long)p_frames->count,
+            (double)get_percentile(p_frames, 0.5) / 1000.0, (double)get_percentile(p_frames, 0.99) / 1000.0, (double)p_frames->max / 1000.0);
+}
+
+static void add_sample(profiler_histogram_t* p_histogram, const uint64_t value)
+{
+    ++p_histogram->count;
+    p_histogram->total += value;
+    if (value > p_histogram->max)
+    {
+        p_histogram->max = value;
+    }
+
+    ++p_histogram->buckets[get_bucket(value)];
+}
+
+// 칸 가운데 값, 최대보다 크면 최대
+static uint64_t get_percentile(const profiler_histogram_t* p_histogram, const double percentile)
+{
+    if (p_histogram->count == 0)
+    {
+        return 0;
+    }
+
+    uint64_t rank = (uint64_t)(percentile * (double)p_histogram->count + 0.5);
+    if (rank == 0)
+    {
+        rank = 1;
+    }
+
+    uint64_t num_samples = 0;
+    for (uint32_t i = 0; i < HISTOGRAM_NUM_BUCKETS; ++i)
+    {
+        num_samples += p_histogram->buckets[i];
+        if (num_samples >= rank)
+        {
+            const uint64_t value = get_bucket_value(i);
+            return (value < p_histogram->max) ? value : p_histogram->max;
+        }
+    }
+
+    return p_histogram->max;
+}
+
+static uint32_t get_bucket(const uint64_t value)
+{
+    if (value < 16)
+    {
+        return (uint32_t)value;
+    }
+
+    const uint32_t exponent = get_highest_bit(value);
+    const uint32_t sub_bucket = (uint32_t)(value >> (exponent - HISTOGRAM_SUB_BUCKET_BITS)) & ((1 << HISTOGRAM_SUB_BUCKET_BITS) - 1);
+    return 16 + ((exponent - 4) << HISTOGRAM_SUB_BUCKET_BITS) + sub_bucket;
+}
+
+static uint64_t get_bucket_value(const uint32_t bucket)
+{
+    if (bucket < 16)
+    {
+        return bucket;
+    }
+
+    const uint32_t exponent = ((bucket - 16) >> HISTOGRAM_SUB_BUCKET_BITS) + 4;
+    const uint64_t sub_bucket = (bucket - 16) & ((1 << HISTOGRAM_SUB_BUCKET_BITS) - 1);
+    const uint32_t width_bits = exponent - HISTOGRAM_SUB_BUCKET_BITS;
+
+    const uint64_t low = (((uint64_t)1 << HISTOGRAM_SUB_BUCKET_BITS) + sub_bucket) << width_bits;
+    return low + (((uint64_t)1 << width_bits) >> 1);
+}
+
+// value != 0
+static uint32_t get_highest_bit(const uint64_t value)
+{
+#if defined(__GNUC__)
+    return 63 - (uint32_t)__builtin_clzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return (uint32_t)index;
+#else
+    uint32_t index = 0;
+    while ((value >> index) > 1)
+    {
+        ++index;
+    }
+    return index;
+#endif // __GNUC__
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "safe99_common/defines.h"
+
+// 프레임 단위 구간 측정
+// PROFILE_BEGIN(name) ~ PROFILE_END(name)으로 감싼 구간의 시작 시각과 길이를 스레드마다 따로 둔 링 버퍼에 넣고,
+// profiler_end_frame()이 모든 스레드의 링을 비우면서 구간별 호출 시간, 구간별 프레임당 합계, 프레임 시간의 분포를 모음
+// 분포는 2의 거듭제곱마다 8칸 (오차 12.5% 이내)이라 p50/p99는 근삿값, 최대는 정확한 값
+//
+// MINESWEEPER_PROFILER를 정의했을 때만 (CMake: MINESWEEPER_ENABLE_PROFILER) 매크로가 측정 코드로 펼쳐지고,
+// 아니면 비어 있으므로 비용이 없음
+// profiler_init() 전이나 profiler_shutdown() 뒤에는 구간을 지나도 시각만 확인하지 않고 바로 돌아감
+//
+// 구간은 같은 블록 안에서 BEGIN/END 짝을 맞추면 중첩 가능, 같은 이름은 어디서 재든 같은 구간
+// 링이 가득 차면 (프레임 사이에 한 스레드가 PROFILER_RING_CAPACITY개 넘게 기록) 버리고 개수만 셈
+//
+// profiler_start_trace()를 부르면 링을 비울 때마다 구간을 Chrome trace event JSON (chrome://tracing, Perfetto)으로도 씀
+// 스레드마다 트랙 하나, 프레임은 profiler_end_frame()을 부른 스레드의 트랙에 frame 구간으로 들어감
+// JSON은 메모리 버퍼에 모았다가 PROFILER_TRACE_FLUSH_SIZE를 넘으면 쓰기 스레드에 넘기므로 프레임이 파일 쓰기를 기다리지 않음
+// 쓰기 스레드가 아직 이전 버퍼를 쓰는 중이면 버퍼를 늘려 계속 모음
+
+#define PROFILER_MAX_ZONES 64
+#define PROFILER_MAX_THREADS 32
+// 2의 거듭제곱
+#define PROFILER_RING_CAPACITY 4096
+#define PROFILER_TRACE_FLUSH_SIZE (256 * 1024)
+
+#if defined(MINESWEEPER_PROFILER)
+    #define PROFILE_BEGIN(name) \
+        static volatile uint64_t s_profile_zone_##name; \
+        const uint64_t profile_start_##name = profiler_begin_zone(&s_profile_zone_##name, #name)
+    #define PROFILE_END(name) profiler_end_zone(&s_profile_zone_##name, profile_start_##name, NULL, 0)
+    // 트레이스에 args: { arg_name: value }로 남김 (예: 연쇄로 열린 칸 수)
+    #define PROFILE_END_ARG(name, arg_name, value) profiler_end_zone(&s_profile_zone_##name, profile_start_##name, arg_name, (uint64_t)(value))
+    #define PROFILE_BEGIN_FRAME() profiler_begin_frame()
+    #define PROFILE_END_FRAME() profiler_end_frame()
+    #define PROFILE_THREAD_NAME(p_name) profiler_set_thread_name(p_name)
+#else
+    #define PROFILE_BEGIN(name)
+    #define PROFILE_END(name)
+    // 값을 구하려고 둔 지역 변수가 안 쓰인다는 경고가 나지 않도록 식만 남김 (부작용 없는 식만)
+    #define PROFILE_END_ARG(name, arg_name, value) ((void)(value))
+    #define PROFILE_BEGIN_FRAME()
+    #define PROFILE_END_FRAME()
+    #define PROFILE_THREAD_NAME(p_name)
+#endif // MINESWEEPER_PROFILER
+
+START_EXTERN_C
+
+// 구간/스레드 표와 분포를 잡음, 이미 초기화했으면 그대로 true
+bool profiler_init(void);
+
+// 측정 중인 다른 스레드가 없을 때 호출
+void profiler_shutdown(void);
+
+// 모은 분포만 비움 (처음 몇 프레임을 빼고 잴 때)
+void profiler_reset(void);
+
+// *p_zone은 초기화 세대 (상위 32비트)와 구간 번호 (하위 32비트, 1부터)
+// 세대가 지금과 다르면 (처음이거나 profiler_shutdown() 뒤 다시 초기화) 이름으로 다시 등록하고 저장
+// 초기화 전이면 0 반환, profiler_end_zone()은 start가 0이면 무시
+uint64_t profiler_begin_zone(volatile uint64_t* p_zone, const char* p_name);
+void profiler_end_zone(const volatile uint64_t* p_zone, const uint64_t start, const char* p_arg_name, const uint64_t arg);
+
+// 트레이스에 보일 호출 스레드 이름, 문자열은 프로파일러를 끝낼 때까지 살아 있어야 함
+void profiler_set_thread_name(const char* p_name);
+
+void profiler_begin_frame(void);
+
+// 모든 스레드의 링을 비우고 프레임 시간과 이번 프레임의 구간별 합계를 분포에 넣음
+void profiler_end_frame(void);
+
+// 링을 비운 뒤 구간별 호출 수와 p50/p99/최대 (호출마다, 구간을 지난 프레임마다)를 씀
+void profiler_report(FILE* p_file);
+
+// 이 시각 뒤에 시작한 구간부터 p_path에 씀, 이미 쓰는 중이면 false
+bool profiler_start_trace(const char* p_path);
+
+// 남은 구간과 스레드 이름을 쓰고 파일을 닫을 때까지 기다림, 쓰기에 실패했으면 false
+// 링이 가득 차서 트레이스에서 빠진 구간 수를 *p_out_num_dropped_events (NULL이면 안 씀)와 파일의 otherData에 남김
+bool profiler_stop_trace(uint64_t* p_out_num_dropped_events);
+
+END_EXTERN_C
+
+#endif // PROFILER_H
\ No newline at end of file
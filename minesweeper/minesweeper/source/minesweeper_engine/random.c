@@ -0,0 +1,101 @@
+#include <stddef.h>
+
+#include "random.h"
+#include "safe99_common/assert.h"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+    #include <intrin.h>
+#endif // _MSC_VER
+
+static uint64_t rotate_left(const uint64_t x, const int k);
+static uint64_t multiply_high(const uint64_t a, const uint64_t b);
+
+void random_init(random_t* p_random, const uint64_t seed)
+{
+    ASSERT(p_random != NULL, "p_random == NULL");
+
+    // 상태가 모두 0이 되지 않도록 splitmix64로 채움
+    uint64_t x = seed;
+    for (int i = 0; i < 4; ++i)
+    {
+        x += 0x9e3779b97f4a7c15;
+        p_random->state[i] = random_mix_seed(x);
+    }
+}
+
+uint64_t random_next(random_t* p_random)
+{
+    ASSERT(p_random != NULL, "p_random == NULL");
+
+    uint64_t* s = p_random->state;
+
+    const uint64_t result = rotate_left(s[1] * 5, 7) * 9;
+    const uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+
+    s[2] ^= t;
+
+    s[3] = rotate_left(s[3], 45);
+
+    return result;
+}
+
+uint64_t random_next_bounded(random_t* p_random, const uint64_t bound)
+{
+    ASSERT(p_random != NULL, "p_random == NULL");
+    ASSERT(bound > 0, "bound == 0");
+
+    // Lemire의 곱셈 방식, 나머지 연산은 드물게 거절할 때만 수행
+    uint64_t x = random_next(p_random);
+    uint64_t low = x * bound;
+    if (low < bound)
+    {
+        const uint64_t threshold = (0 - bound) % bound;
+        while (low < threshold)
+        {
+            x = random_next(p_random);
+            low = x * bound;
+        }
+    }
+
+    return multiply_high(x, bound);
+}
+
+uint64_t random_mix_seed(const uint64_t seed)
+{
+    uint64_t z = seed;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+static uint64_t rotate_left(const uint64_t x, const int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+static uint64_t multiply_high(const uint64_t a, const uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+    return (uint64_t)(((unsigned __int128)a * b) >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return __umulh(a, b);
+#else
+    const uint64_t a_low = a & 0xffffffff;
+    const uint64_t a_high = a >> 32;
+    const uint64_t b_low = b & 0xffffffff;
+    const uint64_t b_high = b >> 32;
+
+    const uint64_t low_low = a_low * b_low;
+    const uint64_t high_low = a_high * b_low;
+    const uint64_t low_high = a_low * b_high;
+    const uint64_t high_high = a_high * b_high;
+
+    const uint64_t middle = (low_low >> 32) + (high_low & 0xffffffff) + low_high;
+    return high_high + (high_low >> 32) + (middle >> 32);
+#endif // __SIZEOF_INT128__
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+#include "safe99_common/defines.h"
+
+// xoshiro256** 의사 난수 생성기
+// 같은 시드면 플랫폼과 무관하게 같은 수열을 만듦
+
+typedef struct random
+{
+    uint64_t state[4];
+} random_t;
+
+START_EXTERN_C
+
+void random_init(random_t* p_random, const uint64_t seed);
+
+uint64_t random_next(random_t* p_random);
+
+// [0, bound) 범위의 균등 분포 정수
+// bound는 0보다 커야 함
+uint64_t random_next_bounded(random_t* p_random, const uint64_t bound);
+
+// 시드 하나에서 서로 겹치지 않는 시드를 뽑을 때 사용 (splitmix64)
+uint64_t random_mix_seed(const uint64_t seed);
+
+END_EXTERN_C
+
+#endif // RANDOM_H
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include <stddef.h>
+
+#include "scheduler.h"
+#include "safe99_common/assert.h"
+
+static uint32_t get_timeout(const scheduler_t* p_scheduler, const uint64_t now);
+
+void scheduler_init(scheduler_t* p_scheduler, scheduler_clock_func pf_clock, void* p_clock_context, scheduler_wait_func pf_wait, void* p_wait_context, const uint32_t max_fps)
+{
+    ASSERT(p_scheduler != NULL, "p_scheduler == NULL");
+    ASSERT(pf_clock != NULL, "pf_clock == NULL");
+    ASSERT(pf_wait != NULL, "pf_wait == NULL");
+
+    p_scheduler->pf_clock = pf_clock;
+    p_scheduler->p_clock_context = p_clock_context;
+    p_scheduler->pf_wait = pf_wait;
+    p_scheduler->p_wait_context = p_wait_context;
+
+    p_scheduler->frame_interval_ms = (max_fps == 0) ? 0 : (1000 + max_fps - 1) / max_fps;
+    p_scheduler->last_frame_time = 0;
+    p_scheduler->deadline = SCHEDULER_NO_DEADLINE;
+
+    // 첫 프레임은 바로 그림
+    p_scheduler->b_redraw_requested = true;
+    p_scheduler->b_animating = false;
+}
+
+void scheduler_request_redraw(scheduler_t* p_scheduler)
+{
+    ASSERT(p_scheduler != NULL, "p_scheduler == NULL");
+    p_scheduler->b_redraw_requested = true;
+}
+
+void scheduler_set_animating(scheduler_t* p_scheduler, const bool b_animating)
+{
+    ASSERT(p_scheduler != NULL, "p_scheduler == NULL");
+    p_scheduler->b_animating = b_animating;
+}
+
+void scheduler_set_deadline(scheduler_t* p_scheduler, const uint64_t deadline)
+{
+    ASSERT(p_scheduler != NULL, "p_scheduler == NULL");
+    p_scheduler->deadline = deadline;
+}
+
+bool scheduler_wait(scheduler_t* p_scheduler)
+{
+    ASSERT(p_scheduler != NULL, "p_scheduler == NULL");
+
+    const uint32_t timeout = get_timeout(p_scheduler, scheduler_get_time(p_scheduler));
+    if (timeout > 0)
+    {
+        if (p_scheduler->pf_wait(p_scheduler->p_wait_context, timeout))
+        {
+            return false;
+        }
+
+        // 시간이 다 되기 전에 깨어났을 수 있으므로 다시 확인
+        if (get_timeout(p_scheduler, scheduler_get_time(p_scheduler)) > 0)
+        {
+            return false;
+        }
+    }
+
+    p_scheduler->last_frame_time = scheduler_get_time(p_scheduler);
+    p_scheduler->b_redraw_requested = false;
+
+    // 지난 마감 시각은 해제, 다음 마감 시각은 프레임에서 다시 설정
+    if (p_scheduler->deadline <= p_scheduler->last_frame_time)
+    {
+        p_scheduler->deadline = SCHEDULER_NO_DEADLINE;
+    }
+
+    return true;
+}
+
+uint64_t scheduler_get_time(const scheduler_t* p_scheduler)
+{
+    ASSERT(p_scheduler != NULL, "p_scheduler == NULL");
+    return p_scheduler->pf_clock(p_scheduler->p_clock_context);
+}
+
+// 다음 프레임까지 남은 시간, 0이면 지금 돌려야 함
+static uint32_t get_timeout(const scheduler_t* p_scheduler, const uint64_t now)
+{
+    uint64_t wake_time = p_scheduler->deadline;
+
+    // 요청이 있으면 프레임 상한만큼만 미룸
+    if (p_scheduler->b_redraw_requested || p_scheduler->b_animating)
+    {
+        const uint64_t frame_time = p_scheduler->last_frame_time + p_scheduler->frame_interval_ms;
+        if (frame_time < wake_time)
+        {
+            wake_time = frame_time;
+        }
+    }
+
+    if (wake_time == SCHEDULER_NO_DEADLINE)
+    {
+        return SCHEDULER_INFINITE;
+    }
+
+    if (wake_time <= now)
+    {
+        return 0;
+    }
+
+    const uint64_t timeout = wake_time - now;
+    return (timeout >= SCHEDULER_INFINITE) ? SCHEDULER_INFINITE - 1 : (uint32_t)timeout;
+}
\ No newline at end of file
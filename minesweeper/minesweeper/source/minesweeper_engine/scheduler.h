@@ -0,0 +1,62 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "safe99_common/defines.h"
+
+// 입력, 타이머 표시 갱신, 애니메이션이 있을 때만 프레임을 돌리고 나머지는 잠드는 스케줄러
+// 시계와 대기 함수를 주입받으므로 플랫폼과 무관하고 가짜 시계로 시험할 수 있음
+
+#define SCHEDULER_NO_DEADLINE UINT64_MAX
+#define SCHEDULER_INFINITE UINT32_MAX
+
+// 현재 시각 (밀리초, 단조 증가)
+typedef uint64_t (*scheduler_clock_func)(void* p_context);
+
+// 이벤트가 오거나 timeout_ms가 지날 때까지 대기, 이벤트가 왔으면 true
+// timeout_ms가 SCHEDULER_INFINITE면 이벤트가 올 때까지 대기
+typedef bool (*scheduler_wait_func)(void* p_context, const uint32_t timeout_ms);
+
+typedef struct scheduler
+{
+    scheduler_clock_func pf_clock;
+    void* p_clock_context;
+    scheduler_wait_func pf_wait;
+    void* p_wait_context;
+
+    // 프레임 사이 최소 간격 (프레임 상한)
+    uint32_t frame_interval_ms;
+    uint64_t last_frame_time;
+
+    // 이 시각이 되면 요청이 없어도 프레임을 돌림 (타이머 표시 갱신 등)
+    uint64_t deadline;
+
+    bool b_redraw_requested;
+    bool b_animating;
+} scheduler_t;
+
+START_EXTERN_C
+
+// max_fps가 0이면 프레임 상한 없음
+void scheduler_init(scheduler_t* p_scheduler, scheduler_clock_func pf_clock, void* p_clock_context, scheduler_wait_func pf_wait, void* p_wait_context, const uint32_t max_fps);
+
+// 입력 등으로 화면이 바뀌었을 때 호출, 다음 프레임 한 번만 돌림
+void scheduler_request_redraw(scheduler_t* p_scheduler);
+
+// 애니메이션 중에는 프레임 상한까지 계속 프레임을 돌림
+void scheduler_set_animating(scheduler_t* p_scheduler, const bool b_animating);
+
+// SCHEDULER_NO_DEADLINE이면 해제
+void scheduler_set_deadline(scheduler_t* p_scheduler, const uint64_t deadline);
+
+// 프레임을 돌릴 때가 될 때까지 대기
+// 프레임을 돌려야 하면 true, 이벤트가 와서 깨어났으면 false (이벤트 처리 후 다시 호출)
+bool scheduler_wait(scheduler_t* p_scheduler);
+
+uint64_t scheduler_get_time(const scheduler_t* p_scheduler);
+
+END_EXTERN_C
+
+#endif // SCHEDULER_H
\ No newline at end of file
@@ -0,0 +1,446 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "clock.h"
+#include "probability.h"
+#include "random.h"
+#include "selfplay.h"
+#include "solver.h"
+#include "safe99_common/assert.h"
+#include "safe99_common/safe_delete.h"
+
+// 임의로 고를 때 이만큼 뽑아도 못 찾으면 임의 위치부터 차례로 찾음
+#define MAX_RANDOM_TRIES 64
+
+typedef struct random_policy
+{
+    const engine_t* p_engine;
+    random_t random;
+} random_policy_t;
+
+typedef struct solver_policy
+{
+    const engine_t* p_engine;
+    solver_t solver;
+    random_t random;
+
+    // 아직 열지 않은 추론 결과
+    const size_t* p_safe_tiles;
+    size_t num_safe_tiles;
+    size_t next_safe_tile;
+
+    // probability 정책만
+    probability_t probability;
+    bool b_probability;
+} solver_policy_t;
+
+static void* create_random_policy(const engine_t* p_engine);
+static void destroy_random_policy(void* p_state);
+static void begin_random_policy(void* p_state);
+static void observe_random_policy(void* p_state);
+static bool choose_random_policy(void* p_state, size_t* p_out_x, size_t* p_out_y);
+
+static void* create_solver_policy(const engine_t* p_engine);
+static void* create_probability_policy(const engine_t* p_engine);
+static void destroy_solver_policy(void* p_state);
+static void begin_solver_policy(void* p_state);
+static void observe_solver_policy(void* p_state);
+static bool choose_solver_policy(void* p_state, size_t* p_out_x, size_t* p_out_y);
+
+static bool pick_random_tile(const engine_t* p_engine, random_t* p_random, const solver_t* p_solver, size_t* p_out_x, size_t* p_out_y);
+static void play_game(void* p_context, const size_t job_index, const size_t worker_index);
+static int compare_latency(const void* p_a, const void* p_b);
+
+static const selfplay_policy_t s_policies[] =
+{
+    { "solver", create_solver_policy, destroy_solver_policy, begin_solver_policy, observe_solver_policy, choose_solver_policy },
+    { "probability", create_probability_policy, destroy_solver_policy, begin_solver_policy, observe_solver_policy, choose_solver_policy },
+    { "random", create_random_policy, destroy_random_policy, begin_random_policy, observe_random_policy, choose_random_policy },
+};
+
+const selfplay_policy_t* selfplay_find_policy(const char* p_name)
+{
+    ASSERT(p_name != NULL, "p_name == NULL");
+
+    for (size_t i = 0; i < sizeof(s_policies) / sizeof(s_policies[0]); ++i)
+    {
+        if (strcmp(s_policies[i].p_name, p_name) == 0)
+        {
+            return &s_policies[i];
+        }
+    }
+
+    return NULL;
+}
+
+bool selfplay_init(selfplay_t* p_selfplay, thread_pool_t* p_pool, const selfplay_config_t* p_config)
+{
+    ASSERT(p_selfplay != NULL, "p_selfplay == NULL");
+    ASSERT(p_config != NULL, "p_config == NULL");
+    ASSERT(p_config->p_policy != NULL, "p_policy == NULL");
+    ASSERT(p_config->num_games > 0, "num_games == 0");
+
+    memset(p_selfplay, 0, sizeof(selfplay_t));
+
+    p_selfplay->p_pool = p_pool;
+    p_selfplay->num_workers = (p_pool == NULL) ? 1 : thread_pool_get_num_threads(p_pool);
+    p_selfplay->config = *p_config;
+
+    p_selfplay->pa_games = (selfplay_game_t*)malloc(sizeof(selfplay_game_t) * p_config->num_games);
+    if (p_selfplay->pa_games == NULL)
+    {
+        ASSERT(false, "Failed to malloc games");
+        goto failed_malloc_games;
+    }
+
+    p_selfplay->pa_latencies = (double*)malloc(sizeof(double) * p_config->num_games);
+    if (p_selfplay->pa_latencies == NULL)
+    {
+        ASSERT(false, "Failed to malloc latencies");
+        goto failed_malloc_latencies;
+    }
+
+    p_selfplay->pa_workers = (selfplay_worker_t*)malloc(sizeof(selfplay_worker_t) * p_selfplay->num_workers);
+    if (p_selfplay->pa_workers == NULL)
+    {
+        ASSERT(false, "Failed to malloc workers");
+        goto failed_malloc_workers;
+    }
+
+    size_t num_ready = 0;
+    for (; num_ready < p_selfplay->num_workers; ++num_ready)
+    {
+        selfplay_worker_t* p_worker = &p_selfplay->pa_workers[num_ready];
+        if (!engine_init(&p_worker->engine, p_config->rows, p_config->cols, p_config->num_mines, p_config->first_seed))
+        {
+            goto failed_init_workers;
+        }
+        engine_set_first_click(&p_worker->engine, p_config->first_click);
+
+        p_worker->p_policy_state = p_config->p_policy->pf_create(&p_worker->engine);
+        if (p_worker->p_policy_state == NULL)
+        {
+            engine_release(&p_worker->engine);
+            goto failed_init_workers;
+        }
+    }
+
+    return true;
+
+failed_init_workers:
+    for (size_t i = 0; i < num_ready; ++i)
+    {
+        p_config->p_policy->pf_destroy(p_selfplay->pa_workers[i].p_policy_state);
+        engine_release(&p_selfplay->pa_workers[i].engine);
+    }
+    SAFE_FREE(p_selfplay->pa_workers);
+
+failed_malloc_workers:
+    SAFE_FREE(p_selfplay->pa_latencies);
+
+failed_malloc_latencies:
+    SAFE_FREE(p_selfplay->pa_games);
+
+failed_malloc_games:
+    memset(p_selfplay, 0, sizeof(selfplay_t));
+    return false;
+}
+
+void selfplay_release(selfplay_t* p_selfplay)
+{
+    ASSERT(p_selfplay != NULL, "p_selfplay == NULL");
+
+    for (size_t i = 0; i < p_selfplay->num_workers; ++i)
+    {
+        p_selfplay->config.p_policy->pf_destroy(p_selfplay->pa_workers[i].p_policy_state);
+        engine_release(&p_selfplay->pa_workers[i].engine);
+    }
+    SAFE_FREE(p_selfplay->pa_workers);
+    SAFE_FREE(p_selfplay->pa_latencies);
+    SAFE_FREE(p_selfplay->pa_games);
+
+    memset(p_selfplay, 0, sizeof(selfplay_t));
+}
+
+void selfplay_run(selfplay_t* p_selfplay, selfplay_result_t* p_out_result)
+{
+    ASSERT(p_selfplay != NULL, "p_selfplay == NULL");
+    ASSERT(p_out_result != NULL, "p_out_result == NULL");
+
+    const size_t num_games = p_selfplay->config.num_games;
+
+    const double start_time = clock_get_seconds();
+
+    // 판 하나가 일감 하나, 판마다 걸리는 시간이 크게 달라도 훔쳐 가며 고르게 나눠짐
+    if (p_selfplay->p_pool != NULL)
+    {
+        thread_pool_run(p_selfplay->p_pool, play_game, p_selfplay, num_games);
+    }
+    else
+    {
+        for (size_t i = 0; i < num_games; ++i)
+        {
+            play_game(p_selfplay, i, 0);
+        }
+    }
+
+    memset(p_out_result, 0, sizeof(selfplay_result_t));
+    p_out_result->elapsed = clock_get_seconds() - start_time;
+    p_out_result->num_games = num_games;
+
+    double total_latency = 0.0;
+    for (size_t i = 0; i < num_games; ++i)
+    {
+        const selfplay_game_t* p_game = &p_selfplay->pa_games[i];
+        switch (p_game->status)
+        {
+        case ENGINE_STATUS_WON:
+            ++p_out_result->num_won;
+            break;
+        case ENGINE_STATUS_LOST:
+            ++p_out_result->num_lost;
+            break;
+        default:
+            ++p_out_result->num_stuck;
+            break;
+        }
+
+        p_out_result->num_moves += p_game->num_moves;
+        total_latency += p_game->latency;
+        p_selfplay->pa_latencies[i] = p_game->latency;
+    }
+
+    // 가장 가까운 순위 백분위
+    double* p_latencies = p_selfplay->pa_latencies;
+    qsort(p_latencies, num_games, sizeof(double), compare_latency);
+
+    p_out_result->mean_latency = total_latency / (double)num_games;
+    p_out_result->p50_latency = p_latencies[(num_games * 50 + 99) / 100 - 1];
+    p_out_result->p90_latency = p_latencies[(num_games * 90 + 99) / 100 - 1];
+    p_out_result->p99_latency = p_latencies[(num_games * 99 + 99) / 100 - 1];
+    p_out_result->max_latency = p_latencies[num_games - 1];
+}
+
+// 판 하나를 끝까지 둠, 결과는 자기 판 칸에만 씀
+static void play_game(void* p_context, const size_t job_index, const size_t worker_index)
+{
+    selfplay_t* p_selfplay = (selfplay_t*)p_context;
+    selfplay_worker_t* p_worker = &p_selfplay->pa_workers[worker_index];
+    const selfplay_policy_t* p_policy = p_selfplay->config.p_policy;
+    engine_t* p_engine = &p_worker->engine;
+
+    const double start_time = clock_get_seconds();
+
+    engine_restart(p_engine, p_selfplay->config.first_seed + job_index);
+    engine_open(p_engine, p_engine->cols / 2, p_engine->rows / 2);
+
+    // 정책이 변경 타일을 읽은 뒤에 비움
+    p_policy->pf_begin_game(p_worker->p_policy_state);
+    engine_clear_dirty(p_engine);
+
+    uint32_t num_moves = 1;
+    while (engine_get_status(p_engine) == ENGINE_STATUS_PLAYING)
+    {
+        size_t x;
+        size_t y;
+        if (!p_policy->pf_choose(p_worker->p_policy_state, &x, &y) || !engine_open(p_engine, x, y))
+        {
+            break;
+        }
+        ++num_moves;
+
+        p_policy->pf_observe(p_worker->p_policy_state);
+        engine_clear_dirty(p_engine);
+    }
+
+    selfplay_game_t* p_game = &p_selfplay->pa_games[job_index];
+    p_game->latency = clock_get_seconds() - start_time;
+    p_game->num_moves = num_moves;
+    p_game->status = engine_get_status(p_engine);
+}
+
+static void* create_random_policy(const engine_t* p_engine)
+{
+    random_policy_t* p_policy = (random_policy_t*)malloc(sizeof(random_policy_t));
+    if (p_policy == NULL)
+    {
+        ASSERT(false, "Failed to malloc policy");
+        return NULL;
+    }
+
+    p_policy->p_engine = p_engine;
+    random_init(&p_policy->random, p_engine->seed);
+
+    return p_policy;
+}
+
+static void destroy_random_policy(void* p_state)
+{
+    SAFE_FREE(p_state);
+}
+
+// 판의 시드로 다시 시작해야 스레드 수와 무관하게 같은 수를 둠
+static void begin_random_policy(void* p_state)
+{
+    random_policy_t* p_policy = (random_policy_t*)p_state;
+    random_init(&p_policy->random, random_mix_seed(p_policy->p_engine->seed));
+}
+
+static void observe_random_policy(void* p_state)
+{
+    (void)p_state;
+}
+
+static bool choose_random_policy(void* p_state, size_t* p_out_x, size_t* p_out_y)
+{
+    random_policy_t* p_policy = (random_policy_t*)p_state;
+    return pick_random_tile(p_policy->p_engine, &p_policy->random, NULL, p_out_x, p_out_y);
+}
+
+static void* create_solver_policy(const engine_t* p_engine)
+{
+    solver_policy_t* p_policy = (solver_policy_t*)malloc(sizeof(solver_policy_t));
+    if (p_policy == NULL)
+    {
+        ASSERT(false, "Failed to malloc policy");
+        return NULL;
+    }
+    memset(p_policy, 0, sizeof(solver_policy_t));
+
+    p_policy->p_engine = p_engine;
+    random_init(&p_policy->random, p_engine->seed);
+
+    if (!solver_init(&p_policy->solver, p_engine))
+    {
+        SAFE_FREE(p_policy);
+        return NULL;
+    }
+
+    return p_policy;
+}
+
+// 판 하나가 이미 작업자 하나에서 돌고 있으므로 확률 계산은 풀 없이 함
+static void* create_probability_policy(const engine_t* p_engine)
+{
+    solver_policy_t* p_policy = (solver_policy_t*)create_solver_policy(p_engine);
+    if (p_policy == NULL)
+    {
+        return NULL;
+    }
+
+    if (!probability_init(&p_policy->probability, p_engine, NULL))
+    {
+        destroy_solver_policy(p_policy);
+        return NULL;
+    }
+    p_policy->b_probability = true;
+
+    return p_policy;
+}
+
+static void destroy_solver_policy(void* p_state)
+{
+    solver_policy_t* p_policy = (solver_policy_t*)p_state;
+
+    if (p_policy->b_probability)
+    {
+        probability_release(&p_policy->probability);
+    }
+    solver_release(&p_policy->solver);
+
+    SAFE_FREE(p_policy);
+}
+
+static void begin_solver_policy(void* p_state)
+{
+    solver_policy_t* p_policy = (solver_policy_t*)p_state;
+
+    // 세대가 바뀌었으므로 판 전체를 다시 읽음
+    solver_clear_results(&p_policy->solver);
+    solver_update(&p_policy->solver);
+
+    p_policy->p_safe_tiles = NULL;
+    p_policy->num_safe_tiles = 0;
+    p_policy->next_safe_tile = 0;
+
+    random_init(&p_policy->random, random_mix_seed(p_policy->p_engine->seed));
+}
+
+static void observe_solver_policy(void* p_state)
+{
+    solver_policy_t* p_policy = (solver_policy_t*)p_state;
+    solver_update(&p_policy->solver);
+}
+
+static bool choose_solver_policy(void* p_state, size_t* p_out_x, size_t* p_out_y)
+{
+    solver_policy_t* p_policy = (solver_policy_t*)p_state;
+    const engine_t* p_engine = p_policy->p_engine;
+
+    while (true)
+    {
+        // 앞서 연 칸에서 번져 이미 열렸을 수 있음
+        while (p_policy->next_safe_tile < p_policy->num_safe_tiles)
+        {
+            const size_t index = p_policy->p_safe_tiles[p_policy->next_safe_tile++];
+            if (engine_get_tile_at(p_engine, index) == TILE_BLIND)
+            {
+                *p_out_x = index % p_engine->cols;
+                *p_out_y = index / p_engine->cols;
+                return true;
+            }
+        }
+
+        solver_clear_results(&p_policy->solver);
+        p_policy->num_safe_tiles = 0;
+        p_policy->next_safe_tile = 0;
+
+        // 새로 확정한 칸이 지뢰뿐이어도 다음 추론에 쓰이므로 한 번 더 돎
+        if (solver_deduce(&p_policy->solver) == 0)
+        {
+            break;
+        }
+        p_policy->p_safe_tiles = solver_get_safe_tiles(&p_policy->solver, &p_policy->num_safe_tiles);
+    }
+
+    if (p_policy->b_probability && probability_compute(&p_policy->probability)
+        && probability_find_safest(&p_policy->probability, p_out_x, p_out_y))
+    {
+        return true;
+    }
+
+    return pick_random_tile(p_engine, &p_policy->random, &p_policy->solver, p_out_x, p_out_y);
+}
+
+// 닫힌 칸 중 임의로 하나, p_solver가 있으면 지뢰로 확정한 칸은 뺌
+static bool pick_random_tile(const engine_t* p_engine, random_t* p_random, const solver_t* p_solver, size_t* p_out_x, size_t* p_out_y)
+{
+    const size_t cols = p_engine->cols;
+    const size_t num_tiles = p_engine->rows * cols;
+
+    size_t index = (size_t)random_next_bounded(p_random, num_tiles);
+    for (size_t i = 0; i < MAX_RANDOM_TRIES + num_tiles; ++i)
+    {
+        const size_t x = index % cols;
+        const size_t y = index / cols;
+        if (engine_get_tile_at(p_engine, index) == TILE_BLIND
+            && (p_solver == NULL || (p_solver->pa_cells[(y + 1) * p_solver->stride + x + 1] & SOLVER_CELL_KNOWN_MINE) == 0))
+        {
+            *p_out_x = x;
+            *p_out_y = y;
+            return true;
+        }
+
+        // 닫힌 칸이 드물면 뽑기보다 차례로 찾는 편이 빠름
+        index = (i < MAX_RANDOM_TRIES) ? (size_t)random_next_bounded(p_random, num_tiles) : (index + 1) % num_tiles;
+    }
+
+    return false;
+}
+
+static int compare_latency(const void* p_a, const void* p_b)
+{
+    const double a = *(const double*)p_a;
+    const double b = *(const double*)p_b;
+    return (a > b) - (a < b);
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+#ifndef SELFPLAY_H
+#define SELFPLAY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "engine.h"
+#include "thread_pool.h"
+#include "safe99_common/defines.h"
+
+// 정책을 정해 여러 판을 스레드 풀에서 자동으로 두고 처리량/승률/판별 지연 시간을 집계
+// 판 i의 시드는 first_seed + i이고 첫 칸은 항상 가운데
+// 작업자마다 엔진과 정책 상태를 따로 두고 판별 결과는 판마다 자기 칸에만 쓰므로 작업자끼리 공유하는 가변 상태가 없음
+// 같은 설정이면 스레드 수와 무관하게 같은 결과 (시간 제외)
+
+// 정책: 작업자마다 상태를 하나씩 만들고 다음에 열 칸을 고름
+typedef struct selfplay_policy
+{
+    const char* p_name;
+
+    // p_engine에 묶인 상태, 실패하면 NULL
+    void* (*pf_create)(const engine_t* p_engine);
+    void (*pf_destroy)(void* p_state);
+
+    // 판마다 첫 칸을 연 뒤, 그 뒤로는 칸을 열 때마다 호출
+    // 호출한 다음에 엔진의 변경 타일 목록을 비우므로 추론기 같은 증분 상태는 여기서 갱신
+    void (*pf_begin_game)(void* p_state);
+    void (*pf_observe)(void* p_state);
+
+    // 다음에 열 칸, 고를 칸이 없으면 false (판을 끝내지 못한 것으로 셈)
+    bool (*pf_choose)(void* p_state, size_t* p_out_x, size_t* p_out_y);
+} selfplay_policy_t;
+
+typedef struct selfplay_config
+{
+    size_t rows;
+    size_t cols;
+    size_t num_mines;
+    engine_first_click_t first_click;
+
+    uint64_t first_seed;
+    size_t num_games;
+
+    const selfplay_policy_t* p_policy;
+} selfplay_config_t;
+
+typedef struct selfplay_result
+{
+    size_t num_games;
+    size_t num_won;
+    size_t num_lost;
+    size_t num_stuck;
+    uint64_t num_moves;
+
+    // 전체 경과 시간과 판별 지연 시간 (초)
+    double elapsed;
+    double mean_latency;
+    double p50_latency;
+    double p90_latency;
+    double p99_latency;
+    double max_latency;
+} selfplay_result_t;
+
+typedef struct selfplay_worker
+{
+    engine_t engine;
+    void* p_policy_state;
+} selfplay_worker_t;
+
+typedef struct selfplay_game
+{
+    double latency;
+    uint32_t num_moves;
+    engine_status_t status;
+} selfplay_game_t;
+
+typedef struct selfplay
+{
+    // NULL이면 호출 스레드에서만 둠
+    thread_pool_t* p_pool;
+    size_t num_workers;
+    selfplay_worker_t* pa_workers;
+
+    selfplay_config_t config;
+
+    // num_games개, 판마다 한 번만 씀
+    selfplay_game_t* pa_games;
+    // 백분위 계산용
+    double* pa_latencies;
+} selfplay_t;
+
+START_EXTERN_C
+
+// 이름으로 기본 정책 찾기, 없으면 NULL
+// "solver": 추론기가 찾은 안전한 칸을 열고 막히면 지뢰로 확정하지 않은 칸 중 임의로 엶
+// "probability": 추론기가 막히면 지뢰 확률이 가장 낮은 칸을 엶
+// "random": 닫힌 칸 중 임의로 엶
+const selfplay_policy_t* selfplay_find_policy(const char* p_name);
+
+// 작업자 수만큼 엔진을 만들고 판마다 결과를 담을 메모리를 미리 잡음
+//
+// 이미 초기화한 자동 대국을 다시 초기화하지 말 것
+// 해야 한다면 selfplay_release() 호출 이후 재호출
+bool selfplay_init(selfplay_t* p_selfplay, thread_pool_t* p_pool, const selfplay_config_t* p_config);
+void selfplay_release(selfplay_t* p_selfplay);
+
+// 모든 판을 두고 집계
+void selfplay_run(selfplay_t* p_selfplay, selfplay_result_t* p_out_result);
+
+END_EXTERN_C
+
+#endif // SELFPLAY_H
\ No newline at end of file
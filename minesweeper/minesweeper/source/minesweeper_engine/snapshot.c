@@ -0,0 +1,514 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bitboard.h"
+#include "snapshot.h"
+#include "safe99_common/assert.h"
+#include "safe99_common/safe_delete.h"
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <Windows.h>
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif // _WIN32
+
+static void fill_layout(snapshot_header_t* p_header);
+static size_t align_up(const size_t size);
+static void copy_unsaved_tiles(uint32_t* p_tiles, engine_t* p_engine);
+
+static void write_thread(void* p_arg);
+static bool write_file(const char* p_path, const uint8_t* p_data, const size_t size);
+static bool flush_file(FILE* p_file);
+static bool replace_file(const char* p_from_path, const char* p_to_path);
+
+bool snapshot_open(snapshot_t* p_snapshot, const char* p_path)
+{
+    ASSERT(p_snapshot != NULL, "p_snapshot == NULL");
+    ASSERT(p_path != NULL, "p_path == NULL");
+
+    memset(p_snapshot, 0, sizeof(snapshot_t));
+
+    if (!mapped_file_open(&p_snapshot->file, p_path))
+    {
+        return false;
+    }
+
+    const uint8_t* p_data = p_snapshot->file.p_data;
+    const size_t file_size = p_snapshot->file.size;
+    const snapshot_header_t* p_header = (const snapshot_header_t*)p_data;
+
+    if (file_size < SNAPSHOT_HEADER_SIZE
+        || memcmp(p_header->magic, "MSSN", 4) != 0
+        || p_header->version != SNAPSHOT_VERSION
+        || p_header->byte_order != SNAPSHOT_BYTE_ORDER
+        || p_header->header_size != SNAPSHOT_HEADER_SIZE
+        || p_header->file_size != file_size)
+    {
+        goto failed_validate;
+    }
+
+    // 엔진이 만들 수 있는 판이고 구역 크기 계산이 넘치지 않는지
+    const uint64_t rows = p_header->rows;
+    const uint64_t cols = p_header->cols;
+    if (rows == 0 || cols == 0 || rows > UINT32_MAX || cols > UINT32_MAX || rows * cols > SIZE_MAX / 16
+        || p_header->num_max_mines == 0 || p_header->num_max_mines >= rows * cols
+        || p_header->num_tiles < p_header->num_max_mines || p_header->num_tiles > rows * cols
+        || p_header->generation > ENGINE_MAX_GENERATION
+        || p_header->first_click > ENGINE_FIRST_CLICK_SAFE_AREA
+        || p_header->status > ENGINE_STATUS_LOST
+        || p_header->b_mines_placed > 1)
+    {
+        goto failed_validate;
+    }
+
+    // 구역 배치는 크기만으로 정해지므로 다시 계산해서 비교
+    snapshot_header_t layout;
+    memcpy(&layout, p_header, sizeof(snapshot_header_t));
+    fill_layout(&layout);
+    if (layout.file_size != file_size
+        || memcmp(layout.section_offsets, p_header->section_offsets, sizeof(layout.section_offsets)) != 0
+        || memcmp(layout.section_sizes, p_header->section_sizes, sizeof(layout.section_sizes)) != 0)
+    {
+        goto failed_validate;
+    }
+
+    if (p_header->b_mines_placed)
+    {
+        // 게임 오버 때 지뢰 목록으로 타일을 씀
+        const uint64_t* p_mine_indices = (const uint64_t*)(p_data + p_header->section_offsets[SNAPSHOT_SECTION_MINE_INDICES]);
+        for (uint64_t i = 0; i < p_header->num_max_mines; ++i)
+        {
+            if (p_mine_indices[i] >= rows * cols)
+            {
+                goto failed_validate;
+            }
+        }
+
+        // 인접 지뢰 개수는 복원할 때 지뢰 평면으로 다시 계산하므로 테두리 줄과 cols 이후 비트는 0이어야 함
+        const uint64_t* p_mine_bits = (const uint64_t*)(p_data + p_header->section_offsets[SNAPSHOT_SECTION_MINE_BITS]);
+        const size_t num_words = bitboard_get_num_words((size_t)cols);
+        const uint64_t tail_mask = (cols % 64 != 0) ? ~(uint64_t)0 << (cols % 64) : 0;
+        for (size_t x = 0; x < num_words; ++x)
+        {
+            if (p_mine_bits[x] != 0 || p_mine_bits[((size_t)rows + 1) * num_words + x] != 0)
+            {
+                goto failed_validate;
+            }
+        }
+        for (size_t y = 1; y <= rows; ++y)
+        {
+            if ((p_mine_bits[y * num_words + num_words - 1] & tail_mask) != 0)
+            {
+                goto failed_validate;
+            }
+        }
+    }
+
+    p_snapshot->p_header = p_header;
+    return true;
+
+failed_validate:
+    mapped_file_close(&p_snapshot->file);
+    memset(p_snapshot, 0, sizeof(snapshot_t));
+    return false;
+}
+
+void snapshot_close(snapshot_t* p_snapshot)
+{
+    ASSERT(p_snapshot != NULL, "p_snapshot == NULL");
+
+    mapped_file_close(&p_snapshot->file);
+    memset(p_snapshot, 0, sizeof(snapshot_t));
+}
+
+bool snapshot_restore(const snapshot_t* p_snapshot, engine_t* p_out_engine, snapshot_session_t* p_out_session)
+{
+    ASSERT(p_snapshot != NULL, "p_snapshot == NULL");
+    ASSERT(p_snapshot->p_header != NULL, "Not opened");
+    ASSERT(p_out_engine != NULL, "p_out_engine == NULL");
+    ASSERT(p_out_session != NULL, "p_out_session == NULL");
+
+    const snapshot_header_t* p_header = p_snapshot->p_header;
+    const uint8_t* p_data = p_snapshot->file.p_data;
+
+    if (!engine_init(p_out_engine, (size_t)p_header->rows, (size_t)p_header->cols, (size_t)p_header->num_max_mines, p_header->seed))
+    {
+        return false;
+    }
+
+    p_out_engine->num_mines = p_header->num_mines;
+    p_out_engine->num_tiles = (size_t)p_header->num_tiles;
+    p_out_engine->generation = p_header->generation;
+    p_out_engine->first_click = (engine_first_click_t)p_header->first_click;
+    p_out_engine->status = (engine_status_t)p_header->status;
+
+    const uint64_t* p_offsets = p_header->section_offsets;
+    const uint64_t* p_sizes = p_header->section_sizes;
+
+    memcpy(p_out_engine->pa_tiles, p_data + p_offsets[SNAPSHOT_SECTION_TILES], (size_t)p_sizes[SNAPSHOT_SECTION_TILES]);
+
+    if (p_header->b_mines_placed)
+    {
+        memcpy(p_out_engine->pa_mine_bits, p_data + p_offsets[SNAPSHOT_SECTION_MINE_BITS], (size_t)p_sizes[SNAPSHOT_SECTION_MINE_BITS]);
+
+        // 64비트에서는 파일 배치와 같음
+        const uint64_t* p_mine_indices = (const uint64_t*)(p_data + p_offsets[SNAPSHOT_SECTION_MINE_INDICES]);
+        if (sizeof(size_t) == sizeof(uint64_t))
+        {
+            memcpy(p_out_engine->pa_mine_indices, p_mine_indices, (size_t)p_sizes[SNAPSHOT_SECTION_MINE_INDICES]);
+        }
+        else
+        {
+            for (size_t i = 0; i < p_out_engine->num_max_mines; ++i)
+            {
+                p_out_engine->pa_mine_indices[i] = (size_t)p_mine_indices[i];
+            }
+        }
+
+        // 타일과 세대를 채운 뒤에 불러야 연 빈칸을 방문한 칸으로 표시함
+        engine_load_mines(p_out_engine);
+    }
+
+    p_out_session->elapsed_ms = p_header->elapsed_ms;
+    p_out_session->b_timer_started = p_header->b_timer_started != 0;
+    memcpy(p_out_session->seed_random.state, p_header->seed_random_state, sizeof(p_out_session->seed_random.state));
+
+    return true;
+}
+
+bool snapshot_writer_init(snapshot_writer_t* p_writer)
+{
+    ASSERT(p_writer != NULL, "p_writer == NULL");
+    ASSERT(sizeof(snapshot_header_t) <= SNAPSHOT_HEADER_SIZE, "Header too large");
+
+    memset(p_writer, 0, sizeof(snapshot_writer_t));
+    p_writer->b_last_succeeded = true;
+
+    if (!mutex_init(&p_writer->mutex))
+    {
+        ASSERT(false, "Failed to init mutex");
+        goto failed_init_mutex;
+    }
+
+    if (!cond_init(&p_writer->cond))
+    {
+        ASSERT(false, "Failed to init cond");
+        goto failed_init_cond;
+    }
+
+    if (!thread_create(&p_writer->thread, write_thread, p_writer))
+    {
+        ASSERT(false, "Failed to create thread");
+        goto failed_create_thread;
+    }
+
+    return true;
+
+failed_create_thread:
+    cond_release(&p_writer->cond);
+
+failed_init_cond:
+    mutex_release(&p_writer->mutex);
+
+failed_init_mutex:
+    memset(p_writer, 0, sizeof(snapshot_writer_t));
+    return false;
+}
+
+void snapshot_writer_release(snapshot_writer_t* p_writer)
+{
+    ASSERT(p_writer != NULL, "p_writer == NULL");
+
+    mutex_lock(&p_writer->mutex);
+    p_writer->b_quit = true;
+    cond_broadcast(&p_writer->cond);
+    mutex_unlock(&p_writer->mutex);
+
+    thread_join(&p_writer->thread);
+
+    cond_release(&p_writer->cond);
+    mutex_release(&p_writer->mutex);
+    SAFE_FREE(p_writer->pa_image);
+
+    memset(p_writer, 0, sizeof(snapshot_writer_t));
+}
+
+bool snapshot_writer_request(snapshot_writer_t* p_writer, const char* p_path, engine_t* p_engine, const snapshot_session_t* p_session)
+{
+    ASSERT(p_writer != NULL, "p_writer == NULL");
+    ASSERT(p_path != NULL, "p_path == NULL");
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+    ASSERT(p_session != NULL, "p_session == NULL");
+
+    // 쓰기 스레드가 이미지를 읽는 중이면 기다리지 않고 건너뜀
+    mutex_lock(&p_writer->mutex);
+    const bool b_pending = p_writer->b_pending;
+    mutex_unlock(&p_writer->mutex);
+
+    if (b_pending || strlen(p_path) + sizeof(".tmp") > SNAPSHOT_MAX_PATH)
+    {
+        return false;
+    }
+
+    snapshot_header_t header;
+    memset(&header, 0, sizeof(snapshot_header_t));
+    memcpy(header.magic, "MSSN", 4);
+    header.version = SNAPSHOT_VERSION;
+    header.byte_order = SNAPSHOT_BYTE_ORDER;
+    header.header_size = SNAPSHOT_HEADER_SIZE;
+    header.rows = p_engine->rows;
+    header.cols = p_engine->cols;
+    header.num_max_mines = p_engine->num_max_mines;
+    header.num_mines = p_engine->num_mines;
+    header.num_tiles = p_engine->num_tiles;
+    header.seed = p_engine->seed;
+    header.generation = p_engine->generation;
+    header.first_click = (uint32_t)p_engine->first_click;
+    header.status = (uint32_t)p_engine->status;
+    header.b_mines_placed = p_engine->b_mines_placed ? 1 : 0;
+    header.elapsed_ms = p_session->elapsed_ms;
+    header.b_timer_started = p_session->b_timer_started ? 1 : 0;
+    memcpy(header.seed_random_state, p_session->seed_random.state, sizeof(header.seed_random_state));
+    fill_layout(&header);
+
+    // 지뢰를 배치한 판 크기로 잡아 두면 같은 엔진에서는 다시 할당하지 않음
+    snapshot_header_t capacity_layout;
+    memcpy(&capacity_layout, &header, sizeof(snapshot_header_t));
+    capacity_layout.b_mines_placed = 1;
+    fill_layout(&capacity_layout);
+
+    bool b_copy_all = false;
+    const size_t image_size = (size_t)header.file_size;
+    const size_t image_capacity = (size_t)capacity_layout.file_size;
+    if (image_capacity > p_writer->image_capacity)
+    {
+        uint8_t* pa_image = (uint8_t*)malloc(image_capacity);
+        if (pa_image == NULL)
+        {
+            return false;
+        }
+
+        SAFE_FREE(p_writer->pa_image);
+        p_writer->pa_image = pa_image;
+        p_writer->image_capacity = image_capacity;
+        b_copy_all = true;
+    }
+
+    uint8_t* p_image = p_writer->pa_image;
+    memset(p_image, 0, SNAPSHOT_HEADER_SIZE);
+    memcpy(p_image, &header, sizeof(snapshot_header_t));
+
+    // 구역 사이 정렬 여백도 0으로 채워 같은 판이면 같은 파일이 나오게 함
+    for (size_t i = 0; i < SNAPSHOT_NUM_SECTIONS; ++i)
+    {
+        const size_t end = (size_t)(header.section_offsets[i] + header.section_sizes[i]);
+        const size_t next = (i + 1 < SNAPSHOT_NUM_SECTIONS) ? (size_t)header.section_offsets[i + 1] : image_size;
+        memset(p_image + end, 0, next - end);
+    }
+
+    // 재시작은 세대만 바꾸므로 이미지의 타일도 그대로 맞음, 바뀐 블록만 복사
+    uint32_t* p_tiles = (uint32_t*)(p_image + header.section_offsets[SNAPSHOT_SECTION_TILES]);
+    if (b_copy_all || p_engine->b_all_unsaved)
+    {
+        memcpy(p_tiles, p_engine->pa_tiles, (size_t)header.section_sizes[SNAPSHOT_SECTION_TILES]);
+        memset(p_engine->pa_unsaved_bits, 0, sizeof(uint64_t) * p_engine->num_unsaved_words);
+        p_engine->b_all_unsaved = false;
+    }
+    else
+    {
+        copy_unsaved_tiles(p_tiles, p_engine);
+    }
+
+    // 지뢰는 판마다 한 번 배치한 뒤 바뀌지 않음
+    if (header.b_mines_placed && (b_copy_all || p_engine->b_mines_unsaved))
+    {
+        memcpy(p_image + header.section_offsets[SNAPSHOT_SECTION_MINE_BITS], p_engine->pa_mine_bits, (size_t)header.section_sizes[SNAPSHOT_SECTION_MINE_BITS]);
+
+        uint64_t* p_mine_indices = (uint64_t*)(p_image + header.section_offsets[SNAPSHOT_SECTION_MINE_INDICES]);
+        if (sizeof(size_t) == sizeof(uint64_t))
+        {
+            memcpy(p_mine_indices, p_engine->pa_mine_indices, (size_t)header.section_sizes[SNAPSHOT_SECTION_MINE_INDICES]);
+        }
+        else
+        {
+            for (size_t i = 0; i < p_engine->num_max_mines; ++i)
+            {
+                p_mine_indices[i] = (uint64_t)p_engine->pa_mine_indices[i];
+            }
+        }
+
+        p_engine->b_mines_unsaved = false;
+    }
+
+    mutex_lock(&p_writer->mutex);
+    {
+        p_writer->image_size = image_size;
+        strcpy(p_writer->path, p_path);
+        p_writer->b_pending = true;
+        cond_broadcast(&p_writer->cond);
+    }
+    mutex_unlock(&p_writer->mutex);
+
+    return true;
+}
+
+bool snapshot_writer_wait(snapshot_writer_t* p_writer)
+{
+    ASSERT(p_writer != NULL, "p_writer == NULL");
+
+    mutex_lock(&p_writer->mutex);
+    while (p_writer->b_pending)
+    {
+        cond_wait(&p_writer->cond, &p_writer->mutex);
+    }
+    const bool b_succeeded = p_writer->b_last_succeeded;
+    mutex_unlock(&p_writer->mutex);
+
+    return b_succeeded;
+}
+
+// 헤더의 판 크기와 지뢰 배치 여부로 구역 오프셋/크기와 파일 크기를 채움
+static void fill_layout(snapshot_header_t* p_header)
+{
+    const size_t rows = (size_t)p_header->rows;
+    const size_t cols = (size_t)p_header->cols;
+    const bool b_mines_placed = p_header->b_mines_placed != 0;
+
+    uint64_t* p_sizes = p_header->section_sizes;
+    p_sizes[SNAPSHOT_SECTION_TILES] = sizeof(uint32_t) * rows * cols;
+    p_sizes[SNAPSHOT_SECTION_MINE_BITS] = b_mines_placed ? sizeof(uint64_t) * (rows + 2) * bitboard_get_num_words(cols) : 0;
+    p_sizes[SNAPSHOT_SECTION_MINE_INDICES] = b_mines_placed ? sizeof(uint64_t) * (size_t)p_header->num_max_mines : 0;
+
+    size_t offset = SNAPSHOT_HEADER_SIZE;
+    for (size_t i = 0; i < SNAPSHOT_NUM_SECTIONS; ++i)
+    {
+        p_header->section_offsets[i] = offset;
+        offset = align_up(offset + (size_t)p_sizes[i]);
+    }
+
+    p_header->file_size = offset;
+}
+
+static size_t align_up(const size_t size)
+{
+    return (size + SNAPSHOT_ALIGNMENT - 1) & ~(size_t)(SNAPSHOT_ALIGNMENT - 1);
+}
+
+// 바뀐 블록만 복사하고 기록을 지움, 기록 워드 수와 바뀐 블록 크기에 비례
+static void copy_unsaved_tiles(uint32_t* p_tiles, engine_t* p_engine)
+{
+    const size_t num_tiles = p_engine->rows * p_engine->cols;
+    uint64_t* p_bits = p_engine->pa_unsaved_bits;
+
+    for (size_t word = 0; word < p_engine->num_unsaved_words; ++word)
+    {
+        uint64_t bits = p_bits[word];
+        if (bits == 0)
+        {
+            continue;
+        }
+        p_bits[word] = 0;
+
+        for (size_t block = word * 64; bits != 0; ++block, bits >>= 1)
+        {
+            if ((bits & 1) == 0)
+            {
+                continue;
+            }
+
+            const size_t begin = block * ENGINE_SAVE_BLOCK_TILES;
+            const size_t end = (begin + ENGINE_SAVE_BLOCK_TILES < num_tiles) ? begin + ENGINE_SAVE_BLOCK_TILES : num_tiles;
+            memcpy(p_tiles + begin, p_engine->pa_tiles + begin, sizeof(uint32_t) * (end - begin));
+        }
+    }
+}
+
+static void write_thread(void* p_arg)
+{
+    snapshot_writer_t* p_writer = (snapshot_writer_t*)p_arg;
+
+    mutex_lock(&p_writer->mutex);
+    while (true)
+    {
+        while (!p_writer->b_pending && !p_writer->b_quit)
+        {
+            cond_wait(&p_writer->cond, &p_writer->mutex);
+        }
+
+        // 끝내기 전에 받은 요청은 씀
+        if (!p_writer->b_pending)
+        {
+            break;
+        }
+
+        // 이미지와 경로는 b_pending인 동안 바뀌지 않음
+        mutex_unlock(&p_writer->mutex);
+        const bool b_succeeded = write_file(p_writer->path, p_writer->pa_image, p_writer->image_size);
+        mutex_lock(&p_writer->mutex);
+
+        p_writer->b_last_succeeded = b_succeeded;
+        if (b_succeeded)
+        {
+            ++p_writer->num_written;
+        }
+        p_writer->b_pending = false;
+        cond_broadcast(&p_writer->cond);
+    }
+    mutex_unlock(&p_writer->mutex);
+}
+
+// 임시 파일에 다 쓰고 디스크에 내린 뒤에만 원래 이름으로 바꿈
+static bool write_file(const char* p_path, const uint8_t* p_data, const size_t size)
+{
+    char temp_path[SNAPSHOT_MAX_PATH];
+    strcpy(temp_path, p_path);
+    strcat(temp_path, ".tmp");
+
+    FILE* p_file = fopen(temp_path, "wb");
+    if (p_file == NULL)
+    {
+        return false;
+    }
+
+    bool b_succeeded = fwrite(p_data, 1, size, p_file) == size && flush_file(p_file);
+    b_succeeded = (fclose(p_file) == 0) && b_succeeded;
+
+    if (!b_succeeded || !replace_file(temp_path, p_path))
+    {
+        remove(temp_path);
+        return false;
+    }
+
+    return true;
+}
+
+#if defined(_WIN32)
+
+static bool flush_file(FILE* p_file)
+{
+    return fflush(p_file) == 0 && _commit(_fileno(p_file)) == 0;
+}
+
+static bool replace_file(const char* p_from_path, const char* p_to_path)
+{
+    return MoveFileExA(p_from_path, p_to_path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+}
+
+#else
+
+static bool flush_file(FILE* p_file)
+{
+    return fflush(p_file) == 0 && fsync(fileno(p_file)) == 0;
+}
+
+static bool replace_file(const char* p_from_path, const char* p_to_path)
+{
+    return rename(p_from_path, p_to_path) == 0;
+}
+
+#endif // _WIN32
\ No newline at end of file
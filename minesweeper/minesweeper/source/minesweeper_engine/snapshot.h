@@ -0,0 +1,144 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "engine.h"
+#include "mapped_file.h"
+#include "random.h"
+#include "thread.h"
+#include "safe99_common/defines.h"
+
+// 진행 중인 판을 통째로 저장했다가 그대로 이어 하는 바이너리 스냅숏
+// 엔진 배열을 메모리 배치 그대로 (이 기계의 바이트 순서, 구역마다 64바이트 정렬) 쓰므로
+// 복원은 파일을 매핑한 뒤 구역마다 memcpy 한 번, 인접 지뢰 개수만 engine_load_mines()로 다시 계산
+//
+// 형식
+//   snapshot_header_t (SNAPSHOT_HEADER_SIZE 바이트로 채움)
+//   구역 (오프셋과 크기는 헤더에)
+//     TILES: pa_tiles 그대로 (u32 x rows * cols, 세대 포함)
+//     MINE_BITS: pa_mine_bits 그대로 (u64 x (rows + 2) * num_mine_words)
+//     MINE_INDICES: pa_mine_indices (u64 x num_max_mines)
+//   지뢰를 배치하기 전이면 지뢰 구역 두 개는 크기 0
+//
+// 쓰기는 임시 파일에 쓰고 디스크에 내린 뒤 이름을 바꾸므로 쓰는 도중에 죽어도 이전 스냅숏이 남음
+
+#define SNAPSHOT_VERSION 2
+#define SNAPSHOT_HEADER_SIZE 256
+#define SNAPSHOT_ALIGNMENT 64
+#define SNAPSHOT_BYTE_ORDER 0x01020304
+
+// 임시 파일 이름 (".tmp" 추가)을 포함한 최대 경로 길이
+#define SNAPSHOT_MAX_PATH 260
+
+typedef enum snapshot_section
+{
+    SNAPSHOT_SECTION_TILES,
+    SNAPSHOT_SECTION_MINE_BITS,
+    SNAPSHOT_SECTION_MINE_INDICES,
+    SNAPSHOT_NUM_SECTIONS
+} snapshot_section_t;
+
+typedef struct snapshot_header
+{
+    char magic[4];
+    uint32_t version;
+    // SNAPSHOT_BYTE_ORDER, 바이트 순서가 다른 기계에서 쓴 파일을 거름
+    uint32_t byte_order;
+    uint32_t header_size;
+    uint64_t file_size;
+
+    // 엔진
+    uint64_t rows;
+    uint64_t cols;
+    uint64_t num_max_mines;
+    int64_t num_mines;
+    uint64_t num_tiles;
+    uint64_t seed;
+    uint32_t generation;
+    uint32_t first_click;
+    uint32_t status;
+    uint32_t b_mines_placed;
+
+    // 엔진 밖의 진행 상태 (snapshot_session_t)
+    uint64_t elapsed_ms;
+    uint64_t seed_random_state[4];
+    uint32_t b_timer_started;
+    uint32_t reserved;
+
+    // 파일 처음부터의 오프셋과 바이트 수
+    uint64_t section_offsets[SNAPSHOT_NUM_SECTIONS];
+    uint64_t section_sizes[SNAPSHOT_NUM_SECTIONS];
+} snapshot_header_t;
+
+// 엔진과 같이 저장하는 게임 상태
+typedef struct snapshot_session
+{
+    // 판을 진행한 시간 (밀리초), 타이머가 멈춘 판은 멈춘 시점까지
+    uint64_t elapsed_ms;
+    bool b_timer_started;
+
+    // 다음 판 시드를 뽑는 난수, 이어 한 뒤에도 같은 순서로 판이 나옴
+    random_t seed_random;
+} snapshot_session_t;
+
+typedef struct snapshot
+{
+    mapped_file_t file;
+    const snapshot_header_t* p_header;
+} snapshot_t;
+
+// 판을 메모리의 파일 이미지에 복사해 두고 파일 쓰기는 전용 스레드에서 함
+// 이미지는 요청 사이에 남아 있으므로 엔진이 기록한 바뀐 타일 블록만 복사하고, 지뢰는 판마다 한 번만 복사함
+// 새 엔진 (처음, 이어 하기)이나 세대가 한 바퀴 돈 뒤에만 타일 전체를 복사함
+typedef struct snapshot_writer
+{
+    thread_t thread;
+    mutex_t mutex;
+    cond_t cond;
+
+    // 파일 내용 그대로, b_pending인 동안에는 쓰기 스레드만 읽음
+    // 지뢰를 배치한 판 크기로 잡으므로 같은 엔진이면 다시 할당하지 않음
+    uint8_t* pa_image;
+    size_t image_size;
+    size_t image_capacity;
+    char path[SNAPSHOT_MAX_PATH];
+
+    // mutex로 보호
+    bool b_pending;
+    bool b_quit;
+    bool b_last_succeeded;
+    size_t num_written;
+} snapshot_writer_t;
+
+START_EXTERN_C
+
+// 파일을 매핑하고 헤더/구역 범위/지뢰 목록/테두리를 검사
+// 틀렸으면 false
+bool snapshot_open(snapshot_t* p_snapshot, const char* p_path);
+void snapshot_close(snapshot_t* p_snapshot);
+
+// 스냅숏 크기로 엔진을 새로 만들고 구역을 복사
+// p_out_engine은 초기화하지 않은 엔진이어야 하고, 실패하면 만들지 않음
+bool snapshot_restore(const snapshot_t* p_snapshot, engine_t* p_out_engine, snapshot_session_t* p_out_session);
+
+// 이미 초기화한 쓰기 객체를 다시 초기화하지 말 것
+// 해야 한다면 snapshot_writer_release() 호출 이후 재호출
+bool snapshot_writer_init(snapshot_writer_t* p_writer);
+
+// 진행 중인 쓰기를 끝낸 뒤 스레드를 멈춤
+void snapshot_writer_release(snapshot_writer_t* p_writer);
+
+// 지난 요청 이후 바뀐 부분만 복사하고 바로 반환, 파일은 쓰기 스레드가 씀
+// 복사한 뒤 엔진의 저장하지 않은 타일/지뢰 기록을 지우므로 엔진 하나는 쓰기 객체 하나로만 저장할 것
+// 이전 스냅숏을 아직 쓰는 중이거나 경로가 너무 길거나 메모리가 모자라면 저장하지 않고 false
+bool snapshot_writer_request(snapshot_writer_t* p_writer, const char* p_path, engine_t* p_engine, const snapshot_session_t* p_session);
+
+// 진행 중인 쓰기가 끝날 때까지 기다림, 마지막 쓰기가 성공했으면 true (쓴 적이 없어도 true)
+bool snapshot_writer_wait(snapshot_writer_t* p_writer);
+
+END_EXTERN_C
+
+#endif // SNAPSHOT_H
\ No newline at end of file
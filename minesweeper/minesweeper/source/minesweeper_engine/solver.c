@@ -0,0 +1,504 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "solver.h"
+#include "safe99_common/assert.h"
+#include "safe99_common/safe_delete.h"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+    #include <intrin.h>
+#endif // _MSC_VER
+
+static const int s_neighbour_dx[8] = { -1, 0, 1, -1, 1, -1, 0, 1 };
+static const int s_neighbour_dy[8] = { -1, -1, -1, 0, 0, 1, 1, 1 };
+
+static uint32_t count_bits(const uint64_t bits);
+
+static FORCEINLINE size_t to_cell_index(const solver_t* p_solver, const size_t tile_index);
+static FORCEINLINE size_t to_tile_index(const solver_t* p_solver, const size_t cell_index);
+static FORCEINLINE bool is_unknown(const uint8_t cell);
+static FORCEINLINE bool is_mine(const uint8_t cell);
+
+static void refresh_all_cells(solver_t* p_solver);
+static void refresh_cell(solver_t* p_solver, const size_t tile_index, const size_t index);
+static void push_queue(solver_t* p_solver, const size_t index);
+static void push_open_neighbours(solver_t* p_solver, const size_t index);
+
+static bool get_constraint(const solver_t* p_solver, const size_t index, const int dx, const int dy, uint64_t* p_out_mask, int* p_out_remaining);
+static size_t mark_window(solver_t* p_solver, const size_t center, uint64_t mask, const uint8_t known);
+static void check_cell(solver_t* p_solver, const size_t index);
+
+bool solver_init(solver_t* p_solver, const engine_t* p_engine)
+{
+    ASSERT(p_solver != NULL, "p_solver == NULL");
+    ASSERT(p_engine != NULL, "p_engine == NULL");
+
+    memset(p_solver, 0, sizeof(solver_t));
+
+    p_solver->p_engine = p_engine;
+    p_solver->rows = p_engine->rows;
+    p_solver->cols = p_engine->cols;
+    p_solver->stride = p_engine->count_stride;
+
+    const ptrdiff_t stride = (ptrdiff_t)p_solver->stride;
+    for (size_t i = 0; i < 8; ++i)
+    {
+        p_solver->neighbour_offsets[i] = s_neighbour_dy[i] * stride + s_neighbour_dx[i];
+    }
+    for (int y = 0; y < SOLVER_WINDOW_SIZE; ++y)
+    {
+        for (int x = 0; x < SOLVER_WINDOW_SIZE; ++x)
+        {
+            p_solver->window_offsets[y * SOLVER_WINDOW_SIZE + x] = (y - SOLVER_WINDOW_RADIUS) * stride + (x - SOLVER_WINDOW_RADIUS);
+        }
+    }
+
+    const size_t num_cells = (p_solver->rows + 2) * p_solver->stride;
+    const size_t num_tiles = p_solver->rows * p_solver->cols;
+
+    p_solver->pa_cells = (uint8_t*)malloc(sizeof(uint8_t) * num_cells);
+    if (p_solver->pa_cells == NULL)
+    {
+        ASSERT(false, "Failed to malloc cells");
+        goto failed_malloc_cells;
+    }
+
+    p_solver->pa_numbers = (uint8_t*)calloc(num_cells, sizeof(uint8_t));
+    if (p_solver->pa_numbers == NULL)
+    {
+        ASSERT(false, "Failed to calloc numbers");
+        goto failed_malloc_numbers;
+    }
+
+    // 숫자 칸마다 큐에 최대 한 번
+    p_solver->pa_queue = (size_t*)malloc(sizeof(size_t) * num_tiles);
+    if (p_solver->pa_queue == NULL)
+    {
+        ASSERT(false, "Failed to malloc queue");
+        goto failed_malloc_queue;
+    }
+
+    // 칸마다 확정은 최대 한 번
+    p_solver->pa_safe_tiles = (size_t*)malloc(sizeof(size_t) * num_tiles);
+    if (p_solver->pa_safe_tiles == NULL)
+    {
+        ASSERT(false, "Failed to malloc safe tiles");
+        goto failed_malloc_safe_tiles;
+    }
+
+    p_solver->pa_mine_tiles = (size_t*)malloc(sizeof(size_t) * num_tiles);
+    if (p_solver->pa_mine_tiles == NULL)
+    {
+        ASSERT(false, "Failed to malloc mine tiles");
+        goto failed_malloc_mine_tiles;
+    }
+
+    solver_reset(p_solver);
+
+    return true;
+
+failed_malloc_mine_tiles:
+    SAFE_FREE(p_solver->pa_safe_tiles);
+
+failed_malloc_safe_tiles:
+    SAFE_FREE(p_solver->pa_queue);
+
+failed_malloc_queue:
+    SAFE_FREE(p_solver->pa_numbers);
+
+failed_malloc_numbers:
+    SAFE_FREE(p_solver->pa_cells);
+
+failed_malloc_cells:
+    memset(p_solver, 0, sizeof(solver_t));
+    return false;
+}
+
+void solver_release(solver_t* p_solver)
+{
+    ASSERT(p_solver != NULL, "p_solver == NULL");
+
+    SAFE_FREE(p_solver->pa_mine_tiles);
+    SAFE_FREE(p_solver->pa_safe_tiles);
+    SAFE_FREE(p_solver->pa_queue);
+    SAFE_FREE(p_solver->pa_numbers);
+    SAFE_FREE(p_solver->pa_cells);
+
+    memset(p_solver, 0, sizeof(solver_t));
+}
+
+void solver_reset(solver_t* p_solver)
+{
+    ASSERT(p_solver != NULL, "p_solver == NULL");
+
+    const size_t rows = p_solver->rows;
+    const size_t cols = p_solver->cols;
+    const size_t stride = p_solver->stride;
+
+    uint8_t* p_cells = p_solver->pa_cells;
+
+    // 테두리
+    memset(p_cells, SOLVER_CELL_BORDER, stride);
+    memset(p_cells + (rows + 1) * stride, SOLVER_CELL_BORDER, stride);
+    for (size_t y = 1; y <= rows; ++y)
+    {
+        p_cells[y * stride] = SOLVER_CELL_BORDER;
+        p_cells[y * stride + cols + 1] = SOLVER_CELL_BORDER;
+        memset(p_cells + y * stride + 1, SOLVER_CELL_CLOSED, cols);
+    }
+
+    p_solver->generation = p_solver->p_engine->generation;
+    p_solver->num_queue = 0;
+    p_solver->num_safe_tiles = 0;
+    p_solver->num_mine_tiles = 0;
+
+    refresh_all_cells(p_solver);
+}
+
+void solver_update(solver_t* p_solver)
+{
+    ASSERT(p_solver != NULL, "p_solver == NULL");
+
+    const engine_t* p_engine = p_solver->p_engine;
+    if (p_engine->generation != p_solver->generation)
+    {
+        solver_reset(p_solver);
+        return;
+    }
+
+    if (engine_is_full_redraw(p_engine))
+    {
+        refresh_all_cells(p_solver);
+        return;
+    }
+
+    size_t num_dirty;
+    const size_t* p_dirty_tiles = engine_get_dirty_tiles(p_engine, &num_dirty);
+    for (size_t i = 0; i < num_dirty; ++i)
+    {
+        refresh_cell(p_solver, p_dirty_tiles[i], to_cell_index(p_solver, p_dirty_tiles[i]));
+    }
+}
+
+size_t solver_deduce(solver_t* p_solver)
+{
+    ASSERT(p_solver != NULL, "p_solver == NULL");
+
+    const uint64_t num_prev_deductions = p_solver->num_deductions;
+
+    while (p_solver->num_queue > 0)
+    {
+        const size_t index = p_solver->pa_queue[--p_solver->num_queue];
+        p_solver->pa_cells[index] &= ~SOLVER_CELL_QUEUED;
+
+        check_cell(p_solver, index);
+    }
+
+    return (size_t)(p_solver->num_deductions - num_prev_deductions);
+}
+
+const size_t* solver_get_safe_tiles(const solver_t* p_solver, size_t* p_out_num_tiles)
+{
+    ASSERT(p_solver != NULL, "p_solver == NULL");
+    ASSERT(p_out_num_tiles != NULL, "p_out_num_tiles == NULL");
+
+    *p_out_num_tiles = p_solver->num_safe_tiles;
+    return p_solver->pa_safe_tiles;
+}
+
+const size_t* solver_get_mine_tiles(const solver_t* p_solver, size_t* p_out_num_tiles)
+{
+    ASSERT(p_solver != NULL, "p_solver == NULL");
+    ASSERT(p_out_num_tiles != NULL, "p_out_num_tiles == NULL");
+
+    *p_out_num_tiles = p_solver->num_mine_tiles;
+    return p_solver->pa_mine_tiles;
+}
+
+void solver_clear_results(solver_t* p_solver)
+{
+    ASSERT(p_solver != NULL, "p_solver == NULL");
+
+    p_solver->num_safe_tiles = 0;
+    p_solver->num_mine_tiles = 0;
+}
+
+static uint32_t count_bits(const uint64_t bits)
+{
+#if defined(__GNUC__)
+    return (uint32_t)__builtin_popcountll(bits);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return (uint32_t)__popcnt64(bits);
+#else
+    uint64_t x = bits - ((bits >> 1) & 0x5555555555555555);
+    x = (x & 0x3333333333333333) + ((x >> 2) & 0x3333333333333333);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0f;
+    return (uint32_t)((x * 0x0101010101010101) >> 56);
+#endif // __GNUC__
+}
+
+static FORCEINLINE size_t to_cell_index(const solver_t* p_solver, const size_t tile_index)
+{
+    return (tile_index / p_solver->cols + 1) * p_solver->stride + tile_index % p_solver->cols + 1;
+}
+
+static FORCEINLINE size_t to_tile_index(const solver_t* p_solver, const size_t cell_index)
+{
+    return (cell_index / p_solver->stride - 1) * p_solver->cols + cell_index % p_solver->stride - 1;
+}
+
+// 닫혀 있고 아직 확정하지 않은 칸
+static FORCEINLINE bool is_unknown(const uint8_t cell)
+{
+    return (cell & (SOLVER_CELL_TYPE_MASK | SOLVER_CELL_KNOWN_SAFE | SOLVER_CELL_KNOWN_MINE)) == SOLVER_CELL_CLOSED;
+}
+
+static FORCEINLINE bool is_mine(const uint8_t cell)
+{
+    return (cell & SOLVER_CELL_TYPE_MASK) == SOLVER_CELL_FLAG || (cell & SOLVER_CELL_KNOWN_MINE);
+}
+
+static void refresh_all_cells(solver_t* p_solver)
+{
+    const size_t cols = p_solver->cols;
+    const size_t stride = p_solver->stride;
+
+    for (size_t y = 0; y < p_solver->rows; ++y)
+    {
+        for (size_t x = 0; x < cols; ++x)
+        {
+            refresh_cell(p_solver, y * cols + x, (y + 1) * stride + x + 1);
+        }
+    }
+}
+
+// 엔진 타일을 다시 읽고 바뀌었으면 영향받는 숫자를 큐에 넣음
+static void refresh_cell(solver_t* p_solver, const size_t tile_index, const size_t index)
+{
+    const tile_t tile = engine_get_tile_at(p_solver->p_engine, tile_index);
+
+    uint8_t type;
+    uint8_t number = 0;
+    switch (tile)
+    {
+    case TILE_OPEN:
+        type = SOLVER_CELL_OPEN;
+        break;
+    case TILE_1:
+    case TILE_2:
+    case TILE_3:
+    case TILE_4:
+    case TILE_5:
+    case TILE_6:
+    case TILE_7:
+    case TILE_8:
+        type = SOLVER_CELL_OPEN;
+        number = (uint8_t)(tile - TILE_1 + 1);
+        break;
+    case TILE_FLAG:
+    case TILE_MINE:
+    case TILE_GAMEOVER_MINE:
+    case TILE_FLAG_MINE:
+        type = SOLVER_CELL_FLAG;
+        break;
+    default:
+        type = SOLVER_CELL_CLOSED;
+        break;
+    }
+
+    uint8_t* p_cell = &p_solver->pa_cells[index];
+    if ((*p_cell & SOLVER_CELL_TYPE_MASK) == type)
+    {
+        return;
+    }
+
+    *p_cell = (uint8_t)((*p_cell & ~SOLVER_CELL_TYPE_MASK) | type);
+    p_solver->pa_numbers[index] = number;
+
+    push_queue(p_solver, index);
+    push_open_neighbours(p_solver, index);
+}
+
+// 닫힌 이웃이 있을 수 있는 숫자 칸만 넣음
+static void push_queue(solver_t* p_solver, const size_t index)
+{
+    uint8_t* p_cell = &p_solver->pa_cells[index];
+    if ((*p_cell & (SOLVER_CELL_TYPE_MASK | SOLVER_CELL_QUEUED)) != SOLVER_CELL_OPEN || p_solver->pa_numbers[index] == 0)
+    {
+        return;
+    }
+
+    *p_cell |= SOLVER_CELL_QUEUED;
+    p_solver->pa_queue[p_solver->num_queue++] = index;
+}
+
+static void push_open_neighbours(solver_t* p_solver, const size_t index)
+{
+    for (size_t i = 0; i < 8; ++i)
+    {
+        push_queue(p_solver, (size_t)((ptrdiff_t)index + p_solver->neighbour_offsets[i]));
+    }
+}
+
+// 숫자 칸 index의 닫힌 이웃을 A 중심 창 좌표로 (A에서 (dx, dy)만큼 떨어진 칸) 비트 마스크에 담음
+// 닫힌 이웃이 없거나 깃발이 숫자보다 많으면 false
+static bool get_constraint(const solver_t* p_solver, const size_t index, const int dx, const int dy, uint64_t* p_out_mask, int* p_out_remaining)
+{
+    const uint8_t* p_cells = p_solver->pa_cells;
+
+    uint64_t mask = 0;
+    int num_mines = 0;
+    for (size_t i = 0; i < 8; ++i)
+    {
+        const uint8_t cell = p_cells[(ptrdiff_t)index + p_solver->neighbour_offsets[i]];
+        if (is_unknown(cell))
+        {
+            const int window_x = dx + s_neighbour_dx[i] + SOLVER_WINDOW_RADIUS;
+            const int window_y = dy + s_neighbour_dy[i] + SOLVER_WINDOW_RADIUS;
+            mask |= (uint64_t)1 << (window_y * SOLVER_WINDOW_SIZE + window_x);
+        }
+        else if (is_mine(cell))
+        {
+            ++num_mines;
+        }
+    }
+
+    const int remaining = (int)p_solver->pa_numbers[index] - num_mines;
+    if (mask == 0 || remaining < 0)
+    {
+        return false;
+    }
+
+    *p_out_mask = mask;
+    *p_out_remaining = remaining;
+    return true;
+}
+
+// 창 좌표 마스크의 칸을 안전/지뢰로 확정하고 결과에 추가, 확정한 칸 수 반환
+static size_t mark_window(solver_t* p_solver, const size_t center, uint64_t mask, const uint8_t known)
+{
+    size_t num_marked = 0;
+
+    while (mask != 0)
+    {
+        const uint64_t lowest = mask & (0 - mask);
+        const uint32_t bit = count_bits(lowest - 1);
+        mask ^= lowest;
+
+        const size_t index = (size_t)((ptrdiff_t)center + p_solver->window_offsets[bit]);
+        uint8_t* p_cell = &p_solver->pa_cells[index];
+        if (!is_unknown(*p_cell))
+        {
+            continue;
+        }
+
+        *p_cell |= known;
+        if (known == SOLVER_CELL_KNOWN_SAFE)
+        {
+            p_solver->pa_safe_tiles[p_solver->num_safe_tiles++] = to_tile_index(p_solver, index);
+        }
+        else
+        {
+            p_solver->pa_mine_tiles[p_solver->num_mine_tiles++] = to_tile_index(p_solver, index);
+        }
+
+        ++p_solver->num_deductions;
+        ++num_marked;
+
+        // 이 칸을 이웃으로 가진 숫자는 닫힌 칸이 줄었으므로 다시 검사
+        push_open_neighbours(p_solver, index);
+    }
+
+    return num_marked;
+}
+
+static void check_cell(solver_t* p_solver, const size_t index)
+{
+    uint64_t mask_a;
+    int remaining_a;
+    if (!get_constraint(p_solver, index, 0, 0, &mask_a, &remaining_a))
+    {
+        return;
+    }
+
+    // 한 칸 규칙
+    if (remaining_a == 0)
+    {
+        mark_window(p_solver, index, mask_a, SOLVER_CELL_KNOWN_SAFE);
+        return;
+    }
+
+    if (remaining_a == (int)count_bits(mask_a))
+    {
+        mark_window(p_solver, index, mask_a, SOLVER_CELL_KNOWN_MINE);
+        return;
+    }
+
+    // 두 칸 규칙: 닫힌 칸을 공유하는 숫자 B는 A의 닫힌 이웃의 이웃 (A에서 2칸 이내)
+    const uint8_t* p_cells = p_solver->pa_cells;
+    uint32_t visited = 0;
+
+    for (size_t i = 0; i < 8; ++i)
+    {
+        const size_t unknown = (size_t)((ptrdiff_t)index + p_solver->neighbour_offsets[i]);
+        if (!is_unknown(p_cells[unknown]))
+        {
+            continue;
+        }
+
+        for (size_t j = 0; j < 8; ++j)
+        {
+            const int dx = s_neighbour_dx[i] + s_neighbour_dx[j];
+            const int dy = s_neighbour_dy[i] + s_neighbour_dy[j];
+            if (dx == 0 && dy == 0)
+            {
+                continue;
+            }
+
+            // 5 x 5 안에서 한 번만
+            const uint32_t visited_bit = (uint32_t)1 << ((dy + 2) * 5 + (dx + 2));
+            if (visited & visited_bit)
+            {
+                continue;
+            }
+            visited |= visited_bit;
+
+            const size_t other = (size_t)((ptrdiff_t)unknown + p_solver->neighbour_offsets[j]);
+            if ((p_cells[other] & SOLVER_CELL_TYPE_MASK) != SOLVER_CELL_OPEN || p_solver->pa_numbers[other] == 0)
+            {
+                continue;
+            }
+
+            uint64_t mask_b;
+            int remaining_b;
+            if (!get_constraint(p_solver, other, dx, dy, &mask_b, &remaining_b))
+            {
+                continue;
+            }
+
+            const uint64_t only_a = mask_a & ~mask_b;
+            const uint64_t only_b = mask_b & ~mask_a;
+
+            // A에만 있는 칸이 모두 지뢰여야 A를 채울 수 있음
+            if (remaining_a - remaining_b == (int)count_bits(only_a))
+            {
+                const size_t num_marked = mark_window(p_solver, index, only_a, SOLVER_CELL_KNOWN_MINE)
+                    + mark_window(p_solver, index, only_b, SOLVER_CELL_KNOWN_SAFE);
+                if (num_marked > 0)
+                {
+                    return;
+                }
+            }
+
+            if (remaining_b - remaining_a == (int)count_bits(only_b))
+            {
+                const size_t num_marked = mark_window(p_solver, index, only_b, SOLVER_CELL_KNOWN_MINE)
+                    + mark_window(p_solver, index, only_a, SOLVER_CELL_KNOWN_SAFE);
+                if (num_marked > 0)
+                {
+                    return;
+                }
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "engine.h"
+#include "safe99_common/defines.h"
+
+// 보이는 정보(열린 숫자, 깃발)만으로 확실한 칸을 찾는 추론기
+// - 한 칸 규칙: 남은 지뢰가 0이면 나머지는 안전, 닫힌 칸 수와 같으면 모두 지뢰
+// - 두 칸 규칙: 닫힌 칸을 공유하는 두 숫자 A, B에서
+//   (A의 남은 지뢰 - B의 남은 지뢰) == (A에만 있는 닫힌 칸 수)이면 A에만 있는 칸은 지뢰, B에만 있는 칸은 안전
+//   (부분집합 추론은 A에만 있는 칸이 없는 경우)
+//
+// 엔진의 pa_counts와 같은 테두리 포함 격자(count_stride)를 쓰므로 이웃은 고정 오프셋 8개로 범위 검사 없이 읽음
+// 엔진의 변경 타일 목록으로 바뀐 칸만 다시 읽고 영향받는 숫자만 다시 검사함
+// 깃발은 지뢰로 믿음
+
+// pa_cells 값
+#define SOLVER_CELL_CLOSED 0x00
+#define SOLVER_CELL_OPEN 0x01
+#define SOLVER_CELL_FLAG 0x02
+#define SOLVER_CELL_BORDER 0x03
+#define SOLVER_CELL_TYPE_MASK 0x03
+#define SOLVER_CELL_KNOWN_SAFE 0x04
+#define SOLVER_CELL_KNOWN_MINE 0x08
+#define SOLVER_CELL_QUEUED 0x10
+
+// 두 칸 규칙에서 A를 가운데 둔 7 x 7 창의 칸을 비트 하나씩으로 표현
+#define SOLVER_WINDOW_SIZE 7
+#define SOLVER_WINDOW_RADIUS 3
+
+typedef struct solver
+{
+    const engine_t* p_engine;
+
+    // 마지막으로 읽은 판의 세대, 같은 판이면 전체를 다시 읽어도 추론한 내용은 유지
+    uint32_t generation;
+
+    size_t rows;
+    size_t cols;
+    size_t stride;
+
+    // 이웃 8칸, 7 x 7 창의 각 칸까지의 인덱스 차이
+    ptrdiff_t neighbour_offsets[8];
+    ptrdiff_t window_offsets[SOLVER_WINDOW_SIZE * SOLVER_WINDOW_SIZE];
+
+    // 테두리 포함 (rows + 2) * stride 격자
+    uint8_t* pa_cells;
+
+    // 열린 숫자, 숫자 칸에만 유효
+    uint8_t* pa_numbers;
+
+    // 다시 검사할 숫자 칸 (테두리 포함 인덱스), SOLVER_CELL_QUEUED로 중복 방지
+    size_t* pa_queue;
+    size_t num_queue;
+
+    // 아직 가져가지 않은 추론 결과 (타일 인덱스 y * cols + x)
+    size_t* pa_safe_tiles;
+    size_t num_safe_tiles;
+    size_t* pa_mine_tiles;
+    size_t num_mine_tiles;
+
+    // 확정한 칸의 누적 개수
+    uint64_t num_deductions;
+} solver_t;
+
+START_EXTERN_C
+
+// p_engine은 solver보다 오래 살아야 하고 크기가 바뀌면 안 됨
+//
+// 이미 초기화한 추론기를 다시 초기화하지 말 것
+// 해야 한다면 solver_release() 호출 이후 재호출
+bool solver_init(solver_t* p_solver, const engine_t* p_engine);
+void solver_release(solver_t* p_solver);
+
+// 판 전체를 다시 읽고 추론한 내용을 모두 버림 (재시작 이후 호출)
+void solver_reset(solver_t* p_solver);
+
+// 마지막 호출 이후 바뀐 타일만 다시 읽음, engine_clear_dirty() 전에 호출
+// 목록이 넘쳐 전체 다시 그리기 상태면 판 전체를 다시 읽음 (재시작했으면 solver_reset()과 같음)
+// 여러 칸을 연달아 열 때는 열 때마다 호출하고 목록을 비워야 넘치지 않음
+void solver_update(solver_t* p_solver);
+
+// 검사할 숫자가 없어질 때까지 추론, 새로 확정한 칸 수 반환
+size_t solver_deduce(solver_t* p_solver);
+
+// 추론 결과 (타일 인덱스 y * cols + x), solver_clear_results()까지 유효
+const size_t* solver_get_safe_tiles(const solver_t* p_solver, size_t* p_out_num_tiles);
+const size_t* solver_get_mine_tiles(const solver_t* p_solver, size_t* p_out_num_tiles);
+void solver_clear_results(solver_t* p_solver);
+
+END_EXTERN_C
+
+#endif // SOLVER_H
\ No newline at end of file
@@ -0,0 +1,207 @@
+#include "thread.h"
+#include "safe99_common/assert.h"
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <Windows.h>
+#else
+    #include <sched.h>
+    #include <unistd.h>
+#endif // _WIN32
+
+#if defined(_WIN32)
+
+static DWORD WINAPI thread_entry(LPVOID p_arg)
+{
+    thread_t* p_thread = (thread_t*)p_arg;
+    p_thread->pf_func(p_thread->p_arg);
+    return 0;
+}
+
+bool thread_create(thread_t* p_thread, thread_func pf_func, void* p_arg)
+{
+    ASSERT(p_thread != NULL, "p_thread == NULL");
+    ASSERT(pf_func != NULL, "pf_func == NULL");
+
+    p_thread->pf_func = pf_func;
+    p_thread->p_arg = p_arg;
+
+    p_thread->handle = CreateThread(NULL, 0, thread_entry, p_thread, 0, NULL);
+    return p_thread->handle != NULL;
+}
+
+void thread_join(thread_t* p_thread)
+{
+    ASSERT(p_thread != NULL, "p_thread == NULL");
+
+    WaitForSingleObject((HANDLE)p_thread->handle, INFINITE);
+    CloseHandle((HANDLE)p_thread->handle);
+    p_thread->handle = NULL;
+}
+
+void thread_yield(void)
+{
+    SwitchToThread();
+}
+
+size_t thread_get_num_cpus(void)
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (info.dwNumberOfProcessors > 0) ? (size_t)info.dwNumberOfProcessors : 1;
+}
+
+bool mutex_init(mutex_t* p_mutex)
+{
+    ASSERT(p_mutex != NULL, "p_mutex == NULL");
+
+    InitializeSRWLock((PSRWLOCK)&p_mutex->p_lock);
+    return true;
+}
+
+void mutex_release(mutex_t* p_mutex)
+{
+    ASSERT(p_mutex != NULL, "p_mutex == NULL");
+    p_mutex->p_lock = NULL;
+}
+
+void mutex_lock(mutex_t* p_mutex)
+{
+    ASSERT(p_mutex != NULL, "p_mutex == NULL");
+    AcquireSRWLockExclusive((PSRWLOCK)&p_mutex->p_lock);
+}
+
+void mutex_unlock(mutex_t* p_mutex)
+{
+    ASSERT(p_mutex != NULL, "p_mutex == NULL");
+    ReleaseSRWLockExclusive((PSRWLOCK)&p_mutex->p_lock);
+}
+
+bool cond_init(cond_t* p_cond)
+{
+    ASSERT(p_cond != NULL, "p_cond == NULL");
+
+    InitializeConditionVariable((PCONDITION_VARIABLE)&p_cond->p_cond);
+    return true;
+}
+
+void cond_release(cond_t* p_cond)
+{
+    ASSERT(p_cond != NULL, "p_cond == NULL");
+    p_cond->p_cond = NULL;
+}
+
+void cond_wait(cond_t* p_cond, mutex_t* p_mutex)
+{
+    ASSERT(p_cond != NULL, "p_cond == NULL");
+    ASSERT(p_mutex != NULL, "p_mutex == NULL");
+
+    SleepConditionVariableSRW((PCONDITION_VARIABLE)&p_cond->p_cond, (PSRWLOCK)&p_mutex->p_lock, INFINITE, 0);
+}
+
+void cond_signal(cond_t* p_cond)
+{
+    ASSERT(p_cond != NULL, "p_cond == NULL");
+    WakeConditionVariable((PCONDITION_VARIABLE)&p_cond->p_cond);
+}
+
+void cond_broadcast(cond_t* p_cond)
+{
+    ASSERT(p_cond != NULL, "p_cond == NULL");
+    WakeAllConditionVariable((PCONDITION_VARIABLE)&p_cond->p_cond);
+}
+
+#else
+
+static void* thread_entry(void* p_arg)
+{
+    thread_t* p_thread = (thread_t*)p_arg;
+    p_thread->pf_func(p_thread->p_arg);
+    return NULL;
+}
+
+bool thread_create(thread_t* p_thread, thread_func pf_func, void* p_arg)
+{
+    ASSERT(p_thread != NULL, "p_thread == NULL");
+    ASSERT(pf_func != NULL, "pf_func == NULL");
+
+    p_thread->pf_func = pf_func;
+    p_thread->p_arg = p_arg;
+
+    return pthread_create(&p_thread->handle, NULL, thread_entry, p_thread) == 0;
+}
+
+void thread_join(thread_t* p_thread)
+{
+    ASSERT(p_thread != NULL, "p_thread == NULL");
+    pthread_join(p_thread->handle, NULL);
+}
+
+void thread_yield(void)
+{
+    sched_yield();
+}
+
+size_t thread_get_num_cpus(void)
+{
+    const long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return (num_cpus > 0) ? (size_t)num_cpus : 1;
+}
+
+bool mutex_init(mutex_t* p_mutex)
+{
+    ASSERT(p_mutex != NULL, "p_mutex == NULL");
+    return pthread_mutex_init(&p_mutex->lock, NULL) == 0;
+}
+
+void mutex_release(mutex_t* p_mutex)
+{
+    ASSERT(p_mutex != NULL, "p_mutex == NULL");
+    pthread_mutex_destroy(&p_mutex->lock);
+}
+
+void mutex_lock(mutex_t* p_mutex)
+{
+    ASSERT(p_mutex != NULL, "p_mutex == NULL");
+    pthread_mutex_lock(&p_mutex->lock);
+}
+
+void mutex_unlock(mutex_t* p_mutex)
+{
+    ASSERT(p_mutex != NULL, "p_mutex == NULL");
+    pthread_mutex_unlock(&p_mutex->lock);
+}
+
+bool cond_init(cond_t* p_cond)
+{
+    ASSERT(p_cond != NULL, "p_cond == NULL");
+    return pthread_cond_init(&p_cond->cond, NULL) == 0;
+}
+
+void cond_release(cond_t* p_cond)
+{
+    ASSERT(p_cond != NULL, "p_cond == NULL");
+    pthread_cond_destroy(&p_cond->cond);
+}
+
+void cond_wait(cond_t* p_cond, mutex_t* p_mutex)
+{
+    ASSERT(p_cond != NULL, "p_cond == NULL");
+    ASSERT(p_mutex != NULL, "p_mutex == NULL");
+
+    pthread_cond_wait(&p_cond->cond, &p_mutex->lock);
+}
+
+void cond_signal(cond_t* p_cond)
+{
+    ASSERT(p_cond != NULL, "p_cond == NULL");
+    pthread_cond_signal(&p_cond->cond);
+}
+
+void cond_broadcast(cond_t* p_cond)
+{
+    ASSERT(p_cond != NULL, "p_cond == NULL");
+    pthread_cond_broadcast(&p_cond->cond);
+}
+
+#endif // _WIN32
\ No newline at end of file
@@ -0,0 +1,226 @@
+#ifndef THREAD_H
+#define THREAD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "safe99_common/defines.h"
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif // _MSC_VER
+
+#if !defined(_WIN32)
+    #include <pthread.h>
+#endif // _WIN32
+
+// 윈도우 스레드/SRW 락/조건 변수와 pthread를 감싼 얇은 계층
+// 원자 연산은 MSVC Interlocked 내장 함수와 GCC/Clang __atomic 내장 함수를 씀
+// 읽기는 acquire, 쓰기는 release, 읽고 쓰기는 순차 일관성
+
+typedef void (*thread_func)(void* p_arg);
+
+typedef struct thread
+{
+#if defined(_WIN32)
+    void* handle;
+#else
+    pthread_t handle;
+#endif // _WIN32
+
+    thread_func pf_func;
+    void* p_arg;
+} thread_t;
+
+typedef struct mutex
+{
+#if defined(_WIN32)
+    void* p_lock; // SRWLOCK
+#else
+    pthread_mutex_t lock;
+#endif // _WIN32
+} mutex_t;
+
+typedef struct cond
+{
+#if defined(_WIN32)
+    void* p_cond; // CONDITION_VARIABLE
+#else
+    pthread_cond_t cond;
+#endif // _WIN32
+} cond_t;
+
+START_EXTERN_C
+
+// p_thread는 thread_join()까지 살아 있어야 함
+bool thread_create(thread_t* p_thread, thread_func pf_func, void* p_arg);
+void thread_join(thread_t* p_thread);
+void thread_yield(void);
+
+// 논리 프로세서 수, 알 수 없으면 1
+size_t thread_get_num_cpus(void);
+
+bool mutex_init(mutex_t* p_mutex);
+void mutex_release(mutex_t* p_mutex);
+void mutex_lock(mutex_t* p_mutex);
+void mutex_unlock(mutex_t* p_mutex);
+
+bool cond_init(cond_t* p_cond);
+void cond_release(cond_t* p_cond);
+
+// p_mutex를 잡은 채로 호출, 깨어난 이유는 호출한 쪽에서 다시 확인
+void cond_wait(cond_t* p_cond, mutex_t* p_mutex);
+void cond_signal(cond_t* p_cond);
+void cond_broadcast(cond_t* p_cond);
+
+#if defined(_MSC_VER)
+
+FORCEINLINE uint32_t atomic_load_u32(const volatile uint32_t* p_value)
+{
+#if defined(_M_IX86) || defined(_M_X64)
+    const uint32_t value = *p_value;
+    _ReadWriteBarrier();
+    return value;
+#else
+    return (uint32_t)_InterlockedOr((volatile long*)p_value, 0);
+#endif // _M_IX86 || _M_X64
+}
+
+FORCEINLINE void atomic_store_u32(volatile uint32_t* p_value, const uint32_t value)
+{
+#if defined(_M_IX86) || defined(_M_X64)
+    _ReadWriteBarrier();
+    *p_value = value;
+#else
+    _InterlockedExchange((volatile long*)p_value, (long)value);
+#endif // _M_IX86 || _M_X64
+}
+
+// 더하기 전 값 반환
+FORCEINLINE uint32_t atomic_fetch_add_u32(volatile uint32_t* p_value, const uint32_t value)
+{
+    return (uint32_t)_InterlockedExchangeAdd((volatile long*)p_value, (long)value);
+}
+
+FORCEINLINE uint32_t atomic_exchange_u32(volatile uint32_t* p_value, const uint32_t value)
+{
+    return (uint32_t)_InterlockedExchange((volatile long*)p_value, (long)value);
+}
+
+FORCEINLINE bool atomic_compare_exchange_u32(volatile uint32_t* p_value, const uint32_t expected, const uint32_t desired)
+{
+    return (uint32_t)_InterlockedCompareExchange((volatile long*)p_value, (long)desired, (long)expected) == expected;
+}
+
+FORCEINLINE uint64_t atomic_load_u64(const volatile uint64_t* p_value)
+{
+#if defined(_M_X64)
+    const uint64_t value = *p_value;
+    _ReadWriteBarrier();
+    return value;
+#else
+    // 32비트에서는 64비트 읽기가 원자적이지 않음
+    return (uint64_t)_InterlockedCompareExchange64((volatile __int64*)p_value, 0, 0);
+#endif // _M_X64
+}
+
+FORCEINLINE void atomic_store_u64(volatile uint64_t* p_value, const uint64_t value)
+{
+#if defined(_M_X64)
+    _ReadWriteBarrier();
+    *p_value = value;
+#else
+    uint64_t old = atomic_load_u64(p_value);
+    while ((uint64_t)_InterlockedCompareExchange64((volatile __int64*)p_value, (__int64)value, (__int64)old) != old)
+    {
+        old = atomic_load_u64(p_value);
+    }
+#endif // _M_X64
+}
+
+FORCEINLINE uint64_t atomic_fetch_add_u64(volatile uint64_t* p_value, const uint64_t value)
+{
+#if defined(_M_X64) || defined(_M_ARM64)
+    return (uint64_t)_InterlockedExchangeAdd64((volatile __int64*)p_value, (__int64)value);
+#else
+    uint64_t old = atomic_load_u64(p_value);
+    while ((uint64_t)_InterlockedCompareExchange64((volatile __int64*)p_value, (__int64)(old + value), (__int64)old) != old)
+    {
+        old = atomic_load_u64(p_value);
+    }
+    return old;
+#endif // _M_X64 || _M_ARM64
+}
+
+FORCEINLINE bool atomic_compare_exchange_u64(volatile uint64_t* p_value, const uint64_t expected, const uint64_t desired)
+{
+    return (uint64_t)_InterlockedCompareExchange64((volatile __int64*)p_value, (__int64)desired, (__int64)expected) == expected;
+}
+
+FORCEINLINE void atomic_fence(void)
+{
+    volatile long barrier = 0;
+    _InterlockedOr(&barrier, 0);
+}
+
+#else
+
+FORCEINLINE uint32_t atomic_load_u32(const volatile uint32_t* p_value)
+{
+    return __atomic_load_n(p_value, __ATOMIC_ACQUIRE);
+}
+
+FORCEINLINE void atomic_store_u32(volatile uint32_t* p_value, const uint32_t value)
+{
+    __atomic_store_n(p_value, value, __ATOMIC_RELEASE);
+}
+
+// 더하기 전 값 반환
+FORCEINLINE uint32_t atomic_fetch_add_u32(volatile uint32_t* p_value, const uint32_t value)
+{
+    return __atomic_fetch_add(p_value, value, __ATOMIC_SEQ_CST);
+}
+
+FORCEINLINE uint32_t atomic_exchange_u32(volatile uint32_t* p_value, const uint32_t value)
+{
+    return __atomic_exchange_n(p_value, value, __ATOMIC_SEQ_CST);
+}
+
+FORCEINLINE bool atomic_compare_exchange_u32(volatile uint32_t* p_value, const uint32_t expected, const uint32_t desired)
+{
+    uint32_t old = expected;
+    return __atomic_compare_exchange_n(p_value, &old, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+FORCEINLINE uint64_t atomic_load_u64(const volatile uint64_t* p_value)
+{
+    return __atomic_load_n(p_value, __ATOMIC_ACQUIRE);
+}
+
+FORCEINLINE void atomic_store_u64(volatile uint64_t* p_value, const uint64_t value)
+{
+    __atomic_store_n(p_value, value, __ATOMIC_RELEASE);
+}
+
+FORCEINLINE uint64_t atomic_fetch_add_u64(volatile uint64_t* p_value, const uint64_t value)
+{
+    return __atomic_fetch_add(p_value, value, __ATOMIC_SEQ_CST);
+}
+
+FORCEINLINE bool atomic_compare_exchange_u64(volatile uint64_t* p_value, const uint64_t expected, const uint64_t desired)
+{
+    uint64_t old = expected;
+    return __atomic_compare_exchange_n(p_value, &old, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+FORCEINLINE void atomic_fence(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+#endif // _MSC_VER
+
+END_EXTERN_C
+
+#endif // THREAD_H
\ No newline at end of file
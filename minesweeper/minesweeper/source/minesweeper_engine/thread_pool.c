@@ -0,0 +1,314 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "profiler.h"
+#include "thread_pool.h"
+#include "safe99_common/assert.h"
+#include "safe99_common/safe_delete.h"
+
+static void worker_main(void* p_arg);
+static void run_jobs(thread_pool_t* p_pool, thread_pool_job_func pf_job, void* p_context, const size_t worker_index);
+static bool pop_job(thread_pool_range_t* p_range, size_t* p_out_job_index);
+static bool steal_jobs(thread_pool_t* p_pool, const size_t worker_index, size_t* p_out_job_index);
+static FORCEINLINE uint64_t make_range(const uint64_t begin, const uint64_t end);
+
+bool thread_pool_init(thread_pool_t* p_pool, const size_t num_threads)
+{
+    ASSERT(p_pool != NULL, "p_pool == NULL");
+
+    memset(p_pool, 0, sizeof(thread_pool_t));
+
+    size_t num_workers = (num_threads == 0) ? thread_get_num_cpus() : num_threads;
+    if (num_workers > THREAD_POOL_MAX_THREADS)
+    {
+        num_workers = THREAD_POOL_MAX_THREADS;
+    }
+    p_pool->num_threads = num_workers;
+
+    if (!mutex_init(&p_pool->lock))
+    {
+        ASSERT(false, "Failed to init lock");
+        goto failed_init_lock;
+    }
+
+    if (!cond_init(&p_pool->work_cond))
+    {
+        ASSERT(false, "Failed to init work cond");
+        goto failed_init_work_cond;
+    }
+
+    if (!cond_init(&p_pool->done_cond))
+    {
+        ASSERT(false, "Failed to init done cond");
+        goto failed_init_done_cond;
+    }
+
+    p_pool->pa_ranges = (thread_pool_range_t*)malloc(sizeof(thread_pool_range_t) * num_workers);
+    if (p_pool->pa_ranges == NULL)
+    {
+        ASSERT(false, "Failed to malloc ranges");
+        goto failed_malloc_ranges;
+    }
+    memset(p_pool->pa_ranges, 0, sizeof(thread_pool_range_t) * num_workers);
+
+    if (num_workers > 1)
+    {
+        p_pool->pa_workers = (thread_pool_worker_t*)malloc(sizeof(thread_pool_worker_t) * (num_workers - 1));
+        if (p_pool->pa_workers == NULL)
+        {
+            ASSERT(false, "Failed to malloc workers");
+            goto failed_malloc_workers;
+        }
+    }
+
+    // 만들지 못한 스레드가 있으면 만든 만큼만 쓰지 않고 모두 정리
+    size_t num_created = 0;
+    for (; num_created + 1 < num_workers; ++num_created)
+    {
+        thread_pool_worker_t* p_worker = &p_pool->pa_workers[num_created];
+        p_worker->p_pool = p_pool;
+        p_worker->index = num_created + 1;
+
+        if (!thread_create(&p_worker->thread, worker_main, p_worker))
+        {
+            ASSERT(false, "Failed to create thread");
+            goto failed_create_threads;
+        }
+    }
+
+    return true;
+
+failed_create_threads:
+    mutex_lock(&p_pool->lock);
+    p_pool->b_quit = true;
+    cond_broadcast(&p_pool->work_cond);
+    mutex_unlock(&p_pool->lock);
+
+    for (size_t i = 0; i < num_created; ++i)
+    {
+        thread_join(&p_pool->pa_workers[i].thread);
+    }
+    SAFE_FREE(p_pool->pa_workers);
+
+failed_malloc_workers:
+    SAFE_FREE(p_pool->pa_ranges);
+
+failed_malloc_ranges:
+    cond_release(&p_pool->done_cond);
+
+failed_init_done_cond:
+    cond_release(&p_pool->work_cond);
+
+failed_init_work_cond:
+    mutex_release(&p_pool->lock);
+
+failed_init_lock:
+    memset(p_pool, 0, sizeof(thread_pool_t));
+    return false;
+}
+
+void thread_pool_release(thread_pool_t* p_pool)
+{
+    ASSERT(p_pool != NULL, "p_pool == NULL");
+
+    mutex_lock(&p_pool->lock);
+    p_pool->b_quit = true;
+    cond_broadcast(&p_pool->work_cond);
+    mutex_unlock(&p_pool->lock);
+
+    for (size_t i = 0; i + 1 < p_pool->num_threads; ++i)
+    {
+        thread_join(&p_pool->pa_workers[i].thread);
+    }
+    SAFE_FREE(p_pool->pa_workers);
+    SAFE_FREE(p_pool->pa_ranges);
+
+    cond_release(&p_pool->done_cond);
+    cond_release(&p_pool->work_cond);
+    mutex_release(&p_pool->lock);
+
+    memset(p_pool, 0, sizeof(thread_pool_t));
+}
+
+size_t thread_pool_get_num_threads(const thread_pool_t* p_pool)
+{
+    ASSERT(p_pool != NULL, "p_pool == NULL");
+    return p_pool->num_threads;
+}
+
+void thread_pool_run(thread_pool_t* p_pool, thread_pool_job_func pf_job, void* p_context, const size_t num_jobs)
+{
+    ASSERT(p_pool != NULL, "p_pool == NULL");
+    ASSERT(pf_job != NULL, "pf_job == NULL");
+    ASSERT(num_jobs <= UINT32_MAX, "Too many jobs");
+
+    if (num_jobs == 0)
+    {
+        return;
+    }
+
+    // 깨우는 비용이 더 큼
+    if (p_pool->num_threads == 1 || num_jobs == 1)
+    {
+        for (size_t i = 0; i < num_jobs; ++i)
+        {
+            pf_job(p_context, i, 0);
+        }
+        return;
+    }
+
+    mutex_lock(&p_pool->lock);
+    {
+        p_pool->pf_job = pf_job;
+        p_pool->p_context = p_context;
+        p_pool->num_jobs = num_jobs;
+        ++p_pool->batch;
+
+        // 처음에는 고르게 나눠 주고 먼저 끝난 작업자가 남은 구간을 훔쳐 감
+        const size_t num_threads = p_pool->num_threads;
+        for (size_t i = 0; i < num_threads; ++i)
+        {
+            const uint64_t begin = (uint64_t)num_jobs * i / num_threads;
+            const uint64_t end = (uint64_t)num_jobs * (i + 1) / num_threads;
+            atomic_store_u64(&p_pool->pa_ranges[i].range, make_range(begin, end));
+        }
+
+        cond_broadcast(&p_pool->work_cond);
+    }
+    mutex_unlock(&p_pool->lock);
+
+    run_jobs(p_pool, pf_job, p_context, 0);
+
+    // 여기까지 오면 모든 구간이 비었으므로 참여 중인 작업자만 기다리면 됨
+    // 훔쳐서 아직 자기 구간에 넣지 않은 일감도 그 작업자가 끝내야 빠짐
+    mutex_lock(&p_pool->lock);
+    {
+        while (p_pool->num_active_workers > 0)
+        {
+            cond_wait(&p_pool->done_cond, &p_pool->lock);
+        }
+
+        p_pool->pf_job = NULL;
+        p_pool->p_context = NULL;
+        p_pool->num_jobs = 0;
+    }
+    mutex_unlock(&p_pool->lock);
+}
+
+static void worker_main(void* p_arg)
+{
+    thread_pool_worker_t* p_worker = (thread_pool_worker_t*)p_arg;
+    thread_pool_t* p_pool = p_worker->p_pool;
+
+    PROFILE_THREAD_NAME("worker");
+
+    uint32_t batch = 0;
+
+    mutex_lock(&p_pool->lock);
+    while (true)
+    {
+        while (!p_pool->b_quit && (p_pool->batch == batch || p_pool->num_jobs == 0))
+        {
+            cond_wait(&p_pool->work_cond, &p_pool->lock);
+        }
+
+        if (p_pool->b_quit)
+        {
+            break;
+        }
+
+        batch = p_pool->batch;
+
+        thread_pool_job_func pf_job = p_pool->pf_job;
+        void* p_context = p_pool->p_context;
+        ++p_pool->num_active_workers;
+
+        mutex_unlock(&p_pool->lock);
+
+        run_jobs(p_pool, pf_job, p_context, p_worker->index);
+
+        mutex_lock(&p_pool->lock);
+
+        if (--p_pool->num_active_workers == 0)
+        {
+            cond_signal(&p_pool->done_cond);
+        }
+    }
+    mutex_unlock(&p_pool->lock);
+}
+
+static void run_jobs(thread_pool_t* p_pool, thread_pool_job_func pf_job, void* p_context, const size_t worker_index)
+{
+    thread_pool_range_t* p_range = &p_pool->pa_ranges[worker_index];
+
+    while (true)
+    {
+        size_t job_index;
+        if (!pop_job(p_range, &job_index) && !steal_jobs(p_pool, worker_index, &job_index))
+        {
+            break;
+        }
+
+        pf_job(p_context, job_index, worker_index);
+    }
+}
+
+// 자기 구간 앞에서 하나 꺼냄
+static bool pop_job(thread_pool_range_t* p_range, size_t* p_out_job_index)
+{
+    while (true)
+    {
+        const uint64_t range = atomic_load_u64(&p_range->range);
+        const uint64_t begin = range & UINT32_MAX;
+        const uint64_t end = range >> 32;
+        if (begin >= end)
+        {
+            return false;
+        }
+
+        if (atomic_compare_exchange_u64(&p_range->range, range, make_range(begin + 1, end)))
+        {
+            *p_out_job_index = (size_t)begin;
+            return true;
+        }
+    }
+}
+
+// 다음 작업자부터 차례로 살펴 남은 구간의 뒤쪽 절반을 가져옴
+// 가져온 첫 일감은 바로 실행하고 나머지는 비어 있던 자기 구간에 넣음
+// 일감 번호는 배치 안에서 한 번만 나눠 주므로 같은 구간 값이 다시 나타나지 않아 CAS가 ABA에 걸리지 않음
+static bool steal_jobs(thread_pool_t* p_pool, const size_t worker_index, size_t* p_out_job_index)
+{
+    const size_t num_threads = p_pool->num_threads;
+
+    for (size_t i = 1; i < num_threads; ++i)
+    {
+        thread_pool_range_t* p_victim = &p_pool->pa_ranges[(worker_index + i) % num_threads];
+
+        while (true)
+        {
+            const uint64_t range = atomic_load_u64(&p_victim->range);
+            const uint64_t begin = range & UINT32_MAX;
+            const uint64_t end = range >> 32;
+            if (begin >= end)
+            {
+                break;
+            }
+
+            const uint64_t split = end - (end - begin + 1) / 2;
+            if (atomic_compare_exchange_u64(&p_victim->range, range, make_range(begin, split)))
+            {
+                atomic_store_u64(&p_pool->pa_ranges[worker_index].range, make_range(split + 1, end));
+                *p_out_job_index = (size_t)split;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+static FORCEINLINE uint64_t make_range(const uint64_t begin, const uint64_t end)
+{
+    return begin | (end << 32);
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "thread.h"
+#include "safe99_common/defines.h"
+
+// 고정 개수 작업자 스레드로 [0, num_jobs) 일감을 나눠 실행하는 병렬 for
+// 호출 스레드도 0번 작업자로 참여하고 모든 일감이 끝나야 돌아옴
+// 작업자마다 연속된 일감 구간을 나눠 주고 자기 구간은 앞에서부터 하나씩 꺼냄
+// 자기 구간이 비면 다른 작업자 구간의 뒤쪽 절반을 훔쳐 오므로 일감 크기가 달라도 놀고 있는 작업자가 없음
+
+#define THREAD_POOL_MAX_THREADS 64
+#define THREAD_POOL_CACHE_LINE_SIZE 64
+
+// worker_index는 [0, num_threads), 작업자별 임시 버퍼를 나눌 때 사용
+typedef void (*thread_pool_job_func)(void* p_context, const size_t job_index, const size_t worker_index);
+
+// 하위 32비트는 다음 일감 번호, 상위 32비트는 구간 끝 (미포함)
+// 주인과 훔치는 쪽 모두 CAS로 바꾸고, 작업자끼리 같은 캐시 라인을 쓰지 않도록 채움
+typedef struct thread_pool_range
+{
+    volatile uint64_t range;
+    uint8_t padding[THREAD_POOL_CACHE_LINE_SIZE - sizeof(uint64_t)];
+} thread_pool_range_t;
+
+typedef struct thread_pool_worker
+{
+    struct thread_pool* p_pool;
+    size_t index;
+    thread_t thread;
+} thread_pool_worker_t;
+
+typedef struct thread_pool
+{
+    // 호출 스레드를 뺀 num_threads - 1개
+    thread_pool_worker_t* pa_workers;
+    size_t num_threads;
+
+    mutex_t lock;
+    cond_t work_cond;
+    cond_t done_cond;
+
+    // 실행 중인 일감, lock으로 보호
+    // 끝나면 num_jobs를 0으로 두어 늦게 깨어난 작업자가 다음 일감 번호를 가져가지 않게 함
+    thread_pool_job_func pf_job;
+    void* p_context;
+    size_t num_jobs;
+    uint32_t batch;
+    size_t num_active_workers;
+    bool b_quit;
+
+    // 작업자별 남은 일감 구간, num_threads개 (0번은 호출 스레드)
+    thread_pool_range_t* pa_ranges;
+} thread_pool_t;
+
+START_EXTERN_C
+
+// num_threads는 호출 스레드를 포함한 작업자 수, 0이면 논리 프로세서 수
+// THREAD_POOL_MAX_THREADS를 넘으면 잘라냄
+//
+// 이미 초기화한 풀을 다시 초기화하지 말 것
+// 해야 한다면 thread_pool_release() 호출 이후 재호출
+bool thread_pool_init(thread_pool_t* p_pool, const size_t num_threads);
+void thread_pool_release(thread_pool_t* p_pool);
+
+size_t thread_pool_get_num_threads(const thread_pool_t* p_pool);
+
+// pf_job(p_context, 0..num_jobs-1, worker_index)를 모두 실행한 뒤 돌아옴
+// 한 번에 한 스레드에서만 호출, 일감 안에서 다시 호출하지 말 것
+void thread_pool_run(thread_pool_t* p_pool, thread_pool_job_func pf_job, void* p_context, const size_t num_jobs);
+
+END_EXTERN_C
+
+#endif // THREAD_POOL_H
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "varint.h"
+
+size_t varint_put(uint8_t* p_buffer, uint64_t value)
+{
+    size_t size = 0;
+    while (value >= 0x80)
+    {
+        p_buffer[size++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    p_buffer[size++] = (uint8_t)value;
+
+    return size;
+}
+
+size_t varint_put_u64(uint8_t* p_buffer, const uint64_t value)
+{
+    for (size_t i = 0; i < sizeof(uint64_t); ++i)
+    {
+        p_buffer[i] = (uint8_t)(value >> (i * 8));
+    }
+
+    return sizeof(uint64_t);
+}
+
+bool varint_read(FILE* p_file, uint64_t* p_out_value)
+{
+    uint64_t value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+        const int byte = fgetc(p_file);
+        if (byte == EOF)
+        {
+            return false;
+        }
+
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            *p_out_value = value;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool varint_read_u64(FILE* p_file, uint64_t* p_out_value)
+{
+    uint8_t bytes[sizeof(uint64_t)];
+    if (fread(bytes, 1, sizeof(bytes), p_file) != sizeof(bytes))
+    {
+        return false;
+    }
+
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(uint64_t); ++i)
+    {
+        value |= (uint64_t)bytes[i] << (i * 8);
+    }
+
+    *p_out_value = value;
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#ifndef VARINT_H
+#define VARINT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "safe99_common/defines.h"
+
+// 바이너리 파일 (행동 로그, 판 교환 형식)이 함께 쓰는 정수 쓰기/읽기
+// varint는 하위 7비트씩, 최상위 비트가 켜져 있으면 다음 바이트가 이어짐 (최대 VARINT_MAX_SIZE 바이트)
+// u64는 리틀 엔디언 8바이트 고정 길이
+
+#define VARINT_MAX_SIZE 10
+
+START_EXTERN_C
+
+// 버퍼에 쓰고 쓴 바이트 수 반환
+size_t varint_put(uint8_t* p_buffer, uint64_t value);
+size_t varint_put_u64(uint8_t* p_buffer, const uint64_t value);
+
+// 파일 끝이거나 varint가 너무 길면 false
+bool varint_read(FILE* p_file, uint64_t* p_out_value);
+bool varint_read_u64(FILE* p_file, uint64_t* p_out_value);
+
+END_EXTERN_C
+
+#endif // VARINT_H
\ No newline at end of file
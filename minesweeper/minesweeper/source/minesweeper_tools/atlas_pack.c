@@ -0,0 +1,119 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "minesweeper/image_loader.h"
+#include "minesweeper/sprite_atlas.h"
+
+// 타일/숫자/얼굴 DDS를 위아래로 쌓아 스프라이트 아틀라스 하나로 만듦
+// 게임이 매핑한 픽셀을 그대로 쓰도록 A8R8G8B8, 한 줄과 픽셀 시작 위치를 64바이트 배수로 맞춤
+//
+// minesweeper_atlas_pack [tiles.dds numbers.dds faces.dds out.msat]
+//   기본: sprite/tiles.dds sprite/numbers.dds sprite/faces.dds sprite/sprites.msat
+
+static const char* s_default_paths[] =
+{
+    "sprite/tiles.dds",
+    "sprite/numbers.dds",
+    "sprite/faces.dds",
+    "sprite/sprites.msat",
+};
+
+static size_t align_up(const size_t size);
+
+int main(int argc, char* argv[])
+{
+    if (argc != 1 && argc != 5)
+    {
+        printf("usage: %s [tiles.dds numbers.dds faces.dds out.msat]\n", argv[0]);
+        return 1;
+    }
+
+    const char* const* p_paths = (argc == 5) ? (const char* const*)(argv + 1) : s_default_paths;
+
+    image_t images[SPRITE_ATLAS_NUM_REGIONS];
+    memset(images, 0, sizeof(images));
+
+    sprite_atlas_header_t header;
+    memset(&header, 0, sizeof(sprite_atlas_header_t));
+
+    int exit_code = 1;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    for (size_t i = 0; i < SPRITE_ATLAS_NUM_REGIONS; ++i)
+    {
+        if (!load_a8r8g8b8_dds(p_paths[i], &images[i]))
+        {
+            printf("Failed to load %s\n", p_paths[i]);
+            goto cleanup;
+        }
+
+        header.regions[i].x = 0;
+        header.regions[i].y = height;
+        header.regions[i].width = images[i].width;
+        header.regions[i].height = images[i].height;
+
+        height += images[i].height;
+        if (images[i].width > width)
+        {
+            width = images[i].width;
+        }
+    }
+
+    memcpy(header.magic, "MSAT", 4);
+    header.version = SPRITE_ATLAS_VERSION;
+    header.width = width;
+    header.height = height;
+    header.pitch = (uint32_t)align_up((size_t)width * sizeof(uint32_t));
+    header.data_offset = (uint32_t)align_up(sizeof(sprite_atlas_header_t));
+    header.a_mask = 0xff000000;
+    header.r_mask = 0x00ff0000;
+    header.g_mask = 0x0000ff00;
+    header.b_mask = 0x000000ff;
+
+    const size_t file_size = header.data_offset + (size_t)header.pitch * height;
+    char* pa_file = (char*)calloc(file_size, 1);
+    if (pa_file == NULL)
+    {
+        printf("Failed to calloc atlas\n");
+        goto cleanup;
+    }
+
+    memcpy(pa_file, &header, sizeof(sprite_atlas_header_t));
+    for (size_t i = 0; i < SPRITE_ATLAS_NUM_REGIONS; ++i)
+    {
+        const size_t src_pitch = (size_t)images[i].width * sizeof(uint32_t);
+        for (uint32_t y = 0; y < images[i].height; ++y)
+        {
+            memcpy(pa_file + header.data_offset + (size_t)(header.regions[i].y + y) * header.pitch, images[i].pa_bitmap + y * src_pitch, src_pitch);
+        }
+    }
+
+    FILE* p_file = fopen(p_paths[SPRITE_ATLAS_NUM_REGIONS], "wb");
+    if (p_file == NULL || fwrite(pa_file, 1, file_size, p_file) != file_size || fclose(p_file) != 0)
+    {
+        printf("Failed to write %s\n", p_paths[SPRITE_ATLAS_NUM_REGIONS]);
+    }
+    else
+    {
+        printf("%s: %u x %u, pitch %u, %zu bytes\n", p_paths[SPRITE_ATLAS_NUM_REGIONS], width, height, header.pitch, file_size);
+        exit_code = 0;
+    }
+
+    free(pa_file);
+
+cleanup:
+    for (size_t i = 0; i < SPRITE_ATLAS_NUM_REGIONS; ++i)
+    {
+        free(images[i].pa_bitmap);
+    }
+
+    return exit_code;
+}
+
+static size_t align_up(const size_t size)
+{
+    return (size + SPRITE_ATLAS_ALIGNMENT - 1) & ~(size_t)(SPRITE_ATLAS_ALIGNMENT - 1);
+}
\ No newline at end of file
@@ -0,0 +1,267 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "minesweeper_engine/board_codec.h"
+#include "minesweeper_engine/clock.h"
+#include "minesweeper_engine/engine.h"
+#include "minesweeper_engine/random.h"
+
+// 판 압축 형식의 크기와 속도 측정
+// 판마다 임의의 칸을 열고 깃발을 꽂은 뒤 임시 파일로 쓰고 다시 읽어서,
+// 판 상태 해시와 지뢰 위치가 같은지, 이어서 같은 칸을 열었을 때도 같은지 확인
+// 원본 크기는 칸마다 bool 지뢰 + tile_t 타일로 잡음
+//
+// minesweeper_board_codec_bench [rows cols num_mines] [options]
+//   --boards n   판 크기마다 만들 판 수 (기본: 크기별 기본값, 크기를 주면 10)
+//   --opens n    판마다 열 칸 수 (기본 20)
+//   --seed n     시드 (기본 1)
+//   --out path   마지막 판을 파일로도 저장
+
+typedef struct bench_size
+{
+    size_t rows;
+    size_t cols;
+    size_t num_mines;
+    size_t num_boards;
+} bench_size_t;
+
+typedef struct bench_result
+{
+    size_t num_boards;
+    size_t num_verified;
+    uint64_t num_cells;
+    uint64_t num_bytes;
+    double encode_elapsed;
+    double decode_elapsed;
+} bench_result_t;
+
+static const bench_size_t s_default_sizes[] =
+{
+    { 16, 30, 99, 2000 },
+    { 256, 256, 10000, 50 },
+    { 1000, 1000, 150000, 5 },
+    { 4000, 4000, 2400000, 2 },
+};
+
+static bool run_bench(const bench_size_t* p_size, const size_t num_opens, const uint64_t seed, const char* p_out_path, bench_result_t* p_out_result);
+static void play_randomly(engine_t* p_engine, random_t* p_random, const size_t num_opens);
+static bool is_same_board(const engine_t* p_engine, const engine_t* p_other);
+
+int main(int argc, char* argv[])
+{
+    bench_size_t custom_size = { 0, 0, 0, 10 };
+    bool b_custom_size = false;
+    size_t num_boards = 0;
+    size_t num_opens = 20;
+    uint64_t seed = 1;
+    const char* p_out_path = NULL;
+
+    int arg = 1;
+    if (argc >= 4 && argv[1][0] != '-')
+    {
+        custom_size.rows = (size_t)strtoull(argv[1], NULL, 10);
+        custom_size.cols = (size_t)strtoull(argv[2], NULL, 10);
+        custom_size.num_mines = (size_t)strtoull(argv[3], NULL, 10);
+        b_custom_size = true;
+        arg = 4;
+
+        if (custom_size.rows < 1 || custom_size.cols < 1 || custom_size.num_mines < 1 || custom_size.num_mines >= custom_size.rows * custom_size.cols)
+        {
+            printf("rows >= 1, cols >= 1, 1 <= num_mines < rows * cols\n");
+            return 1;
+        }
+    }
+
+    for (; arg < argc; ++arg)
+    {
+        if (strcmp(argv[arg], "--boards") == 0 && arg + 1 < argc)
+        {
+            num_boards = (size_t)strtoull(argv[++arg], NULL, 10);
+        }
+        else if (strcmp(argv[arg], "--opens") == 0 && arg + 1 < argc)
+        {
+            num_opens = (size_t)strtoull(argv[++arg], NULL, 10);
+        }
+        else if (strcmp(argv[arg], "--seed") == 0 && arg + 1 < argc)
+        {
+            seed = strtoull(argv[++arg], NULL, 10);
+        }
+        else if (strcmp(argv[arg], "--out") == 0 && arg + 1 < argc)
+        {
+            p_out_path = argv[++arg];
+        }
+        else
+        {
+            printf("usage: %s [rows cols num_mines] [--boards n] [--opens n] [--seed n] [--out path]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("%-20s %8s %9s %12s %10s %8s %12s %12s\n", "board", "boards", "verified", "bytes/board", "bits/cell", "ratio", "enc MB/s", "dec MB/s");
+
+    const bench_size_t* p_sizes = b_custom_size ? &custom_size : s_default_sizes;
+    const size_t num_sizes = b_custom_size ? 1 : sizeof(s_default_sizes) / sizeof(s_default_sizes[0]);
+
+    int exit_code = 0;
+    for (size_t i = 0; i < num_sizes; ++i)
+    {
+        bench_size_t size = p_sizes[i];
+        if (num_boards != 0)
+        {
+            size.num_boards = num_boards;
+        }
+
+        bench_result_t result;
+        if (!run_bench(&size, num_opens, seed, p_out_path, &result))
+        {
+            printf("Failed to run %zu x %zu\n", size.rows, size.cols);
+            exit_code = 1;
+            break;
+        }
+
+        char board[32];
+        snprintf(board, sizeof(board), "%zux%zu/%zu", size.rows, size.cols, size.num_mines);
+
+        // 원본 크기 기준 처리량
+        const double raw_megabytes = (double)result.num_cells * (double)(sizeof(bool) + sizeof(tile_t)) / 1000000.0;
+        printf("%-20s %8zu %8.1f%% %12.0f %10.3f %7.1fx %12.1f %12.1f\n",
+               board, result.num_boards, 100.0 * (double)result.num_verified / (double)result.num_boards,
+               (double)result.num_bytes / (double)result.num_boards,
+               8.0 * (double)result.num_bytes / (double)result.num_cells,
+               raw_megabytes * 1000000.0 / (double)result.num_bytes,
+               raw_megabytes / result.encode_elapsed, raw_megabytes / result.decode_elapsed);
+
+        if (result.num_verified != result.num_boards)
+        {
+            exit_code = 1;
+        }
+    }
+
+    return exit_code;
+}
+
+static bool run_bench(const bench_size_t* p_size, const size_t num_opens, const uint64_t seed, const char* p_out_path, bench_result_t* p_out_result)
+{
+    memset(p_out_result, 0, sizeof(bench_result_t));
+
+    random_t seed_random;
+    random_init(&seed_random, seed);
+
+    for (size_t board = 0; board < p_size->num_boards; ++board)
+    {
+        const uint64_t board_seed = random_next(&seed_random);
+
+        engine_t engine;
+        if (!engine_init(&engine, p_size->rows, p_size->cols, p_size->num_mines, board_seed))
+        {
+            return false;
+        }
+        engine_set_first_click(&engine, ENGINE_FIRST_CLICK_SAFE_AREA);
+
+        random_t play_random;
+        random_init(&play_random, board_seed);
+        play_randomly(&engine, &play_random, num_opens);
+
+        FILE* p_file = tmpfile();
+        if (p_file == NULL)
+        {
+            engine_release(&engine);
+            return false;
+        }
+
+        const double encode_start_time = clock_get_seconds();
+        const bool b_written = board_codec_write(p_file, &engine) && fflush(p_file) == 0;
+        p_out_result->encode_elapsed += clock_get_seconds() - encode_start_time;
+
+        p_out_result->num_bytes += (uint64_t)ftell(p_file);
+        p_out_result->num_cells += (uint64_t)p_size->rows * p_size->cols;
+        rewind(p_file);
+
+        engine_t decoded;
+        const double decode_start_time = clock_get_seconds();
+        const bool b_read = b_written && board_codec_read(p_file, &decoded);
+        p_out_result->decode_elapsed += clock_get_seconds() - decode_start_time;
+
+        fclose(p_file);
+
+        if (b_read)
+        {
+            // 같은 칸을 계속 열어도 같아야 함 (숫자/방문 표시를 다시 만든 것까지 확인)
+            bool b_same = is_same_board(&engine, &decoded);
+            if (b_same && engine.status == ENGINE_STATUS_PLAYING)
+            {
+                random_t engine_random;
+                random_t decoded_random;
+                random_init(&engine_random, ~board_seed);
+                random_init(&decoded_random, ~board_seed);
+                play_randomly(&engine, &engine_random, num_opens);
+                play_randomly(&decoded, &decoded_random, num_opens);
+                b_same = is_same_board(&engine, &decoded);
+            }
+
+            if (b_same)
+            {
+                ++p_out_result->num_verified;
+            }
+
+            engine_release(&decoded);
+        }
+
+        if (p_out_path != NULL && board + 1 == p_size->num_boards)
+        {
+            FILE* p_out_file = fopen(p_out_path, "wb");
+            if (p_out_file == NULL || !board_codec_write(p_out_file, &engine) || fclose(p_out_file) != 0)
+            {
+                printf("Failed to write %s\n", p_out_path);
+            }
+        }
+
+        engine_release(&engine);
+    }
+
+    p_out_result->num_boards = p_size->num_boards;
+    return true;
+}
+
+// 임의의 칸을 열고 가끔 깃발을 꽂음, 끝나면 멈춤
+static void play_randomly(engine_t* p_engine, random_t* p_random, const size_t num_opens)
+{
+    for (size_t i = 0; i < num_opens && !engine_is_gameover(p_engine); ++i)
+    {
+        const size_t x = (size_t)random_next_bounded(p_random, p_engine->cols);
+        const size_t y = (size_t)random_next_bounded(p_random, p_engine->rows);
+
+        if (i > 0 && random_next_bounded(p_random, 4) == 0)
+        {
+            engine_cycle_flag(p_engine, x, y);
+        }
+        else
+        {
+            engine_open(p_engine, x, y);
+        }
+    }
+}
+
+static bool is_same_board(const engine_t* p_engine, const engine_t* p_other)
+{
+    if (engine_get_hash(p_engine) != engine_get_hash(p_other) || p_engine->b_mines_placed != p_other->b_mines_placed)
+    {
+        return false;
+    }
+
+    for (size_t y = 0; y < p_engine->rows; ++y)
+    {
+        for (size_t x = 0; x < p_engine->cols; ++x)
+        {
+            if (engine_is_mine(p_engine, x, y) != engine_is_mine(p_other, x, y))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
\ No newline at end of file
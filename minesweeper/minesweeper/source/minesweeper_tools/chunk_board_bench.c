@@ -0,0 +1,167 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "minesweeper_engine/chunk_board.h"
+#include "minesweeper_engine/clock.h"
+#include "minesweeper_engine/random.h"
+
+// 청크 단위 판을 가운데에서 넓혀 가며 열어 flood fill 처리량과 청크 메모리 측정
+// 지뢰를 아는 플레이어가 한 변이 2 * radius인 정사각형 안의 닫힌 칸 중 지뢰가 아닌 칸만 임의로 엶
+// 이어서 멀리 떨어진 칸에 깃발을 꽂았다 빼며 청크 할당/회수 시간 측정
+// 지뢰를 알고 여는데 지면 실패
+//
+// minesweeper_chunk_board_bench [options]
+//   --mines n    청크 (64 x 64)마다 지뢰 수 (기본 600)
+//   --opens n    열기 횟수 (기본 100000)
+//   --radius n   여는 영역의 반 변 (기본 4096)
+//   --budget n   열기/이어가기 한 번에 열 최대 칸 수 (기본 65536)
+//   --tiles n    이만큼 열면 열기 단계를 멈춤 (기본 16777216), 지뢰가 적으면 빈칸이 끝없이 이어지므로 필요함
+//   --seed n     시드 (기본 1)
+
+int main(int argc, char* argv[])
+{
+    uint32_t num_mines_per_chunk = 600;
+    size_t num_opens = 100000;
+    int64_t radius = 4096;
+    size_t open_budget = 65536;
+    uint64_t max_tiles = 16777216;
+    uint64_t seed = 1;
+
+    for (int arg = 1; arg < argc; ++arg)
+    {
+        if (strcmp(argv[arg], "--mines") == 0 && arg + 1 < argc)
+        {
+            num_mines_per_chunk = (uint32_t)strtoul(argv[++arg], NULL, 10);
+        }
+        else if (strcmp(argv[arg], "--opens") == 0 && arg + 1 < argc)
+        {
+            num_opens = (size_t)strtoull(argv[++arg], NULL, 10);
+        }
+        else if (strcmp(argv[arg], "--radius") == 0 && arg + 1 < argc)
+        {
+            radius = (int64_t)strtoll(argv[++arg], NULL, 10);
+        }
+        else if (strcmp(argv[arg], "--budget") == 0 && arg + 1 < argc)
+        {
+            open_budget = (size_t)strtoull(argv[++arg], NULL, 10);
+        }
+        else if (strcmp(argv[arg], "--tiles") == 0 && arg + 1 < argc)
+        {
+            max_tiles = strtoull(argv[++arg], NULL, 10);
+        }
+        else if (strcmp(argv[arg], "--seed") == 0 && arg + 1 < argc)
+        {
+            seed = strtoull(argv[++arg], NULL, 10);
+        }
+        else
+        {
+            printf("usage: %s [--mines n] [--opens n] [--radius n] [--budget n] [--tiles n] [--seed n]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (num_mines_per_chunk == 0 || num_mines_per_chunk >= CHUNK_BOARD_NUM_CHUNK_TILES || radius <= 0 || radius > ((int64_t)1 << 40)
+        || open_budget == 0)
+    {
+        printf("0 < mines < %d, 0 < radius <= 2^40, budget > 0\n", CHUNK_BOARD_NUM_CHUNK_TILES);
+        return 1;
+    }
+
+    chunk_board_t board;
+    if (!chunk_board_init(&board, seed, num_mines_per_chunk, open_budget))
+    {
+        printf("Failed to init chunk board\n");
+        return 1;
+    }
+
+    random_t random;
+    random_init(&random, seed);
+
+    int exit_code = 0;
+    size_t num_errors = 0;
+
+    printf("mines/chunk: %u, radius: %lld, budget: %zu\n", num_mines_per_chunk, (long long)radius, open_budget);
+    printf("%-16s %12s %12s %10s\n", "phase", "ops", "tiles", "ns/tile");
+
+    // 첫 열기는 가운데, 이후 이미 열린 칸이나 지뢰를 고르면 건너뜀
+    // 할당하지 않은 청크의 지뢰 확인은 느리므로 열기/이어가기 시간만 더함
+    size_t num_calls = 0;
+    double elapsed = 0.0;
+    for (size_t i = 0; i < num_opens && chunk_board_get_num_opened(&board) < max_tiles; ++i)
+    {
+        int64_t x = 0;
+        int64_t y = 0;
+        if (i > 0)
+        {
+            x = (int64_t)random_next_bounded(&random, (uint64_t)radius * 2) - radius;
+            y = (int64_t)random_next_bounded(&random, (uint64_t)radius * 2) - radius;
+            if (chunk_board_get_tile(&board, x, y) != TILE_BLIND || chunk_board_is_mine(&board, x, y))
+            {
+                continue;
+            }
+        }
+
+        const double start_time = clock_get_seconds();
+        chunk_board_open(&board, x, y);
+        ++num_calls;
+        while (chunk_board_get_num_opened(&board) < max_tiles && chunk_board_continue(&board))
+        {
+            ++num_calls;
+        }
+        elapsed += clock_get_seconds() - start_time;
+
+        if (chunk_board_get_status(&board) != ENGINE_STATUS_PLAYING)
+        {
+            ++num_errors;
+            break;
+        }
+    }
+    const uint64_t num_opened = chunk_board_get_num_opened(&board);
+    printf("%-16s %12zu %12llu %10.2f\n", "open", num_calls, (unsigned long long)num_opened,
+           (num_opened > 0) ? elapsed * 1e9 / (double)num_opened : 0.0);
+
+    const size_t num_chunks = chunk_board_get_num_chunks(&board);
+    printf("chunks: %zu, %.1f MB (chunks %.1f MB, map %.1f MB), %.1f opened tiles/chunk\n", num_chunks,
+           (double)(num_chunks * sizeof(board_chunk_t) + board.chunk_map.num_slots * (board.chunk_map.slot_size + 1)) / 1e6,
+           (double)(num_chunks * sizeof(board_chunk_t)) / 1e6,
+           (double)(board.chunk_map.num_slots * (board.chunk_map.slot_size + 1)) / 1e6,
+           (num_chunks > 0) ? (double)num_opened / (double)num_chunks : 0.0);
+
+    // 깃발 -> 물음표 -> 없음이면 청크를 할당했다가 바로 회수함, 회수한 청크는 풀에서 다시 씀
+    const size_t num_cycles = num_opens / 10;
+    // 연 영역에서 flood fill이 닿지 않을 만큼 멀리
+    const int64_t far_offset = (int64_t)1 << 48;
+    const double start_time = clock_get_seconds();
+    for (size_t i = 0; i < num_cycles; ++i)
+    {
+        const int64_t x = far_offset + (int64_t)random_next_bounded(&random, (uint64_t)radius * 2);
+        const int64_t y = (int64_t)random_next_bounded(&random, (uint64_t)radius * 2) - radius;
+        for (int cycle = 0; cycle < 3; ++cycle)
+        {
+            if (!chunk_board_cycle_flag(&board, x, y))
+            {
+                ++num_errors;
+            }
+        }
+    }
+    elapsed = clock_get_seconds() - start_time;
+    printf("alloc+reclaim: %zu chunks, %.2f ns/chunk\n", num_cycles, (num_cycles > 0) ? elapsed * 1e9 / (double)num_cycles : 0.0);
+
+    if (chunk_board_get_num_chunks(&board) != num_chunks || chunk_board_get_num_flags(&board) != 0)
+    {
+        ++num_errors;
+    }
+
+    if (num_errors != 0)
+    {
+        printf("errors: %zu\n", num_errors);
+        exit_code = 1;
+    }
+
+    chunk_board_release(&board);
+
+    return exit_code;
+}
\ No newline at end of file
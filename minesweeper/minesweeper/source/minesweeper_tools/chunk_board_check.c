@@ -0,0 +1,314 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "minesweeper_engine/chunk_board.h"
+#include "minesweeper_engine/random.h"
+
+// 청크 단위 판을 임의로 열고 할당된 청크의 모든 칸을 chunk_board_is_mine()으로 다시 세어 확인 (ctest에서 실행)
+// - 열린 칸의 숫자 = 주변 8칸 지뢰 수 (청크 경계 포함), 열린 칸에 지뢰 없음
+// - 빈칸 주변은 모두 열림, 첫 칸 주변 3x3에 지뢰 없음, 지면 할당된 지뢰가 모두 보임
+// - 열기 예산이 있는 판과 없는 판의 결과가 같음
+// - 깃발을 꽂았다 뺀 청크는 회수, 재시작하면 청크 0개
+// 좌표 범위 끝에 붙은 판도 섞음
+//
+// minesweeper_chunk_board_check [--rounds n] [--seed n]
+
+#define NUM_OPENS_PER_ROUND 30
+
+static bool check_round(random_t* p_random, const size_t round);
+static bool check_resident_chunks(chunk_board_t* p_board, chunk_board_t* p_reference_board);
+static int count_neighbor_mines(chunk_board_t* p_board, const int64_t x, const int64_t y);
+static FORCEINLINE bool is_in_range(const int64_t x, const int64_t y);
+static FORCEINLINE bool is_opened(const tile_t tile);
+
+int main(int argc, char* argv[])
+{
+    size_t num_rounds = 40;
+    uint64_t seed = 42;
+
+    for (int arg = 1; arg < argc; ++arg)
+    {
+        if (strcmp(argv[arg], "--rounds") == 0 && arg + 1 < argc)
+        {
+            num_rounds = (size_t)strtoull(argv[++arg], NULL, 10);
+        }
+        else if (strcmp(argv[arg], "--seed") == 0 && arg + 1 < argc)
+        {
+            seed = strtoull(argv[++arg], NULL, 10);
+        }
+        else
+        {
+            printf("usage: %s [--rounds n] [--seed n]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    random_t random;
+    random_init(&random, seed);
+
+    for (size_t round = 0; round < num_rounds; ++round)
+    {
+        if (!check_round(&random, round))
+        {
+            printf("failed at round %zu (seed %llu)\n", round, (unsigned long long)seed);
+            return 1;
+        }
+    }
+
+    printf("ok: %zu rounds\n", num_rounds);
+
+    return 0;
+}
+
+static bool check_round(random_t* p_random, const size_t round)
+{
+    const uint32_t num_mines_per_chunk = 500 + (uint32_t)random_next_bounded(p_random, (round % 3 == 0) ? 1500 : 300);
+    const size_t open_budget = (round % 2 == 0) ? 1 + (size_t)random_next_bounded(p_random, 500) : 0;
+    const uint64_t board_seed = random_next(p_random);
+
+    int64_t origin_x = (int64_t)random_next_bounded(p_random, 1000000) - 500000;
+    int64_t origin_y = (int64_t)random_next_bounded(p_random, 1000000) - 500000;
+    if (round % 7 == 0)
+    {
+        origin_x = CHUNK_BOARD_MAX_COORD - 3;
+        origin_y = CHUNK_BOARD_MIN_COORD + 2;
+    }
+
+    bool b_passed = false;
+
+    chunk_board_t board;
+    chunk_board_t reference_board;
+    if (!chunk_board_init(&board, board_seed, num_mines_per_chunk, open_budget))
+    {
+        printf("Failed to init chunk board\n");
+        goto failed_init_board;
+    }
+    if (!chunk_board_init(&reference_board, board_seed, num_mines_per_chunk, 0))
+    {
+        printf("Failed to init reference board\n");
+        goto failed_init_reference_board;
+    }
+
+    // 첫 열기 전에 꽂았다 뺀 깃발의 청크는 회수돼야 함
+    chunk_board_cycle_flag(&board, origin_x + 1, origin_y + 1);
+    chunk_board_cycle_flag(&board, origin_x + 1, origin_y + 1);
+    for (int cycle = 0; cycle < 3; ++cycle)
+    {
+        chunk_board_cycle_flag(&board, origin_x - 5000, origin_y);
+    }
+    if (chunk_board_get_num_chunks(&board) != 1)
+    {
+        printf("flagged chunks not reclaimed: %zu chunks\n", chunk_board_get_num_chunks(&board));
+        goto cleanup;
+    }
+
+    if (!chunk_board_open(&board, origin_x, origin_y))
+    {
+        printf("first open failed\n");
+        goto cleanup;
+    }
+    while (chunk_board_continue(&board))
+    {
+    }
+    chunk_board_open(&reference_board, origin_x, origin_y);
+
+    if (chunk_board_get_status(&board) != ENGINE_STATUS_PLAYING)
+    {
+        printf("lost on first open\n");
+        goto cleanup;
+    }
+
+    for (int64_t y = origin_y - 1; y <= origin_y + 1; ++y)
+    {
+        for (int64_t x = origin_x - 1; x <= origin_x + 1; ++x)
+        {
+            if (is_in_range(x, y) && chunk_board_is_mine(&board, x, y))
+            {
+                printf("mine next to first open at %lld %lld\n", (long long)x, (long long)y);
+                goto cleanup;
+            }
+        }
+    }
+
+    for (int i = 0; i < NUM_OPENS_PER_ROUND && chunk_board_get_status(&board) == ENGINE_STATUS_PLAYING; ++i)
+    {
+        const int64_t x = origin_x + (int64_t)random_next_bounded(p_random, 200) - 100;
+        const int64_t y = origin_y + (int64_t)random_next_bounded(p_random, 200) - 100;
+        if (!is_in_range(x, y))
+        {
+            continue;
+        }
+
+        const bool b_mine = chunk_board_is_mine(&board, x, y);
+        const tile_t tile = chunk_board_get_tile(&board, x, y);
+
+        chunk_board_open(&board, x, y);
+        while (chunk_board_continue(&board))
+        {
+        }
+        chunk_board_open(&reference_board, x, y);
+
+        if (b_mine && tile == TILE_BLIND && chunk_board_get_status(&board) != ENGINE_STATUS_LOST)
+        {
+            printf("opened mine at %lld %lld without losing\n", (long long)x, (long long)y);
+            goto cleanup;
+        }
+    }
+
+    if (chunk_board_get_num_opened(&board) != chunk_board_get_num_opened(&reference_board))
+    {
+        printf("budgeted board opened %llu, reference opened %llu\n",
+               (unsigned long long)chunk_board_get_num_opened(&board), (unsigned long long)chunk_board_get_num_opened(&reference_board));
+        goto cleanup;
+    }
+
+    if (!check_resident_chunks(&board, &reference_board))
+    {
+        goto cleanup;
+    }
+
+    chunk_board_restart(&board, board_seed + 1);
+    if (chunk_board_get_num_chunks(&board) != 0)
+    {
+        printf("restart kept %zu chunks\n", chunk_board_get_num_chunks(&board));
+        goto cleanup;
+    }
+
+    b_passed = true;
+
+cleanup:
+    chunk_board_release(&reference_board);
+
+failed_init_reference_board:
+    chunk_board_release(&board);
+
+failed_init_board:
+    return b_passed;
+}
+
+static bool check_resident_chunks(chunk_board_t* p_board, chunk_board_t* p_reference_board)
+{
+    const bool b_playing = chunk_board_get_status(p_board) == ENGINE_STATUS_PLAYING;
+    const bool b_lost = chunk_board_get_status(p_board) == ENGINE_STATUS_LOST;
+    uint64_t num_opened = 0;
+
+    size_t slot = 0;
+    void* p_value;
+    while (flat_map_get_next(&p_board->chunk_map, &slot, NULL, &p_value))
+    {
+        const board_chunk_t* p_chunk = *(board_chunk_t**)p_value;
+        uint32_t num_touched = 0;
+
+        for (int64_t local_y = 0; local_y < CHUNK_BOARD_CHUNK_SIZE; ++local_y)
+        {
+            for (int64_t local_x = 0; local_x < CHUNK_BOARD_CHUNK_SIZE; ++local_x)
+            {
+                const int64_t x = p_chunk->key.chunk_x * CHUNK_BOARD_CHUNK_SIZE + local_x;
+                const int64_t y = p_chunk->key.chunk_y * CHUNK_BOARD_CHUNK_SIZE + local_y;
+                const tile_t tile = (tile_t)p_chunk->tiles[local_y * CHUNK_BOARD_CHUNK_SIZE + local_x];
+                const bool b_mine = chunk_board_is_mine(p_board, x, y);
+
+                if (tile != TILE_BLIND)
+                {
+                    ++num_touched;
+                }
+
+                // 지면 남은 지뢰가 드러나므로 플레이 중일 때만 비교
+                if (b_playing && chunk_board_get_tile(p_reference_board, x, y) != tile)
+                {
+                    printf("tile differs from reference at %lld %lld\n", (long long)x, (long long)y);
+                    return false;
+                }
+
+                if (b_lost && b_mine && tile != TILE_MINE && tile != TILE_GAMEOVER_MINE)
+                {
+                    printf("mine not revealed at %lld %lld\n", (long long)x, (long long)y);
+                    return false;
+                }
+
+                if (!is_opened(tile))
+                {
+                    continue;
+                }
+                ++num_opened;
+
+                if (b_mine)
+                {
+                    printf("opened mine at %lld %lld\n", (long long)x, (long long)y);
+                    return false;
+                }
+
+                const int count = (tile == TILE_OPEN) ? 0 : tile - TILE_1 + 1;
+                const int num_neighbor_mines = count_neighbor_mines(p_board, x, y);
+                if (count != num_neighbor_mines)
+                {
+                    printf("count %d, brute force %d at %lld %lld\n", count, num_neighbor_mines, (long long)x, (long long)y);
+                    return false;
+                }
+
+                if (tile != TILE_OPEN)
+                {
+                    continue;
+                }
+
+                for (int64_t neighbor_y = y - 1; neighbor_y <= y + 1; ++neighbor_y)
+                {
+                    for (int64_t neighbor_x = x - 1; neighbor_x <= x + 1; ++neighbor_x)
+                    {
+                        if (is_in_range(neighbor_x, neighbor_y) && !is_opened(chunk_board_get_tile(p_board, neighbor_x, neighbor_y)))
+                        {
+                            printf("flood fill stopped at %lld %lld\n", (long long)neighbor_x, (long long)neighbor_y);
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (num_touched != p_chunk->num_touched || num_touched == 0)
+        {
+            printf("chunk %lld %lld touched %u, counted %u\n", (long long)p_chunk->key.chunk_x, (long long)p_chunk->key.chunk_y,
+                   p_chunk->num_touched, num_touched);
+            return false;
+        }
+    }
+
+    if (num_opened != chunk_board_get_num_opened(p_board))
+    {
+        printf("num_opened %llu, counted %llu\n", (unsigned long long)chunk_board_get_num_opened(p_board), (unsigned long long)num_opened);
+        return false;
+    }
+
+    return true;
+}
+
+static int count_neighbor_mines(chunk_board_t* p_board, const int64_t x, const int64_t y)
+{
+    int num_mines = 0;
+    for (int64_t neighbor_y = y - 1; neighbor_y <= y + 1; ++neighbor_y)
+    {
+        for (int64_t neighbor_x = x - 1; neighbor_x <= x + 1; ++neighbor_x)
+        {
+            if ((neighbor_x != x || neighbor_y != y) && is_in_range(neighbor_x, neighbor_y)
+                && chunk_board_is_mine(p_board, neighbor_x, neighbor_y))
+            {
+                ++num_mines;
+            }
+        }
+    }
+
+    return num_mines;
+}
+
+static FORCEINLINE bool is_in_range(const int64_t x, const int64_t y)
+{
+    return x >= CHUNK_BOARD_MIN_COORD && x <= CHUNK_BOARD_MAX_COORD && y >= CHUNK_BOARD_MIN_COORD && y <= CHUNK_BOARD_MAX_COORD;
+}
+
+static FORCEINLINE bool is_opened(const tile_t tile)
+{
+    return tile == TILE_OPEN || (tile >= TILE_1 && tile <= TILE_8);
+}
\ No newline at end of file
@@ -0,0 +1,179 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "minesweeper_engine/clock.h"
+#include "minesweeper_engine/flat_map.h"
+#include "minesweeper_engine/random.h"
+
+// 청크 단위 판과 같은 키 (청크 좌표 두 개) -> 포인터 크기 값으로 flat_map 찾기/넣기/제거 시간 측정
+// 키는 가운데를 중심으로 한 정사각형 영역의 좌표, 찾기는 임의 순서
+// 찾은 값이 넣은 값과 다르거나 없는 키를 찾으면 실패
+//
+// minesweeper_flat_map_bench [options]
+//   --keys n      넣을 키 수 (기본 1000000)
+//   --lookups n   단계마다 찾기 횟수 (기본 10000000)
+//   --fnv         좌표 해시 대신 기본 해시 (FNV-1a)
+//   --seed n      시드 (기본 1)
+
+typedef struct bench_key
+{
+    int64_t x;
+    int64_t y;
+} bench_key_t;
+
+static FORCEINLINE bench_key_t make_key(const size_t index, const size_t side);
+static uint64_t get_key_hash(const void* p_key, const size_t key_size);
+
+int main(int argc, char* argv[])
+{
+    size_t num_keys = 1000000;
+    size_t num_lookups = 10000000;
+    bool b_fnv = false;
+    uint64_t seed = 1;
+
+    for (int arg = 1; arg < argc; ++arg)
+    {
+        if (strcmp(argv[arg], "--keys") == 0 && arg + 1 < argc)
+        {
+            num_keys = (size_t)strtoull(argv[++arg], NULL, 10);
+        }
+        else if (strcmp(argv[arg], "--lookups") == 0 && arg + 1 < argc)
+        {
+            num_lookups = (size_t)strtoull(argv[++arg], NULL, 10);
+        }
+        else if (strcmp(argv[arg], "--fnv") == 0)
+        {
+            b_fnv = true;
+        }
+        else if (strcmp(argv[arg], "--seed") == 0 && arg + 1 < argc)
+        {
+            seed = strtoull(argv[++arg], NULL, 10);
+        }
+        else
+        {
+            printf("usage: %s [--keys n] [--lookups n] [--fnv] [--seed n]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (num_keys == 0)
+    {
+        printf("keys > 0\n");
+        return 1;
+    }
+
+    // 한 변이 side인 영역을 앞에서부터 채움
+    size_t side = 1;
+    while (side * side < num_keys)
+    {
+        ++side;
+    }
+
+    flat_map_t map;
+    if (!flat_map_init(&map, sizeof(bench_key_t), sizeof(size_t), 0, b_fnv ? NULL : get_key_hash))
+    {
+        printf("Failed to init map\n");
+        return 1;
+    }
+
+    random_t random;
+    random_init(&random, seed);
+
+    int exit_code = 0;
+    size_t num_errors = 0;
+
+    printf("keys: %zu, hash: %s\n", num_keys, b_fnv ? "fnv-1a" : "coords");
+    printf("%-16s %12s %10s\n", "phase", "ops", "ns/op");
+
+    // 0개에서 시작해 늘리면서 넣기
+    double start_time = clock_get_seconds();
+    for (size_t i = 0; i < num_keys; ++i)
+    {
+        const bench_key_t key = make_key(i, side);
+        if (!flat_map_insert(&map, &key, sizeof(bench_key_t), &i, sizeof(size_t)))
+        {
+            ++num_errors;
+        }
+    }
+    double elapsed = clock_get_seconds() - start_time;
+    printf("%-16s %12zu %10.2f\n", "insert", num_keys, elapsed * 1e9 / (double)num_keys);
+
+    start_time = clock_get_seconds();
+    for (size_t i = 0; i < num_lookups; ++i)
+    {
+        const size_t index = (size_t)random_next_bounded(&random, num_keys);
+        const bench_key_t key = make_key(index, side);
+        const size_t* p_value = (const size_t*)flat_map_get_value_or_null(&map, &key, sizeof(bench_key_t));
+        if (p_value == NULL || *p_value != index)
+        {
+            ++num_errors;
+        }
+    }
+    elapsed = clock_get_seconds() - start_time;
+    printf("%-16s %12zu %10.2f\n", "lookup hit", num_lookups, (num_lookups > 0) ? elapsed * 1e9 / (double)num_lookups : 0.0);
+
+    // 영역 밖 좌표
+    start_time = clock_get_seconds();
+    for (size_t i = 0; i < num_lookups; ++i)
+    {
+        const bench_key_t key = { (int64_t)side + (int64_t)random_next_bounded(&random, side), (int64_t)random_next_bounded(&random, side) - (int64_t)(side / 2) };
+        if (flat_map_get_value_or_null(&map, &key, sizeof(bench_key_t)) != NULL)
+        {
+            ++num_errors;
+        }
+    }
+    elapsed = clock_get_seconds() - start_time;
+    printf("%-16s %12zu %10.2f\n", "lookup miss", num_lookups, (num_lookups > 0) ? elapsed * 1e9 / (double)num_lookups : 0.0);
+
+    // 청크 회수/할당처럼 임의 키를 빼고 다시 넣음 (지움 표시가 쌓였다가 같은 크기로 다시 만듦)
+    const size_t num_churns = num_lookups / 2;
+    start_time = clock_get_seconds();
+    for (size_t i = 0; i < num_churns; ++i)
+    {
+        const size_t index = (size_t)random_next_bounded(&random, num_keys);
+        const bench_key_t key = make_key(index, side);
+        if (!flat_map_remove(&map, &key, sizeof(bench_key_t))
+            || !flat_map_insert(&map, &key, sizeof(bench_key_t), &index, sizeof(size_t)))
+        {
+            ++num_errors;
+        }
+    }
+    elapsed = clock_get_seconds() - start_time;
+    printf("%-16s %12zu %10.2f\n", "remove+insert", num_churns, (num_churns > 0) ? elapsed * 1e9 / (double)num_churns : 0.0);
+
+    if (flat_map_get_num_elements(&map) != num_keys)
+    {
+        ++num_errors;
+    }
+
+    printf("slots: %zu (%.1f%% full), %.1f MB\n", map.num_slots, 100.0 * (double)num_keys / (double)map.num_slots,
+           (double)(map.num_slots * (map.slot_size + 1)) / 1e6);
+
+    if (num_errors != 0)
+    {
+        printf("errors: %zu\n", num_errors);
+        exit_code = 1;
+    }
+
+    flat_map_release(&map);
+
+    return exit_code;
+}
+
+// 키 배열을 두면 찾을 때마다 배열 읽기도 캐시를 놓치므로 번호에서 바로 만듦
+static FORCEINLINE bench_key_t make_key(const size_t index, const size_t side)
+{
+    const bench_key_t key = { (int64_t)(index % side) - (int64_t)(side / 2), (int64_t)(index / side) - (int64_t)(side / 2) };
+    return key;
+}
+
+static uint64_t get_key_hash(const void* p_key, const size_t key_size)
+{
+    (void)key_size;
+
+    const bench_key_t* p_bench_key = (const bench_key_t*)p_key;
+    return random_mix_seed((uint64_t)p_bench_key->x ^ random_mix_seed((uint64_t)p_bench_key->y));
+}
\ No newline at end of file
@@ -0,0 +1,264 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "minesweeper_engine/clock.h"
+#include "minesweeper_engine/engine.h"
+#include "minesweeper_engine/generator.h"
+#include "minesweeper_engine/random.h"
+#include "minesweeper_engine/solver.h"
+#include "minesweeper_engine/thread_pool.h"
+
+// 추측 없는 판 생성 시간 측정
+// 판마다 가운데 타일을 첫 클릭으로 두고 생성기로 시드를 찾은 뒤,
+// 따로 둔 엔진/추론기로 그 시드의 판이 실제로 추측 없이 풀리는지 확인
+//
+// minesweeper_generator_bench [rows cols num_mines] [options]
+//   --boards n       판 크기마다 만들 판 수 (기본: 크기별 기본값, 크기를 주면 100)
+//   --threads n      생성 스레드 수, 0이면 논리 프로세서 수, 1이면 풀 없이 (기본 0)
+//   --candidates n   판마다 풀어 볼 최대 후보 수 (기본 100000)
+//   --seed n         시드 (기본 1)
+
+typedef struct bench_size
+{
+    size_t rows;
+    size_t cols;
+    size_t num_mines;
+    size_t num_boards;
+} bench_size_t;
+
+typedef struct bench_result
+{
+    size_t num_boards;
+    size_t num_found;
+    size_t num_verified;
+    uint64_t num_candidates;
+    double elapsed;
+    double max_elapsed;
+} bench_result_t;
+
+static const bench_size_t s_default_sizes[] =
+{
+    { 9, 9, 10, 1000 },
+    { 16, 16, 40, 200 },
+    { 16, 30, 99, 50 },
+    { 48, 48, 480, 20 },
+};
+
+static bool run_bench(const bench_size_t* p_size, thread_pool_t* p_pool, const uint64_t num_max_candidates, const uint64_t seed, bench_result_t* p_out_result);
+static bool is_solvable(engine_t* p_engine, solver_t* p_solver, const uint64_t seed);
+
+int main(int argc, char* argv[])
+{
+    bench_size_t custom_size = { 0, 0, 0, 100 };
+    bool b_custom_size = false;
+    size_t num_boards = 0;
+    size_t num_threads = 0;
+    uint64_t num_max_candidates = 100000;
+    uint64_t seed = 1;
+
+    int arg = 1;
+    if (argc >= 4 && argv[1][0] != '-')
+    {
+        custom_size.rows = (size_t)strtoull(argv[1], NULL, 10);
+        custom_size.cols = (size_t)strtoull(argv[2], NULL, 10);
+        custom_size.num_mines = (size_t)strtoull(argv[3], NULL, 10);
+        b_custom_size = true;
+        arg = 4;
+
+        if (custom_size.rows < 3 || custom_size.cols < 3 || custom_size.num_mines < 1 || custom_size.num_mines + 9 > custom_size.rows * custom_size.cols)
+        {
+            printf("rows >= 3, cols >= 3, 1 <= num_mines <= rows * cols - 9\n");
+            return 1;
+        }
+    }
+
+    for (; arg < argc; ++arg)
+    {
+        if (strcmp(argv[arg], "--boards") == 0 && arg + 1 < argc)
+        {
+            num_boards = (size_t)strtoull(argv[++arg], NULL, 10);
+        }
+        else if (strcmp(argv[arg], "--threads") == 0 && arg + 1 < argc)
+        {
+            num_threads = (size_t)strtoull(argv[++arg], NULL, 10);
+        }
+        else if (strcmp(argv[arg], "--candidates") == 0 && arg + 1 < argc)
+        {
+            num_max_candidates = strtoull(argv[++arg], NULL, 10);
+        }
+        else if (strcmp(argv[arg], "--seed") == 0 && arg + 1 < argc)
+        {
+            seed = strtoull(argv[++arg], NULL, 10);
+        }
+        else
+        {
+            printf("usage: %s [rows cols num_mines] [--boards n] [--threads n] [--candidates n] [--seed n]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    thread_pool_t pool;
+    thread_pool_t* p_pool = NULL;
+    if (num_threads != 1)
+    {
+        if (!thread_pool_init(&pool, num_threads))
+        {
+            printf("Failed to init thread pool\n");
+            return 1;
+        }
+        p_pool = &pool;
+    }
+
+    printf("threads: %zu\n", (p_pool == NULL) ? (size_t)1 : thread_pool_get_num_threads(p_pool));
+    printf("%-16s %8s %8s %9s %14s %12s %12s\n", "board", "boards", "found", "verified", "candidates", "avg ms", "max ms");
+
+    const bench_size_t* p_sizes = b_custom_size ? &custom_size : s_default_sizes;
+    const size_t num_sizes = b_custom_size ? 1 : sizeof(s_default_sizes) / sizeof(s_default_sizes[0]);
+
+    int exit_code = 0;
+    for (size_t i = 0; i < num_sizes; ++i)
+    {
+        bench_size_t size = p_sizes[i];
+        if (num_boards != 0)
+        {
+            size.num_boards = num_boards;
+        }
+
+        bench_result_t result;
+        if (!run_bench(&size, p_pool, num_max_candidates, seed, &result))
+        {
+            printf("Failed to init %zu x %zu\n", size.rows, size.cols);
+            exit_code = 1;
+            break;
+        }
+
+        char board[32];
+        snprintf(board, sizeof(board), "%zux%zu/%zu", size.rows, size.cols, size.num_mines);
+
+        const size_t num_found = (result.num_found > 0) ? result.num_found : 1;
+        printf("%-16s %8zu %7.1f%% %8.1f%% %14.1f %12.3f %12.3f\n",
+               board, result.num_boards, 100.0 * (double)result.num_found / (double)result.num_boards,
+               100.0 * (double)result.num_verified / (double)num_found,
+               (double)result.num_candidates / (double)result.num_boards,
+               result.elapsed * 1000.0 / (double)result.num_boards, result.max_elapsed * 1000.0);
+
+        // 찾은 판은 모두 풀려야 함
+        if (result.num_verified != result.num_found)
+        {
+            exit_code = 1;
+        }
+    }
+
+    if (p_pool != NULL)
+    {
+        thread_pool_release(p_pool);
+    }
+
+    return exit_code;
+}
+
+static bool run_bench(const bench_size_t* p_size, thread_pool_t* p_pool, const uint64_t num_max_candidates, const uint64_t seed, bench_result_t* p_out_result)
+{
+    generator_t generator;
+    if (!generator_init(&generator, p_pool, p_size->rows, p_size->cols, p_size->num_mines, ENGINE_FIRST_CLICK_SAFE_AREA))
+    {
+        return false;
+    }
+
+    engine_t engine;
+    if (!engine_init(&engine, p_size->rows, p_size->cols, p_size->num_mines, seed))
+    {
+        goto failed_init_engine;
+    }
+    engine_set_first_click(&engine, ENGINE_FIRST_CLICK_SAFE_AREA);
+
+    solver_t solver;
+    if (!solver_init(&solver, &engine))
+    {
+        goto failed_init_solver;
+    }
+
+    random_t seed_random;
+    random_init(&seed_random, seed);
+
+    memset(p_out_result, 0, sizeof(bench_result_t));
+
+    for (size_t board = 0; board < p_size->num_boards; ++board)
+    {
+        const uint64_t board_seed = random_next(&seed_random);
+
+        uint64_t found_seed;
+        const double start_time = clock_get_seconds();
+        const bool b_found = generator_find_seed(&generator, p_size->cols / 2, p_size->rows / 2, board_seed, num_max_candidates, &found_seed);
+        const double elapsed = clock_get_seconds() - start_time;
+
+        p_out_result->num_candidates += generator_get_num_tried_candidates(&generator);
+        p_out_result->elapsed += elapsed;
+        if (elapsed > p_out_result->max_elapsed)
+        {
+            p_out_result->max_elapsed = elapsed;
+        }
+
+        if (!b_found)
+        {
+            continue;
+        }
+
+        ++p_out_result->num_found;
+        if (is_solvable(&engine, &solver, found_seed))
+        {
+            ++p_out_result->num_verified;
+        }
+    }
+
+    p_out_result->num_boards = p_size->num_boards;
+
+    solver_release(&solver);
+    engine_release(&engine);
+    generator_release(&generator);
+
+    return true;
+
+failed_init_solver:
+    engine_release(&engine);
+
+failed_init_engine:
+    generator_release(&generator);
+    return false;
+}
+
+// 가운데 타일을 연 뒤 추론기가 찾은 안전한 칸만 열어서 이기는지 확인
+static bool is_solvable(engine_t* p_engine, solver_t* p_solver, const uint64_t seed)
+{
+    engine_restart(p_engine, seed);
+    engine_open(p_engine, p_engine->cols / 2, p_engine->rows / 2);
+
+    solver_update(p_solver);
+    engine_clear_dirty(p_engine);
+
+    while (engine_get_status(p_engine) == ENGINE_STATUS_PLAYING)
+    {
+        solver_deduce(p_solver);
+
+        size_t num_safe_tiles;
+        const size_t* p_safe_tiles = solver_get_safe_tiles(p_solver, &num_safe_tiles);
+        if (num_safe_tiles == 0)
+        {
+            break;
+        }
+
+        for (size_t i = 0; i < num_safe_tiles; ++i)
+        {
+            engine_open(p_engine, p_safe_tiles[i] % p_engine->cols, p_safe_tiles[i] / p_engine->cols);
+            solver_update(p_solver);
+            engine_clear_dirty(p_engine);
+        }
+        solver_clear_results(p_solver);
+    }
+
+    solver_clear_results(p_solver);
+    return engine_get_status(p_engine) == ENGINE_STATUS_WON;
+}
\ No newline at end of file
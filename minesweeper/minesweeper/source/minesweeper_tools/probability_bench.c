@@ -0,0 +1,262 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "minesweeper_engine/clock.h"
+#include "minesweeper_engine/engine.h"
+#include "minesweeper_engine/probability.h"
+#include "minesweeper_engine/random.h"
+#include "minesweeper_engine/solver.h"
+#include "minesweeper_engine/thread_pool.h"
+
+// 확률 계산 지연 시간 측정
+// 첫 타일(가운데, 주변 3x3 안전)을 연 뒤 추론기가 찾은 안전한 칸을 모두 열고,
+// 막히면 확률을 계산해 지뢰 확률이 가장 낮은 칸을 여는 것을 끝날 때까지 반복
+//
+// minesweeper_probability_bench [rows cols num_mines] [options]
+//   --games n     판 크기마다 돌릴 게임 수 (기본: 크기별 기본값, 크기를 주면 100)
+//   --threads n   확률 계산 스레드 수, 0이면 논리 프로세서 수, 1이면 풀 없이 (기본 0)
+//   --seed n      시드 (기본 1)
+
+typedef struct bench_size
+{
+    size_t rows;
+    size_t cols;
+    size_t num_mines;
+    size_t num_games;
+} bench_size_t;
+
+typedef struct bench_result
+{
+    size_t num_games;
+    size_t num_won;
+    size_t num_queries;
+    size_t num_frontier_tiles;
+    double query_time;
+    double max_query_time;
+} bench_result_t;
+
+static const bench_size_t s_default_sizes[] =
+{
+    { 9, 9, 10, 2000 },
+    { 16, 16, 40, 1000 },
+    { 16, 30, 99, 500 },
+    { 48, 48, 480, 50 },
+};
+
+static bool run_bench(const bench_size_t* p_size, thread_pool_t* p_pool, const uint64_t seed, bench_result_t* p_out_result);
+static void open_safe_tiles(engine_t* p_engine, solver_t* p_solver);
+
+int main(int argc, char* argv[])
+{
+    bench_size_t custom_size = { 0, 0, 0, 100 };
+    bool b_custom_size = false;
+    size_t num_games = 0;
+    size_t num_threads = 0;
+    uint64_t seed = 1;
+
+    int arg = 1;
+    if (argc >= 4 && argv[1][0] != '-')
+    {
+        custom_size.rows = (size_t)strtoull(argv[1], NULL, 10);
+        custom_size.cols = (size_t)strtoull(argv[2], NULL, 10);
+        custom_size.num_mines = (size_t)strtoull(argv[3], NULL, 10);
+        b_custom_size = true;
+        arg = 4;
+
+        if (custom_size.rows < 3 || custom_size.cols < 3 || custom_size.num_mines < 1 || custom_size.num_mines + 9 > custom_size.rows * custom_size.cols)
+        {
+            printf("rows >= 3, cols >= 3, 1 <= num_mines <= rows * cols - 9\n");
+            return 1;
+        }
+    }
+
+    for (; arg < argc; ++arg)
+    {
+        if (strcmp(argv[arg], "--games") == 0 && arg + 1 < argc)
+        {
+            num_games = (size_t)strtoull(argv[++arg], NULL, 10);
+        }
+        else if (strcmp(argv[arg], "--threads") == 0 && arg + 1 < argc)
+        {
+            num_threads = (size_t)strtoull(argv[++arg], NULL, 10);
+        }
+        else if (strcmp(argv[arg], "--seed") == 0 && arg + 1 < argc)
+        {
+            seed = strtoull(argv[++arg], NULL, 10);
+        }
+        else
+        {
+            printf("usage: %s [rows cols num_mines] [--games n] [--threads n] [--seed n]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    thread_pool_t pool;
+    thread_pool_t* p_pool = NULL;
+    if (num_threads != 1)
+    {
+        if (!thread_pool_init(&pool, num_threads))
+        {
+            printf("Failed to init thread pool\n");
+            return 1;
+        }
+        p_pool = &pool;
+    }
+
+    printf("threads: %zu\n", (p_pool == NULL) ? (size_t)1 : thread_pool_get_num_threads(p_pool));
+    printf("%-16s %8s %8s %10s %10s %12s %12s\n", "board", "games", "won", "queries", "frontier", "avg ms", "max ms");
+
+    const bench_size_t* p_sizes = b_custom_size ? &custom_size : s_default_sizes;
+    const size_t num_sizes = b_custom_size ? 1 : sizeof(s_default_sizes) / sizeof(s_default_sizes[0]);
+
+    int exit_code = 0;
+    for (size_t i = 0; i < num_sizes; ++i)
+    {
+        bench_size_t size = p_sizes[i];
+        if (num_games != 0)
+        {
+            size.num_games = num_games;
+        }
+
+        bench_result_t result;
+        if (!run_bench(&size, p_pool, seed, &result))
+        {
+            printf("Failed to run %zu x %zu\n", size.rows, size.cols);
+            exit_code = 1;
+            break;
+        }
+
+        char board[32];
+        snprintf(board, sizeof(board), "%zux%zu/%zu", size.rows, size.cols, size.num_mines);
+
+        const size_t num_queries = (result.num_queries > 0) ? result.num_queries : 1;
+        printf("%-16s %8zu %7.1f%% %10zu %10.1f %12.3f %12.3f\n",
+               board, result.num_games, 100.0 * (double)result.num_won / (double)result.num_games, result.num_queries,
+               (double)result.num_frontier_tiles / (double)num_queries,
+               result.query_time * 1000.0 / (double)num_queries, result.max_query_time * 1000.0);
+    }
+
+    if (p_pool != NULL)
+    {
+        thread_pool_release(p_pool);
+    }
+
+    return exit_code;
+}
+
+static bool run_bench(const bench_size_t* p_size, thread_pool_t* p_pool, const uint64_t seed, bench_result_t* p_out_result)
+{
+    engine_t engine;
+    if (!engine_init(&engine, p_size->rows, p_size->cols, p_size->num_mines, seed))
+    {
+        return false;
+    }
+    engine_set_first_click(&engine, ENGINE_FIRST_CLICK_SAFE_AREA);
+
+    solver_t solver;
+    if (!solver_init(&solver, &engine))
+    {
+        goto failed_init_solver;
+    }
+
+    probability_t probability;
+    if (!probability_init(&probability, &engine, p_pool))
+    {
+        goto failed_init_probability;
+    }
+
+    random_t seed_random;
+    random_init(&seed_random, seed);
+
+    memset(p_out_result, 0, sizeof(bench_result_t));
+
+    for (size_t game = 0; game < p_size->num_games; ++game)
+    {
+        engine_restart(&engine, random_next(&seed_random));
+        engine_open(&engine, p_size->cols / 2, p_size->rows / 2);
+
+        while (engine_get_status(&engine) == ENGINE_STATUS_PLAYING)
+        {
+            open_safe_tiles(&engine, &solver);
+            if (engine_get_status(&engine) != ENGINE_STATUS_PLAYING)
+            {
+                break;
+            }
+
+            const double start_time = clock_get_seconds();
+            const bool b_computed = probability_compute(&probability);
+            const double elapsed = clock_get_seconds() - start_time;
+
+            // 깃발을 꽂지 않으므로 모순일 수 없음
+            size_t x;
+            size_t y;
+            if (!b_computed || !probability_find_safest(&probability, &x, &y))
+            {
+                goto failed_compute;
+            }
+
+            ++p_out_result->num_queries;
+            p_out_result->num_frontier_tiles += probability_get_num_frontier_tiles(&probability);
+            p_out_result->query_time += elapsed;
+            if (elapsed > p_out_result->max_query_time)
+            {
+                p_out_result->max_query_time = elapsed;
+            }
+
+            engine_open(&engine, x, y);
+        }
+
+        if (engine_get_status(&engine) == ENGINE_STATUS_WON)
+        {
+            ++p_out_result->num_won;
+        }
+    }
+
+    p_out_result->num_games = p_size->num_games;
+
+    probability_release(&probability);
+    solver_release(&solver);
+    engine_release(&engine);
+
+    return true;
+
+failed_compute:
+    probability_release(&probability);
+
+failed_init_probability:
+    solver_release(&solver);
+
+failed_init_solver:
+    engine_release(&engine);
+    return false;
+}
+
+// 추론기가 막힐 때까지 안전한 칸을 엶
+static void open_safe_tiles(engine_t* p_engine, solver_t* p_solver)
+{
+    solver_update(p_solver);
+    engine_clear_dirty(p_engine);
+
+    while (engine_get_status(p_engine) == ENGINE_STATUS_PLAYING)
+    {
+        solver_deduce(p_solver);
+
+        size_t num_safe_tiles;
+        const size_t* p_safe_tiles = solver_get_safe_tiles(p_solver, &num_safe_tiles);
+        if (num_safe_tiles == 0)
+        {
+            break;
+        }
+
+        for (size_t i = 0; i < num_safe_tiles; ++i)
+        {
+            engine_open(p_engine, p_safe_tiles[i] % p_engine->cols, p_safe_tiles[i] / p_engine->cols);
+            solver_update(p_solver);
+            engine_clear_dirty(p_engine);
+        }
+        solver_clear_results(p_solver);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,198 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "minesweeper_engine/action_log.h"
+#include "minesweeper_engine/clock.h"
+#include "minesweeper_engine/engine.h"
+#include "safe99_common/safe_delete.h"
+
+// 행동 기록을 창 없이 엔진에 최대 속도로 다시 적용하고 마지막 판 상태 해시를 기록과 비교
+// 파일 읽기는 재생 전에 모두 끝내므로 시간에는 엔진 처리만 들어감
+//
+// minesweeper_replay path [options]
+//   --repeat n   같은 기록을 n번 재생 (기본 1)
+
+static bool load_actions(action_log_reader_t* p_reader, action_t** pp_out_actions, size_t* p_out_num_actions);
+static bool replay(engine_t* p_engine, const action_log_header_t* p_header, const action_t* p_actions, const size_t num_actions, size_t* p_out_failed_index);
+static const char* get_action_name(const action_type_t type);
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2 || argv[1][0] == '-')
+    {
+        printf("usage: %s path [--repeat n]\n", argv[0]);
+        return 1;
+    }
+
+    const char* p_path = argv[1];
+    size_t num_repeats = 1;
+
+    for (int i = 2; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc)
+        {
+            num_repeats = (size_t)strtoull(argv[++i], NULL, 10);
+        }
+        else
+        {
+            printf("unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    action_log_reader_t reader;
+    if (!action_log_reader_open(&reader, p_path))
+    {
+        printf("Failed to open %s\n", p_path);
+        return 1;
+    }
+
+    const action_log_header_t header = reader.header;
+
+    action_t* pa_actions;
+    size_t num_actions;
+    const bool b_loaded = load_actions(&reader, &pa_actions, &num_actions);
+    action_log_reader_close(&reader);
+
+    if (!b_loaded)
+    {
+        printf("Broken log %s\n", p_path);
+        return 1;
+    }
+
+    engine_t engine;
+    if (!engine_init(&engine, header.rows, header.cols, header.num_mines, header.seed))
+    {
+        printf("Failed to init engine\n");
+        free(pa_actions);
+        return 1;
+    }
+    engine_set_first_click(&engine, header.first_click);
+
+    int exit_code = 0;
+
+    const double start_time = clock_get_seconds();
+
+    size_t repeat = 0;
+    for (; repeat < num_repeats; ++repeat)
+    {
+        size_t failed_index;
+        if (!replay(&engine, &header, pa_actions, num_actions, &failed_index))
+        {
+            const action_t* p_action = &pa_actions[failed_index];
+            printf("mismatch at action %zu (%s, %zu, %zu, t=%llu ms)\n",
+                   failed_index, get_action_name(p_action->type), p_action->x, p_action->y, (unsigned long long)p_action->time);
+            exit_code = 1;
+            break;
+        }
+    }
+
+    const double elapsed = clock_get_seconds() - start_time;
+
+    // 시각은 기록을 시작한 때부터 재므로 END의 시각이 기록한 시간
+    const uint64_t recorded_time = pa_actions[num_actions - 1].time;
+    const size_t num_applied = repeat * num_actions;
+
+    printf("board: %zu x %zu, %zu mines, seed %llu\n", header.rows, header.cols, header.num_mines, (unsigned long long)header.seed);
+    printf("actions: %zu, recorded %.3f s\n", num_actions - 1, (double)recorded_time / 1000.0);
+    printf("replays: %zu\n", repeat);
+    printf("elapsed: %.6f s\n", elapsed);
+    if (elapsed > 0.0)
+    {
+        printf("actions/s: %.1f\n", (double)num_applied / elapsed);
+    }
+    printf("hash: %016llx (%s)\n", (unsigned long long)pa_actions[num_actions - 1].hash, (exit_code == 0) ? "ok" : "mismatch");
+
+    engine_release(&engine);
+    free(pa_actions);
+
+    return exit_code;
+}
+
+// END까지 읽음, END의 행동 수가 맞아야 함
+static bool load_actions(action_log_reader_t* p_reader, action_t** pp_out_actions, size_t* p_out_num_actions)
+{
+    size_t capacity = 1024;
+    size_t num_actions = 0;
+    action_t* pa_actions = (action_t*)malloc(sizeof(action_t) * capacity);
+    if (pa_actions == NULL)
+    {
+        return false;
+    }
+
+    while (true)
+    {
+        if (num_actions == capacity)
+        {
+            capacity *= 2;
+            action_t* pa_new_actions = (action_t*)realloc(pa_actions, sizeof(action_t) * capacity);
+            if (pa_new_actions == NULL)
+            {
+                goto failed_load;
+            }
+            pa_actions = pa_new_actions;
+        }
+
+        if (!action_log_reader_read(p_reader, &pa_actions[num_actions]))
+        {
+            goto failed_load;
+        }
+
+        if (pa_actions[num_actions++].type == ACTION_TYPE_END)
+        {
+            break;
+        }
+    }
+
+    if (pa_actions[num_actions - 1].num_actions != num_actions - 1)
+    {
+        goto failed_load;
+    }
+
+    *pp_out_actions = pa_actions;
+    *p_out_num_actions = num_actions;
+    return true;
+
+failed_load:
+    SAFE_FREE(pa_actions);
+    return false;
+}
+
+// 게임처럼 행동마다 변경 타일 목록을 비움
+static bool replay(engine_t* p_engine, const action_log_header_t* p_header, const action_t* p_actions, const size_t num_actions, size_t* p_out_failed_index)
+{
+    engine_restart(p_engine, p_header->seed);
+    engine_clear_dirty(p_engine);
+
+    for (size_t i = 0; i < num_actions; ++i)
+    {
+        if (!action_log_apply(p_engine, &p_actions[i]))
+        {
+            *p_out_failed_index = i;
+            return false;
+        }
+        engine_clear_dirty(p_engine);
+    }
+
+    return true;
+}
+
+static const char* get_action_name(const action_type_t type)
+{
+    switch (type)
+    {
+    case ACTION_TYPE_OPEN:
+        return "open";
+    case ACTION_TYPE_CYCLE_FLAG:
+        return "flag";
+    case ACTION_TYPE_RESTART:
+        return "restart";
+    case ACTION_TYPE_SET_SEED:
+        return "seed";
+    default:
+        return "end";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,212 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <string.h>
+
+#include "minesweeper_engine/scheduler.h"
+
+// 가짜 시계와 미리 정한 이벤트로 main.c와 같은 루프를 돌려 프레임/이벤트 순서 확인 (ctest에서 실행)
+// 실제 시간은 쓰지 않으므로 항상 같은 결과
+// - 첫 프레임은 바로, 이후 타이머 표시는 1초마다 (게임이 끝나면 마감 시각 없음)
+// - 입력은 프레임 상한 (60fps, 17ms) 안에서 하나로 묶임
+// - 시간이 다 되기 전에 깨어나면 프레임 없이 다시 대기
+// - 애니메이션 중에는 상한 간격으로 계속 그림
+// - 할 일이 없으면 무한 대기
+
+#define MAX_FPS 60
+#define START_TIME 1000
+#define GAME_END_TIME 4000
+#define TICK_INTERVAL_MS 1000
+#define ANIMATION_MS 50
+#define MAX_LOG_LENGTH 1024
+
+typedef enum fake_event_kind
+{
+    FAKE_EVENT_INPUT,
+    FAKE_EVENT_ANIMATE,
+    FAKE_EVENT_SPURIOUS_WAKE
+} fake_event_kind_t;
+
+typedef struct fake_event
+{
+    uint64_t time;
+    fake_event_kind_t kind;
+} fake_event_t;
+
+typedef struct fake_clock
+{
+    uint64_t now;
+
+    const fake_event_t* p_events;
+    size_t num_events;
+    size_t next_event;
+
+    // 대기에서 꺼낸 이벤트, 루프가 처리
+    const fake_event_t* p_pending_event;
+    bool b_done;
+
+    char log[MAX_LOG_LENGTH];
+    size_t log_length;
+} fake_clock_t;
+
+static const fake_event_t s_events[] =
+{
+    { 2500, FAKE_EVENT_INPUT },
+    { 2505, FAKE_EVENT_INPUT },
+    { 2510, FAKE_EVENT_INPUT },
+    { 2900, FAKE_EVENT_SPURIOUS_WAKE },
+    { 3995, FAKE_EVENT_INPUT },
+    { 5000, FAKE_EVENT_ANIMATE },
+    { 6000, FAKE_EVENT_INPUT },
+};
+
+static const char* s_expected_log =
+    "frame 1000\n"
+    "frame 2000\n"
+    "input 2500\n"
+    "frame 2500\n"
+    "input 2505\n"
+    "input 2510\n"
+    "frame 2517\n"
+    "wake 2900\n"
+    "frame 3000\n"
+    "input 3995\n"
+    "frame 3995\n"
+    "frame 4000\n"
+    "animate 5000\n"
+    "frame 5000\n"
+    "frame 5017\n"
+    "frame 5034\n"
+    "frame 5051\n"
+    "input 6000\n"
+    "frame 6000\n";
+
+static uint64_t get_fake_time(void* p_context);
+static bool wait_fake_event(void* p_context, const uint32_t timeout_ms);
+static void append_log(fake_clock_t* p_clock, const char* p_name);
+
+int main(void)
+{
+    fake_clock_t clock;
+    memset(&clock, 0, sizeof(fake_clock_t));
+    clock.now = START_TIME;
+    clock.p_events = s_events;
+    clock.num_events = sizeof(s_events) / sizeof(s_events[0]);
+
+    scheduler_t scheduler;
+    scheduler_init(&scheduler, get_fake_time, &clock, wait_fake_event, &clock, MAX_FPS);
+
+    uint64_t animation_end_time = 0;
+
+    // 잘못되어 끝나지 않을 때를 대비한 상한
+    for (int i = 0; i < 1000 && !clock.b_done; ++i)
+    {
+        if (scheduler_wait(&scheduler))
+        {
+            const uint64_t now = scheduler_get_time(&scheduler);
+            append_log(&clock, "frame");
+
+            if (scheduler.b_animating && now >= animation_end_time)
+            {
+                scheduler_set_animating(&scheduler, false);
+            }
+
+            // get_game_next_tick()처럼 다음 초, 게임이 끝났으면 마감 시각 없음
+            if (now < GAME_END_TIME)
+            {
+                scheduler_set_deadline(&scheduler, START_TIME + ((now - START_TIME) / TICK_INTERVAL_MS + 1) * TICK_INTERVAL_MS);
+            }
+            else
+            {
+                scheduler_set_deadline(&scheduler, SCHEDULER_NO_DEADLINE);
+            }
+            continue;
+        }
+
+        const fake_event_t* p_event = clock.p_pending_event;
+        if (p_event == NULL)
+        {
+            continue;
+        }
+        clock.p_pending_event = NULL;
+
+        scheduler_request_redraw(&scheduler);
+        if (p_event->kind == FAKE_EVENT_ANIMATE)
+        {
+            scheduler_set_animating(&scheduler, true);
+            animation_end_time = p_event->time + ANIMATION_MS;
+        }
+    }
+
+    if (!clock.b_done || strcmp(clock.log, s_expected_log) != 0)
+    {
+        printf("expected:\n%s\ngot:\n%s\n", s_expected_log, clock.log);
+        return 1;
+    }
+
+    printf("ok\n");
+
+    return 0;
+}
+
+static uint64_t get_fake_time(void* p_context)
+{
+    return ((const fake_clock_t*)p_context)->now;
+}
+
+// 다음 이벤트가 timeout_ms 안에 있으면 그 시각으로 건너뛰고 이벤트를 넘김, 없으면 timeout_ms만큼 흐름
+// 이벤트가 남지 않았는데 무한 대기하면 끝
+static bool wait_fake_event(void* p_context, const uint32_t timeout_ms)
+{
+    fake_clock_t* p_clock = (fake_clock_t*)p_context;
+
+    if (p_clock->next_event < p_clock->num_events)
+    {
+        const fake_event_t* p_event = &p_clock->p_events[p_clock->next_event];
+        if (timeout_ms == SCHEDULER_INFINITE || p_event->time <= p_clock->now + timeout_ms)
+        {
+            ++p_clock->next_event;
+            if (p_event->time > p_clock->now)
+            {
+                p_clock->now = p_event->time;
+            }
+
+            switch (p_event->kind)
+            {
+            case FAKE_EVENT_INPUT:
+                append_log(p_clock, "input");
+                break;
+            case FAKE_EVENT_ANIMATE:
+                append_log(p_clock, "animate");
+                break;
+            case FAKE_EVENT_SPURIOUS_WAKE:
+                append_log(p_clock, "wake");
+                return false;
+            default:
+                break;
+            }
+
+            p_clock->p_pending_event = p_event;
+            return true;
+        }
+    }
+
+    if (timeout_ms == SCHEDULER_INFINITE)
+    {
+        p_clock->b_done = true;
+        return true;
+    }
+
+    p_clock->now += timeout_ms;
+    return false;
+}
+
+static void append_log(fake_clock_t* p_clock, const char* p_name)
+{
+    const int length = snprintf(p_clock->log + p_clock->log_length, MAX_LOG_LENGTH - p_clock->log_length, "%s %llu\n",
+                                p_name, (unsigned long long)p_clock->now);
+    if (length > 0 && p_clock->log_length + (size_t)length < MAX_LOG_LENGTH)
+    {
+        p_clock->log_length += (size_t)length;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,186 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "minesweeper_engine/clock.h"
+#include "minesweeper_engine/engine.h"
+#include "minesweeper_engine/random.h"
+#include "minesweeper_engine/solver.h"
+
+// 추론기 처리량 측정
+// 첫 타일(가운데, 주변 3x3 안전)을 연 뒤 추론기가 찾은 안전한 칸만 열면서 막힐 때까지 진행
+// 추측 없이 이기면 풀린 판
+//
+// minesweeper_solver_bench [rows cols num_mines] [options]
+//   --games n   판 크기마다 돌릴 게임 수 (기본: 크기별 기본값, 크기를 주면 1000)
+//   --seed n    시드 (기본 1)
+
+typedef struct bench_size
+{
+    size_t rows;
+    size_t cols;
+    size_t num_mines;
+    size_t num_games;
+} bench_size_t;
+
+typedef struct bench_result
+{
+    size_t num_games;
+    size_t num_solved;
+    uint64_t num_deductions;
+    double elapsed;
+} bench_result_t;
+
+static const bench_size_t s_default_sizes[] =
+{
+    { 9, 9, 10, 20000 },
+    { 16, 16, 40, 10000 },
+    { 16, 30, 99, 5000 },
+    { 100, 100, 1600, 200 },
+    { 1000, 1000, 160000, 4 },
+};
+
+static bool run_bench(const bench_size_t* p_size, const uint64_t seed, bench_result_t* p_out_result);
+
+int main(int argc, char* argv[])
+{
+    bench_size_t custom_size = { 0, 0, 0, 1000 };
+    bool b_custom_size = false;
+    size_t num_games = 0;
+    uint64_t seed = 1;
+
+    int arg = 1;
+    if (argc >= 4 && argv[1][0] != '-')
+    {
+        custom_size.rows = (size_t)strtoull(argv[1], NULL, 10);
+        custom_size.cols = (size_t)strtoull(argv[2], NULL, 10);
+        custom_size.num_mines = (size_t)strtoull(argv[3], NULL, 10);
+        b_custom_size = true;
+        arg = 4;
+
+        if (custom_size.rows < 3 || custom_size.cols < 3 || custom_size.num_mines < 1 || custom_size.num_mines + 9 > custom_size.rows * custom_size.cols)
+        {
+            printf("rows >= 3, cols >= 3, 1 <= num_mines <= rows * cols - 9\n");
+            return 1;
+        }
+    }
+
+    for (; arg < argc; ++arg)
+    {
+        if (strcmp(argv[arg], "--games") == 0 && arg + 1 < argc)
+        {
+            num_games = (size_t)strtoull(argv[++arg], NULL, 10);
+        }
+        else if (strcmp(argv[arg], "--seed") == 0 && arg + 1 < argc)
+        {
+            seed = strtoull(argv[++arg], NULL, 10);
+        }
+        else
+        {
+            printf("usage: %s [rows cols num_mines] [--games n] [--seed n]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    const bench_size_t* p_sizes = b_custom_size ? &custom_size : s_default_sizes;
+    const size_t num_sizes = b_custom_size ? 1 : sizeof(s_default_sizes) / sizeof(s_default_sizes[0]);
+
+    printf("%-16s %8s %8s %12s %12s %14s %10s\n", "board", "games", "solved", "games/s", "solved/s", "deductions/s", "us/game");
+
+    for (size_t i = 0; i < num_sizes; ++i)
+    {
+        bench_size_t size = p_sizes[i];
+        if (num_games != 0)
+        {
+            size.num_games = num_games;
+        }
+
+        bench_result_t result;
+        if (!run_bench(&size, seed, &result))
+        {
+            printf("Failed to init %zu x %zu\n", size.rows, size.cols);
+            return 1;
+        }
+
+        char board[32];
+        snprintf(board, sizeof(board), "%zux%zu/%zu", size.rows, size.cols, size.num_mines);
+
+        const double elapsed = (result.elapsed > 0.0) ? result.elapsed : 1e-9;
+        printf("%-16s %8zu %7.1f%% %12.1f %12.1f %14.0f %10.2f\n",
+               board, result.num_games, 100.0 * (double)result.num_solved / (double)result.num_games,
+               (double)result.num_games / elapsed, (double)result.num_solved / elapsed,
+               (double)result.num_deductions / elapsed, elapsed * 1000000.0 / (double)result.num_games);
+    }
+
+    return 0;
+}
+
+static bool run_bench(const bench_size_t* p_size, const uint64_t seed, bench_result_t* p_out_result)
+{
+    engine_t engine;
+    if (!engine_init(&engine, p_size->rows, p_size->cols, p_size->num_mines, seed))
+    {
+        return false;
+    }
+    engine_set_first_click(&engine, ENGINE_FIRST_CLICK_SAFE_AREA);
+
+    solver_t solver;
+    if (!solver_init(&solver, &engine))
+    {
+        engine_release(&engine);
+        return false;
+    }
+
+    random_t seed_random;
+    random_init(&seed_random, seed);
+
+    memset(p_out_result, 0, sizeof(bench_result_t));
+
+    const double start_time = clock_get_seconds();
+
+    for (size_t game = 0; game < p_size->num_games; ++game)
+    {
+        engine_restart(&engine, random_next(&seed_random));
+        engine_open(&engine, p_size->cols / 2, p_size->rows / 2);
+
+        solver_update(&solver);
+        engine_clear_dirty(&engine);
+
+        while (engine_get_status(&engine) == ENGINE_STATUS_PLAYING)
+        {
+            solver_deduce(&solver);
+
+            size_t num_safe_tiles;
+            const size_t* p_safe_tiles = solver_get_safe_tiles(&solver, &num_safe_tiles);
+            if (num_safe_tiles == 0)
+            {
+                break;
+            }
+
+            // 열 때마다 반영해야 변경 타일 목록이 넘쳐 판 전체를 다시 읽는 일이 없음
+            for (size_t i = 0; i < num_safe_tiles; ++i)
+            {
+                engine_open(&engine, p_safe_tiles[i] % p_size->cols, p_safe_tiles[i] / p_size->cols);
+                solver_update(&solver);
+                engine_clear_dirty(&engine);
+            }
+            solver_clear_results(&solver);
+        }
+
+        if (engine_get_status(&engine) == ENGINE_STATUS_WON)
+        {
+            ++p_out_result->num_solved;
+        }
+    }
+
+    p_out_result->elapsed = clock_get_seconds() - start_time;
+    p_out_result->num_games = p_size->num_games;
+    p_out_result->num_deductions = solver.num_deductions;
+
+    solver_release(&solver);
+    engine_release(&engine);
+
+    return true;
+}
\ No newline at end of file
@@ -7,6 +7,8 @@
     #ifdef _MSC_VER
         #include <intrin.h>
         #define ASSERT(cond, msg) { if (!(cond)) { __debugbreak(); } }
+    #else
+        #define ASSERT(cond, msg) { if (!(cond)) { __builtin_trap(); } }
     #endif // _MSC_VER
 #endif // NDBUG
 
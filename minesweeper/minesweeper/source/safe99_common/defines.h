@@ -2,11 +2,15 @@
 #define DEFINES_H
 
 // dll exports
-#ifdef SAFE99_DLL_EXPORTS
-    #define SAFE99_API __declspec(dllexport)
+#ifdef _WIN32
+    #ifdef SAFE99_DLL_EXPORTS
+        #define SAFE99_API __declspec(dllexport)
+    #else
+        #define SAFE99_API __declspec(dllimport)
+    #endif // SAFE99_DLL_EXPORTS
 #else
-    #define SAFE99_API __declspec(dllimport)
-#endif // SAFE99_DLL_EXPORTS
+    #define SAFE99_API
+#endif // _WIN32
 
 // extern "C"
 #ifdef __cplusplus
@@ -23,12 +27,21 @@
     #else
         #define DISABLE_SSE_INTRINSICS
     #endif // PLATFORM
+#else
+    #if defined(__SSE2__)
+        #define ENABLE_SSE_INTRINSICS
+    #else
+        #define DISABLE_SSE_INTRINSICS
+    #endif // __SSE2__
 #endif // _MSC_VER
 
 // inline
 #ifdef _MSC_VER
     #define INLINE inline
     #define FORCEINLINE __forceinline
+#else
+    #define INLINE inline
+    #define FORCEINLINE inline __attribute__((always_inline))
 #endif // _MSC_VER
 
 #define TO_STR(s) #s